@@ -9,6 +9,8 @@
 #ifndef MCLD_ADT_SIZETRAITS_H_
 #define MCLD_ADT_SIZETRAITS_H_
 
+#include "mcld/Support/ELF.h"
+
 #include <llvm/Support/DataTypes.h>
 #include <llvm/Support/ELF.h>
 
@@ -55,6 +57,7 @@ class ELFSizeTraits<32> {
   typedef llvm::ELF::Elf32_Rela Rela;
   typedef llvm::ELF::Elf32_Phdr Phdr;
   typedef llvm::ELF::Elf32_Dyn Dyn;
+  typedef ELF::Elf32_Chdr Chdr;
 };
 
 template <>
@@ -75,6 +78,7 @@ class ELFSizeTraits<64> {
   typedef llvm::ELF::Elf64_Rela Rela;
   typedef llvm::ELF::Elf64_Phdr Phdr;
   typedef llvm::ELF::Elf64_Dyn Dyn;
+  typedef ELF::Elf64_Chdr Chdr;
 };
 
 /// alignAddress - helper function to align an address with given alignment
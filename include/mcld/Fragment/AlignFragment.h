@@ -43,6 +43,9 @@ class AlignFragment : public Fragment {
 
   size_t size() const;
 
+  /// sizeAt - the size of the padding if the fragment were at pOffset
+  size_t sizeAt(uint64_t pOffset) const;
+
  private:
   /// Alignment - The alignment to ensure, in bytes.
   unsigned int m_Alignment;
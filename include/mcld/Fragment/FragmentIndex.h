@@ -0,0 +1,90 @@
+//===- FragmentIndex.h ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_FRAGMENT_FRAGMENTINDEX_H_
+#define MCLD_FRAGMENT_FRAGMENTINDEX_H_
+
+#include <llvm/Support/DataTypes.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace mcld {
+
+class Fragment;
+class SectionData;
+
+/** \class FragmentIndex
+ *  \brief FragmentIndex is a flat view of the fragments of a SectionData:
+ *  an array of the fragments and the prefix sums of their sizes.
+ *
+ *  The fragment list of a section is walked once to build the index. Then
+ *  an offset in the section is mapped to its fragment by binary search, and
+ *  the layout of the fragments is written back without chasing the list.
+ *  The sizes of the fragments are computed on up to pNumThreads threads;
+ *  only the prefix sum itself is serial, since the size of an AlignFragment
+ *  depends on its offset.
+ *
+ *  The index is a snapshot. It has to be built again once fragments are
+ *  added to or removed from the section, or once their sizes change.
+ */
+class FragmentIndex {
+ public:
+  /// npos - find() did not find a fragment
+  static const size_t npos = ~size_t(0);
+
+ public:
+  FragmentIndex();
+
+  /// build - index the fragments of pSD. The first fragment is at offset 0.
+  void build(SectionData& pSD, unsigned pNumThreads = 1);
+
+  /// build - index pFirst and the fragments after it. pFirst is placed at
+  /// the end of the fragment before it, which must have an offset.
+  void build(Fragment& pFirst, unsigned pNumThreads = 1);
+
+  void clear();
+
+  bool empty() const { return m_Fragments.empty(); }
+
+  size_t numOfFragments() const { return m_Fragments.size(); }
+
+  Fragment& getFragment(size_t pIdx) const { return *m_Fragments[pIdx]; }
+
+  /// getOffset - the offset of fragment pIdx in the section.
+  /// getOffset(numOfFragments()) is the end of the last fragment.
+  uint64_t getOffset(size_t pIdx) const { return m_Offsets[pIdx]; }
+
+  uint64_t getSize(size_t pIdx) const {
+    return m_Offsets[pIdx + 1] - m_Offsets[pIdx];
+  }
+
+  /// find - the index of the fragment that pOffset, relative to the first
+  /// indexed fragment, refers to, and the offset in that fragment. The rules
+  /// are those of FragmentRef::Create(Fragment&, uint64_t): an offset at the
+  /// end of a fragment refers to the start of the next one, and an offset
+  /// at or beyond the end of the last fragment refers to nothing (npos).
+  size_t find(uint64_t pOffset, uint64_t& pFragOffset) const;
+
+  /// assignOffsets - set the offset of every indexed fragment
+  void assignOffsets(unsigned pNumThreads = 1) const;
+
+ private:
+  void build(Fragment* pFirst, uint64_t pStart, unsigned pNumThreads);
+
+ private:
+  std::vector<Fragment*> m_Fragments;
+
+  /// m_Offsets - m_Offsets[i] is the offset of fragment i, and the last
+  /// element is the end of the last fragment.
+  std::vector<uint64_t> m_Offsets;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_FRAGMENT_FRAGMENTINDEX_H_
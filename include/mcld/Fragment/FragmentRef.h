@@ -17,8 +17,10 @@
 namespace mcld {
 
 class Fragment;
+class FragmentIndex;
 class LDSection;
 class Layout;
+class SectionData;
 
 /** \class FragmentRef
  *  \brief FragmentRef is a reference of a Fragment's contetnt.
@@ -30,6 +32,26 @@ class FragmentRef {
   typedef NonConstTraits<unsigned char>::pointer Address;
   typedef ConstTraits<unsigned char>::pointer ConstAddress;
 
+ public:
+  /** \class IndexScope
+   *  \brief IndexScope indexes the fragments of a section while it lives, so
+   *  that Create(LDSection&, uint64_t) finds the fragment of each offset by
+   *  binary search. No fragment may be added to the section meanwhile.
+   */
+  class IndexScope {
+   public:
+    explicit IndexScope(LDSection& pSection);
+
+    ~IndexScope();
+
+   private:
+    IndexScope(const IndexScope&);             // DO NOT IMPLEMENT
+    IndexScope& operator=(const IndexScope&);  // DO NOT IMPLEMENT
+
+   private:
+    SectionData* m_pData;  // NULL if the section is not indexed
+  };
+
  public:
   /// Create - create a fragment reference for a given fragment.
   ///
@@ -42,6 +64,10 @@ class FragmentRef {
 
   static FragmentRef* Create(LDSection& pSection, uint64_t pOffset);
 
+  /// Create - create a fragment reference for pOffset from the first fragment
+  /// of pIndex. It gives the same reference as Create(Fragment&, uint64_t).
+  static FragmentRef* Create(const FragmentIndex& pIndex, uint64_t pOffset);
+
   /// Clear - clear all generated FragmentRef in the system.
   static void Clear();
 
@@ -41,6 +41,25 @@ class GeneralOptions {
     Both = 0x3
   };
 
+  enum class BuildIDStyle : uint8_t {
+    None,
+    Fast,   // 64-bit xxHash
+    MD5,
+    SHA1,
+    UUID,   // random
+    Hex     // given on the command line
+  };
+
+  enum class DebugCompression : uint8_t {
+    None,
+    Zlib
+  };
+
+  enum class DynRelocPacking : uint8_t {
+    None,
+    Relr   // relative relocations in .relr.dyn
+  };
+
   enum class ICF {
     Unknown,
     None,
@@ -64,6 +83,17 @@ class GeneralOptions {
   typedef UndefSymList::iterator undef_sym_iterator;
   typedef UndefSymList::const_iterator const_undef_sym_iterator;
 
+  typedef std::vector<std::string> SymbolOrderList;
+
+  /// CallGraphEdge - a line of --call-graph-ordering-file
+  struct CallGraphEdge {
+    std::string caller;
+    std::string callee;
+    uint64_t count;
+  };
+
+  typedef std::vector<CallGraphEdge> CallGraphProfile;
+
   typedef std::set<std::string> ExcludeLIBS;
 
  public:
@@ -263,6 +293,32 @@ class GeneralOptions {
 
   void setHashStyle(HashStyle pStyle) { m_HashStyle = pStyle; }
 
+  // --build-id[=style]
+  BuildIDStyle getBuildIDStyle() const { return m_BuildIDStyle; }
+
+  bool hasBuildID() const { return m_BuildIDStyle != BuildIDStyle::None; }
+
+  void setBuildIDStyle(BuildIDStyle pStyle) { m_BuildIDStyle = pStyle; }
+
+  /// the bytes of --build-id=0xHEX
+  const std::string& buildIDBytes() const { return m_BuildIDBytes; }
+
+  void setBuildIDBytes(const std::string& pBytes) { m_BuildIDBytes = pBytes; }
+
+  // --compress-debug-sections=type
+  DebugCompression getCompressDebugSections() const {
+    return m_CompressDebugSections;
+  }
+
+  void setCompressDebugSections(DebugCompression pType) {
+    m_CompressDebugSections = pType;
+  }
+
+  // --pack-dyn-relocs=format
+  DynRelocPacking getPackDynRelocs() const { return m_PackDynRelocs; }
+
+  void setPackDynRelocs(DynRelocPacking pFormat) { m_PackDynRelocs = pFormat; }
+
   ICF getICFMode() const { return m_ICF; }
 
   void setICFMode(ICF pMode) { m_ICF = pMode; }
@@ -277,6 +333,72 @@ class GeneralOptions {
     m_bPrintICFSections = pPrintICFSections;
   }
 
+  // --threads=N, 0 means one thread per hardware thread
+  void setNumThreads(unsigned pNum) { m_NumThreads = pNum; }
+
+  unsigned numThreads() const { return m_NumThreads; }
+
+  // --mmap-populate-limit=SIZE, 0 disables populating input mappings
+  void setMmapPopulateLimit(size_t pSize) { m_MmapPopulateLimit = pSize; }
+
+  size_t mmapPopulateLimit() const { return m_MmapPopulateLimit; }
+
+  // --prefetch-inputs=K, 0 disables the input prefetcher
+  void setPrefetchInputs(size_t pNum) { m_PrefetchInputs = pNum; }
+
+  size_t prefetchInputs() const { return m_PrefetchInputs; }
+
+  // --prefetch-budget=SIZE
+  void setPrefetchBudget(size_t pSize) { m_PrefetchBudget = pSize; }
+
+  size_t prefetchBudget() const { return m_PrefetchBudget; }
+
+  // --[no-]mmap-output-file
+  void setMmapOutputFile(bool pEnable = true) { m_bMmapOutputFile = pEnable; }
+
+  bool mmapOutputFile() const { return m_bMmapOutputFile; }
+
+  // --batch-apply-relocs
+  void setBatchApplyRelocs(bool pEnable = true) {
+    m_bBatchApplyRelocs = pEnable;
+  }
+
+  bool batchApplyRelocs() const { return m_bBatchApplyRelocs; }
+
+  // --incremental
+  void setIncremental(bool pEnable = true) { m_bIncremental = pEnable; }
+
+  bool incremental() const { return m_bIncremental; }
+
+  /// the command line an incremental link state belongs to
+  void setIncrementalKey(const std::string& pKey) { m_IncrementalKey = pKey; }
+
+  const std::string& incrementalKey() const { return m_IncrementalKey; }
+
+  // --time-trace=FILE
+  void setTimeTraceFile(const std::string& pPath) { m_TimeTraceFile = pPath; }
+
+  const std::string& timeTraceFile() const { return m_TimeTraceFile; }
+
+  bool hasTimeTrace() const { return !m_TimeTraceFile.empty(); }
+
+  // --print-stats
+  void setPrintStats(bool pEnable = true) { m_bPrintStats = pEnable; }
+
+  bool printStats() const { return m_bPrintStats; }
+
+  // --print-memory-usage
+  void setPrintMemoryUsage(bool pEnable = true) {
+    m_bPrintMemoryUsage = pEnable;
+  }
+
+  bool printMemoryUsage() const { return m_bPrintMemoryUsage; }
+
+  // --huge-pages
+  void setHugePages(bool pEnable = true) { m_bHugePages = pEnable; }
+
+  bool hugePages() const { return m_bHugePages; }
+
   // -----  link-in rpath  ----- //
   const RpathList& getRpathList() const { return m_RpathList; }
   RpathList& getRpathList() { return m_RpathList; }
@@ -309,6 +431,20 @@ class GeneralOptions {
   }
   undef_sym_iterator undef_sym_end() { return m_UndefSymList.end(); }
 
+  // -----  --symbol-ordering-file, hot symbols in order  ----- //
+  const SymbolOrderList& getSymbolOrderList() const {
+    return m_SymbolOrderList;
+  }
+  SymbolOrderList& getSymbolOrderList() { return m_SymbolOrderList; }
+
+  bool hasSymbolOrder() const { return !m_SymbolOrderList.empty(); }
+
+  // -----  --call-graph-ordering-file, weighted calls  ----- //
+  const CallGraphProfile& getCallGraphProfile() const {
+    return m_CallGraphProfile;
+  }
+  CallGraphProfile& getCallGraphProfile() { return m_CallGraphProfile; }
+
   // -----  filter and auxiliary filter  ----- //
   void setFilter(const std::string& pFilter) { m_Filter = pFilter; }
 
@@ -381,14 +517,32 @@ class GeneralOptions {
   bool m_bPrintGCSections : 1;    // --print-gc-sections
   bool m_bGenUnwindInfo : 1;      // --ld-generated-unwind-info
   bool m_bPrintICFSections : 1;   // --print-icf-sections
+  bool m_bMmapOutputFile : 1;     // --[no-]mmap-output-file
+  bool m_bBatchApplyRelocs : 1;   // --batch-apply-relocs
+  bool m_bIncremental : 1;        // --incremental
+  bool m_bPrintStats : 1;         // --print-stats
+  bool m_bPrintMemoryUsage : 1;   // --print-memory-usage
+  bool m_bHugePages : 1;          // --huge-pages
   ICF m_ICF;
   size_t m_ICFIterations;
+  unsigned m_NumThreads;  // --threads=N
+  size_t m_MmapPopulateLimit;  // --mmap-populate-limit=SIZE
+  size_t m_PrefetchInputs;     // --prefetch-inputs=K
+  size_t m_PrefetchBudget;     // --prefetch-budget=SIZE
   StripSymbolMode m_StripSymbols;
   RpathList m_RpathList;
   ScriptList m_ScriptList;
   UndefSymList m_UndefSymList;  // -u [symbol], --undefined [symbol]
+  SymbolOrderList m_SymbolOrderList;  // --symbol-ordering-file
+  CallGraphProfile m_CallGraphProfile;  // --call-graph-ordering-file
   HashStyle m_HashStyle;
+  BuildIDStyle m_BuildIDStyle;
+  std::string m_BuildIDBytes;
+  DebugCompression m_CompressDebugSections;
+  DynRelocPacking m_PackDynRelocs;
   std::string m_Filter;
+  std::string m_IncrementalKey;
+  std::string m_TimeTraceFile;  // --time-trace=FILE
   AuxiliaryList m_AuxiliaryList;
   ExcludeLIBS m_ExcludeLIBS;
 };
@@ -0,0 +1,92 @@
+//===- BuildID.h ----------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_BUILDID_H_
+#define MCLD_LD_BUILDID_H_
+#include "mcld/GeneralOptions.h"
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <string>
+
+namespace mcld {
+
+class FileOutputBuffer;
+class LDSection;
+
+/** \class BuildID
+ *  \brief BuildID represents .note.gnu.build-id section.
+ *
+ *  .note.gnu.build-id section format, with words in the target byte order
+ *  uint32_t : namesz (4)
+ *  uint32_t : descsz
+ *  uint32_t : type (NT_GNU_BUILD_ID)
+ *  char[4]  : "GNU\0"
+ *  uint8_t[descsz] : the build id
+ *
+ *  A hashed build id covers the whole output file with the build id itself
+ *  zeroed. The file is cut into fixed-size chunks that are hashed on several
+ *  threads, and the build id is the hash of the chunk digests. It does not
+ *  depend on the number of threads, but it is not the plain hash of the file.
+ */
+class BuildID {
+ public:
+  typedef GeneralOptions::BuildIDStyle Style;
+
+  /// the size of the chunks hashed by one thread at a time
+  static const size_t ChunkSize = 1024 * 1024;
+
+ public:
+  BuildID(LDSection& pSection,
+          Style pStyle,
+          const std::string& pBytes,
+          bool pLittleEndian,
+          unsigned pNumThreads = 1);
+
+  /// sizeOutput - size the note by the length of the build id
+  void sizeOutput();
+
+  /// emitOutput - write out the note. Everything else in pOutput must be in
+  /// its final state.
+  void emitOutput(FileOutputBuffer& pOutput);
+
+  /// getDigestSize - the length of a hashed build id of pStyle
+  static size_t getDigestSize(Style pStyle);
+
+  /// computeTreeHash - hash pData in chunks of pChunkSize bytes on up to
+  /// pNumThreads threads, and write the hash of the chunk digests to pResult.
+  static void computeTreeHash(Style pStyle,
+                              llvm::ArrayRef<uint8_t> pData,
+                              size_t pChunkSize,
+                              unsigned pNumThreads,
+                              uint8_t* pResult);
+
+ private:
+  /// the size of the build id
+  size_t descSize() const;
+
+ private:
+  /// .note.gnu.build-id section
+  LDSection& m_Section;
+
+  Style m_Style;
+
+  /// the bytes given by --build-id=0xHEX
+  std::string m_Bytes;
+
+  /// whether the target is little-endian
+  bool m_bLittleEndian;
+
+  /// the number of threads used to hash the output
+  unsigned m_NumThreads;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_BUILDID_H_
@@ -0,0 +1,76 @@
+//===- CallGraphSort.h ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_CALLGRAPHSORT_H_
+#define MCLD_LD_CALLGRAPHSORT_H_
+
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcld {
+
+/** \class CallGraphSort
+ *  \brief CallGraphSort orders the sections of a weighted call graph by the
+ *  C3 heuristic (Ottoni and Maher, "Optimizing Function Placement for
+ *  Large-Scale Data-Center Applications", CGO 2017).
+ *
+ *  Every section starts as a cluster of its own. Visiting the sections from
+ *  the densest, the cluster of a section is appended to the cluster of its
+ *  heaviest caller, unless the result would be larger than the cluster size
+ *  or much less dense than the caller. The clusters are then laid out from
+ *  the densest, so that the hot callers and callees share pages.
+ *
+ *  Sorting the sections and the clusters is O(n log n), and the merges are
+ *  nearly linear through a union-find of the cluster leaders.
+ */
+class CallGraphSort {
+ public:
+  explicit CallGraphSort(uint64_t pClusterSize);
+
+  /// addNode - add a section of pSize bytes and return its index
+  unsigned int addNode(uint64_t pSize);
+
+  /// addEdge - add pWeight calls from the section pCaller to pCallee
+  void addEdge(unsigned int pCaller, unsigned int pCallee, uint64_t pWeight);
+
+  /// sort - the indices of all sections in their new order
+  void sort(std::vector<unsigned int>& pOrder);
+
+  size_t numOfNodes() const { return m_Clusters.size(); }
+
+ private:
+  struct Cluster {
+    unsigned int next;     ///< the next section in a circular list
+    unsigned int prev;     ///< the last section when this is the leader
+    uint64_t size;
+    uint64_t weight;
+    uint64_t initialWeight;
+    int bestPred;          ///< the heaviest caller, or -1
+    uint64_t bestPredWeight;
+
+    double density() const {
+      return (size == 0) ? 0.0 : static_cast<double>(weight) / size;
+    }
+  };
+
+  /// getLeader - the leader of the cluster that pIndex is in
+  unsigned int getLeader(unsigned int pIndex);
+
+  /// merge - append the cluster of pFrom to the cluster of pInto
+  void merge(unsigned int pInto, unsigned int pFrom);
+
+ private:
+  uint64_t m_ClusterSize;
+  std::vector<Cluster> m_Clusters;
+  std::vector<unsigned int> m_Leaders;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_CALLGRAPHSORT_H_
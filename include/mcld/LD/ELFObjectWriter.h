@@ -11,7 +11,10 @@
 #include "mcld/LD/ObjectWriter.h"
 #include "mcld/Support/FileOutputBuffer.h"
 
+#include <llvm/ADT/DenseMap.h>
+
 #include <cassert>
+#include <vector>
 
 namespace mcld {
 
@@ -38,6 +41,14 @@ class ELFObjectWriter : public ObjectWriter {
 
   size_t getOutputSize(const Module& pModule) const;
 
+  void emitSection(Module& pModule, LDSection& pSection, MemoryRegion& pRegion);
+
+  bool compressSection(LDSection& pSection, ConstMemoryRegion pContents);
+
+ private:
+  typedef llvm::DenseMap<const LDSection*, std::vector<uint8_t> >
+      CompressedSectionMap;
+
  private:
   void writeSection(Module& pModule,
                     FileOutputBuffer& pOutput,
@@ -111,10 +122,19 @@ class ELFObjectWriter : public ObjectWriter {
 
   void emitSectionData(const SectionData& pSD, MemoryRegion& pRegion) const;
 
+  // writeCompressionHeader - emit ElfXX_Chdr
+  template <size_t SIZE>
+  void writeCompressionHeader(const LDSection& pSection,
+                              uint64_t pSize,
+                              uint8_t* pData) const;
+
  private:
   GNULDBackend& m_Backend;
 
   const LinkerConfig& m_Config;
+
+  /// the contents of the compressed sections, headed by ElfXX_Chdr
+  CompressedSectionMap m_CompressedSections;
 };
 
 template <>
@@ -10,6 +10,8 @@
 #define MCLD_LD_ELFREADERIF_H_
 
 #include "mcld/LinkerConfig.h"
+#include "mcld/LD/LDSymbol.h"
+#include "mcld/LD/ParsedInput.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Target/GNULDBackend.h"
 
@@ -84,6 +86,20 @@ class ELFReaderIF {
   /// readDynamic - read ELF .dynamic in input dynobj
   virtual bool readDynamic(Input& pInput) const = 0;
 
+  /// getParsed - the tables of pInput parsed by the InputCache, or NULL
+  static const ParsedInput::Object* getParsed(const Input& pInput);
+
+  /// createSections - create the LDSections of pInput from the section
+  /// table in pObject
+  bool createSections(Input& pInput, const ParsedInput::Object& pObject) const;
+
+  /// createSymbols - create the LDSymbols of pInput from the decoded symbol
+  /// table pSymbols, whose names are in pStrTab
+  bool createSymbols(Input& pInput,
+                     IRBuilder& pBuilder,
+                     const std::vector<ParsedInput::Symbol>& pSymbols,
+                     const char* pStrTab) const;
+
  protected:
   /// LinkInfo - some section needs sh_link and sh_info, remember them.
   struct LinkInfo {
@@ -94,6 +110,26 @@ class ELFReaderIF {
 
   typedef std::vector<LinkInfo> LinkInfoList;
 
+  struct AliasInfo {
+    LDSymbol* pt_alias;  /// potential alias
+    uint64_t ld_value;
+    ResolveInfo::Binding ld_binding;
+  };
+
+  /// comparison function to sort symbols for analyzing weak alias.
+  /// sort symbols by symbol value and then weak before strong.
+  static bool less(AliasInfo p1, AliasInfo p2) {
+    if (p1.ld_value != p2.ld_value)
+      return (p1.ld_value < p2.ld_value);
+    if (p1.ld_binding != p2.ld_binding) {
+      if (ResolveInfo::Weak == p1.ld_binding)
+        return true;
+      else if (ResolveInfo::Weak == p2.ld_binding)
+        return false;
+    }
+    return p1.pt_alias->str() < p2.pt_alias->str();
+  }
+
  protected:
   ResolveInfo::Type getSymType(uint8_t pInfo, uint16_t pShndx) const;
 
@@ -13,6 +13,8 @@
 #include "mcld/Support/FileOutputBuffer.h"
 
 #include <cassert>
+#include <vector>
+
 namespace mcld {
 
 class LDSection;
@@ -31,10 +33,16 @@ class FileOutputBuffer;
  *  uint32_t : fde_count
  *  __________________________ when fde_count > 0
  *  <uint32_t, uint32_t>+ : binary search table
+ *
+ *  The table entries are always 4-byte offsets relative to .eh_frame_hdr, but
+ *  the initial locations read out of the FDEs are target addresses, so
+ *  emitOutput is instantiated for both 32-bit and 64-bit targets.
  */
 class EhFrameHdr {
  public:
-  EhFrameHdr(LDSection& pEhFrameHdr, const LDSection& pEhFrame);
+  EhFrameHdr(LDSection& pEhFrameHdr,
+             const LDSection& pEhFrame,
+             unsigned pNumThreads = 1);
 
   ~EhFrameHdr();
 
@@ -47,10 +55,31 @@ class EhFrameHdr {
     assert(false && "Call invalid EhFrameHdr::emitOutput");
   }
 
+  /// radixSort - stable sort of pEntries by their high words on up to
+  /// pNumThreads threads. pBuffer is scratch space of the same size.
+  static void radixSort(std::vector<uint64_t>& pEntries,
+                        std::vector<uint64_t>& pBuffer,
+                        unsigned pNumThreads);
+
  private:
+  /// emitTable - write out eh_frame_hdr for a SIZE-bit target
+  template <size_t SIZE>
+  void emitTable(FileOutputBuffer& pOutput);
+
+  /// emitHeader - write out the fixed fields of eh_frame_hdr
+  size_t emitHeader(uint8_t* pData);
+
+  /// emitSearchTable - fill the binary search table of .eh_frame_hdr
+  template <size_t SIZE>
+  void emitSearchTable(uint32_t* pTable,
+                       size_t pNumOfFDEs,
+                       const MemoryRegion& pEhFrameRegion) const;
+
   /// computePCBegin - return the address of FDE's pc
-  uint32_t computePCBegin(const EhFrame::FDE& pFDE,
-                          const MemoryRegion& pEhFrameRegion);
+  template <size_t SIZE>
+  typename SizeTraits<SIZE>::Address computePCBegin(
+      const EhFrame::FDE& pFDE,
+      const MemoryRegion& pEhFrameRegion) const;
 
  private:
   /// .eh_frame_hdr section
@@ -58,6 +87,9 @@ class EhFrameHdr {
 
   /// eh_frame
   const LDSection& m_EhFrame;
+
+  /// the number of threads used to build the search table
+  unsigned m_NumThreads;
 };
 
 //===----------------------------------------------------------------------===//
@@ -67,6 +99,9 @@ class EhFrameHdr {
 template <>
 void EhFrameHdr::emitOutput<32>(FileOutputBuffer& pOutput);
 
+template <>
+void EhFrameHdr::emitOutput<64>(FileOutputBuffer& pOutput);
+
 }  // namespace mcld
 
 #endif  // MCLD_LD_EHFRAMEHDR_H_
@@ -86,6 +86,9 @@ class EhFrameReader {
 template <>
 bool EhFrameReader::read<32, true>(Input& pInput, EhFrame& pEhFrame);
 
+template <>
+bool EhFrameReader::read<64, true>(Input& pInput, EhFrame& pEhFrame);
+
 template <>
 EhFrameReader::Token EhFrameReader::scan<true>(ConstAddress pHandler,
                                                uint64_t pOffset,
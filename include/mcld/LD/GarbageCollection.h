@@ -63,8 +63,12 @@ class GarbageCollection {
   /// run - do garbage collection
   bool run();
 
+  /// setUpReachedSections - traverse the input relocations of pModule to set
+  /// up the sections that each section reaches directly
+  static void setUpReachedSections(Module& pModule,
+                                   SectionReachedListMap& pMap);
+
  private:
-  void setUpReachedSections();
   void findReferencedSections(SectionVecTy& pEntry);
   void getEntrySections(SectionVecTy& pEntry);
   void stripSections();
@@ -8,11 +8,14 @@
 //===----------------------------------------------------------------------===//
 #ifndef MCLD_LD_OBJECTWRITER_H_
 #define MCLD_LD_OBJECTWRITER_H_
+#include "mcld/Support/MemoryRegion.h"
+
 #include <system_error>
 
 namespace mcld {
 
 class FileOutputBuffer;
+class LDSection;
 class Module;
 
 /** \class ObjectWriter
@@ -29,6 +32,19 @@ class ObjectWriter {
                                       FileOutputBuffer& pOutput) = 0;
 
   virtual size_t getOutputSize(const Module& pModule) const = 0;
+
+  /// emitSection - write the contents of pSection to pRegion as writeObject
+  /// does, without its relocations applied
+  virtual void emitSection(Module& pModule,
+                           LDSection& pSection,
+                           MemoryRegion& pRegion) = 0;
+
+  /// compressSection - make pContents, the final contents of pSection, the
+  /// compressed contents of pSection. The caller lays out the sections after
+  /// pSection again.
+  /// @return false if compressing would not make pSection smaller
+  virtual bool compressSection(LDSection& pSection,
+                               ConstMemoryRegion pContents) = 0;
 };
 
 }  // namespace mcld
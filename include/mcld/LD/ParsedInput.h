@@ -0,0 +1,115 @@
+//===- ParsedInput.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LD_PARSEDINPUT_H_
+#define MCLD_LD_PARSEDINPUT_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/Support/DataTypes.h>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mcld {
+
+/** \class ParsedInput
+ *  \brief ParsedInput holds the tables of an input file decoded to host byte
+ *  order: the section table and symbol table of every ELF object in it, and
+ *  the symbol index of an archive.
+ *
+ *  The link server parses the inputs it keeps in its InputCache once, and
+ *  the links forked from it create the LDSections and LDSymbols of those
+ *  inputs from the parsed tables instead of decoding the file again. The
+ *  strings stay in the file; a Symbol refers to its string table by offset.
+ *
+ *  An object is found by the offset of its ELF header in the file, which is
+ *  Input::fileOffset() of archive members. Malformed objects are left out,
+ *  and their readers decode them from the file as usual.
+ */
+class ParsedInput {
+ public:
+  struct Section {
+    std::string name;
+    uint32_t type;
+    uint64_t flags;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t link;
+    uint32_t info;
+    uint64_t addralign;
+  };
+
+  struct Symbol {
+    uint32_t name;
+    uint8_t info;
+    uint8_t other;
+    uint16_t shndx;
+    uint64_t value;
+    uint64_t size;
+  };
+
+  struct Object {
+    std::vector<Section> sections;
+
+    /// the table read by the readers: .symtab of relocatable objects,
+    /// .dynsym of shared objects. It is empty if there is none.
+    std::vector<Symbol> symbols;
+    uint64_t symtabOffset;
+    uint64_t symtabSize;
+  };
+
+  struct ArchiveSymbol {
+    std::string name;
+    uint32_t fileOffset;
+  };
+
+ public:
+  /// parse the pSize bytes at pData, an ELF file or an archive
+  ParsedInput(const char* pData, size_t pSize);
+
+  ~ParsedInput();
+
+  /// getObject - the ELF object at pFileOffset, or NULL
+  const Object* getObject(uint64_t pFileOffset) const;
+
+  /// hasArchiveSymbols - is this an archive with a symbol index
+  bool hasArchiveSymbols() const { return m_bHasArchiveSymbols; }
+
+  /// archiveSymbols - the symbol index of the archive, in file order
+  const std::vector<ArchiveSymbol>& archiveSymbols() const {
+    return m_ArchiveSymbols;
+  }
+
+  /// empty - nothing in the file could be parsed
+  bool empty() const { return m_Objects.empty() && !m_bHasArchiveSymbols; }
+
+  size_t numOfObjects() const { return m_Objects.size(); }
+
+ private:
+  typedef std::map<uint64_t, Object> ObjectMap;
+
+ private:
+  void parseArchive(const char* pData, size_t pSize);
+
+  void parseObject(const char* pData, size_t pSize, uint64_t pFileOffset);
+
+ private:
+  ObjectMap m_Objects;
+  std::vector<ArchiveSymbol> m_ArchiveSymbols;
+  bool m_bHasArchiveSymbols;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ParsedInput);
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_LD_PARSEDINPUT_H_
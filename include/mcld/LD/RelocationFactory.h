@@ -23,7 +23,7 @@ class LinkerConfig;
  *
  */
 class RelocationFactory
-    : public GCFactory<Relocation, MCLD_RELOCATIONS_PER_INPUT> {
+    : public ArenaGCFactory<Relocation, MCLD_RELOCATIONS_PER_INPUT> {
  public:
   typedef Relocation::Type Type;
   typedef Relocation::Address Address;
@@ -32,6 +32,16 @@ class Relocator {
  public:
   enum Result { OK, BadReloc, Overflow, Unsupported, Unknown };
 
+  /** \enum ScanKind
+   *  \brief ScanKind tells what scanRelocation() does for a relocation.
+   *
+   *  ScanNone   - scanning the relocation has no effect
+   *  ScanSymbol - only the first relocation of the symbol in the same group
+   *               reserves anything, scanning the others has no effect
+   *  ScanEach   - every relocation has to be scanned
+   */
+  enum ScanKind { ScanNone, ScanSymbol, ScanEach };
+
  public:
   explicit Relocator(const LinkerConfig& pConfig) : m_Config(pConfig) {}
 
@@ -40,6 +50,27 @@ class Relocator {
   /// apply - general apply function
   virtual Result applyRelocation(Relocation& pRelocation) = 0;
 
+  /// applyRelocations - apply the relocations in [pBegin, pEnd), all of type
+  /// pType, and report every result that is not OK. The default applies them
+  /// one by one through applyRelocation().
+  virtual void applyRelocations(Type pType,
+                                Relocation* const* pBegin,
+                                Relocation* const* pEnd);
+
+  /// canApplyByType - return true if relocations of an input can be applied
+  /// in any order, so that the linker may group them by type and hand each
+  /// group to applyRelocations().
+  virtual bool canApplyByType() const { return false; }
+
+  /// canApplyAlone - return true if a relocation of type pType against a
+  /// symbol without GOT, PLT or dynamic relocation depends only on the
+  /// symbol value, the addend and the place, so that an incremental link can
+  /// apply it again without scanning the other inputs.
+  virtual bool canApplyAlone(Type pType) const { return false; }
+
+  /// reportResult - issue the diagnostic for applying pReloc with pResult
+  void reportResult(const Relocation& pReloc, Result pResult) const;
+
   /// scanRelocation - When read in relocations, backend can do any modification
   /// to relocation and generate empty entries, such as GOT, dynamic relocation
   /// entries and other target dependent entries. These entries are generated
@@ -54,6 +85,21 @@ class Relocator {
                               LDSection& pSection,
                               Input& pInput) = 0;
 
+  /// classifyScan - tell what scanRelocation() would do for pReloc, so that
+  /// the linker can classify the relocations of all inputs in parallel and
+  /// scan only the ones that may reserve an entry. For ScanSymbol, pGroup is
+  /// set to the kind of entry the relocation reserves.
+  /// It runs concurrently before any relocation is scanned, so it must only
+  /// read the relocation, its symbol and the configuration.
+  /// @param pReloc - a read in relocation entry
+  /// @param pSection - the relocation section of pReloc
+  /// @param pGroup - the group of ScanSymbol relocations
+  virtual ScanKind classifyScan(const Relocation& pReloc,
+                                const LDSection& pSection,
+                                unsigned& pGroup) const {
+    return ScanEach;
+  }
+
   /// issueUndefRefError - Provides a basic version for undefined reference
   /// dump.
   /// It will handle the filename and function name automatically.
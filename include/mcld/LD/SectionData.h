@@ -20,6 +20,7 @@
 
 namespace mcld {
 
+class FragmentIndex;
 class LDSection;
 
 /** \class SectionData
@@ -45,6 +46,8 @@ class SectionData {
   typedef FragmentListType::const_reverse_iterator const_reverse_iterator;
 
  public:
+  ~SectionData();
+
   static SectionData* Create(LDSection& pSection);
 
   static void Destroy(SectionData*& pSection);
@@ -80,9 +83,25 @@ class SectionData {
   const_reverse_iterator rend() const { return m_Fragments.rend(); }
   reverse_iterator rend() { return m_Fragments.rend(); }
 
+  /// updateOffsets - place pFirst and every fragment after it at the end of
+  /// the fragment before, as relaxation does once stubs grow the section.
+  void updateOffsets(Fragment& pFirst, unsigned pNumThreads = 1);
+
+  // -----  fragment index  ----- //
+  /// buildIndex - index the fragments until dropIndex(), so that
+  /// FragmentRef::Create(LDSection&, uint64_t) finds them by binary search.
+  /// No fragment may be added or removed meanwhile.
+  void buildIndex();
+
+  void dropIndex();
+
+  /// getIndex - the index, or NULL if there is none
+  const FragmentIndex* getIndex() const { return m_pIndex; }
+
  private:
   FragmentListType m_Fragments;
   LDSection* m_pSection;
+  FragmentIndex* m_pIndex;
 
  private:
   DISALLOW_COPY_AND_ASSIGN(SectionData);
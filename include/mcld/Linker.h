@@ -16,6 +16,7 @@ namespace mcld {
 class FileHandle;
 class FileOutputBuffer;
 class IRBuilder;
+class LinkContext;
 class LinkerConfig;
 class LinkerScript;
 class Module;
@@ -25,11 +26,17 @@ class TargetLDBackend;
 
 /** \class Linker
 *  \brief Linker is a modular linker.
+*
+*  A linker works in the link context that is current when it is created.
+*  Every step enters that context, so independent links in different
+*  contexts can run on different threads.
 */
 class Linker {
  public:
   Linker();
 
+  explicit Linker(LinkContext& pContext);
+
   ~Linker();
 
   /// emulate - To set up target-dependent options and default linker script.
@@ -47,6 +54,11 @@ class Linker {
   /// link - A convenient way to resolve and to layout the output mcld::Module.
   bool link(Module& pModule, IRBuilder& pBuilder);
 
+  /// relink - To patch the output of the last incremental link with the same
+  /// command line, when only the contents of some objects have changed.
+  ///   @return false if the output has to be linked again
+  bool relink(const Module& pModule);
+
   /// emit - To emit output mcld::Module to a FileOutputBuffer.
   bool emit(FileOutputBuffer& pOutput);
 
@@ -59,6 +71,8 @@ class Linker {
 
   bool reset();
 
+  LinkContext& getContext() const { return *m_pContext; }
+
  private:
   bool initTarget();
 
@@ -68,7 +82,11 @@ class Linker {
 
   bool initEmulator(LinkerScript& pScript);
 
+  /// recordState - keep the state of an incremental link beside pPath
+  void recordState(const std::string& pPath);
+
  private:
+  LinkContext* m_pContext;
   LinkerConfig* m_pConfig;
   IRBuilder* m_pIRBuilder;
 
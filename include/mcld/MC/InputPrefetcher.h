@@ -0,0 +1,115 @@
+//===- InputPrefetcher.h --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_MC_INPUTPREFETCHER_H_
+#define MCLD_MC_INPUTPREFETCHER_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mcld {
+
+class InputTree;
+class MemoryArea;
+
+/** \class InputPrefetcher
+ *  \brief InputPrefetcher reads in the input files ahead of the readers.
+ *
+ *  The inputs are mapped when the input tree is built, but their pages are
+ *  faulted in one by one as ObjectLinker::normalize() parses them. The
+ *  prefetcher walks the input tree up front and pages in the next few inputs
+ *  on background threads, so that I/O overlaps with parsing.
+ *
+ *  At most pLookahead inputs after the one being read are prefetched, and
+ *  the prefetched but not yet read inputs never exceed pBudget bytes, unless
+ *  a single input is larger than that.
+ */
+class InputPrefetcher {
+ public:
+  InputPrefetcher(unsigned pNumThreads, size_t pLookahead, size_t pBudget);
+
+  ~InputPrefetcher();
+
+  /// add - append pArea to the prefetch list. Areas shared by several inputs
+  /// are only added once.
+  void add(const MemoryArea& pArea);
+
+  /// start - add the memory areas of pTree in link order and start the
+  /// background threads.
+  void start(const InputTree& pTree);
+
+  void start();
+
+  /// advance - the caller is about to read pArea. Inputs before it are
+  /// done with, and the threads may move past it.
+  void advance(const MemoryArea& pArea);
+
+  /// stop - stop prefetching and wait for the background threads.
+  void stop();
+
+  // -----  observers  ----- //
+  size_t size() const { return m_Entries.size(); }
+
+  /// numOfPrefetched - the number of inputs paged in before they were read.
+  size_t numOfPrefetched() const { return m_NumPrefetched; }
+
+  uint64_t prefetchedBytes() const { return m_PrefetchedBytes; }
+
+  /// savedMicroseconds - the time the background threads spent on paging in
+  /// the inputs counted by numOfPrefetched(). The readers would otherwise
+  /// have waited for it.
+  uint64_t savedMicroseconds() const { return m_SavedMicroseconds; }
+
+ private:
+  struct Entry {
+    enum State { Pending, Running, Done };
+
+    const MemoryArea* area;
+    State state;
+    uint64_t micros;
+  };
+
+  void work();
+
+  bool canPrefetch() const;
+
+ private:
+  unsigned m_NumThreads;
+  size_t m_Lookahead;
+  size_t m_Budget;
+
+  std::vector<Entry> m_Entries;
+  llvm::DenseMap<const MemoryArea*, size_t> m_IndexMap;
+
+  // guards everything below
+  std::mutex m_Mutex;
+  std::condition_variable m_Cond;
+  std::vector<std::thread> m_Workers;
+  size_t m_Next;      // the next entry to prefetch
+  size_t m_Consumed;  // entries before this one are read by the linker
+  size_t m_InFlight;  // bytes prefetched after m_Consumed
+  bool m_bStop;
+
+  size_t m_NumPrefetched;
+  uint64_t m_PrefetchedBytes;
+  uint64_t m_SavedMicroseconds;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(InputPrefetcher);
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_MC_INPUTPREFETCHER_H_
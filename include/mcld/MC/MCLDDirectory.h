@@ -38,6 +38,11 @@ class MCLDDirectory : public sys::fs::Directory {
 
   const std::string& name() const { return m_Name; }
 
+  /// find - return the path of the entry pFileName in this directory, or NULL
+  /// if there is no such entry. The whole directory is read into the cache
+  /// by the first lookup, so later lookups are single hash probes.
+  sys::fs::Path* find(const std::string& pFileName);
+
  private:
   std::string m_Name;
   bool m_bInSysroot;
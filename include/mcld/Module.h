@@ -24,12 +24,16 @@
 namespace mcld {
 
 class Input;
+class LinkContext;
 class LinkerScript;
 class LDSection;
 class LDSymbol;
 
 /** \class Module
  *  \brief Module provides the intermediate representation for linking.
+ *
+ *  A module belongs to the link context that is current when it is created.
+ *  Its sections, symbols and relocations are allocated from that context.
  */
 class Module {
  public:
@@ -69,6 +73,8 @@ class Module {
 
   const LinkerScript& getScript() const { return m_Script; }
 
+  LinkContext& getContext() const { return m_Context; }
+
   LinkerScript& getScript() { return m_Script; }
 
   // -----  link-in objects ----- //
@@ -164,6 +170,7 @@ class Module {
  private:
   std::string m_Name;
   LinkerScript& m_Script;
+  LinkContext& m_Context;
   ObjectList m_ObjectList;
   LibraryList m_LibraryList;
   InputTree m_MainTree;
@@ -0,0 +1,151 @@
+//===- IncrementalState.h -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_OBJECT_INCREMENTALSTATE_H_
+#define MCLD_OBJECT_INCREMENTALSTATE_H_
+
+#include "mcld/Support/FileSystem.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/StringRef.h>
+
+#include <string>
+#include <vector>
+
+namespace mcld {
+
+/** \class IncrementalState
+ *  \brief IncrementalState is what an incremental link keeps beside its
+ *  output to patch the output later.
+ *
+ *  It records where every input section of every object was placed, the
+ *  symbol table of every object and the final state of every global symbol.
+ *  When the next link with the same command line finds that only the
+ *  contents of some objects have changed, and the changed objects still fit
+ *  in their places, their sections are rewritten in place instead of linking
+ *  again.
+ */
+class IncrementalState {
+ public:
+  typedef sys::fs::detail::FileIdentity FileIdentity;
+
+  /// Section - an input section of an object
+  struct Section {
+    enum Mode {
+      Patch,    ///< rewritten in place, code may grow into its reserve
+      Compare,  ///< must not change
+      Relocs,   ///< relocations of a Patch section, applied again
+      Skip,     ///< not compared, such as the symbol and string tables
+      Drop      ///< left out for a group kept from another object
+    };
+
+    Mode mode;
+    uint32_t type;
+    uint32_t flag;
+    uint32_t align;
+    uint32_t link;
+    uint64_t size;
+    uint64_t reserve;  ///< padding after a Patch section
+    bool placed;       ///< has an address in the output
+    uint64_t addr;
+    uint64_t offset;   ///< file offset in the output
+    uint64_t digest;   ///< of the contents of a Compare section
+    std::string name;
+  };
+
+  /// Symbol - a symbol of an object
+  struct Symbol {
+    enum {
+      NoEntry = -1,  ///< not in the output symbol tables
+      Fixed = -2     ///< in .dynsym, its size must not change
+    };
+
+    uint64_t size;
+    int64_t outIndex;  ///< index in the output .symtab, or NoEntry or Fixed
+  };
+
+  /// Object - a relocatable object that can be patched
+  struct Object {
+    std::string path;
+    FileIdentity identity;
+    uint64_t symbolDigest;  ///< of the symbols without values and sizes
+    std::vector<Section> sections;
+    std::vector<Symbol> symbols;
+  };
+
+  /// File - an input that is never patched, such as an archive
+  struct File {
+    std::string path;
+    FileIdentity identity;
+  };
+
+  /// Global - the final state of a global symbol
+  struct Global {
+    bool defined;
+    bool plain;  ///< has no GOT, PLT or dynamic relocation
+    uint64_t value;
+  };
+
+  typedef std::vector<Object> ObjectList;
+  typedef std::vector<File> FileList;
+  typedef llvm::StringMap<Global> GlobalMap;
+
+ public:
+  IncrementalState();
+
+  /// getPath - the state file of the output pOutput
+  static std::string getPath(const std::string& pOutput);
+
+  /// identify - get the identity of the file pPath
+  static bool identify(const std::string& pPath, FileIdentity& pIdentity);
+
+  /// digest - a 64-bit digest of pData
+  static uint64_t digest(llvm::StringRef pData);
+
+  bool read(const std::string& pPath);
+
+  bool write(const std::string& pPath) const;
+
+  // -----  the link  ----- //
+  uint64_t key() const { return m_Key; }
+  void setKey(uint64_t pKey) { m_Key = pKey; }
+
+  unsigned int codePosition() const { return m_CodePosition; }
+  void setCodePosition(unsigned int pPosition) { m_CodePosition = pPosition; }
+
+  // -----  the output  ----- //
+  const FileIdentity& output() const { return m_Output; }
+  void setOutput(const FileIdentity& pIdentity) { m_Output = pIdentity; }
+
+  /// the file offset of the output .symtab, 0 if there is none
+  uint64_t symtabOffset() const { return m_SymTabOffset; }
+  void setSymTabOffset(uint64_t pOffset) { m_SymTabOffset = pOffset; }
+
+  // -----  inputs  ----- //
+  ObjectList& objects() { return m_Objects; }
+  const ObjectList& objects() const { return m_Objects; }
+
+  FileList& files() { return m_Files; }
+  const FileList& files() const { return m_Files; }
+
+  GlobalMap& globals() { return m_Globals; }
+  const GlobalMap& globals() const { return m_Globals; }
+
+ private:
+  uint64_t m_Key;
+  unsigned int m_CodePosition;
+  FileIdentity m_Output;
+  uint64_t m_SymTabOffset;
+  ObjectList m_Objects;
+  FileList m_Files;
+  GlobalMap m_Globals;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_OBJECT_INCREMENTALSTATE_H_
@@ -8,8 +8,14 @@
 //===----------------------------------------------------------------------===//
 #ifndef MCLD_OBJECT_OBJECTLINKER_H_
 #define MCLD_OBJECT_OBJECTLINKER_H_
+#include "mcld/Object/IncrementalState.h"
+
+#include <llvm/ADT/DenseMap.h>
 #include <llvm/Support/DataTypes.h>
 
+#include <utility>
+#include <vector>
+
 namespace mcld {
 
 class ArchiveReader;
@@ -19,10 +25,14 @@ class DynObjReader;
 class DynObjWriter;
 class ExecWriter;
 class FileOutputBuffer;
+class Fragment;
 class GroupReader;
+class Input;
 class IRBuilder;
+class LDSection;
 class LinkerConfig;
 class Module;
+class ObjectBuilder;
 class ObjectReader;
 class ObjectWriter;
 class Relocation;
@@ -117,12 +127,35 @@ class ObjectLinker {
   /// finalizeSymbolValue - finalize the symbol value
   bool finalizeSymbolValue();
 
+  /// compressDebugSections - apply the relocations of the debug sections at
+  /// the end of the output, compress them, and lay them out again by their
+  /// compressed sizes
+  bool compressDebugSections();
+
   /// emitOutput - emit the output file.
   bool emitOutput(FileOutputBuffer& pOutput);
 
   /// postProcessing - do modificatiion after all processes
   bool postProcessing(FileOutputBuffer& pOutput);
 
+  // -----  incremental linking  ----- //
+  /// recordState - describe the emitted output in pState for a later
+  /// incremental link
+  ///   @return false if the output can not be patched
+  bool recordState(IncrementalState& pState);
+
+  /// preparePatch - check that the only object of this link can take the
+  /// place of pRecord in the output described by pState, apply its
+  /// relocations and describe it in pUpdate
+  bool preparePatch(const IncrementalState& pState,
+                    const IncrementalState::Object& pRecord,
+                    IncrementalState::Object& pUpdate);
+
+  /// emitPatch - write the object checked by preparePatch() into pOutput
+  void emitPatch(const IncrementalState& pState,
+                 const IncrementalState::Object& pUpdate,
+                 FileOutputBuffer& pOutput);
+
   // -----  readers and writers  ----- //
   const ObjectReader* getObjectReader() const { return m_pObjectReader; }
   ObjectReader* getObjectReader() { return m_pObjectReader; }
@@ -146,6 +179,9 @@ class ObjectLinker {
   ObjectWriter* getWriter() { return m_pWriter; }
 
  private:
+  /// the input sections placed first in their output sections, in order
+  typedef std::vector<std::pair<Input*, LDSection*> > SectionOrder;
+
   /// normalSyncRelocationResult - sync relocation result when producing shared
   /// objects or executables
   void normalSyncRelocationResult(FileOutputBuffer& pOutput);
@@ -162,6 +198,41 @@ class ObjectLinker {
   /// section symbol and not defined in the discarded section
   void addSymbolToOutput(ResolveInfo& pInfo, Module& pModule);
 
+  /// mergeSection - merge pSection of pInput into its output section and,
+  /// in an incremental link, remember where it is placed
+  LDSection* mergeSection(Input& pInput, LDSection& pSection);
+
+  /// mergeInputSection - merge pSection of pInput by its kind
+  bool mergeInputSection(Input& pInput,
+                         LDSection& pSection,
+                         ObjectBuilder& pBuilder);
+
+  /// getSectionOrder - the input sections that define the symbols listed by
+  /// --symbol-ordering-file, ordered by their first listed symbol
+  void getSectionOrder(SectionOrder& pOrder) const;
+
+  /// getCallGraphOrder - the input sections that define the symbols named by
+  /// --call-graph-ordering-file, clustered by the calls between them
+  void getCallGraphOrder(SectionOrder& pOrder) const;
+
+  /// describeObject - describe the sections and symbols of pInput in
+  /// pRecord, leaving the modes and places to the caller
+  bool describeObject(Input& pInput, IncrementalState::Object& pRecord) const;
+
+ private:
+  /// Placement - the first fragment of a merged input section and the room
+  /// left after it
+  struct Placement {
+    const Fragment* first;
+    uint64_t reserve;
+  };
+
+  typedef llvm::DenseMap<const LDSection*, Placement> PlacementMap;
+
+  /// a relocation applied by preparePatch() and the output file offset of
+  /// its place
+  typedef std::vector<std::pair<Relocation*, uint64_t> > PatchRelocList;
+
  private:
   const LinkerConfig& m_Config;
   Module* m_pModule;
@@ -177,6 +248,11 @@ class ObjectLinker {
   BinaryReader* m_pBinaryReader;
   ScriptReader* m_pScriptReader;
   ObjectWriter* m_pWriter;
+
+  // -----  incremental linking  ----- //
+  PlacementMap m_Placements;
+  Input* m_pPatchInput;
+  PatchRelocList m_PatchRelocs;
 };
 
 }  // namespace mcld
@@ -21,6 +21,7 @@
 namespace mcld {
 
 class Fragment;
+class Input;
 class LDSection;
 
 /** \class SectionMap
@@ -34,6 +35,9 @@ class SectionMap {
     typedef DotAssignments::const_iterator const_dot_iterator;
     typedef DotAssignments::iterator dot_iterator;
 
+    /// the input sections held back to be sorted, with their files
+    typedef std::vector<std::pair<const mcld::Input*, LDSection*> > SortList;
+
     Input(const std::string& pName, InputSectDesc::KeepPolicy pPolicy);
     explicit Input(const InputSectDesc& pInputDesc);
 
@@ -52,11 +56,26 @@ class SectionMap {
     const DotAssignments& dotAssignments() const { return m_DotAssignments; }
     DotAssignments& dotAssignments() { return m_DotAssignments; }
 
+    /// isSorted - the description sorts its sections by SORT_BY_NAME,
+    /// SORT_BY_ALIGNMENT, SORT_BY_INIT_PRIORITY or their combinations
+    bool isSorted() const { return m_bSorted; }
+
+    /// defer - hold pSection of pFile back until placeSorted()
+    void defer(const mcld::Input& pFile, LDSection& pSection) {
+      m_SortList.push_back(std::make_pair(&pFile, &pSection));
+    }
+
+    /// placeSorted - stably sort the held sections by the policies of the
+    /// description, and move them into the section data of the description
+    void placeSorted();
+
    private:
     InputSectDesc::KeepPolicy m_Policy;
     InputSectDesc::Spec m_Spec;
     LDSection* m_pSection;
     DotAssignments m_DotAssignments;
+    bool m_bSorted;
+    SortList m_SortList;
   };
 
   class Output {
@@ -199,7 +218,8 @@ class SectionMap {
                const std::string& pInputFile,
                const std::string& pInputSection) const;
 
-  bool matched(const WildcardPattern& pPattern, const std::string& pName) const;
+  static bool matched(const WildcardPattern& pPattern,
+                      const std::string& pName);
 
  private:
   OutputDescList m_OutputDescList;
@@ -9,8 +9,10 @@
 #ifndef MCLD_SUPPORT_ALLOCATORS_H_
 #define MCLD_SUPPORT_ALLOCATORS_H_
 #include "mcld/ADT/TypeTraits.h"
+#include "mcld/Support/Arena.h"
 #include "mcld/Support/Compiler.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
 
@@ -301,6 +303,194 @@ class LinearAllocator<DataType, 0>
   virtual ~LinearAllocator() {}
 };
 
+/** \class ArenaChunk
+ *  \brief ArenaChunk is the storage of the ArenaAllocator. Unlike Chunk, the
+ *  chunks of an allocator differ in size, so each one keeps its capacity.
+ *
+ *  @see ArenaAllocator
+ */
+template <typename DataType>
+class ArenaChunk {
+ public:
+  typedef DataType value_type;
+
+ public:
+  ArenaChunk(DataType* pData, size_t pCapacity)
+      : next(NULL), bound(0), capacity(pCapacity), data(pData) {}
+
+  static void construct(value_type* pPtr) { new (pPtr) value_type(); }
+
+  static void construct(value_type* pPtr, const value_type& pValue) {
+    new (pPtr) value_type(pValue);
+  }
+
+  // The arena never deletes a chunk, so the data are destructed here, where
+  // deleting a Chunk<DataType, N> destructs them.
+  static void destroy(value_type* pPtr) { pPtr->~value_type(); }
+
+ public:
+  ArenaChunk* next;
+  size_t bound;
+  size_t capacity;
+  DataType* data;
+};
+
+/** \class ArenaAllocator
+ *  \brief ArenaAllocator is a LinearAllocator whose chunks come from the
+ *  Arena of the link context it is created in.
+ *
+ *  The first chunk holds InitialSize data, and every new chunk doubles the
+ *  size of the last one up to kMaxChunkBytes, so the number of chunks grows
+ *  with the logarithm of the data instead of linearly. Chunks released by
+ *  clear() are kept and reused; their memory goes back with the arena.
+ *
+ *  The allocator itself is not thread-safe, but allocators on different
+ *  threads may share the arena. It has to be destroyed before the context,
+ *  which is the case for the objects of the context.
+ */
+template <typename DataType, size_t InitialSize>
+class ArenaAllocator {
+ public:
+  typedef ArenaChunk<DataType> chunk_type;
+  typedef DataType value_type;
+  typedef DataType* pointer;
+  typedef DataType& reference;
+  typedef const DataType* const_pointer;
+  typedef const DataType& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+
+  template <typename NewDataType>
+  struct rebind {
+    typedef ArenaAllocator<NewDataType, InitialSize> other;
+  };
+
+  /// the size the chunks stop growing at
+  static const size_t kMaxChunkBytes = 1024 * 1024;
+
+ public:
+  ArenaAllocator()
+      : m_pArena(&Arena::current()),
+        m_pRoot(NULL),
+        m_pCurrent(NULL),
+        m_pFree(NULL),
+        m_AllocatedNum(0),
+        m_NextSize(InitialSize) {}
+
+  virtual ~ArenaAllocator() {}
+
+  pointer address(reference X) const { return &X; }
+
+  const_pointer address(const_reference X) const { return &X; }
+
+  void construct(pointer pPtr, const_reference pValue) {
+    chunk_type::construct(pPtr, pValue);
+  }
+
+  void construct(pointer pPtr) { chunk_type::construct(pPtr); }
+
+  void destroy(pointer pPtr) { chunk_type::destroy(pPtr); }
+
+  /// allocate - allocate N data in order. Unlike LinearAllocator, N may be
+  /// larger than a chunk.
+  pointer allocate(size_type N) {
+    if (N == 0)
+      return 0;
+    if (empty() || m_pCurrent->bound + N > m_pCurrent->capacity)
+      getNewChunk(N);
+    pointer result = m_pCurrent->data + m_pCurrent->bound;
+    m_pCurrent->bound += N;
+    return result;
+  }
+
+  pointer allocate() { return allocate(1); }
+
+  /// deallocate - release the last N data allocated, which start at pPtr.
+  /// Other data stay until clear().
+  void deallocate(pointer& pPtr, size_type N) {
+    if (empty() || N == 0 || N > m_pCurrent->bound)
+      return;
+    if (pPtr != m_pCurrent->data + m_pCurrent->bound - N)
+      return;
+    m_pCurrent->bound -= N;
+    pPtr = 0;
+  }
+
+  void deallocate(pointer& pPtr) { deallocate(pPtr, 1); }
+
+  /// reset - forget all chunks without destructing the data
+  void reset() {
+    m_pRoot = 0;
+    m_pCurrent = 0;
+    m_AllocatedNum = 0;
+  }
+
+  /// clear - destruct the data, and keep the chunks for reuse
+  void clear() {
+    chunk_type* cur = m_pRoot;
+    while (cur != 0) {
+      chunk_type* next = cur->next;
+      for (size_t idx = 0; idx != cur->bound; ++idx)
+        destroy(cur->data + idx);
+      cur->bound = 0;
+      cur->next = m_pFree;
+      m_pFree = cur;
+      cur = next;
+    }
+    reset();
+  }
+
+  // -----  observers  ----- //
+  bool empty() const { return (m_pRoot == 0); }
+
+  size_type max_size() const { return m_AllocatedNum; }
+
+ protected:
+  chunk_type* getNewChunk(size_type N) {
+    chunk_type* result = takeFreeChunk(N);
+    if (result == NULL) {
+      size_t capacity = std::max<size_t>(N, m_NextSize);
+      result = new (m_pArena->allocate<chunk_type>(1))
+          chunk_type(m_pArena->allocate<DataType>(capacity), capacity);
+      size_t limit = std::max<size_t>(InitialSize,
+                                      kMaxChunkBytes / sizeof(DataType));
+      m_NextSize = std::min(m_NextSize * 2, limit);
+    }
+
+    if (empty())
+      m_pRoot = result;
+    else
+      m_pCurrent->next = result;
+    m_pCurrent = result;
+    m_AllocatedNum += result->capacity;
+    return result;
+  }
+
+  /// takeFreeChunk - take a chunk released by clear() that holds N data
+  chunk_type* takeFreeChunk(size_type N) {
+    for (chunk_type** link = &m_pFree; *link != NULL; link = &(*link)->next) {
+      chunk_type* chunk = *link;
+      if (chunk->capacity >= N) {
+        *link = chunk->next;
+        chunk->next = NULL;
+        return chunk;
+      }
+    }
+    return NULL;
+  }
+
+ protected:
+  Arena* m_pArena;
+  chunk_type* m_pRoot;
+  chunk_type* m_pCurrent;
+  chunk_type* m_pFree;
+  size_type m_AllocatedNum;
+  size_t m_NextSize;
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(ArenaAllocator);
+};
+
 template <typename DataType>
 class MallocAllocator {
  public:
@@ -0,0 +1,130 @@
+//===- Arena.h ------------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_ARENA_H_
+#define MCLD_SUPPORT_ARENA_H_
+
+#include <llvm/Support/DataTypes.h>
+
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mcld {
+
+/** \class Arena
+ *  \brief Arena is a bump pointer allocator that many threads may allocate
+ *  from at the same time.
+ *
+ *  The arena maps memory in slabs whose size doubles from
+ *  Policy::initialSlabSize up to Policy::maxSlabSize, so a small link maps
+ *  little memory and a huge one maps few slabs. Each thread bumps a pointer
+ *  through a slab of its own and takes the lock only to get a new slab.
+ *  Memory is never returned one allocation at a time; it all goes away with
+ *  reset() or with the arena.
+ *
+ *  Each link context has its own arena, see ArenaAllocator.
+ */
+class Arena {
+ public:
+  /** \class Policy
+   *  \brief Policy tells how the arena grows.
+   */
+  struct Policy {
+    size_t initialSlabSize;  // the size of the first slab
+    size_t maxSlabSize;      // the size the slabs stop growing at
+    bool hugePages;          // back the slabs with huge pages
+  };
+
+  /// the alignment of allocate(pSize)
+  static const size_t kDefaultAlignment = 16;
+
+ public:
+  Arena();
+
+  explicit Arena(const Policy& pPolicy);
+
+  ~Arena();
+
+  /// current - the arena of the current link context
+  static Arena& current();
+
+  const Policy& policy() const { return m_Policy; }
+
+  /// setHugePages - back the slabs mapped from now on with huge pages
+  void setHugePages(bool pEnable = true);
+
+  /// allocate - allocate pSize bytes aligned to pAlign, a power of two
+  void* allocate(size_t pSize, size_t pAlign = kDefaultAlignment);
+
+  /// allocate - allocate room for pNum objects of type T
+  template <typename T>
+  T* allocate(size_t pNum) {
+    return static_cast<T*>(allocate(sizeof(T) * pNum, alignof(T)));
+  }
+
+  /// reset - unmap all slabs. No thread may allocate from the arena at the
+  /// same time, and nothing allocated before may be used afterwards.
+  void reset();
+
+  // -----  observers  ----- //
+  size_t numOfSlabs() const;
+
+  /// bytesReserved - the bytes of the mapped slabs
+  uint64_t bytesReserved() const;
+
+  /// bytesAllocated - the bytes handed out
+  uint64_t bytesAllocated() const;
+
+ private:
+  struct Slab {
+    char* begin;
+    size_t size;
+  };
+
+  /// the bump pointer of a thread
+  struct ThreadState {
+    std::thread::id owner;
+    char* cur;
+    char* end;
+    uint64_t allocated;
+  };
+
+ private:
+  Arena(const Arena&);             // DO NOT IMPLEMENT
+  Arena& operator=(const Arena&);  // DO NOT IMPLEMENT
+
+  /// bump - allocate from the slab of pState, or return NULL if it is full
+  static void* bump(ThreadState& pState, size_t pSize, size_t pAlign);
+
+  /// getThreadState - the bump pointer of this thread. The caller holds the
+  /// lock.
+  ThreadState& getThreadState();
+
+  /// allocateSlow - allocate when the bump pointer of this thread is not
+  /// cached or its slab is full
+  void* allocateSlow(size_t pSize, size_t pAlign);
+
+  /// mapSlab - map a slab of at least pSize bytes. The caller holds the lock.
+  Slab mapSlab(size_t pSize);
+
+  void unmapSlabs();
+
+ private:
+  Policy m_Policy;
+  uint64_t m_Id;  // tells the bump pointers of this arena in the thread cache
+  size_t m_NextSlabSize;
+  mutable std::mutex m_Mutex;
+  std::vector<Slab> m_Slabs;
+  std::vector<ThreadState*> m_Threads;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_ARENA_H_
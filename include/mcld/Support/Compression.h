@@ -0,0 +1,39 @@
+//===- Compression.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_COMPRESSION_H_
+#define MCLD_SUPPORT_COMPRESSION_H_
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace mcld {
+namespace zlib {
+
+/// compress - deflate pInput into one zlib stream in pOutput.
+///
+/// pInput is cut into chunks that are deflated on up to pNumThreads threads.
+/// Every chunk but the last ends on a sync flush, so the raw deflate data of
+/// the chunks can be concatenated, and their Adler-32 checksums are combined
+/// into the checksum of the stream.
+void compress(llvm::ArrayRef<uint8_t> pInput,
+              unsigned pNumThreads,
+              std::vector<uint8_t>& pOutput);
+
+/// uncompress - inflate the zlib stream pInput into the pSize bytes at
+/// pOutput.
+/// @return false if pInput is not a zlib stream of exactly pSize bytes
+bool uncompress(llvm::ArrayRef<uint8_t> pInput, uint8_t* pOutput, size_t pSize);
+
+}  // namespace zlib
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_COMPRESSION_H_
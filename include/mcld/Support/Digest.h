@@ -0,0 +1,32 @@
+//===- Digest.h -----------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_DIGEST_H_
+#define MCLD_SUPPORT_DIGEST_H_
+
+#include <llvm/ADT/ArrayRef.h>
+#include <llvm/Support/DataTypes.h>
+
+namespace mcld {
+namespace digest {
+
+/// the size of a SHA-1 digest
+const size_t kSHA1Size = 20;
+
+/// xxHash64 - the 64-bit xxHash of pData with seed 0, as the xxHash
+/// reference implementation computes it
+uint64_t xxHash64(llvm::ArrayRef<uint8_t> pData);
+
+/// SHA1 - write the SHA-1 digest of pData (FIPS 180-4) to pResult, which
+/// holds kSHA1Size bytes
+void SHA1(llvm::ArrayRef<uint8_t> pData, uint8_t* pResult);
+
+}  // namespace digest
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_DIGEST_H_
@@ -9,6 +9,8 @@
 #ifndef MCLD_SUPPORT_ELF_H_
 #define MCLD_SUPPORT_ELF_H_
 
+#include <llvm/Support/DataTypes.h>
+
 namespace mcld {
 namespace ELF {
 
@@ -19,9 +21,47 @@ enum SHF {
   SHF_ORDERED = 0x40000000,
 
   // Section with data that is GP relative addressable.
-  SHF_MIPS_GPREL = 0x10000000
+  SHF_MIPS_GPREL = 0x10000000,
+
+  // Section data is compressed and headed by an ElfXX_Chdr. It is newer than
+  // the LLVM the tree builds with.
+  SHF_COMPRESSED = 0x800
 };  // enum SHF
 
+// The values below are newer than the LLVM the tree builds with.
+
+// Section types
+enum SHT {
+  // Relative relocations packed into bitmaps (generic ABI)
+  SHT_RELR = 19
+};  // enum SHT
+
+// Dynamic table tags
+enum DT {
+  DT_RELRSZ = 35,
+  DT_RELR = 36,
+  DT_RELRENT = 37
+};  // enum DT
+
+// Compression algorithms of SHF_COMPRESSED sections
+enum ELFCOMPRESS {
+  ELFCOMPRESS_ZLIB = 1
+};  // enum ELFCOMPRESS
+
+// Compression header of a SHF_COMPRESSED section
+struct Elf32_Chdr {
+  uint32_t ch_type;
+  uint32_t ch_size;
+  uint32_t ch_addralign;
+};
+
+struct Elf64_Chdr {
+  uint32_t ch_type;
+  uint32_t ch_reserved;
+  uint64_t ch_size;
+  uint64_t ch_addralign;
+};
+
 }  // namespace ELF
 }  // namespace mcld
 
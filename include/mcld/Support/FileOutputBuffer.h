@@ -24,6 +24,17 @@ class FileHandle;
 /// FileOutputBuffer - This interface is borrowed from llvm bassically, and we
 /// may use ostream to emit output later.
 class FileOutputBuffer {
+ public:
+  enum Mode {
+    // The output file is mapped and written in place. Dirty pages are
+    // flushed by the OS when the buffer is destroyed.
+    Mapped,
+    // The output is built in anonymous memory and written to the file by
+    // commit() with large pwrite() calls in file order. This avoids the
+    // page faults and the writeback stall at munmap of a huge mapping.
+    Direct
+  };
+
  public:
   /// Factory method to create an OutputBuffer object which manages a read/write
   /// buffer of the specified size. When committed, the buffer will be written
@@ -32,21 +43,28 @@ class FileOutputBuffer {
                                 size_t pSize,
                                 std::unique_ptr<FileOutputBuffer>& pResult);
 
+  static std::error_code create(FileHandle& pFileHandle,
+                                size_t pSize,
+                                Mode pMode,
+                                std::unique_ptr<FileOutputBuffer>& pResult);
+
   /// Returns a pointer to the start of the buffer.
-  uint8_t* getBufferStart() {
-    return reinterpret_cast<uint8_t*>(m_pRegion->data());
-  }
+  uint8_t* getBufferStart() { return m_pData; }
 
   /// Returns a pointer to the end of the buffer.
-  uint8_t* getBufferEnd() {
-    return reinterpret_cast<uint8_t*>(m_pRegion->data()) + m_pRegion->size();
-  }
+  uint8_t* getBufferEnd() { return m_pData + m_Size; }
 
   /// Returns size of the buffer.
-  size_t getBufferSize() const { return m_pRegion->size(); }
+  size_t getBufferSize() const { return m_Size; }
+
+  Mode mode() const { return m_Mode; }
 
   MemoryRegion request(size_t pOffset, size_t pLength);
 
+  /// commit - write the buffer out to the file. It does nothing for a Mapped
+  /// buffer.
+  std::error_code commit();
+
   /// Returns path where file will show up if buffer is committed.
   llvm::StringRef getPath() const;
 
@@ -59,8 +77,13 @@ class FileOutputBuffer {
   FileOutputBuffer(llvm::sys::fs::mapped_file_region* pRegion,
                    FileHandle& pFileHandle);
 
+  FileOutputBuffer(uint8_t* pBuffer, size_t pSize, FileHandle& pFileHandle);
+
   std::unique_ptr<llvm::sys::fs::mapped_file_region> m_pRegion;
   FileHandle& m_FileHandle;
+  Mode m_Mode;
+  uint8_t* m_pData;
+  size_t m_Size;
 };
 
 }  // namespace mcld
@@ -104,6 +104,37 @@ void* mmap(void* pAddr,
            off_t pOffset);
 int munmap(void* pAddr, size_t pLen);
 
+/// MapAdvice - the expected access pattern of a mapped input file.
+enum MapAdvice {
+  MapNormal,      // no special treatment
+  MapSequential,  // read ahead aggressively, drop pages soon after use
+  MapWillNeed     // start reading the pages in now
+};
+
+/// map_file - map the first pLength bytes of pFD read-only. If pPopulate is
+/// set, the pages are read in before the call returns.
+/// @return NULL on failure.
+void* map_file(int pFD, size_t pLength, bool pPopulate);
+int unmap_file(void* pAddr, size_t pLength);
+int advise_map(const void* pAddr, size_t pLength, MapAdvice pAdvice);
+
+/// FileIdentity - the facts that tell two versions of a file apart.
+struct FileIdentity {
+  uint64_t device;
+  uint64_t inode;
+  uint64_t size;
+  int64_t mtime;  // in nanoseconds where the host records them
+};
+
+inline bool operator==(const FileIdentity& pX, const FileIdentity& pY) {
+  return pX.device == pY.device && pX.inode == pY.inode &&
+         pX.size == pY.size && pX.mtime == pY.mtime;
+}
+
+/// file_identity - get the identity of the regular file opened as pFD.
+/// @return false if pFD is not a regular file or the host can not tell.
+bool file_identity(int pFD, FileIdentity& pIdentity);
+
 }  // namespace detail
 }  // namespace fs
 }  // namespace sys
@@ -10,6 +10,7 @@
 #define MCLD_SUPPORT_GCFACTORY_H_
 #include "mcld/ADT/TypeTraits.h"
 #include "mcld/Support/Allocators.h"
+#include "mcld/Support/MemoryUsage.h"
 
 #include <assert.h>
 #include <cstddef>
@@ -99,8 +100,12 @@ class DataIterator : public DataIteratorBase<ChunkType> {
   }
 };
 
+/** \class GCFactoryBase
+ *  \brief GCFactoryBase counts the data allocated from its allocator, and
+ *  reports its chunks to the MemoryUsage of the current link context.
+ */
 template <typename Alloc>
-class GCFactoryBase : public Alloc {
+class GCFactoryBase : public Alloc, public TrackedAllocator {
  public:
   typedef DataIterator<typename Alloc::chunk_type,
                        NonConstTraits<typename Alloc::value_type> > iterator;
@@ -113,9 +118,13 @@ class GCFactoryBase : public Alloc {
   typedef typename Alloc::size_type size_type;
 
  protected:
-  GCFactoryBase() : Alloc(), m_NumAllocData(0) {}
+  GCFactoryBase()
+      : Alloc(), TrackedAllocator(getTypeName<value_type>()),
+        m_NumAllocData(0) {}
 
-  explicit GCFactoryBase(size_t pNum) : Alloc(pNum), m_NumAllocData(0) {}
+  explicit GCFactoryBase(size_t pNum)
+      : Alloc(pNum), TrackedAllocator(getTypeName<value_type>()),
+        m_NumAllocData(0) {}
 
  public:
   virtual ~GCFactoryBase() { Alloc::clear(); }
@@ -174,6 +183,16 @@ class GCFactoryBase : public Alloc {
 
   unsigned int size() const { return m_NumAllocData; }
 
+  void getUsage(AllocatorUsage& pUsage) const {
+    pUsage.objectSize = sizeof(value_type);
+    pUsage.chunks = 0;
+    for (typename Alloc::chunk_type* chunk = Alloc::m_pRoot; chunk != NULL;
+         chunk = chunk->next)
+      ++pUsage.chunks;
+    pUsage.objects = m_NumAllocData;
+    pUsage.capacity = Alloc::max_size();
+  }
+
  protected:
   unsigned int m_NumAllocData;
 };
@@ -196,6 +215,20 @@ class GCFactory<DataType, 0>
      : GCFactoryBase<LinearAllocator<DataType, 0> >(pNum) {}
 };
 
+/** \class ArenaGCFactory
+ *  \brief ArenaGCFactory is a GCFactory whose chunks grow geometrically from
+ *  InitialSize data and come from the Arena of the current link context.
+ *  Use it for the factories owned by a link context.
+ *
+ *  @see ArenaAllocator
+ */
+template <typename DataType, size_t InitialSize>
+class ArenaGCFactory
+    : public GCFactoryBase<ArenaAllocator<DataType, InitialSize> > {
+ public:
+  ArenaGCFactory() : GCFactoryBase<ArenaAllocator<DataType, InitialSize> >() {}
+};
+
 }  // namespace mcld
 
 #endif  // MCLD_SUPPORT_GCFACTORY_H_
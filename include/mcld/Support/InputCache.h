@@ -0,0 +1,131 @@
+//===- InputCache.h -------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_INPUTCACHE_H_
+#define MCLD_SUPPORT_INPUTCACHE_H_
+
+#include "mcld/Support/FileSystem.h"
+
+#include <llvm/ADT/StringRef.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace mcld {
+
+class ParsedInput;
+
+/** \class InputCache
+ *  \brief InputCache keeps read-only mappings of input files alive across
+ *  links in one process.
+ *
+ *  An entry is keyed by absolute path and is valid as long as the device,
+ *  inode, size and modification time of the file are unchanged. A changed
+ *  file is mapped again. Mappings are reference counted, so an entry evicted
+ *  to stay within the budget is unmapped only when the last MemoryArea using
+ *  it goes away.
+ *
+ *  An entry may also hold the ParsedInput of its file, set by the owner of
+ *  the cache once it has parsed the mapping. It is dropped together with the
+ *  mapping and does not count against the budget.
+ *
+ *  When a cache is installed with setShared(), MemoryArea takes its mappings
+ *  from it.
+ */
+class InputCache {
+ public:
+  /// Mapping - points to the first byte of a mapped file. The file is
+  /// unmapped when the last Mapping goes away.
+  typedef std::shared_ptr<const char> Mapping;
+
+  /// Parsed - the tables parsed from a mapping
+  typedef std::shared_ptr<const ParsedInput> Parsed;
+
+ public:
+  /// @param pBudget - the total size of the files to keep mapped
+  explicit InputCache(size_t pBudget);
+
+  ~InputCache();
+
+  /// acquire - get a current mapping of pPath.
+  /// @param pPopulate - read in the pages of a newly mapped file at once
+  /// @param pParsed - if not NULL, set to the parsed tables of the mapping
+  ///                   or to NULL if they are not parsed yet
+  /// @return false if pPath can not be mapped; the caller reads it instead.
+  bool acquire(llvm::StringRef pPath,
+               bool pPopulate,
+               Mapping& pMapping,
+               size_t& pSize,
+               Parsed* pParsed = NULL);
+
+  /// setParsed - keep pParsed, parsed from pMapping, with the entry of pPath.
+  /// @return false if the entry no longer holds pMapping
+  bool setParsed(llvm::StringRef pPath,
+                 const Mapping& pMapping,
+                 const Parsed& pParsed);
+
+  /// takeNewPaths - the absolute paths mapped since the last call, oldest
+  /// first
+  std::vector<std::string> takeNewPaths();
+
+  /// shared - the cache used by MemoryArea, or NULL
+  static InputCache* shared();
+
+  /// setShared - install pCache for MemoryArea. NULL turns caching off.
+  static void setShared(InputCache* pCache);
+
+  // -----  observers  ----- //
+  size_t size() const;
+
+  size_t cachedBytes() const;
+
+  size_t numOfHits() const;
+
+  size_t numOfMisses() const;
+
+  /// numOfParsed - the number of entries holding their parsed tables
+  size_t numOfParsed() const;
+
+ private:
+  struct Entry {
+    sys::fs::detail::FileIdentity identity;
+    Mapping mapping;
+    Parsed parsed;
+    uint64_t lastUse;
+  };
+
+  typedef std::map<std::string, Entry> EntryMap;
+
+ private:
+  InputCache(const InputCache&);             // DO NOT IMPLEMENT
+  InputCache& operator=(const InputCache&);  // DO NOT IMPLEMENT
+
+  /// getKey - the absolute path of pPath
+  static std::string getKey(llvm::StringRef pPath);
+
+  /// evict - drop the least recently used entries but pKeep until the
+  /// cached files fit in the budget.
+  void evict(const std::string& pKeep);
+
+ private:
+  mutable std::mutex m_Mutex;
+  EntryMap m_Entries;
+  std::vector<std::string> m_NewPaths;
+  size_t m_Budget;
+  size_t m_CachedBytes;
+  uint64_t m_Clock;
+  size_t m_NumOfHits;
+  size_t m_NumOfMisses;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_INPUTCACHE_H_
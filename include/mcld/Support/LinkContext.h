@@ -0,0 +1,142 @@
+//===- LinkContext.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_LINKCONTEXT_H_
+#define MCLD_SUPPORT_LINKCONTEXT_H_
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace mcld {
+
+/** \class LinkContext
+ *  \brief LinkContext owns the per-link state that used to be process-wide:
+ *  the factories of sections, symbols, fragment references, relocations and
+ *  script tokens, the output .debug_str and the diagnostic engine.
+ *
+ *  Each thread has a current context. Objects created through the static
+ *  Create() functions (LDSection::Create, Relocation::Create, ...) come from
+ *  the current context, and destroying the context releases all of them at
+ *  once. Threads that never enter a context use the global one, so a single
+ *  link per process behaves as before.
+ *
+ *  Links in different contexts may run concurrently. The workers of
+ *  parallel::forEach enter the context of their caller, so get() may be
+ *  called from several threads at once: looking up an object is lock-free,
+ *  and creating one is serialized. Whether the returned object may be used
+ *  concurrently is up to the object; an Arena may, a GCFactory may not.
+ */
+class LinkContext {
+ public:
+  /** \class Scope
+   *  \brief Scope makes a context current on this thread for its lifetime.
+   */
+  class Scope {
+   public:
+    explicit Scope(LinkContext& pContext);
+
+    ~Scope();
+
+   private:
+    Scope(const Scope&);             // DO NOT IMPLEMENT
+    Scope& operator=(const Scope&);  // DO NOT IMPLEMENT
+
+   private:
+    LinkContext* m_pPrevious;
+  };
+
+ public:
+  LinkContext();
+
+  ~LinkContext();
+
+  /// current - the context of this thread
+  static LinkContext& current();
+
+  /// global - the context of threads that have not entered one
+  static LinkContext& global();
+
+  /// get - the object of type T owned by this context. It is created on the
+  /// first request and destroyed with the context.
+  template <typename T>
+  T& get() {
+    size_t id = slotId<T>();
+    Slot* block =
+        m_Blocks[id / kSlotsPerBlock].load(std::memory_order_acquire);
+    void* object = NULL;
+    if (block != NULL) {
+      object =
+          block[id % kSlotsPerBlock].object.load(std::memory_order_acquire);
+    }
+    if (object == NULL)
+      object = create(id, &construct<T>, &destruct<T>);
+    return *static_cast<T*>(object);
+  }
+
+  /// release - destroy every object owned by this context, in the reverse
+  /// order of their creation.
+  void release();
+
+ private:
+  typedef void* (*Constructor)();
+  typedef void (*Destructor)(void*);
+
+  struct Slot {
+    std::atomic<void*> object;
+    Destructor destruct;
+  };
+
+  /// Slots are allocated in blocks on demand, so that a lookup never sees
+  /// the storage move. A context holds up to kMaxBlocks * kSlotsPerBlock
+  /// types; newSlotId() stops the link when there are more.
+  static const size_t kSlotsPerBlock = 64;
+  static const size_t kMaxBlocks = 64;
+
+ private:
+  LinkContext(const LinkContext&);             // DO NOT IMPLEMENT
+  LinkContext& operator=(const LinkContext&);  // DO NOT IMPLEMENT
+
+  template <typename T>
+  static void* construct() {
+    return new T();
+  }
+
+  template <typename T>
+  static void destruct(void* pObject) {
+    delete static_cast<T*>(pObject);
+  }
+
+  template <typename T>
+  static size_t slotId() {
+    static const size_t id = newSlotId();
+    return id;
+  }
+
+  /// newSlotId - a new id for a type; thread-safe
+  static size_t newSlotId();
+
+  /// create - construct the object of slot pId unless another thread did
+  /// @return the object
+  void* create(size_t pId, Constructor pConstruct, Destructor pDestruct);
+
+ private:
+  std::atomic<Slot*> m_Blocks[kMaxBlocks];
+
+  /// serializes create() and release(). It is recursive, as a constructor
+  /// may create other objects of this context.
+  std::recursive_mutex m_Mutex;
+
+  /// the slot ids in creation order
+  std::vector<size_t> m_Order;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_LINKCONTEXT_H_
@@ -14,10 +14,27 @@
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/MemoryBuffer.h>
 
+#include <memory>
+#include <vector>
+
 namespace mcld {
 
+class ParsedInput;
+
 /** \class MemoryArea
  *  \brief MemoryArea is used to manage input read-only memory space.
+ *
+ *  A file is mapped read-only as a whole and advised for sequential access,
+ *  since readers scan the headers, symbols and sections from front to back.
+ *  Regions that will be copied to the output can be prefetched by
+ *  prefetch(). Files that can not be mapped are read into a buffer instead.
+ *
+ *  MemoryArea also records which pages of a mapped file are requested, so
+ *  that the linker can report how much of each input it really touches.
+ *
+ *  If an InputCache is installed, the mapping is shared with the cache and
+ *  outlives the MemoryArea, and the tables the cache has parsed from the
+ *  file are available through parsed().
  */
 class MemoryArea {
   friend class MemoryAreaFactory;
@@ -29,19 +46,70 @@ class MemoryArea {
   // @param pFileHandle - file handler
   explicit MemoryArea(llvm::StringRef pFilename);
 
+  // @param pPopulateLimit - populate the mapping of files not larger than
+  //                         this size at construction.
+  MemoryArea(llvm::StringRef pFilename, size_t pPopulateLimit);
+
   explicit MemoryArea(const char* pMemBuffer, size_t pSize);
 
+  ~MemoryArea();
+
   // request - create a MemoryRegion within a sufficient space
   // find an existing space to hold the MemoryRegion.
   // if MemoryArea does not find such space, then it creates a new space and
   // assign a MemoryRegion into the space.
   llvm::StringRef request(size_t pOffset, size_t pLength);
 
-  size_t size() const;
+  // keep - hold pData, pSize bytes derived from the file such as the
+  // contents of a compressed section, as long as the area lives.
+  llvm::StringRef keep(std::unique_ptr<char[]> pData, size_t pSize);
+
+  // prefetch - hint that [pOffset, pOffset + pLength) will be read soon.
+  void prefetch(size_t pOffset, size_t pLength);
+
+  // populate - page in the whole mapping. Unlike request(), it does not
+  // count as touching the pages. It is safe to call from another thread.
+  void populate() const;
+
+  size_t size() const { return m_Size; }
+
+  // parsed - the tables parsed from the file by the InputCache, or NULL
+  const ParsedInput* parsed() const { return m_pParsed.get(); }
+
+  // -----  instrumentation  ----- //
+  bool isMapped() const { return m_bMapped; }
+
+  /// mappedBytes - the number of bytes mapped from the file.
+  size_t mappedBytes() const { return m_bMapped ? m_Size : 0; }
+
+  /// touchedBytes - the number of bytes in the pages covered by request().
+  size_t touchedBytes() const;
 
  private:
+  void open(llvm::StringRef pFilename, size_t pPopulateLimit);
+
+  void touch(size_t pOffset, size_t pLength);
+
+ private:
+  const char* m_pData;
+  size_t m_Size;
+  bool m_bMapped;
+
+  // used if the file can not be mapped
   std::unique_ptr<llvm::MemoryBuffer> m_pMemoryBuffer;
 
+  // keeps a mapping of the InputCache alive
+  std::shared_ptr<const char> m_pSharedMapping;
+
+  // the tables parsed from the mapping of the InputCache
+  std::shared_ptr<const ParsedInput> m_pParsed;
+
+  // one entry per page of a mapped file, non-zero once requested
+  std::vector<uint8_t> m_TouchedPages;
+
+  // buffers given to keep()
+  std::vector<std::unique_ptr<char[]> > m_KeptBuffers;
+
  private:
   DISALLOW_COPY_AND_ASSIGN(MemoryArea);
 };
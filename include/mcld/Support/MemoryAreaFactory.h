@@ -59,8 +59,15 @@ class MemoryAreaFactory : public GCFactory<MemoryArea, 0> {
 
   void destruct(MemoryArea* pArea);
 
+  /// setPopulateLimit - input files not larger than pSize are read in as soon
+  /// as they are mapped.
+  void setPopulateLimit(size_t pSize) { m_PopulateLimit = pSize; }
+
+  size_t populateLimit() const { return m_PopulateLimit; }
+
  private:
   llvm::StringMap<MemoryArea*> m_AreaMap;
+  size_t m_PopulateLimit;
 };
 
 }  // namespace mcld
@@ -0,0 +1,142 @@
+//===- MemoryUsage.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_MEMORYUSAGE_H_
+#define MCLD_SUPPORT_MEMORYUSAGE_H_
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}  // namespace llvm
+
+namespace mcld {
+
+class MemoryUsage;
+
+/// getTypeName - the name of type T, such as "LDSymbol". It is taken from
+/// the signature of this function, so it works without RTTI.
+template <typename T>
+llvm::StringRef getTypeName() {
+#if defined(__GNUC__)
+  // GCC:   "llvm::StringRef mcld::getTypeName() [with T = LDSymbol]"
+  // Clang: "llvm::StringRef mcld::getTypeName() [T = mcld::LDSymbol]"
+  llvm::StringRef name(__PRETTY_FUNCTION__);
+  size_t pos = name.find("T = ");
+  if (pos != llvm::StringRef::npos) {
+    name = name.drop_front(pos + 4);
+    return name.substr(0, name.find_first_of(";]"));
+  }
+#endif
+  return "unknown";
+}
+
+/** \class AllocatorUsage
+ *  \brief AllocatorUsage describes the memory held by the allocators of one
+ *  type of objects.
+ */
+struct AllocatorUsage {
+  llvm::StringRef name;  // the type of the allocated objects
+  size_t objectSize;     // the size of an object
+  size_t instances;      // the number of allocators
+  size_t chunks;         // the number of chunks
+  size_t objects;        // the number of live objects
+  size_t capacity;       // the number of objects the chunks can hold
+
+  uint64_t allocatedBytes() const {
+    return static_cast<uint64_t>(capacity) * objectSize;
+  }
+
+  /// wastedBytes - the bytes of the unused slots in the chunks
+  uint64_t wastedBytes() const {
+    return static_cast<uint64_t>(capacity - objects) * objectSize;
+  }
+};
+
+/** \class TrackedAllocator
+ *  \brief TrackedAllocator is an allocator that reports its memory to the
+ *  MemoryUsage of the link context it is created in.
+ *
+ *  @see GCFactoryBase
+ */
+class TrackedAllocator {
+ public:
+  explicit TrackedAllocator(llvm::StringRef pName);
+
+  virtual ~TrackedAllocator();
+
+  llvm::StringRef allocatorName() const { return m_Name; }
+
+  /// getUsage - fill in the object size, chunks, objects and capacity
+  virtual void getUsage(AllocatorUsage& pUsage) const = 0;
+
+ private:
+  friend class MemoryUsage;
+
+  TrackedAllocator(const TrackedAllocator&);             // DO NOT IMPLEMENT
+  TrackedAllocator& operator=(const TrackedAllocator&);  // DO NOT IMPLEMENT
+
+ private:
+  llvm::StringRef m_Name;
+  MemoryUsage* m_pUsage;  // NULL if the MemoryUsage has gone
+  size_t m_Index;         // the index in MemoryUsage::m_Allocators
+};
+
+/** \class MemoryUsage
+ *  \brief MemoryUsage keeps the allocators of a link context, so that the
+ *  linker can tell which kind of objects hold the memory of a link.
+ *
+ *  Allocators add and remove themselves; they may do so on the worker
+ *  threads of the link once the MemoryUsage of the context exists. The
+ *  Linker creates it in emulate().
+ */
+class MemoryUsage {
+ public:
+  typedef std::vector<AllocatorUsage> UsageList;
+
+ public:
+  MemoryUsage();
+
+  ~MemoryUsage();
+
+  /// current - the MemoryUsage of the current link context
+  static MemoryUsage& current();
+
+  /// getUsage - the usage of the allocators summed up by their names, with
+  /// the most allocated bytes first.
+  void getUsage(UsageList& pUsage) const;
+
+  /// print - print the usage of the allocators and the peak resident set
+  /// size of the process after link phase pPhase
+  void print(llvm::raw_ostream& pOS, llvm::StringRef pPhase) const;
+
+  size_t numOfAllocators() const;
+
+ private:
+  friend class TrackedAllocator;
+
+  MemoryUsage(const MemoryUsage&);             // DO NOT IMPLEMENT
+  MemoryUsage& operator=(const MemoryUsage&);  // DO NOT IMPLEMENT
+
+  void add(TrackedAllocator& pAllocator);
+
+  void remove(TrackedAllocator& pAllocator);
+
+ private:
+  mutable std::mutex m_Mutex;
+  std::vector<TrackedAllocator*> m_Allocators;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_MEMORYUSAGE_H_
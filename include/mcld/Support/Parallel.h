@@ -0,0 +1,93 @@
+//===- Parallel.h ---------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_PARALLEL_H_
+#define MCLD_SUPPORT_PARALLEL_H_
+
+#include "mcld/Support/LinkContext.h"
+
+#include <llvm/Support/DataTypes.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace mcld {
+namespace parallel {
+
+/// getThreadCount - resolve the number of worker threads. Zero means one
+/// worker per hardware thread.
+inline unsigned getThreadCount(unsigned pRequested) {
+  if (pRequested != 0)
+    return pRequested;
+  unsigned hw = std::thread::hardware_concurrency();
+  return (hw == 0) ? 1 : hw;
+}
+
+/// numOfChunks - the number of chunks forEachChunk() splits pSize elements
+/// into, given at most pThreads workers and at least pMinChunk elements per
+/// chunk. Callers use it to size per-chunk storage.
+inline size_t numOfChunks(unsigned pThreads, size_t pSize, size_t pMinChunk) {
+  if (pSize == 0)
+    return 0;
+  size_t by_size = (pSize + pMinChunk - 1) / std::max<size_t>(pMinChunk, 1);
+  return std::max<size_t>(1, std::min<size_t>(getThreadCount(pThreads),
+                                              by_size));
+}
+
+/// forEachChunk - split [0, pSize) into numOfChunks() contiguous chunks and
+/// call pFunc(chunk, begin, end) for each of them. The calling thread handles
+/// chunk 0, the others run on their own threads in the caller's link context.
+/// Chunks never overlap, so pFunc may write per-element or per-chunk results
+/// without locking.
+template <typename Func>
+void forEachChunk(unsigned pThreads,
+                  size_t pSize,
+                  size_t pMinChunk,
+                  Func pFunc) {
+  size_t chunks = numOfChunks(pThreads, pSize, pMinChunk);
+  if (chunks <= 1) {
+    if (pSize != 0)
+      pFunc(0, 0, pSize);
+    return;
+  }
+
+  size_t step = (pSize + chunks - 1) / chunks;
+  LinkContext& context = LinkContext::current();
+  std::vector<std::thread> workers;
+  workers.reserve(chunks - 1);
+  for (size_t c = 1; c < chunks; ++c) {
+    size_t begin = std::min(pSize, c * step);
+    size_t end = std::min(pSize, begin + step);
+    workers.push_back(std::thread([&context, pFunc, c, begin, end]() {
+      LinkContext::Scope scope(context);
+      pFunc(c, begin, end);
+    }));
+  }
+  pFunc(0, 0, std::min(pSize, step));
+
+  for (std::thread& worker : workers)
+    worker.join();
+}
+
+/// forEach - call pFunc(i) for every i in [0, pSize) on up to pThreads
+/// threads.
+template <typename Func>
+void forEach(unsigned pThreads, size_t pSize, size_t pMinChunk, Func pFunc) {
+  forEachChunk(pThreads, pSize, pMinChunk,
+               [&pFunc](size_t pChunk, size_t pBegin, size_t pEnd) {
+                 for (size_t i = pBegin; i != pEnd; ++i)
+                   pFunc(i);
+               });
+}
+
+}  // namespace parallel
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_PARALLEL_H_
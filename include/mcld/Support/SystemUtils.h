@@ -36,6 +36,18 @@ long GetRandomNum();
 /// SetRandomSeed - set the initial seed value for future calls to random().
 void SetRandomSeed(unsigned pSeed);
 
+/// GetPeakMemoryUsage - the peak resident set size of the process in bytes,
+/// or 0 if it is unknown.
+uint64_t GetPeakMemoryUsage();
+
+/// AllocatePages - map pSize bytes of zero-filled memory. If pHuge is set,
+/// ask the system to back it with huge pages where it can.
+/// @return NULL if the memory can not be mapped
+void* AllocatePages(size_t pSize, bool pHuge);
+
+/// FreePages - unmap the memory mapped by AllocatePages
+void FreePages(void* pAddr, size_t pSize);
+
 }  // namespace sys
 }  // namespace mcld
 
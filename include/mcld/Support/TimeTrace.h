@@ -0,0 +1,128 @@
+//===- TimeTrace.h --------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SUPPORT_TIMETRACE_H_
+#define MCLD_SUPPORT_TIMETRACE_H_
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/DataTypes.h>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+}  // namespace llvm
+
+namespace mcld {
+
+/** \class TimeTrace
+ *  \brief TimeTrace records how long the steps of a link take, together with
+ *  a few counters, and writes them as Chrome trace events or as a summary.
+ *
+ *  Each link context has its own trace. It records nothing until enable() is
+ *  called, so a Scope in a link step costs one test when tracing is off.
+ *  Once the trace of a context exists, Scopes may be entered on the worker
+ *  threads of the link; the Linker creates it in emulate().
+ */
+class TimeTrace {
+ public:
+  /** \class Scope
+   *  \brief Scope records the time from its construction to its destruction
+   *  as one step of the trace of the current link context.
+   */
+  class Scope {
+   public:
+    /// @param pName - the name of the step
+    /// @param pDetail - the object the step works on, such as an input path
+    explicit Scope(llvm::StringRef pName,
+                   llvm::StringRef pDetail = llvm::StringRef());
+
+    ~Scope();
+
+   private:
+    Scope(const Scope&);             // DO NOT IMPLEMENT
+    Scope& operator=(const Scope&);  // DO NOT IMPLEMENT
+
+   private:
+    TimeTrace* m_pTrace;  // NULL if the trace is disabled
+    llvm::StringRef m_Name;
+    llvm::StringRef m_Detail;
+    uint64_t m_Start;
+  };
+
+ public:
+  TimeTrace();
+
+  ~TimeTrace();
+
+  /// current - the trace of the current link context
+  static TimeTrace& current();
+
+  /// enable - start recording. Times are relative to the first call.
+  void enable();
+
+  bool isEnabled() const { return m_bEnabled; }
+
+  /// addCounter - record pValue as the value of counter pName at this time
+  void addCounter(llvm::StringRef pName, uint64_t pValue);
+
+  /// addStep - record the step pName that started at pStart and took
+  /// pDuration microseconds
+  void addStep(llvm::StringRef pName,
+               llvm::StringRef pDetail,
+               uint64_t pStart,
+               uint64_t pDuration);
+
+  /// now - the microseconds since the trace was enabled
+  uint64_t now() const;
+
+  /// write - write the trace in Chrome trace event format
+  void write(llvm::raw_ostream& pOS) const;
+
+  /// printStats - print the total time and count of every step in the order
+  /// they first finished, followed by the last value of every counter
+  void printStats(llvm::raw_ostream& pOS) const;
+
+  /// numOfEvents - the number of recorded steps and counters
+  size_t numOfEvents() const;
+
+ private:
+  enum EventKind { Step, Counter };
+
+  struct Event {
+    EventKind kind;
+    std::string name;
+    std::string detail;
+    uint64_t start;
+    uint64_t value;  // the duration of a step
+    unsigned tid;
+  };
+
+ private:
+  TimeTrace(const TimeTrace&);             // DO NOT IMPLEMENT
+  TimeTrace& operator=(const TimeTrace&);  // DO NOT IMPLEMENT
+
+  /// getThreadIndex - the index of the calling thread. The caller holds the
+  /// lock.
+  unsigned getThreadIndex();
+
+ private:
+  bool m_bEnabled;
+  std::chrono::steady_clock::time_point m_Origin;
+  mutable std::mutex m_Mutex;
+  std::vector<Event> m_Events;
+  std::vector<std::thread::id> m_Threads;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_SUPPORT_TIMETRACE_H_
@@ -24,7 +24,9 @@
 namespace mcld {
 
 class BranchIslandFactory;
+class BuildID;
 class EhFrameHdr;
+class RelrSection;
 class ELFAttribute;
 class ELFDynamic;
 class ELFDynObjFileFormat;
@@ -330,6 +332,12 @@ class GNULDBackend : public TargetLDBackend {
   /// entry in the middle
   void createAndSizeEhFrameHdr(Module& pModule);
 
+  /// createAndSizeBuildID - size .note.gnu.build-id for --build-id
+  void createAndSizeBuildID(Module& pModule);
+
+  /// getRelrDyn - the relocations packed by --pack-dyn-relocs=relr, or NULL
+  const RelrSection* getRelrDyn() const { return m_pRelrDyn; }
+
   /// attribute - the attribute section data.
   ELFAttribute& attribute() { return *m_pAttribute; }
 
@@ -347,6 +355,15 @@ class GNULDBackend : public TargetLDBackend {
   /// getRelEntrySize - the size in BYTE of rela type relocation
   virtual size_t getRelaEntrySize() = 0;
 
+  /// getRelativeRelocType - the type of the relative relocations in
+  /// .rela.dyn. Targets that return 0x0 do not support
+  /// --pack-dyn-relocs=relr.
+  virtual uint32_t getRelativeRelocType() const { return 0x0; }
+
+  /// packRelativeRelocs - move the relative relocations from .rela.dyn to
+  /// .relr.dyn for --pack-dyn-relocs=relr
+  void packRelativeRelocs();
+
   uint64_t getSymbolSize(const LDSymbol& pSymbol) const;
 
   uint64_t getSymbolInfo(const LDSymbol& pSymbol) const;
@@ -536,6 +553,12 @@ class GNULDBackend : public TargetLDBackend {
   // section .eh_frame_hdr
   EhFrameHdr* m_pEhFrameHdr;
 
+  // section .note.gnu.build-id
+  BuildID* m_pBuildID;
+
+  // section .relr.dyn
+  RelrSection* m_pRelrDyn;
+
   // attribute section
   ELFAttribute* m_pAttribute;
 
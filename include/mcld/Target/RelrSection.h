@@ -0,0 +1,91 @@
+//===- RelrSection.h ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_TARGET_RELRSECTION_H_
+#define MCLD_TARGET_RELRSECTION_H_
+
+#include "mcld/Support/MemoryRegion.h"
+
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcld {
+
+class FileOutputBuffer;
+class LDSection;
+class LinkerConfig;
+class Relocation;
+
+/** \class RelrSection
+ *  \brief RelrSection is .relr.dyn, the relative dynamic relocations packed
+ *  by --pack-dyn-relocs=relr.
+ *
+ *  A relative relocation adds the load base to a word, so it is described by
+ *  the address of the word alone, and its addend is kept in the word. The
+ *  section is a list of words:
+ *  - an even word is the address of a relocated word. The next bitmap
+ *    starts at the word after it.
+ *  - an odd word is a bitmap. Bit i (i >= 1) relocates the (i - 1)th word
+ *    from where the bitmap starts, and the next bitmap starts
+ *    (wordbits - 1) words later.
+ *
+ *  The encoding depends on the final addresses, so the section is sized
+ *  again after layout, and it never shrinks. The words left over are empty
+ *  bitmaps.
+ */
+class RelrSection {
+ public:
+  typedef std::vector<Relocation*> RelocList;
+
+ public:
+  RelrSection(LDSection& pSection, const LinkerConfig& pConfig);
+
+  ~RelrSection();
+
+  /// canPack - whether the relative relocation pReloc relocates a whole word
+  /// that stays aligned through layout
+  bool canPack(const Relocation& pReloc) const;
+
+  /// add - pack pReloc, which must not be emitted anywhere else
+  void add(Relocation& pReloc);
+
+  bool empty() const { return m_Relocs.empty(); }
+
+  size_t numOfRelocs() const { return m_Relocs.size(); }
+
+  /// finalizeSectionSize - encode the relocations at their current addresses
+  /// and grow the section to fit.
+  /// @return true if the section has grown
+  bool finalizeSectionSize();
+
+  /// emit - write the encoding to pRegion
+  void emit(MemoryRegion& pRegion) const;
+
+  /// applyAddends - write the addends into the relocated words of pOutput
+  void applyAddends(FileOutputBuffer& pOutput) const;
+
+  /// encode - encode the sorted addresses pAddrs of pWordSize-byte words
+  static void encode(const std::vector<uint64_t>& pAddrs,
+                     unsigned int pWordSize,
+                     std::vector<uint64_t>& pResult);
+
+ private:
+  void encode(std::vector<uint64_t>& pResult) const;
+
+  unsigned int wordSize() const;
+
+ private:
+  LDSection& m_Section;
+  const LinkerConfig& m_Config;
+  RelocList m_Relocs;
+};
+
+}  // namespace mcld
+
+#endif  // MCLD_TARGET_RELRSECTION_H_
@@ -181,6 +181,9 @@ class TargetLDBackend {
   /// entry in the middle
   virtual void createAndSizeEhFrameHdr(Module& pModule) = 0;
 
+  /// createAndSizeBuildID - size the build id note for --build-id
+  virtual void createAndSizeBuildID(Module& pModule) = 0;
+
   /// isSymbolPreemptible - whether the symbol can be preemted by other link
   /// units
   virtual bool isSymbolPreemptible(const ResolveInfo& pSym) const = 0;
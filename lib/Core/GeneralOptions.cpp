@@ -59,10 +59,23 @@ GeneralOptions::GeneralOptions()
       m_bPrintGCSections(false),
       m_bGenUnwindInfo(true),
       m_bPrintICFSections(false),
+      m_bMmapOutputFile(true),
+      m_bBatchApplyRelocs(false),
+      m_bIncremental(false),
+      m_bPrintStats(false),
+      m_bPrintMemoryUsage(false),
+      m_bHugePages(false),
       m_ICF(ICF::None),
       m_ICFIterations(2),
+      m_NumThreads(0),
+      m_MmapPopulateLimit(0),
+      m_PrefetchInputs(0),
+      m_PrefetchBudget(256 * 1024 * 1024),
       m_StripSymbols(StripSymbolMode::KeepAllSymbols),
-      m_HashStyle(HashStyle::SystemV) {
+      m_HashStyle(HashStyle::SystemV),
+      m_BuildIDStyle(BuildIDStyle::None),
+      m_CompressDebugSections(DebugCompression::None),
+      m_PackDynRelocs(DynRelocPacking::None) {
 }
 
 GeneralOptions::~GeneralOptions() {
@@ -344,6 +344,8 @@ Fragment* IRBuilder::CreateRegion(Input& pInput,
   if (0 == pLength)
     return new FillFragment(0x0, 0, 0);
 
+  // The region is copied to the output later. Start reading it in now.
+  pInput.memArea()->prefetch(pOffset, pLength);
   llvm::StringRef region = pInput.memArea()->request(pOffset, pLength);
   return new RegionFragment(region);
 }
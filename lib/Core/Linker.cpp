@@ -10,29 +10,259 @@
 
 #include "mcld/IRBuilder.h"
 #include "mcld/LinkerConfig.h"
+#include "mcld/LinkerScript.h"
 #include "mcld/Module.h"
 #include "mcld/Fragment/FragmentRef.h"
 #include "mcld/Fragment/Relocation.h"
+#include "mcld/LD/DiagnosticEngine.h"
+#include "mcld/LD/DiagnosticPrinter.h"
+#include "mcld/LD/LDContext.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/ObjectWriter.h"
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/SectionData.h"
 #include "mcld/MC/InputBuilder.h"
+#include "mcld/Object/IncrementalState.h"
 #include "mcld/Object/ObjectLinker.h"
 #include "mcld/Support/FileHandle.h"
 #include "mcld/Support/FileOutputBuffer.h"
+#include "mcld/Support/LinkContext.h"
+#include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Support/TargetRegistry.h"
+#include "mcld/Support/Arena.h"
+#include "mcld/Support/MemoryUsage.h"
+#include "mcld/Support/TimeTrace.h"
 #include "mcld/Support/raw_ostream.h"
 #include "mcld/Target/TargetLDBackend.h"
 
+#include <llvm/Support/FileSystem.h>
+
 #include <cassert>
+#include <memory>
+#include <set>
+#include <vector>
 
 namespace mcld {
 
+/// ReportInputMappings - tell how much of each mapped input file was used.
+static void ReportInputMappings(const Module& pModule) {
+  std::set<const MemoryArea*> reported;
+  InputTree::const_dfs_iterator input,
+      inEnd = pModule.getInputTree().dfs_end();
+  for (input = pModule.getInputTree().dfs_begin(); input != inEnd; ++input) {
+    const MemoryArea* area = (*input)->memArea();
+    // archive members share the area of their archive
+    if (area == NULL || !area->isMapped() || !reported.insert(area).second)
+      continue;
+    note(diag::note_input_mapping) << (*input)->path() << area->mappedBytes()
+                                   << area->touchedBytes();
+  }
+}
+
+/// GetOutputMode - how the output file is written, --[no-]mmap-output-file
+static FileOutputBuffer::Mode GetOutputMode(const LinkerConfig& pConfig) {
+  if (pConfig.options().mmapOutputFile())
+    return FileOutputBuffer::Mapped;
+  return FileOutputBuffer::Direct;
+}
+
+/// Commit - write out a Direct output buffer.
+static bool Commit(FileOutputBuffer& pOutput) {
+  if (pOutput.commit()) {
+    error(diag::err_cannot_write_file) << pOutput.getPath() << 0
+                                       << pOutput.getBufferSize();
+    return false;
+  }
+  return true;
+}
+
+/// ReportTimeTrace - record the link statistics, and write the time trace
+/// and print the statistics if asked to.
+static void ReportTimeTrace(const LinkerConfig& pConfig,
+                            const Module& pModule,
+                            uint64_t pOutputSize) {
+  TimeTrace& trace = TimeTrace::current();
+  if (!trace.isEnabled())
+    return;
+
+  uint64_t relocs = 0;
+  Module::const_obj_iterator obj, objEnd = pModule.obj_end();
+  for (obj = pModule.obj_begin(); obj != objEnd; ++obj) {
+    const LDContext* context = (*obj)->context();
+    LDContext::const_sect_iterator rs, rsEnd = context->relocSectEnd();
+    for (rs = context->relocSectBegin(); rs != rsEnd; ++rs) {
+      if ((*rs)->hasRelocData())
+        relocs += (*rs)->getRelocData()->size();
+    }
+  }
+
+  uint64_t frags = 0;
+  Module::const_iterator sect, sectEnd = pModule.end();
+  for (sect = pModule.begin(); sect != sectEnd; ++sect) {
+    if ((*sect)->hasSectionData())
+      frags += (*sect)->getSectionData()->size();
+  }
+
+  trace.addCounter("objects", pModule.getObjectList().size());
+  trace.addCounter("libraries", pModule.getLibraryList().size());
+  trace.addCounter("symbols", pModule.sym_size());
+  trace.addCounter("relocations", relocs);
+  trace.addCounter("output sections", pModule.size());
+  trace.addCounter("fragments", frags);
+  trace.addCounter("bytes written", pOutputSize);
+
+  const std::string& path = pConfig.options().timeTraceFile();
+  if (!path.empty()) {
+    std::error_code ec;
+    mcld::raw_fd_ostream os(path.c_str(), ec);
+    if (ec)
+      warning(diag::warn_cannot_write_time_trace) << path << ec.message();
+    else
+      trace.write(os);
+  }
+  if (pConfig.options().printStats())
+    trace.printStats(mcld::errs());
+}
+
+namespace {
+
+/** \class PhaseMemoryReport
+ *  \brief PhaseMemoryReport prints the memory usage of the current link
+ *  context when a link phase ends, if --print-memory-usage is given.
+ */
+class PhaseMemoryReport {
+ public:
+  PhaseMemoryReport(const LinkerConfig& pConfig, const char* pPhase)
+      : m_Config(pConfig), m_pPhase(pPhase) {}
+
+  ~PhaseMemoryReport() {
+    if (!m_Config.options().printMemoryUsage())
+      return;
+    MemoryUsage::current().print(mcld::errs(), m_pPhase);
+    const Arena& arena = Arena::current();
+    mcld::errs() << "  arena: " << arena.numOfSlabs() << " slabs, "
+                 << arena.bytesReserved() / 1024 << " KB mapped, "
+                 << arena.bytesAllocated() / 1024 << " KB allocated\n";
+  }
+
+ private:
+  const LinkerConfig& m_Config;
+  const char* m_pPhase;
+};
+
+/** \class PatchLink
+ *  \brief PatchLink reads one changed object of an incremental link into a
+ *  module of its own and checks that it can be patched into the output.
+ *
+ *  Every PatchLink works in a link context of its own, so the sections,
+ *  symbols and relocations it reads stay apart from those of other objects
+ *  until all of them have been checked and written.
+ */
+class PatchLink {
+ public:
+  PatchLink(const LinkerConfig& pConfig, const Target& pTarget)
+      : m_Config(pConfig),
+        m_Target(pTarget),
+        m_pScript(NULL),
+        m_pModule(NULL),
+        m_pBuilder(NULL),
+        m_pBackend(NULL),
+        m_pObjLinker(NULL) {}
+
+  ~PatchLink();
+
+  /// prepare - read the object of pRecord and check it against pState
+  bool prepare(const IncrementalState& pState,
+               const IncrementalState::Object& pRecord);
+
+  /// emit - write the object into pOutput
+  void emit(const IncrementalState& pState, FileOutputBuffer& pOutput) {
+    LinkContext::Scope scope(m_Context);
+    m_pObjLinker->emitPatch(pState, m_Update, pOutput);
+  }
+
+  /// update - the record of the object after it is patched
+  const IncrementalState::Object& update() const { return m_Update; }
+
+ private:
+  PatchLink(const PatchLink&);             // DO NOT IMPLEMENT
+  PatchLink& operator=(const PatchLink&);  // DO NOT IMPLEMENT
+
+  /// failed - an error was reported while reading the object
+  bool failed() const {
+    return getDiagnosticEngine().getPrinter()->getNumErrors() > 0;
+  }
+
+ private:
+  LinkContext m_Context;
+  const LinkerConfig& m_Config;
+  const Target& m_Target;
+  LinkerScript* m_pScript;
+  Module* m_pModule;
+  IRBuilder* m_pBuilder;
+  TargetLDBackend* m_pBackend;
+  ObjectLinker* m_pObjLinker;
+  IncrementalState::Object m_Update;
+};
+
+PatchLink::~PatchLink() {
+  LinkContext::Scope scope(m_Context);
+  RelocData::Clear();
+  SectionData::Clear();
+  EhFrame::Clear();
+  delete m_pBackend;
+  delete m_pObjLinker;
+  delete m_pBuilder;
+  delete m_pModule;
+  delete m_pScript;
+  LDSection::Clear();
+  LDSymbol::Clear();
+  FragmentRef::Clear();
+  Relocation::Clear();
+}
+
+bool PatchLink::prepare(const IncrementalState& pState,
+                        const IncrementalState::Object& pRecord) {
+  LinkContext::Scope scope(m_Context);
+  InitializeDiagnosticEngine(m_Config);
+
+  m_pScript = new LinkerScript();
+  m_pModule = new Module(pRecord.path, *m_pScript);
+  m_pBuilder = new IRBuilder(*m_pModule, m_Config);
+  m_pBackend = m_Target.createLDBackend(m_Config);
+  if (m_pBackend == NULL)
+    return false;
+  m_pObjLinker = new ObjectLinker(m_Config, *m_pBackend);
+  if (!m_pObjLinker->initialize(*m_pModule, *m_pBuilder) ||
+      !m_pObjLinker->initStdSections())
+    return false;
+
+  if (m_pBuilder->ReadInput(pRecord.path, sys::fs::Path(pRecord.path)) ==
+      NULL)
+    return false;
+  m_pObjLinker->normalize();
+  if (failed())
+    return false;
+  m_pObjLinker->readRelocations();
+  return !failed() && m_pObjLinker->preparePatch(pState, pRecord, m_Update);
+}
+
+}  // anonymous namespace
+
 Linker::Linker()
-    : m_pConfig(NULL),
+    : m_pContext(&LinkContext::current()),
+      m_pConfig(NULL),
+      m_pIRBuilder(NULL),
+      m_pTarget(NULL),
+      m_pBackend(NULL),
+      m_pObjLinker(NULL) {
+}
+
+Linker::Linker(LinkContext& pContext)
+    : m_pContext(&pContext),
+      m_pConfig(NULL),
       m_pIRBuilder(NULL),
       m_pTarget(NULL),
       m_pBackend(NULL),
@@ -46,8 +276,18 @@ Linker::~Linker() {
 /// emulate - To set up target-dependent options and default linker script.
 /// Follow GNU ld quirks.
 bool Linker::emulate(LinkerScript& pScript, LinkerConfig& pConfig) {
+  LinkContext::Scope scope(*m_pContext);
   m_pConfig = &pConfig;
 
+  // create the trace of the context before any worker thread looks for it
+  TimeTrace& trace = TimeTrace::current();
+  if (pConfig.options().hasTimeTrace() || pConfig.options().printStats())
+    trace.enable();
+
+  // and the memory usage and the arena, allocators of worker threads use them
+  MemoryUsage::current();
+  Arena::current().setHugePages(pConfig.options().hugePages());
+
   if (!initTarget())
     return false;
 
@@ -64,6 +304,8 @@ bool Linker::emulate(LinkerScript& pScript, LinkerConfig& pConfig) {
 }
 
 bool Linker::link(Module& pModule, IRBuilder& pBuilder) {
+  LinkContext::Scope scope(*m_pContext);
+  assert(&pModule.getContext() == m_pContext);
   if (!normalize(pModule, pBuilder))
     return false;
 
@@ -73,8 +315,102 @@ bool Linker::link(Module& pModule, IRBuilder& pBuilder) {
   return layout();
 }
 
+/// relink - patch the output of the last incremental link with the same
+/// command line. Every input but the objects must be unchanged, and every
+/// changed object must still fit in the places of its sections.
+bool Linker::relink(const Module& pModule) {
+  LinkContext::Scope scope(*m_pContext);
+  assert(m_pConfig != NULL && m_pTarget != NULL);
+  const std::string& output = pModule.name();
+
+  // a build id covers the whole output, patching would leave it stale
+  if (m_pConfig->options().hasBuildID())
+    return false;
+
+  // compressed debug sections cannot be patched in place either
+  if (m_pConfig->options().getCompressDebugSections() !=
+      GeneralOptions::DebugCompression::None)
+    return false;
+
+  // nor can the addends that .relr.dyn keeps in the relocated words
+  if (m_pConfig->options().getPackDynRelocs() !=
+      GeneralOptions::DynRelocPacking::None)
+    return false;
+
+  IncrementalState state;
+  if (!state.read(IncrementalState::getPath(output)) ||
+      state.key() !=
+          IncrementalState::digest(m_pConfig->options().incrementalKey()))
+    return false;
+
+  IncrementalState::FileIdentity identity;
+  if (!IncrementalState::identify(output, identity) ||
+      !(identity == state.output()))
+    return false;
+
+  for (IncrementalState::FileList::const_iterator file = state.files().begin(),
+       fEnd = state.files().end(); file != fEnd; ++file) {
+    IncrementalState::FileIdentity current;
+    if (!IncrementalState::identify(file->path, current) ||
+        !(current == file->identity))
+      return false;
+  }
+
+  std::vector<size_t> changed;
+  for (size_t i = 0; i < state.objects().size(); ++i) {
+    IncrementalState::FileIdentity current;
+    if (!IncrementalState::identify(state.objects()[i].path, current))
+      return false;
+    if (!(current == state.objects()[i].identity))
+      changed.push_back(i);
+  }
+  if (changed.empty())
+    return true;
+
+  // check every changed object before touching the output
+  std::vector<std::unique_ptr<PatchLink> > patches;
+  bool result = true;
+  m_pConfig->setCodePosition(
+      static_cast<LinkerConfig::CodePosition>(state.codePosition()));
+  for (size_t i = 0; i < changed.size() && result; ++i) {
+    patches.emplace_back(new PatchLink(*m_pConfig, *m_pTarget));
+    result = patches.back()->prepare(state, state.objects()[changed[i]]);
+  }
+  m_pConfig->setCodePosition(LinkerConfig::Unset);
+  if (!result)
+    return false;
+
+  FileHandle file;
+  if (!file.open(sys::fs::Path(output),
+                 FileHandle::OpenMode(FileHandle::ReadWrite),
+                 FileHandle::Permission(FileHandle::System)))
+    return false;
+
+  std::unique_ptr<FileOutputBuffer> buffer;
+  if (FileOutputBuffer::create(file, identity.size, FileOutputBuffer::Mapped,
+                               buffer))
+    return false;
+  for (size_t i = 0; i < changed.size(); ++i) {
+    patches[i]->emit(state, *buffer);
+    state.objects()[changed[i]] = patches[i]->update();
+  }
+  buffer.reset();
+  file.close();
+
+  if (IncrementalState::identify(output, identity)) {
+    state.setOutput(identity);
+    state.write(IncrementalState::getPath(output));
+  }
+  note(diag::note_incremental_patch) << changed.size() << output;
+  return true;
+}
+
 /// normalize - to convert the command line language to the input tree.
 bool Linker::normalize(Module& pModule, IRBuilder& pBuilder) {
+  LinkContext::Scope scope(*m_pContext);
+  PhaseMemoryReport report(*m_pConfig, "normalize");
+  TimeTrace::Scope phase("Normalize");
+  assert(&pModule.getContext() == m_pContext);
   assert(m_pConfig != NULL);
 
   m_pIRBuilder = &pBuilder;
@@ -101,7 +437,10 @@ bool Linker::normalize(Module& pModule, IRBuilder& pBuilder) {
   //   read out sections and symbol/string tables (from the files) and
   //   set them in Module. When reading out the symbol, resolve their symbols
   //   immediately and set their ResolveInfo (i.e., Symbol Resolution).
-  m_pObjLinker->normalize();
+  {
+    TimeTrace::Scope step("normalize");
+    m_pObjLinker->normalize();
+  }
 
   if (m_pConfig->options().trace()) {
     static int counter = 0;
@@ -163,6 +502,10 @@ bool Linker::normalize(Module& pModule, IRBuilder& pBuilder) {
 }
 
 bool Linker::resolve(Module& pModule) {
+  LinkContext::Scope scope(*m_pContext);
+  PhaseMemoryReport report(*m_pConfig, "resolve");
+  TimeTrace::Scope phase("Resolve");
+  assert(&pModule.getContext() == m_pContext);
   assert(m_pConfig != NULL);
   assert(m_pObjLinker != NULL);
 
@@ -172,10 +515,16 @@ bool Linker::resolve(Module& pModule) {
   //   initiate their reloc entries in SectOrRelocData of LDSection.
   //
   //   To collect all edges in the reference graph.
-  m_pObjLinker->readRelocations();
+  {
+    TimeTrace::Scope step("readRelocations");
+    m_pObjLinker->readRelocations();
+  }
 
   // 7. - data stripping optimizations
-  m_pObjLinker->dataStrippingOpt();
+  {
+    TimeTrace::Scope step("dataStrippingOpt");
+    m_pObjLinker->dataStrippingOpt();
+  }
 
   // 8. - merge all sections
   //   Push sections into Module's SectionTable.
@@ -183,8 +532,11 @@ bool Linker::resolve(Module& pModule) {
   //   Maintain them as fragments in the section.
   //
   //   To merge nodes of the reference graph.
-  if (!m_pObjLinker->mergeSections())
-    return false;
+  {
+    TimeTrace::Scope step("mergeSections");
+    if (!m_pObjLinker->mergeSections())
+      return false;
+  }
 
   // 9.a - add symbols to output
   //  After all input symbols have been resolved, add them to output symbol
@@ -200,6 +552,9 @@ bool Linker::resolve(Module& pModule) {
 }
 
 bool Linker::layout() {
+  LinkContext::Scope scope(*m_pContext);
+  PhaseMemoryReport report(*m_pConfig, "layout");
+  TimeTrace::Scope phase("Layout");
   assert(m_pConfig != NULL && m_pObjLinker != NULL);
 
   // 10. - add standard symbols, target-dependent symbols and script symbols
@@ -210,29 +565,53 @@ bool Linker::layout() {
   // 11. - scan all relocation entries by output symbols.
   //   reserve GOT space for layout.
   //   the space info is needed by pre-layout to compute the section size
-  m_pObjLinker->scanRelocations();
+  {
+    TimeTrace::Scope step("scanRelocations");
+    m_pObjLinker->scanRelocations();
+  }
 
   // 12.a - init relaxation stuff.
   m_pObjLinker->initStubs();
 
   // 12.b - pre-layout
-  m_pObjLinker->prelayout();
+  {
+    TimeTrace::Scope step("prelayout");
+    m_pObjLinker->prelayout();
+  }
 
   // 12.c - linear layout
   //   Decide which sections will be left in. Sort the sections according to
   //   a given order. Then, create program header accordingly.
   //   Finally, set the offset for sections (@ref LDSection)
   //   according to the new order.
-  m_pObjLinker->layout();
+  {
+    TimeTrace::Scope step("layout");
+    m_pObjLinker->layout();
+  }
 
   // 12.d - post-layout (create segment, instruction relaxing)
-  m_pObjLinker->postlayout();
+  {
+    TimeTrace::Scope step("postlayout");
+    m_pObjLinker->postlayout();
+  }
 
   // 13. - finalize symbol value
-  m_pObjLinker->finalizeSymbolValue();
+  {
+    TimeTrace::Scope step("finalizeSymbolValue");
+    m_pObjLinker->finalizeSymbolValue();
+  }
 
-  // 14. - apply relocations
-  m_pObjLinker->relocation();
+  // 14.a - apply relocations
+  {
+    TimeTrace::Scope step("relocation");
+    m_pObjLinker->relocation();
+  }
+
+  // 14.b - compress debug sections
+  {
+    TimeTrace::Scope step("compressDebugSections");
+    m_pObjLinker->compressDebugSections();
+  }
 
   if (!Diagnose())
     return false;
@@ -240,11 +619,20 @@ bool Linker::layout() {
 }
 
 bool Linker::emit(FileOutputBuffer& pOutput) {
+  LinkContext::Scope scope(*m_pContext);
+  PhaseMemoryReport report(*m_pConfig, "emit");
+  TimeTrace::Scope phase("Emit");
   // 15. - write out output
-  m_pObjLinker->emitOutput(pOutput);
+  {
+    TimeTrace::Scope step("emitOutput");
+    m_pObjLinker->emitOutput(pOutput);
+  }
 
   // 16. - post processing
-  m_pObjLinker->postProcessing(pOutput);
+  {
+    TimeTrace::Scope step("postProcessing");
+    m_pObjLinker->postProcessing(pOutput);
+  }
 
   if (!Diagnose())
     return false;
@@ -253,6 +641,8 @@ bool Linker::emit(FileOutputBuffer& pOutput) {
 }
 
 bool Linker::emit(const Module& pModule, const std::string& pPath) {
+  LinkContext::Scope scope(*m_pContext);
+  assert(&pModule.getContext() == m_pContext);
   FileHandle file;
   FileHandle::OpenMode open_mode(
       FileHandle::ReadWrite | FileHandle::Truncate | FileHandle::Create);
@@ -278,26 +668,64 @@ bool Linker::emit(const Module& pModule, const std::string& pPath) {
   }
 
   std::unique_ptr<FileOutputBuffer> output;
-  FileOutputBuffer::create(
-      file, m_pObjLinker->getWriter()->getOutputSize(pModule), output);
-
-  result = emit(*output);
+  FileOutputBuffer::create(file,
+                           m_pObjLinker->getWriter()->getOutputSize(pModule),
+                           GetOutputMode(*m_pConfig),
+                           output);
+
+  result = emit(*output) && Commit(*output);
+  uint64_t output_size = output->getBufferSize();
+  output.reset();
   file.close();
+
+  if (result && m_pConfig->options().incremental())
+    recordState(pPath);
+
+  if (m_pConfig->options().verbose() >= 1)
+    ReportInputMappings(pModule);
+  ReportTimeTrace(*m_pConfig, pModule, output_size);
   return result;
 }
 
 bool Linker::emit(const Module& pModule, int pFileDescriptor) {
+  LinkContext::Scope scope(*m_pContext);
+  assert(&pModule.getContext() == m_pContext);
   FileHandle file;
   file.delegate(pFileDescriptor);
 
   std::unique_ptr<FileOutputBuffer> output;
-  FileOutputBuffer::create(
-      file, m_pObjLinker->getWriter()->getOutputSize(pModule), output);
+  FileOutputBuffer::create(file,
+                           m_pObjLinker->getWriter()->getOutputSize(pModule),
+                           GetOutputMode(*m_pConfig),
+                           output);
+
+  bool result = emit(*output) && Commit(*output);
+
+  if (m_pConfig->options().verbose() >= 1)
+    ReportInputMappings(pModule);
+  ReportTimeTrace(*m_pConfig, pModule, output->getBufferSize());
+  return result;
+}
 
-  return emit(*output);
+/// recordState - keep the state of an incremental link beside its output
+/// pPath, or remove a stale one if the output can not be patched.
+void Linker::recordState(const std::string& pPath) {
+  std::string path = IncrementalState::getPath(pPath);
+  IncrementalState state;
+  IncrementalState::FileIdentity identity;
+  state.setKey(IncrementalState::digest(m_pConfig->options().incrementalKey()));
+  if (!m_pObjLinker->recordState(state) ||
+      !IncrementalState::identify(pPath, identity)) {
+    llvm::sys::fs::remove(path);
+    return;
+  }
+  state.setOutput(identity);
+  if (!state.write(path))
+    llvm::sys::fs::remove(path);
 }
 
 bool Linker::reset() {
+  LinkContext::Scope scope(*m_pContext);
   m_pConfig = NULL;
   m_pIRBuilder = NULL;
   m_pTarget = NULL;
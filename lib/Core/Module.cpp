@@ -15,20 +15,25 @@
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/LD/SectionData.h"
 #include "mcld/LD/StaticResolver.h"
+#include "mcld/Support/LinkContext.h"
 
 namespace mcld {
 
-static GCFactory<Module::AliasList, MCLD_SECTIONS_PER_INPUT>
-    gc_aliaslist_factory;
+typedef ArenaGCFactory<Module::AliasList, MCLD_SECTIONS_PER_INPUT>
+    AliasListFactory;
 
 //===----------------------------------------------------------------------===//
 // Module
 //===----------------------------------------------------------------------===//
-Module::Module(LinkerScript& pScript) : m_Script(pScript), m_NamePool(1024) {
+Module::Module(LinkerScript& pScript)
+    : m_Script(pScript), m_Context(LinkContext::current()), m_NamePool(1024) {
 }
 
 Module::Module(const std::string& pName, LinkerScript& pScript)
-    : m_Name(pName), m_Script(pScript), m_NamePool(1024) {
+    : m_Name(pName),
+      m_Script(pScript),
+      m_Context(LinkContext::current()),
+      m_NamePool(1024) {
 }
 
 Module::~Module() {
@@ -54,7 +59,7 @@ const LDSection* Module::getSection(const std::string& pName) const {
 }
 
 void Module::CreateAliasList(const ResolveInfo& pSym) {
-  AliasList* result = gc_aliaslist_factory.allocate();
+  AliasList* result = m_Context.get<AliasListFactory>().allocate();
   new (result) AliasList();
   m_AliasLists.push_back(result);
   result->push_back(&pSym);
@@ -32,7 +32,11 @@ AlignFragment::AlignFragment(unsigned int pAlignment,
 size_t AlignFragment::size() const {
   assert(hasOffset() &&
          "AlignFragment::size() should not be called before layout.");
-  uint64_t size = llvm::OffsetToAlignment(getOffset(), m_Alignment);
+  return sizeAt(getOffset());
+}
+
+size_t AlignFragment::sizeAt(uint64_t pOffset) const {
+  uint64_t size = llvm::OffsetToAlignment(pOffset, m_Alignment);
   if (size > m_MaxBytesToEmit)
     return 0;
 
@@ -0,0 +1,111 @@
+//===- FragmentIndex.cpp --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Fragment/FragmentIndex.h"
+
+#include "mcld/Fragment/AlignFragment.h"
+#include "mcld/LD/SectionData.h"
+#include "mcld/Support/Parallel.h"
+
+#include <llvm/Support/Casting.h>
+
+#include <algorithm>
+
+namespace mcld {
+
+namespace {
+
+/// the minimum number of fragments handed to one thread
+const size_t kMinFragmentsPerThread = 4096;
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// FragmentIndex
+//===----------------------------------------------------------------------===//
+FragmentIndex::FragmentIndex() {
+}
+
+void FragmentIndex::build(SectionData& pSD, unsigned pNumThreads) {
+  build(pSD.empty() ? NULL : &pSD.front(), 0, pNumThreads);
+}
+
+void FragmentIndex::build(Fragment& pFirst, unsigned pNumThreads) {
+  uint64_t start = 0;
+  const Fragment* prev = pFirst.getPrevNode();
+  if (prev != NULL)
+    start = prev->getOffset() + prev->size();
+  build(&pFirst, start, pNumThreads);
+}
+
+void FragmentIndex::build(Fragment* pFirst,
+                          uint64_t pStart,
+                          unsigned pNumThreads) {
+  clear();
+  for (Fragment* frag = pFirst; frag != NULL; frag = frag->getNextNode())
+    m_Fragments.push_back(frag);
+  m_Offsets.resize(m_Fragments.size() + 1);
+
+  // get the sizes first, m_Offsets[i + 1] holds the size of fragment i
+  parallel::forEach(pNumThreads, m_Fragments.size(), kMinFragmentsPerThread,
+                    [this](size_t pIdx) {
+                      const Fragment* frag = m_Fragments[pIdx];
+                      if (!llvm::isa<AlignFragment>(frag))
+                        m_Offsets[pIdx + 1] = frag->size();
+                    });
+
+  // then sum them up. An AlignFragment pads up to its alignment from the
+  // offset it gets here.
+  m_Offsets[0] = pStart;
+  for (size_t i = 0; i < m_Fragments.size(); ++i) {
+    uint64_t size = m_Offsets[i + 1];
+    if (const AlignFragment* align =
+            llvm::dyn_cast<AlignFragment>(m_Fragments[i]))
+      size = align->sizeAt(m_Offsets[i]);
+    m_Offsets[i + 1] = m_Offsets[i] + size;
+  }
+}
+
+void FragmentIndex::clear() {
+  m_Fragments.clear();
+  m_Offsets.clear();
+}
+
+size_t FragmentIndex::find(uint64_t pOffset, uint64_t& pFragOffset) const {
+  if (m_Fragments.empty())
+    return npos;
+
+  // the first fragment that does not end before pOffset
+  uint64_t offset = m_Offsets.front() + pOffset;
+  std::vector<uint64_t>::const_iterator end =
+      std::lower_bound(m_Offsets.begin() + 1, m_Offsets.end(), offset);
+  size_t idx = end - (m_Offsets.begin() + 1);
+  if (idx == m_Fragments.size())
+    return npos;
+
+  if (*end == offset && getSize(idx) != 0) {
+    // pOffset is the end of fragment idx, refer to the start of the next
+    ++idx;
+    if (idx == m_Fragments.size())
+      return npos;
+    pFragOffset = 0;
+    return idx;
+  }
+
+  pFragOffset = offset - m_Offsets[idx];
+  return idx;
+}
+
+void FragmentIndex::assignOffsets(unsigned pNumThreads) const {
+  parallel::forEach(pNumThreads, m_Fragments.size(), kMinFragmentsPerThread,
+                    [this](size_t pIdx) {
+                      m_Fragments[pIdx]->setOffset(m_Offsets[pIdx]);
+                    });
+}
+
+}  // namespace mcld
@@ -9,27 +9,64 @@
 #include "mcld/Fragment/FragmentRef.h"
 
 #include "mcld/Fragment/Fragment.h"
+#include "mcld/Fragment/FragmentIndex.h"
 #include "mcld/Fragment/RegionFragment.h"
 #include "mcld/Fragment/Stub.h"
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/SectionData.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Casting.h>
-#include <llvm/Support/ManagedStatic.h>
 
 #include <cassert>
 
 namespace mcld {
 
-typedef GCFactory<FragmentRef, MCLD_SECTIONS_PER_INPUT> FragRefFactory;
+typedef ArenaGCFactory<FragmentRef, MCLD_SECTIONS_PER_INPUT> FragRefFactory;
 
-static llvm::ManagedStatic<FragRefFactory> g_FragRefFactory;
+static inline FragRefFactory& CurrentFragRefFactory() {
+  return LinkContext::current().get<FragRefFactory>();
+}
+
+/// GetSectionData - the fragments the offsets in pSection refer to
+static SectionData* GetSectionData(LDSection& pSection) {
+  switch (pSection.kind()) {
+    case LDFileFormat::Relocation:
+      // No fragment reference refers to a relocation section
+      return NULL;
+    case LDFileFormat::EhFrame:
+      if (pSection.hasEhFrame())
+        return pSection.getEhFrame()->getSectionData();
+      return NULL;
+    default:
+      return pSection.getSectionData();
+  }
+}
 
 FragmentRef FragmentRef::g_NullFragmentRef;
 
+//===----------------------------------------------------------------------===//
+// FragmentRef::IndexScope
+//===----------------------------------------------------------------------===//
+FragmentRef::IndexScope::IndexScope(LDSection& pSection)
+    : m_pData(GetSectionData(pSection)) {
+  // a section of one fragment is found as fast without an index
+  if (m_pData == NULL || m_pData->empty() ||
+      &m_pData->front() == &m_pData->back() || m_pData->getIndex() != NULL) {
+    m_pData = NULL;
+    return;
+  }
+  m_pData->buildIndex();
+}
+
+FragmentRef::IndexScope::~IndexScope() {
+  if (m_pData != NULL)
+    m_pData->dropIndex();
+}
+
 //===----------------------------------------------------------------------===//
 // FragmentRef
 //===----------------------------------------------------------------------===//
@@ -67,36 +104,38 @@ FragmentRef* FragmentRef::Create(Fragment& pFrag, uint64_t pOffset) {
   if (frag == NULL)
     return Null();
 
-  FragmentRef* result = g_FragRefFactory->allocate();
+  FragmentRef* result = CurrentFragRefFactory().allocate();
   new (result) FragmentRef(*frag, offset);
 
   return result;
 }
 
 FragmentRef* FragmentRef::Create(LDSection& pSection, uint64_t pOffset) {
-  SectionData* data = NULL;
-  switch (pSection.kind()) {
-    case LDFileFormat::Relocation:
-      // No fragment reference refers to a relocation section
-      break;
-    case LDFileFormat::EhFrame:
-      if (pSection.hasEhFrame())
-        data = pSection.getEhFrame()->getSectionData();
-      break;
-    default:
-      data = pSection.getSectionData();
-      break;
-  }
-
+  SectionData* data = GetSectionData(pSection);
   if (data == NULL || data->empty()) {
     return Null();
   }
 
+  if (data->getIndex() != NULL)
+    return Create(*data->getIndex(), pOffset);
   return Create(data->front(), pOffset);
 }
 
+FragmentRef* FragmentRef::Create(const FragmentIndex& pIndex,
+                                 uint64_t pOffset) {
+  uint64_t offset = 0;
+  size_t idx = pIndex.find(pOffset, offset);
+  if (idx == FragmentIndex::npos)
+    return Null();
+
+  FragmentRef* result = CurrentFragRefFactory().allocate();
+  new (result) FragmentRef(pIndex.getFragment(idx), offset);
+
+  return result;
+}
+
 void FragmentRef::Clear() {
-  g_FragRefFactory->clear();
+  CurrentFragRefFactory().clear();
 }
 
 FragmentRef* FragmentRef::Null() {
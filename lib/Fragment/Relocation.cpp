@@ -14,30 +14,32 @@
 #include "mcld/LD/Relocator.h"
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/Support/LinkContext.h"
 #include "mcld/Support/MsgHandling.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-static llvm::ManagedStatic<RelocationFactory> g_RelocationFactory;
+static inline RelocationFactory& CurrentRelocationFactory() {
+  return LinkContext::current().get<RelocationFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // Relocation Factory Methods
 //===----------------------------------------------------------------------===//
 /// Initialize - set up the relocation factory
 void Relocation::SetUp(const LinkerConfig& pConfig) {
-  g_RelocationFactory->setConfig(pConfig);
+  CurrentRelocationFactory().setConfig(pConfig);
 }
 
 /// Clear - Clean up the relocation factory
 void Relocation::Clear() {
-  g_RelocationFactory->clear();
+  CurrentRelocationFactory().clear();
 }
 
 /// Create - produce an empty relocation entry
 Relocation* Relocation::Create() {
-  return g_RelocationFactory->produceEmptyEntry();
+  return CurrentRelocationFactory().produceEmptyEntry();
 }
 
 /// Create - produce a relocation entry
@@ -47,12 +49,12 @@ Relocation* Relocation::Create() {
 Relocation* Relocation::Create(Type pType,
                                FragmentRef& pFragRef,
                                Address pAddend) {
-  return g_RelocationFactory->produce(pType, pFragRef, pAddend);
+  return CurrentRelocationFactory().produce(pType, pFragRef, pAddend);
 }
 
 /// Destroy - destroy a relocation entry
 void Relocation::Destroy(Relocation*& pRelocation) {
-  g_RelocationFactory->destroy(pRelocation);
+  CurrentRelocationFactory().destroy(pRelocation);
   pRelocation = NULL;
 }
 
@@ -95,32 +97,8 @@ Relocation::Address Relocation::symValue() const {
 
 void Relocation::apply(Relocator& pRelocator) {
   Relocator::Result result = pRelocator.applyRelocation(*this);
-
-  switch (result) {
-    case Relocator::OK: {
-      // do nothing
-      return;
-    }
-    case Relocator::Overflow: {
-      error(diag::result_overflow) << pRelocator.getName(type())
-                                   << symInfo()->name();
-      return;
-    }
-    case Relocator::BadReloc: {
-      error(diag::result_badreloc) << pRelocator.getName(type())
-                                   << symInfo()->name();
-      return;
-    }
-    case Relocator::Unsupported: {
-      fatal(diag::unsupported_relocation) << type()
-                                          << "mclinker@googlegroups.com";
-      return;
-    }
-    case Relocator::Unknown: {
-      fatal(diag::unknown_relocation) << type() << symInfo()->name();
-      return;
-    }
-  }  // end of switch
+  if (result != Relocator::OK)
+    pRelocator.reportResult(*this, result);
 }
 
 void Relocation::setType(Type pType) {
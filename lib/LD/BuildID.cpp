@@ -0,0 +1,174 @@
+//===- BuildID.cpp --------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/BuildID.h"
+
+#include "mcld/ADT/SizeTraits.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/Support/Digest.h"
+#include "mcld/Support/FileOutputBuffer.h"
+#include "mcld/Support/Parallel.h"
+
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MD5.h>
+
+#include <cassert>
+#include <cstring>
+#include <random>
+#include <vector>
+
+namespace mcld {
+
+namespace {
+
+/// NT_GNU_BUILD_ID
+const uint32_t kNoteType = 3;
+
+/// namesz, descsz, type and "GNU\0"
+const size_t kHeaderSize = 16;
+
+/// the fewest chunks worth a thread of their own
+const size_t kMinChunksPerThread = 4;
+
+/// HashBlock - write the digest of pBlock to pResult
+void HashBlock(BuildID::Style pStyle,
+               llvm::ArrayRef<uint8_t> pBlock,
+               uint8_t* pResult) {
+  switch (pStyle) {
+    case BuildID::Style::Fast: {
+      uint64_t hash = digest::xxHash64(pBlock);
+      for (unsigned i = 0; i < 8; ++i)
+        pResult[i] = static_cast<uint8_t>(hash >> (8 * i));
+      break;
+    }
+    case BuildID::Style::MD5: {
+      llvm::MD5 hash;
+      hash.update(pBlock);
+      llvm::MD5::MD5Result result;
+      hash.final(result);
+      std::memcpy(pResult, &result[0], 16);
+      break;
+    }
+    case BuildID::Style::SHA1:
+      digest::SHA1(pBlock, pResult);
+      break;
+    default:
+      assert(false && "not a hashed build id");
+      break;
+  }
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// BuildID
+//===----------------------------------------------------------------------===//
+const size_t BuildID::ChunkSize;
+
+BuildID::BuildID(LDSection& pSection,
+                 Style pStyle,
+                 const std::string& pBytes,
+                 bool pLittleEndian,
+                 unsigned pNumThreads)
+    : m_Section(pSection),
+      m_Style(pStyle),
+      m_Bytes(pBytes),
+      m_bLittleEndian(pLittleEndian),
+      m_NumThreads(pNumThreads) {
+}
+
+void BuildID::sizeOutput() {
+  m_Section.setSize(kHeaderSize + descSize());
+}
+
+void BuildID::emitOutput(FileOutputBuffer& pOutput) {
+  MemoryRegion region = pOutput.request(m_Section.offset(), m_Section.size());
+  // namesz, descsz and type are words of the target
+  uint32_t header[3] = {4, static_cast<uint32_t>(descSize()), kNoteType};
+  if (llvm::sys::IsLittleEndianHost != m_bLittleEndian) {
+    for (unsigned i = 0; i < 3; ++i)
+      header[i] = mcld::bswap32(header[i]);
+  }
+  std::memcpy(region.begin(), header, sizeof(header));
+  std::memcpy(region.begin() + 12, "GNU", 4);
+
+  uint8_t* desc = region.begin() + kHeaderSize;
+  switch (m_Style) {
+    case Style::Hex:
+      std::memcpy(desc, m_Bytes.data(), m_Bytes.size());
+      break;
+    case Style::UUID: {
+      std::random_device device;
+      for (size_t i = 0; i < 16; ++i)
+        desc[i] = static_cast<uint8_t>(device());
+      // RFC 4122 version 4, variant 1
+      desc[6] = (desc[6] & 0x0f) | 0x40;
+      desc[8] = (desc[8] & 0x3f) | 0x80;
+      break;
+    }
+    default: {
+      // hash the output with the build id zeroed
+      std::vector<uint8_t> digest(descSize());
+      std::memset(desc, 0, digest.size());
+      computeTreeHash(m_Style,
+                      llvm::ArrayRef<uint8_t>(pOutput.getBufferStart(),
+                                              pOutput.getBufferSize()),
+                      ChunkSize,
+                      m_NumThreads,
+                      digest.data());
+      std::memcpy(desc, digest.data(), digest.size());
+      break;
+    }
+  }
+}
+
+size_t BuildID::getDigestSize(Style pStyle) {
+  switch (pStyle) {
+    case Style::Fast:
+      return 8;
+    case Style::MD5:
+    case Style::UUID:
+      return 16;
+    case Style::SHA1:
+      return 20;
+    default:
+      return 0;
+  }
+}
+
+void BuildID::computeTreeHash(Style pStyle,
+                              llvm::ArrayRef<uint8_t> pData,
+                              size_t pChunkSize,
+                              unsigned pNumThreads,
+                              uint8_t* pResult) {
+  assert(pChunkSize != 0);
+  size_t digest_size = getDigestSize(pStyle);
+  size_t num_of_chunks = (pData.size() + pChunkSize - 1) / pChunkSize;
+
+  // every chunk writes its own slot, so the leaves need no locking
+  std::vector<uint8_t> leaves(num_of_chunks * digest_size);
+  parallel::forEach(pNumThreads, num_of_chunks, kMinChunksPerThread,
+                    [&](size_t pChunk) {
+                      size_t begin = pChunk * pChunkSize;
+                      size_t length =
+                          std::min(pChunkSize, pData.size() - begin);
+                      HashBlock(pStyle,
+                                pData.slice(begin, length),
+                                leaves.data() + pChunk * digest_size);
+                    });
+
+  HashBlock(pStyle, leaves, pResult);
+}
+
+size_t BuildID::descSize() const {
+  if (m_Style == Style::Hex)
+    return m_Bytes.size();
+  return getDigestSize(m_Style);
+}
+
+}  // namespace mcld
@@ -0,0 +1,147 @@
+//===- CallGraphSort.cpp --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/CallGraphSort.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace mcld {
+
+namespace {
+
+/// a merge may not leave the caller cluster less dense than this fraction
+const double kMaxDensityDegradation = 8.0;
+
+/// a caller that makes less than this fraction of the calls is not a reason
+/// to merge
+const uint64_t kMinPredFraction = 10;
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// CallGraphSort
+//===----------------------------------------------------------------------===//
+CallGraphSort::CallGraphSort(uint64_t pClusterSize)
+    : m_ClusterSize(pClusterSize) {
+}
+
+unsigned int CallGraphSort::addNode(uint64_t pSize) {
+  unsigned int index = m_Clusters.size();
+  Cluster cluster;
+  cluster.next = cluster.prev = index;
+  cluster.size = pSize;
+  cluster.weight = cluster.initialWeight = 0;
+  cluster.bestPred = -1;
+  cluster.bestPredWeight = 0;
+  m_Clusters.push_back(cluster);
+  m_Leaders.push_back(index);
+  return index;
+}
+
+void CallGraphSort::addEdge(unsigned int pCaller,
+                            unsigned int pCallee,
+                            uint64_t pWeight) {
+  assert(pCaller < m_Clusters.size() && pCallee < m_Clusters.size());
+  // a recursive call does not bring two sections together
+  if (pCaller == pCallee)
+    return;
+
+  Cluster& callee = m_Clusters[pCallee];
+  callee.weight += pWeight;
+  callee.initialWeight += pWeight;
+  if (callee.bestPred == -1 || callee.bestPredWeight < pWeight) {
+    callee.bestPred = pCaller;
+    callee.bestPredWeight = pWeight;
+  }
+}
+
+void CallGraphSort::sort(std::vector<unsigned int>& pOrder) {
+  std::vector<unsigned int> sorted(m_Clusters.size());
+  for (unsigned int i = 0; i < sorted.size(); ++i)
+    sorted[i] = i;
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [this](unsigned int pA, unsigned int pB) {
+                     return m_Clusters[pA].density() >
+                            m_Clusters[pB].density();
+                   });
+
+  for (unsigned int i = 0; i < sorted.size(); ++i) {
+    unsigned int index = sorted[i];
+    Cluster& cluster = m_Clusters[index];
+    if (cluster.bestPred == -1 ||
+        cluster.bestPredWeight * kMinPredFraction <= cluster.initialWeight)
+      continue;
+
+    unsigned int pred = getLeader(cluster.bestPred);
+    if (pred == index)
+      continue;
+
+    Cluster& into = m_Clusters[pred];
+    if (into.size + cluster.size > m_ClusterSize)
+      continue;
+
+    double density = static_cast<double>(into.weight + cluster.weight) /
+                     (into.size + cluster.size);
+    if (density < into.density() / kMaxDensityDegradation)
+      continue;
+
+    merge(pred, index);
+  }
+
+  // lay out the clusters from the densest, each from its leader
+  sorted.clear();
+  for (unsigned int i = 0; i < m_Clusters.size(); ++i) {
+    if (m_Leaders[i] == i)
+      sorted.push_back(i);
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [this](unsigned int pA, unsigned int pB) {
+                     return m_Clusters[pA].density() >
+                            m_Clusters[pB].density();
+                   });
+
+  pOrder.clear();
+  pOrder.reserve(m_Clusters.size());
+  for (unsigned int i = 0; i < sorted.size(); ++i) {
+    unsigned int index = sorted[i];
+    do {
+      pOrder.push_back(index);
+      index = m_Clusters[index].next;
+    } while (index != sorted[i]);
+  }
+}
+
+unsigned int CallGraphSort::getLeader(unsigned int pIndex) {
+  // path halving
+  while (m_Leaders[pIndex] != pIndex) {
+    m_Leaders[pIndex] = m_Leaders[m_Leaders[pIndex]];
+    pIndex = m_Leaders[pIndex];
+  }
+  return pIndex;
+}
+
+void CallGraphSort::merge(unsigned int pInto, unsigned int pFrom) {
+  Cluster& into = m_Clusters[pInto];
+  Cluster& from = m_Clusters[pFrom];
+
+  // splice the circular list of pFrom after the last section of pInto
+  unsigned int tail = into.prev;
+  unsigned int from_tail = from.prev;
+  m_Clusters[tail].next = pFrom;
+  m_Clusters[from_tail].next = pInto;
+  into.prev = from_tail;
+
+  into.size += from.size;
+  into.weight += from.weight;
+  from.size = 0;
+  from.weight = 0;
+  m_Leaders[pFrom] = pInto;
+}
+
+}  // namespace mcld
@@ -15,17 +15,19 @@
 #include "mcld/Fragment/Fragment.h"
 #include "mcld/Fragment/RegionFragment.h"
 #include "mcld/Fragment/Relocation.h"
+#include "mcld/Support/LinkContext.h"
 #include "mcld/Target/TargetLDBackend.h"
 #include "mcld/LD/Relocator.h"
 
 #include <llvm/Support/Casting.h>
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
 // DebugString represents the output .debug_str section, which is at most on
-// in each linking
-static llvm::ManagedStatic<DebugString> g_DebugString;
+// in each linking, so each link context holds one
+static inline DebugString& CurrentDebugString() {
+  return LinkContext::current().get<DebugString>();
+}
 
 static inline size_t string_length(const char* pStr) {
   const char* p = pStr;
@@ -88,8 +90,9 @@ void DebugString::emit(MemoryRegion& pRegion) {
 }
 
 DebugString* DebugString::Create(LDSection& pSection) {
-  g_DebugString->setOutputSection(pSection);
-  return &(*g_DebugString);
+  DebugString& result = CurrentDebugString();
+  result.setOutputSection(pSection);
+  return &result;
 }
 
 }  // namespace mcld
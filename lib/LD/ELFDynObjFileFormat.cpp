@@ -9,6 +9,7 @@
 #include "mcld/LD/ELFDynObjFileFormat.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/Object/ObjectBuilder.h"
+#include "mcld/Support/ELF.h"
 
 #include <llvm/Support/ELF.h>
 
@@ -62,6 +63,11 @@ void ELFDynObjFileFormat::initObjectFormat(ObjectBuilder& pBuilder,
                                      llvm::ELF::SHT_REL,
                                      llvm::ELF::SHF_ALLOC,
                                      pBitClass / 8);
+  f_pRelrDyn = pBuilder.CreateSection(".relr.dyn",
+                                      LDFileFormat::Relocation,
+                                      ELF::SHT_RELR,
+                                      llvm::ELF::SHF_ALLOC,
+                                      pBitClass / 8);
   f_pGOT = pBuilder.CreateSection(".got",
                                   LDFileFormat::Target,
                                   llvm::ELF::SHT_PROGBITS,
@@ -89,6 +95,11 @@ void ELFDynObjFileFormat::initObjectFormat(ObjectBuilder& pBuilder,
                                          llvm::ELF::SHT_GNU_HASH,
                                          llvm::ELF::SHF_ALLOC,
                                          pBitClass / 8);
+  f_pNoteGNUBuildID = pBuilder.CreateSection(".note.gnu.build-id",
+                                             LDFileFormat::Note,
+                                             llvm::ELF::SHT_NOTE,
+                                             llvm::ELF::SHF_ALLOC,
+                                             0x4);
 }
 
 }  // namespace mcld
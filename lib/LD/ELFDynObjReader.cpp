@@ -107,12 +107,19 @@ bool ELFDynObjReader::readSymbols(Input& pInput) {
     return false;
   }
 
-  llvm::StringRef symtab_region = pInput.memArea()->request(
-      pInput.fileOffset() + symtab_shdr->offset(), symtab_shdr->size());
-
   llvm::StringRef strtab_region = pInput.memArea()->request(
       pInput.fileOffset() + strtab_shdr->offset(), strtab_shdr->size());
   const char* strtab = strtab_region.begin();
+
+  // a link server has decoded the symbols already
+  const ParsedInput::Object* parsed = ELFReaderIF::getParsed(pInput);
+  if (parsed != NULL && parsed->symtabOffset == symtab_shdr->offset() &&
+      parsed->symtabSize == symtab_shdr->size())
+    return m_pELFReader->createSymbols(
+        pInput, m_Builder, parsed->symbols, strtab);
+
+  llvm::StringRef symtab_region = pInput.memArea()->request(
+      pInput.fileOffset() + symtab_shdr->offset(), symtab_shdr->size());
   bool result =
       m_pELFReader->readSymbols(pInput, m_Builder, symtab_region, strtab);
   return result;
@@ -9,6 +9,7 @@
 #include "mcld/LD/ELFExecFileFormat.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/Object/ObjectBuilder.h"
+#include "mcld/Support/ELF.h"
 
 #include <llvm/Support/ELF.h>
 
@@ -63,6 +64,11 @@ void ELFExecFileFormat::initObjectFormat(ObjectBuilder& pBuilder,
                                      llvm::ELF::SHT_REL,
                                      llvm::ELF::SHF_ALLOC,
                                      pBitClass / 8);
+  f_pRelrDyn = pBuilder.CreateSection(".relr.dyn",
+                                      LDFileFormat::Relocation,
+                                      ELF::SHT_RELR,
+                                      llvm::ELF::SHF_ALLOC,
+                                      pBitClass / 8);
   f_pGOT = pBuilder.CreateSection(".got",
                                   LDFileFormat::Target,
                                   llvm::ELF::SHT_PROGBITS,
@@ -90,6 +96,11 @@ void ELFExecFileFormat::initObjectFormat(ObjectBuilder& pBuilder,
                                          llvm::ELF::SHT_GNU_HASH,
                                          llvm::ELF::SHF_ALLOC,
                                          pBitClass / 8);
+  f_pNoteGNUBuildID = pBuilder.CreateSection(".note.gnu.build-id",
+                                             LDFileFormat::Note,
+                                             llvm::ELF::SHT_NOTE,
+                                             llvm::ELF::SHF_ALLOC,
+                                             0x4);
 }
 
 }  // namespace mcld
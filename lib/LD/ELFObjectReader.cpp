@@ -9,6 +9,7 @@
 #include "mcld/LD/ELFObjectReader.h"
 
 #include "mcld/IRBuilder.h"
+#include "mcld/Fragment/FragmentRef.h"
 #include "mcld/MC/Input.h"
 #include "mcld/LD/ELFReader.h"
 #include "mcld/LD/EhFrameReader.h"
@@ -194,6 +195,20 @@ bool ELFObjectReader::readSections(Input& pInput) {
         }
         break;
       }
+      /** note sections **/
+      case LDFileFormat::Note: {
+        // the linker writes its own build id for --build-id
+        if (m_Config.options().hasBuildID() &&
+            m_Config.codeGenType() != LinkerConfig::Object &&
+            (*section)->name() == ".note.gnu.build-id") {
+          (*section)->setKind(LDFileFormat::Ignore);
+          break;
+        }
+        SectionData* sd = IRBuilder::CreateSectionData(**section);
+        if (!m_pELFReader->readRegularSection(pInput, *sd))
+          fatal(diag::err_cannot_read_section) << (*section)->name();
+        break;
+      }
       /** normal sections **/
       // FIXME: support Version Kind
       case LDFileFormat::Version:
@@ -202,7 +217,6 @@ bool ELFObjectReader::readSections(Input& pInput) {
       /** Fall through **/
       case LDFileFormat::TEXT:
       case LDFileFormat::DATA:
-      case LDFileFormat::Note:
       case LDFileFormat::MetaData: {
         SectionData* sd = IRBuilder::CreateSectionData(**section);
         if (!m_pELFReader->readRegularSection(pInput, *sd))
@@ -227,7 +241,12 @@ bool ELFObjectReader::readSections(Input& pInput) {
         // We don't really parse EhFrame if this is a partial linking
         if ((m_Config.codeGenType() != LinkerConfig::Object) &&
             (m_ReadFlag & ParseEhFrame)) {
-          if (!m_pEhFrameReader->read<32, true>(pInput, *eh_frame)) {
+          bool parsed = false;
+          if (m_Config.targets().is64Bits())
+            parsed = m_pEhFrameReader->read<64, true>(pInput, *eh_frame);
+          else
+            parsed = m_pEhFrameReader->read<32, true>(pInput, *eh_frame);
+          if (!parsed) {
             // if we failed to parse a .eh_frame, we should not parse the rest
             // .eh_frame.
             m_ReadFlag ^= ParseEhFrame;
@@ -290,11 +309,19 @@ bool ELFObjectReader::readSymbols(Input& pInput) {
     return false;
   }
 
-  llvm::StringRef symtab_region = pInput.memArea()->request(
-      pInput.fileOffset() + symtab_shdr->offset(), symtab_shdr->size());
   llvm::StringRef strtab_region = pInput.memArea()->request(
       pInput.fileOffset() + strtab_shdr->offset(), strtab_shdr->size());
   const char* strtab = strtab_region.begin();
+
+  // a link server has decoded the symbols already
+  const ParsedInput::Object* parsed = ELFReaderIF::getParsed(pInput);
+  if (parsed != NULL && parsed->symtabOffset == symtab_shdr->offset() &&
+      parsed->symtabSize == symtab_shdr->size())
+    return m_pELFReader->createSymbols(
+        pInput, m_Builder, parsed->symbols, strtab);
+
+  llvm::StringRef symtab_region = pInput.memArea()->request(
+      pInput.fileOffset() + symtab_shdr->offset(), symtab_shdr->size());
   bool result =
       m_pELFReader->readSymbols(pInput, m_Builder, symtab_region, strtab);
   return result;
@@ -314,6 +341,8 @@ bool ELFObjectReader::readRelocations(Input& pInput) {
     llvm::StringRef region = mem->request(offset, size);
     IRBuilder::CreateRelocData(
         **rs);  ///< create relocation data for the header
+    // every relocation looks up its fragment in the target section
+    FragmentRef::IndexScope index(*(*rs)->getLink());
     switch ((*rs)->type()) {
       case llvm::ELF::SHT_RELA: {
         if (!m_pELFReader->readRela(pInput, **rs, region)) {
@@ -26,14 +26,18 @@
 #include "mcld/LD/LDSymbol.h"
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/Support/Compression.h"
+#include "mcld/Support/ELF.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Target/GNUInfo.h"
 #include "mcld/Target/GNULDBackend.h"
+#include "mcld/Target/RelrSection.h"
 
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/ELF.h>
 #include <llvm/Support/Errc.h>
 #include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/Host.h>
 
 namespace mcld {
 
@@ -87,35 +91,83 @@ void ELFObjectWriter::writeSection(Module& pModule,
       return;
   }
 
+  // a compressed section has its final contents already
+  CompressedSectionMap::const_iterator compressed =
+      m_CompressedSections.find(section);
+  if (compressed != m_CompressedSections.end()) {
+    std::memcpy(region.begin(), compressed->second.data(), region.size());
+    return;
+  }
+
+  emitSection(pModule, *section, region);
+}
+
+void ELFObjectWriter::emitSection(Module& pModule,
+                                  LDSection& pSection,
+                                  MemoryRegion& pRegion) {
   // Write out sections with data
-  switch (section->kind()) {
+  switch (pSection.kind()) {
     case LDFileFormat::GCCExceptTable:
     case LDFileFormat::TEXT:
     case LDFileFormat::DATA:
     case LDFileFormat::Debug:
     case LDFileFormat::Note:
-      emitSectionData(*section, region);
+      emitSectionData(pSection, pRegion);
       break;
     case LDFileFormat::EhFrame:
-      emitEhFrame(pModule, *section->getEhFrame(), region);
+      emitEhFrame(pModule, *pSection.getEhFrame(), pRegion);
       break;
     case LDFileFormat::Relocation:
+      // .relr.dyn is encoded by the backend
+      if (ELF::SHT_RELR == pSection.type()) {
+        assert(target().getRelrDyn() != NULL);
+        target().getRelrDyn()->emit(pRegion);
+        break;
+      }
+
       // sort relocation for the benefit of the dynamic linker.
-      target().sortRelocation(*section);
+      target().sortRelocation(pSection);
 
-      emitRelocation(m_Config, *section, region);
+      emitRelocation(m_Config, pSection, pRegion);
       break;
     case LDFileFormat::Target:
-      target().emitSectionData(*section, region);
+      target().emitSectionData(pSection, pRegion);
       break;
     case LDFileFormat::DebugString:
-      section->getDebugString()->emit(region);
+      pSection.getDebugString()->emit(pRegion);
       break;
     default:
       llvm_unreachable("invalid section kind");
   }
 }
 
+bool ELFObjectWriter::compressSection(LDSection& pSection,
+                                      ConstMemoryRegion pContents) {
+  std::vector<uint8_t> deflated;
+  zlib::compress(pContents, m_Config.options().numThreads(), deflated);
+
+  size_t header_size = m_Config.targets().is32Bits()
+                           ? sizeof(ELFSizeTraits<32>::Chdr)
+                           : sizeof(ELFSizeTraits<64>::Chdr);
+  if (header_size + deflated.size() >= pContents.size())
+    return false;
+
+  std::vector<uint8_t>& data = m_CompressedSections[&pSection];
+  data.resize(header_size + deflated.size());
+  if (m_Config.targets().is32Bits())
+    writeCompressionHeader<32>(pSection, pContents.size(), data.data());
+  else
+    writeCompressionHeader<64>(pSection, pContents.size(), data.data());
+  std::memcpy(data.data() + header_size, deflated.data(), deflated.size());
+
+  // the header is aligned as a word of the ELF class, and keeps the
+  // alignment of the contents
+  pSection.setFlag(pSection.flag() | ELF::SHF_COMPRESSED);
+  pSection.setAlign(m_Config.targets().bitclass() / 8);
+  pSection.setSize(data.size());
+  return true;
+}
+
 std::error_code ELFObjectWriter::writeObject(Module& pModule,
                                              FileOutputBuffer& pOutput) {
   bool is_dynobj = m_Config.codeGenType() == LinkerConfig::DynObj;
@@ -184,6 +236,25 @@ std::error_code ELFObjectWriter::writeObject(Module& pModule,
   return std::error_code();
 }
 
+// writeCompressionHeader - emit ElfXX_Chdr
+template <size_t SIZE>
+void ELFObjectWriter::writeCompressionHeader(const LDSection& pSection,
+                                             uint64_t pSize,
+                                             uint8_t* pData) const {
+  typedef typename ELFSizeTraits<SIZE>::Chdr ElfXX_Chdr;
+  ElfXX_Chdr header;
+  std::memset(&header, 0, sizeof(header));
+  header.ch_type = ELF::ELFCOMPRESS_ZLIB;
+  header.ch_size = pSize;
+  header.ch_addralign = pSection.align();
+  if (llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian()) {
+    header.ch_type = mcld::bswap32(header.ch_type);
+    header.ch_size = mcld::bswap<SIZE>(header.ch_size);
+    header.ch_addralign = mcld::bswap<SIZE>(header.ch_addralign);
+  }
+  std::memcpy(pData, &header, sizeof(header));
+}
+
 // getOutputSize - count the final output size
 size_t ELFObjectWriter::getOutputSize(const Module& pModule) const {
   if (m_Config.targets().is32Bits()) {
@@ -566,6 +637,7 @@ uint64_t ELFObjectWriter::getSectEntrySize(const LDSection& pSection) const {
   typedef typename ELFSizeTraits<SIZE>::Rel ElfXX_Rel;
   typedef typename ELFSizeTraits<SIZE>::Rela ElfXX_Rela;
   typedef typename ELFSizeTraits<SIZE>::Dyn ElfXX_Dyn;
+  typedef typename ELFSizeTraits<SIZE>::Addr ElfXX_Addr;
 
   if (llvm::ELF::SHT_DYNSYM == pSection.type() ||
       llvm::ELF::SHT_SYMTAB == pSection.type())
@@ -574,6 +646,8 @@ uint64_t ELFObjectWriter::getSectEntrySize(const LDSection& pSection) const {
     return sizeof(ElfXX_Rel);
   if (llvm::ELF::SHT_RELA == pSection.type())
     return sizeof(ElfXX_Rela);
+  if (ELF::SHT_RELR == pSection.type())
+    return sizeof(ElfXX_Addr);
   if (llvm::ELF::SHT_HASH == pSection.type() ||
       llvm::ELF::SHT_GNU_HASH == pSection.type())
     return sizeof(ElfXX_Word);
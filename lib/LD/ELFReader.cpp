@@ -9,11 +9,15 @@
 #include "mcld/LD/ELFReader.h"
 
 #include "mcld/IRBuilder.h"
+#include "mcld/ADT/SizeTraits.h"
 #include "mcld/Fragment/FillFragment.h"
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDContext.h"
+#include "mcld/LD/ParsedInput.h"
 #include "mcld/LD/SectionData.h"
 #include "mcld/Object/ObjectBuilder.h"
+#include "mcld/Support/Compression.h"
+#include "mcld/Support/ELF.h"
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Target/GNUInfo.h"
@@ -30,6 +34,58 @@
 
 namespace mcld {
 
+/// ReadCompressedSection - create the fragment of a SHF_COMPRESSED section.
+/// The contents are inflated into memory kept by the MemoryArea of the input
+/// only when the section is read, so sections left out of the link, such as
+/// debug sections under --strip-debug, are never inflated. The section takes
+/// the size and alignment of its inflated contents. pSwap tells whether the
+/// header is in the byte order opposite to the host.
+template <size_t SIZE>
+static bool ReadCompressedSection(Input& pInput,
+                                  uint64_t pOffset,
+                                  SectionData& pSD,
+                                  bool pSwap) {
+  typedef typename ELFSizeTraits<SIZE>::Chdr ElfXX_Chdr;
+  LDSection& section = pSD.getSection();
+  if (section.size() < sizeof(ElfXX_Chdr))
+    return false;
+
+  llvm::StringRef region = pInput.memArea()->request(pOffset, section.size());
+  ElfXX_Chdr chdr;
+  std::memcpy(&chdr, region.data(), sizeof(ElfXX_Chdr));
+  if (pSwap) {
+    chdr.ch_type = mcld::bswap32(chdr.ch_type);
+    chdr.ch_size = mcld::bswap<SIZE>(chdr.ch_size);
+    chdr.ch_addralign = mcld::bswap<SIZE>(chdr.ch_addralign);
+  }
+  if (ELF::ELFCOMPRESS_ZLIB != chdr.ch_type)
+    return false;
+
+  // deflate never shrinks data by more than 1032:1, so a larger size is a
+  // corrupt header, not a reason to allocate
+  llvm::ArrayRef<uint8_t> deflated(
+      reinterpret_cast<const uint8_t*>(region.data()) + sizeof(ElfXX_Chdr),
+      region.size() - sizeof(ElfXX_Chdr));
+  if (chdr.ch_size / 1032 > deflated.size())
+    return false;
+
+  std::unique_ptr<char[]> data(new char[chdr.ch_size]);
+  if (!zlib::uncompress(
+          deflated, reinterpret_cast<uint8_t*>(data.get()), chdr.ch_size))
+    return false;
+
+  llvm::StringRef contents =
+      pInput.memArea()->keep(std::move(data), chdr.ch_size);
+  section.setSize(chdr.ch_size);
+  section.setAlign(chdr.ch_addralign);
+  section.setFlag(section.flag() & ~ELF::SHF_COMPRESSED);
+
+  Fragment* frag = IRBuilder::CreateRegion(const_cast<char*>(contents.data()),
+                                           contents.size());
+  ObjectBuilder::AppendFragment(*frag, pSD);
+  return true;
+}
+
 //===----------------------------------------------------------------------===//
 // ELFReader<32, true>
 //===----------------------------------------------------------------------===//
@@ -56,6 +112,10 @@ bool ELFReader<32, true>::readRegularSection(Input& pInput,
   uint32_t offset = pInput.fileOffset() + pSD.getSection().offset();
   uint32_t size = pSD.getSection().size();
 
+  if ((pSD.getSection().flag() & ELF::SHF_COMPRESSED) != 0)
+    return ReadCompressedSection<32>(
+        pInput, offset, pSD, !llvm::sys::IsLittleEndianHost);
+
   Fragment* frag = IRBuilder::CreateRegion(pInput, offset, size);
   ObjectBuilder::AppendFragment(*frag, pSD);
   return true;
@@ -71,130 +131,25 @@ bool ELFReader<32, true>::readSymbols(Input& pInput,
   const llvm::ELF::Elf32_Sym* symtab =
       reinterpret_cast<const llvm::ELF::Elf32_Sym*>(pRegion.begin());
 
-  uint32_t st_name = 0x0;
-  uint32_t st_value = 0x0;
-  uint32_t st_size = 0x0;
-  uint8_t st_info = 0x0;
-  uint8_t st_other = 0x0;
-  uint16_t st_shndx = 0x0;
-
-  // skip the first NULL symbol
-  pInput.context()->addSymbol(LDSymbol::Null());
-
-  /// recording symbols added from DynObj to analyze weak alias
-  std::vector<AliasInfo> potential_aliases;
-  bool is_dyn_obj = (pInput.type() == Input::DynObj);
-  for (size_t idx = 1; idx < entsize; ++idx) {
-    st_info = symtab[idx].st_info;
-    st_other = symtab[idx].st_other;
+  std::vector<ParsedInput::Symbol> symbols(entsize);
+  for (size_t idx = 0; idx < entsize; ++idx) {
+    ParsedInput::Symbol& symbol = symbols[idx];
+    symbol.info = symtab[idx].st_info;
+    symbol.other = symtab[idx].st_other;
 
     if (llvm::sys::IsLittleEndianHost) {
-      st_name = symtab[idx].st_name;
-      st_value = symtab[idx].st_value;
-      st_size = symtab[idx].st_size;
-      st_shndx = symtab[idx].st_shndx;
+      symbol.name = symtab[idx].st_name;
+      symbol.value = symtab[idx].st_value;
+      symbol.size = symtab[idx].st_size;
+      symbol.shndx = symtab[idx].st_shndx;
     } else {
-      st_name = mcld::bswap32(symtab[idx].st_name);
-      st_value = mcld::bswap32(symtab[idx].st_value);
-      st_size = mcld::bswap32(symtab[idx].st_size);
-      st_shndx = mcld::bswap16(symtab[idx].st_shndx);
-    }
-
-    // If the section should not be included, set the st_shndx SHN_UNDEF
-    // - A section in interrelated groups are not included.
-    if (pInput.type() == Input::Object && st_shndx < llvm::ELF::SHN_LORESERVE &&
-        st_shndx != llvm::ELF::SHN_UNDEF) {
-      if (pInput.context()->getSection(st_shndx) == NULL)
-        st_shndx = llvm::ELF::SHN_UNDEF;
-    }
-
-    // get ld_type
-    ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
-
-    // get ld_desc
-    ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
-
-    // get ld_binding
-    ResolveInfo::Binding ld_binding =
-        getSymBinding((st_info >> 4), st_shndx, st_other);
-
-    // get ld_value - ld_value must be section relative.
-    uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
-
-    // get ld_vis
-    ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
-
-    // get section
-    LDSection* section = NULL;
-    if (st_shndx < llvm::ELF::SHN_LORESERVE)  // including ABS and COMMON
-      section = pInput.context()->getSection(st_shndx);
-
-    // get ld_name
-    std::string ld_name;
-    if (ResolveInfo::Section == ld_type) {
-      // Section symbol's st_name is the section index.
-      assert(section != NULL && "get a invalid section");
-      ld_name = section->name();
-    } else {
-      ld_name = std::string(pStrTab + st_name);
-    }
-
-    LDSymbol* psym = pBuilder.AddSymbol(pInput,
-                                        ld_name,
-                                        ld_type,
-                                        ld_desc,
-                                        ld_binding,
-                                        st_size,
-                                        ld_value,
-                                        section,
-                                        ld_vis);
-
-    if (is_dyn_obj && psym != NULL && ResolveInfo::Undefined != ld_desc &&
-        (ResolveInfo::Global == ld_binding ||
-         ResolveInfo::Weak == ld_binding) &&
-        ResolveInfo::Object == ld_type) {
-      AliasInfo p;
-      p.pt_alias = psym;
-      p.ld_binding = ld_binding;
-      p.ld_value = ld_value;
-      potential_aliases.push_back(p);
+      symbol.name = mcld::bswap32(symtab[idx].st_name);
+      symbol.value = mcld::bswap32(symtab[idx].st_value);
+      symbol.size = mcld::bswap32(symtab[idx].st_size);
+      symbol.shndx = mcld::bswap16(symtab[idx].st_shndx);
     }
-  }  // end of for loop
-
-  // analyze weak alias
-  // FIXME: it is better to let IRBuilder handle alias anlysis.
-  //        1. eliminate code duplication
-  //        2. easy to know if a symbol is from .so
-  //           (so that it may be a potential alias)
-  if (is_dyn_obj) {
-    // sort symbols by symbol value and then weak before strong
-    std::sort(potential_aliases.begin(), potential_aliases.end(), less);
-
-    // for each weak symbol, find out all its aliases, and
-    // then link them as a circular list in Module
-    std::vector<AliasInfo>::iterator sym_it, sym_e;
-    sym_e = potential_aliases.end();
-    for (sym_it = potential_aliases.begin(); sym_it != sym_e; ++sym_it) {
-      if (ResolveInfo::Weak != sym_it->ld_binding)
-        continue;
-
-      Module& pModule = pBuilder.getModule();
-      std::vector<AliasInfo>::iterator alias_it = sym_it + 1;
-      while (alias_it != sym_e) {
-        if (sym_it->ld_value != alias_it->ld_value)
-          break;
-
-        if (sym_it + 1 == alias_it)
-          pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
-        pModule.addAlias(*alias_it->pt_alias->resolveInfo());
-        ++alias_it;
-      }
-
-      sym_it = alias_it - 1;
-    }  // end of for loop
   }
-
-  return true;
+  return createSymbols(pInput, pBuilder, symbols, pStrTab);
 }
 
 //===----------------------------------------------------------------------===//
@@ -302,6 +257,10 @@ Input::Type ELFReader<32, true>::fileType(const void* pELFHeader) const {
 /// readSectionHeaders - read ELF section header table and create LDSections
 bool ELFReader<32, true>::readSectionHeaders(Input& pInput,
                                              const void* pELFHeader) const {
+  // a link server has parsed the table already
+  if (const ParsedInput::Object* parsed = getParsed(pInput))
+    return createSections(pInput, *parsed);
+
   const llvm::ELF::Elf32_Ehdr* ehdr =
       reinterpret_cast<const llvm::ELF::Elf32_Ehdr*>(pELFHeader);
 
@@ -556,6 +515,10 @@ bool ELFReader<64, true>::readRegularSection(Input& pInput,
   uint64_t offset = pInput.fileOffset() + pSD.getSection().offset();
   uint64_t size = pSD.getSection().size();
 
+  if ((pSD.getSection().flag() & ELF::SHF_COMPRESSED) != 0)
+    return ReadCompressedSection<64>(
+        pInput, offset, pSD, !llvm::sys::IsLittleEndianHost);
+
   Fragment* frag = IRBuilder::CreateRegion(pInput, offset, size);
   ObjectBuilder::AppendFragment(*frag, pSD);
   return true;
@@ -571,125 +534,25 @@ bool ELFReader<64, true>::readSymbols(Input& pInput,
   const llvm::ELF::Elf64_Sym* symtab =
       reinterpret_cast<const llvm::ELF::Elf64_Sym*>(pRegion.begin());
 
-  uint32_t st_name = 0x0;
-  uint64_t st_value = 0x0;
-  uint64_t st_size = 0x0;
-  uint8_t st_info = 0x0;
-  uint8_t st_other = 0x0;
-  uint16_t st_shndx = 0x0;
-
-  // skip the first NULL symbol
-  pInput.context()->addSymbol(LDSymbol::Null());
-
-  /// recording symbols added from DynObj to analyze weak alias
-  std::vector<AliasInfo> potential_aliases;
-  bool is_dyn_obj = (pInput.type() == Input::DynObj);
-  for (size_t idx = 1; idx < entsize; ++idx) {
-    st_info = symtab[idx].st_info;
-    st_other = symtab[idx].st_other;
+  std::vector<ParsedInput::Symbol> symbols(entsize);
+  for (size_t idx = 0; idx < entsize; ++idx) {
+    ParsedInput::Symbol& symbol = symbols[idx];
+    symbol.info = symtab[idx].st_info;
+    symbol.other = symtab[idx].st_other;
 
     if (llvm::sys::IsLittleEndianHost) {
-      st_name = symtab[idx].st_name;
-      st_value = symtab[idx].st_value;
-      st_size = symtab[idx].st_size;
-      st_shndx = symtab[idx].st_shndx;
-    } else {
-      st_name = mcld::bswap32(symtab[idx].st_name);
-      st_value = mcld::bswap64(symtab[idx].st_value);
-      st_size = mcld::bswap64(symtab[idx].st_size);
-      st_shndx = mcld::bswap16(symtab[idx].st_shndx);
-    }
-
-    // If the section should not be included, set the st_shndx SHN_UNDEF
-    // - A section in interrelated groups are not included.
-    if (pInput.type() == Input::Object && st_shndx < llvm::ELF::SHN_LORESERVE &&
-        st_shndx != llvm::ELF::SHN_UNDEF) {
-      if (pInput.context()->getSection(st_shndx) == NULL)
-        st_shndx = llvm::ELF::SHN_UNDEF;
-    }
-
-    // get ld_type
-    ResolveInfo::Type ld_type = getSymType(st_info, st_shndx);
-
-    // get ld_desc
-    ResolveInfo::Desc ld_desc = getSymDesc(st_shndx, pInput);
-
-    // get ld_binding
-    ResolveInfo::Binding ld_binding =
-        getSymBinding((st_info >> 4), st_shndx, st_other);
-
-    // get ld_value - ld_value must be section relative.
-    uint64_t ld_value = getSymValue(st_value, st_shndx, pInput);
-
-    // get ld_vis
-    ResolveInfo::Visibility ld_vis = getSymVisibility(st_other);
-
-    // get section
-    LDSection* section = NULL;
-    if (st_shndx < llvm::ELF::SHN_LORESERVE)  // including ABS and COMMON
-      section = pInput.context()->getSection(st_shndx);
-
-    // get ld_name
-    std::string ld_name;
-    if (ResolveInfo::Section == ld_type) {
-      // Section symbol's st_name is the section index.
-      assert(section != NULL && "get a invalid section");
-      ld_name = section->name();
+      symbol.name = symtab[idx].st_name;
+      symbol.value = symtab[idx].st_value;
+      symbol.size = symtab[idx].st_size;
+      symbol.shndx = symtab[idx].st_shndx;
     } else {
-      ld_name = std::string(pStrTab + st_name);
-    }
-
-    LDSymbol* psym = pBuilder.AddSymbol(pInput,
-                                        ld_name,
-                                        ld_type,
-                                        ld_desc,
-                                        ld_binding,
-                                        st_size,
-                                        ld_value,
-                                        section,
-                                        ld_vis);
-
-    if (is_dyn_obj && psym != NULL && ResolveInfo::Undefined != ld_desc &&
-        (ResolveInfo::Global == ld_binding ||
-         ResolveInfo::Weak == ld_binding) &&
-        ResolveInfo::Object == ld_type) {
-      AliasInfo p;
-      p.pt_alias = psym;
-      p.ld_binding = ld_binding;
-      p.ld_value = ld_value;
-      potential_aliases.push_back(p);
+      symbol.name = mcld::bswap32(symtab[idx].st_name);
+      symbol.value = mcld::bswap64(symtab[idx].st_value);
+      symbol.size = mcld::bswap64(symtab[idx].st_size);
+      symbol.shndx = mcld::bswap16(symtab[idx].st_shndx);
     }
-  }  // end of for loop
-
-  // analyze weak alias here
-  if (is_dyn_obj) {
-    // sort symbols by symbol value and then weak before strong
-    std::sort(potential_aliases.begin(), potential_aliases.end(), less);
-
-    // for each weak symbol, find out all its aliases, and
-    // then link them as a circular list in Module
-    std::vector<AliasInfo>::iterator sym_it, sym_e;
-    sym_e = potential_aliases.end();
-    for (sym_it = potential_aliases.begin(); sym_it != sym_e; ++sym_it) {
-      if (ResolveInfo::Weak != sym_it->ld_binding)
-        continue;
-
-      Module& pModule = pBuilder.getModule();
-      std::vector<AliasInfo>::iterator alias_it = sym_it + 1;
-      while (alias_it != sym_e) {
-        if (sym_it->ld_value != alias_it->ld_value)
-          break;
-
-        if (sym_it + 1 == alias_it)
-          pModule.CreateAliasList(*sym_it->pt_alias->resolveInfo());
-        pModule.addAlias(*alias_it->pt_alias->resolveInfo());
-        ++alias_it;
-      }
-
-      sym_it = alias_it - 1;
-    }  // end of for loop
   }
-  return true;
+  return createSymbols(pInput, pBuilder, symbols, pStrTab);
 }
 
 //===----------------------------------------------------------------------===//
@@ -796,6 +659,10 @@ Input::Type ELFReader<64, true>::fileType(const void* pELFHeader) const {
 /// readSectionHeaders - read ELF section header table and create LDSections
 bool ELFReader<64, true>::readSectionHeaders(Input& pInput,
                                              const void* pELFHeader) const {
+  // a link server has parsed the table already
+  if (const ParsedInput::Object* parsed = getParsed(pInput))
+    return createSections(pInput, *parsed);
+
   const llvm::ELF::Elf64_Ehdr* ehdr =
       reinterpret_cast<const llvm::ELF::Elf64_Ehdr*>(pELFHeader);
 
@@ -11,15 +11,17 @@
 #include "mcld/Config/Config.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 #include <cassert>
 
 namespace mcld {
 
-typedef GCFactory<ELFSegment, MCLD_SEGMENTS_PER_OUTPUT> ELFSegmentFactory;
-static llvm::ManagedStatic<ELFSegmentFactory> g_ELFSegmentFactory;
+typedef ArenaGCFactory<ELFSegment, MCLD_SEGMENTS_PER_OUTPUT> ELFSegmentFactory;
+static inline ELFSegmentFactory& CurrentELFSegmentFactory() {
+  return LinkContext::current().get<ELFSegmentFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // ELFSegment
@@ -82,19 +84,19 @@ void ELFSegment::append(LDSection* pSection) {
 }
 
 ELFSegment* ELFSegment::Create(uint32_t pType, uint32_t pFlag) {
-  ELFSegment* seg = g_ELFSegmentFactory->allocate();
+  ELFSegment* seg = CurrentELFSegmentFactory().allocate();
   new (seg) ELFSegment(pType, pFlag);
   return seg;
 }
 
 void ELFSegment::Destroy(ELFSegment*& pSegment) {
-  g_ELFSegmentFactory->destroy(pSegment);
-  g_ELFSegmentFactory->deallocate(pSegment);
+  CurrentELFSegmentFactory().destroy(pSegment);
+  CurrentELFSegmentFactory().deallocate(pSegment);
   pSegment = NULL;
 }
 
 void ELFSegment::Clear() {
-  g_ELFSegmentFactory->clear();
+  CurrentELFSegmentFactory().clear();
 }
 
 }  // namespace mcld
@@ -18,14 +18,16 @@
 #include "mcld/MC/Input.h"
 #include "mcld/Object/ObjectBuilder.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-typedef GCFactory<EhFrame, MCLD_SECTIONS_PER_INPUT> EhFrameFactory;
+typedef ArenaGCFactory<EhFrame, MCLD_SECTIONS_PER_INPUT> EhFrameFactory;
 
-static llvm::ManagedStatic<EhFrameFactory> g_EhFrameFactory;
+static inline EhFrameFactory& CurrentEhFrameFactory() {
+  return LinkContext::current().get<EhFrameFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // EhFrame::Record
@@ -101,19 +103,19 @@ EhFrame::~EhFrame() {
 }
 
 EhFrame* EhFrame::Create(LDSection& pSection) {
-  EhFrame* result = g_EhFrameFactory->allocate();
+  EhFrame* result = CurrentEhFrameFactory().allocate();
   new (result) EhFrame(pSection);
   return result;
 }
 
 void EhFrame::Destroy(EhFrame*& pSection) {
   pSection->~EhFrame();
-  g_EhFrameFactory->deallocate(pSection);
+  CurrentEhFrameFactory().deallocate(pSection);
   pSection = NULL;
 }
 
 void EhFrame::Clear() {
-  g_EhFrameFactory->clear();
+  CurrentEhFrameFactory().clear();
 }
 
 const LDSection& EhFrame::getSection() const {
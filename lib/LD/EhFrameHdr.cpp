@@ -10,27 +10,44 @@
 
 #include "mcld/LD/EhFrame.h"
 #include "mcld/LD/LDSection.h"
+#include "mcld/Support/Parallel.h"
 
 #include <llvm/Support/Dwarf.h>
 #include <llvm/Support/DataTypes.h>
 
 #include <algorithm>
 #include <cstring>
+#include <vector>
 
 namespace mcld {
 
 //===----------------------------------------------------------------------===//
 // Helper Function
 //===----------------------------------------------------------------------===//
-namespace bit32 {
+namespace {
 
-typedef std::pair<SizeTraits<32>::Address, SizeTraits<32>::Address> Entry;
+/// the minimum number of FDEs handed to one thread
+const size_t kMinFDEsPerThread = 4096;
 
-bool EntryCompare(const Entry& pX, const Entry& pY) {
-  return (pX.first < pY.first);
+/// An entry of the binary search table. The high word holds the biased
+/// offset of initial location from .eh_frame_hdr, so that comparing the
+/// high words gives the signed order of the offsets, and the low word holds
+/// the offset of the FDE.
+typedef uint64_t Entry;
+
+Entry makeEntry(uint32_t pPCOffset, uint32_t pFDEOffset) {
+  return (static_cast<Entry>(pPCOffset ^ 0x80000000u) << 32) | pFDEOffset;
+}
+
+uint32_t getPCOffset(Entry pEntry) {
+  return static_cast<uint32_t>(pEntry >> 32) ^ 0x80000000u;
 }
 
-}  // namespace bit32
+uint32_t getFDEOffset(Entry pEntry) {
+  return static_cast<uint32_t>(pEntry);
+}
+
+}  // anonymous namespace
 
 //===----------------------------------------------------------------------===//
 // Template Specification Functions
@@ -38,24 +55,62 @@ bool EntryCompare(const Entry& pX, const Entry& pY) {
 /// emitOutput<32> - write out eh_frame_hdr
 template <>
 void EhFrameHdr::emitOutput<32>(FileOutputBuffer& pOutput) {
-  MemoryRegion ehframehdr_region =
-      pOutput.request(m_EhFrameHdr.offset(), m_EhFrameHdr.size());
+  emitTable<32>(pOutput);
+}
 
-  MemoryRegion ehframe_region =
-      pOutput.request(m_EhFrame.offset(), m_EhFrame.size());
+/// emitOutput<64> - write out eh_frame_hdr
+template <>
+void EhFrameHdr::emitOutput<64>(FileOutputBuffer& pOutput) {
+  emitTable<64>(pOutput);
+}
+
+//===----------------------------------------------------------------------===//
+// EhFrameHdr
+//===----------------------------------------------------------------------===//
 
-  uint8_t* data = ehframehdr_region.begin();
+EhFrameHdr::EhFrameHdr(LDSection& pEhFrameHdr,
+                       const LDSection& pEhFrame,
+                       unsigned pNumThreads)
+    : m_EhFrameHdr(pEhFrameHdr),
+      m_EhFrame(pEhFrame),
+      m_NumThreads(pNumThreads) {
+}
+
+EhFrameHdr::~EhFrameHdr() {
+}
+
+/// @ref lsb core generic 4.1
+/// .eh_frame_hdr section format
+/// uint8_t : version
+/// uint8_t : eh_frame_ptr_enc
+/// uint8_t : fde_count_enc
+/// uint8_t : table_enc
+/// uint32_t : eh_frame_ptr
+/// uint32_t : fde_count
+/// __________________________ when fde_count > 0
+/// <uint32_t, uint32_t>+ : binary search table
+/// sizeOutput - base on the fde count to size output
+void EhFrameHdr::sizeOutput() {
+  size_t size = 12;
+  if (m_EhFrame.hasEhFrame())
+    size += 8 * m_EhFrame.getEhFrame()->numOfFDEs();
+  m_EhFrameHdr.setSize(size);
+}
+
+/// emitHeader - write out the fixed fields of eh_frame_hdr
+/// @return the number of entries in the binary search table
+size_t EhFrameHdr::emitHeader(uint8_t* pData) {
   // version
-  data[0] = 1;
+  pData[0] = 1;
   // eh_frame_ptr_enc
-  data[1] = llvm::dwarf::DW_EH_PE_pcrel | llvm::dwarf::DW_EH_PE_sdata4;
+  pData[1] = llvm::dwarf::DW_EH_PE_pcrel | llvm::dwarf::DW_EH_PE_sdata4;
 
   // eh_frame_ptr
-  uint32_t* eh_frame_ptr = reinterpret_cast<uint32_t*>(data + 4);
+  uint32_t* eh_frame_ptr = reinterpret_cast<uint32_t*>(pData + 4);
   *eh_frame_ptr = m_EhFrame.addr() - (m_EhFrameHdr.addr() + 4);
 
   // fde_count
-  uint32_t* fde_count = reinterpret_cast<uint32_t*>(data + 8);
+  uint32_t* fde_count = reinterpret_cast<uint32_t*>(pData + 8);
   if (m_EhFrame.hasEhFrame())
     *fde_count = m_EhFrame.getEhFrame()->numOfFDEs();
   else
@@ -63,93 +118,147 @@ void EhFrameHdr::emitOutput<32>(FileOutputBuffer& pOutput) {
 
   if (*fde_count == 0) {
     // fde_count_enc
-    data[2] = llvm::dwarf::DW_EH_PE_omit;
+    pData[2] = llvm::dwarf::DW_EH_PE_omit;
     // table_enc
-    data[3] = llvm::dwarf::DW_EH_PE_omit;
+    pData[3] = llvm::dwarf::DW_EH_PE_omit;
   } else {
     // fde_count_enc
-    data[2] = llvm::dwarf::DW_EH_PE_udata4;
+    pData[2] = llvm::dwarf::DW_EH_PE_udata4;
     // table_enc
-    data[3] = llvm::dwarf::DW_EH_PE_datarel | llvm::dwarf::DW_EH_PE_sdata4;
-
-    // prepare the binary search table
-    typedef std::vector<bit32::Entry> SearchTableType;
-    SearchTableType search_table;
-
-    for (EhFrame::const_cie_iterator i = m_EhFrame.getEhFrame()->cie_begin(),
-                                     e = m_EhFrame.getEhFrame()->cie_end();
-         i != e;
-         ++i) {
-      EhFrame::CIE& cie = **i;
-      for (EhFrame::const_fde_iterator fi = cie.begin(), fe = cie.end();
-           fi != fe;
-           ++fi) {
-        EhFrame::FDE& fde = **fi;
-        SizeTraits<32>::Offset offset;
-        SizeTraits<32>::Address fde_pc;
-        SizeTraits<32>::Address fde_addr;
-        offset = fde.getOffset();
-        fde_pc = computePCBegin(fde, ehframe_region);
-        fde_addr = m_EhFrame.addr() + offset;
-        search_table.push_back(std::make_pair(fde_pc, fde_addr));
-      }
-    }
+    pData[3] = llvm::dwarf::DW_EH_PE_datarel | llvm::dwarf::DW_EH_PE_sdata4;
+  }
+  return *fde_count;
+}
 
-    std::sort(search_table.begin(), search_table.end(), bit32::EntryCompare);
+/// emitTable - write out eh_frame_hdr for a SIZE-bit target
+template <size_t SIZE>
+void EhFrameHdr::emitTable(FileOutputBuffer& pOutput) {
+  MemoryRegion ehframehdr_region =
+      pOutput.request(m_EhFrameHdr.offset(), m_EhFrameHdr.size());
 
-    // write out the binary search table
-    uint32_t* bst = reinterpret_cast<uint32_t*>(data + 12);
-    SearchTableType::const_iterator entry, entry_end = search_table.end();
-    size_t id = 0;
-    for (entry = search_table.begin(); entry != entry_end; ++entry) {
-      bst[id++] = (*entry).first - m_EhFrameHdr.addr();
-      bst[id++] = (*entry).second - m_EhFrameHdr.addr();
-    }
+  MemoryRegion ehframe_region =
+      pOutput.request(m_EhFrame.offset(), m_EhFrame.size());
+
+  size_t fde_count = emitHeader(ehframehdr_region.begin());
+  if (fde_count != 0) {
+    uint32_t* bst = reinterpret_cast<uint32_t*>(ehframehdr_region.begin() + 12);
+    emitSearchTable<SIZE>(bst, fde_count, ehframe_region);
   }
 }
 
-//===----------------------------------------------------------------------===//
-// EhFrameHdr
-//===----------------------------------------------------------------------===//
+/// emitSearchTable - fill the binary search table of eh_frame_hdr. The
+/// initial locations are decoded from the output .eh_frame in parallel, and
+/// the table is then radix sorted by the offsets of the initial locations.
+template <size_t SIZE>
+void EhFrameHdr::emitSearchTable(uint32_t* pTable,
+                                 size_t pNumOfFDEs,
+                                 const MemoryRegion& pEhFrameRegion) const {
+  typedef typename SizeTraits<SIZE>::Address Address;
 
-EhFrameHdr::EhFrameHdr(LDSection& pEhFrameHdr, const LDSection& pEhFrame)
-    : m_EhFrameHdr(pEhFrameHdr), m_EhFrame(pEhFrame) {
-}
+  // The number of CIEs is usually small, so collecting the FDEs is cheap.
+  std::vector<const EhFrame::FDE*> fdes;
+  fdes.reserve(pNumOfFDEs);
+  for (EhFrame::const_cie_iterator i = m_EhFrame.getEhFrame()->cie_begin(),
+                                   e = m_EhFrame.getEhFrame()->cie_end();
+       i != e;
+       ++i) {
+    const EhFrame::CIE& cie = **i;
+    fdes.insert(fdes.end(), cie.begin(), cie.end());
+  }
+  assert(fdes.size() == pNumOfFDEs);
 
-EhFrameHdr::~EhFrameHdr() {
+  // prepare the binary search table
+  const Address hdr_addr = m_EhFrameHdr.addr();
+  const Address ehframe_addr = m_EhFrame.addr();
+  std::vector<Entry> search_table(pNumOfFDEs);
+  parallel::forEach(m_NumThreads, pNumOfFDEs, kMinFDEsPerThread,
+      [&](size_t pIdx) {
+        const EhFrame::FDE& fde = *fdes[pIdx];
+        Address fde_pc = computePCBegin<SIZE>(fde, pEhFrameRegion);
+        Address fde_addr = ehframe_addr + fde.getOffset();
+        search_table[pIdx] =
+            makeEntry(static_cast<uint32_t>(fde_pc - hdr_addr),
+                      static_cast<uint32_t>(fde_addr - hdr_addr));
+      });
+
+  std::vector<Entry> buffer(pNumOfFDEs);
+  radixSort(search_table, buffer, m_NumThreads);
+
+  // write out the binary search table
+  parallel::forEach(m_NumThreads, pNumOfFDEs, kMinFDEsPerThread,
+      [pTable, &search_table](size_t pIdx) {
+        pTable[2 * pIdx] = getPCOffset(search_table[pIdx]);
+        pTable[2 * pIdx + 1] = getFDEOffset(search_table[pIdx]);
+      });
 }
 
-/// @ref lsb core generic 4.1
-/// .eh_frame_hdr section format
-/// uint8_t : version
-/// uint8_t : eh_frame_ptr_enc
-/// uint8_t : fde_count_enc
-/// uint8_t : table_enc
-/// uint32_t : eh_frame_ptr
-/// uint32_t : fde_count
-/// __________________________ when fde_count > 0
-/// <uint32_t, uint32_t>+ : binary search table
-/// sizeOutput - base on the fde count to size output
-void EhFrameHdr::sizeOutput() {
-  size_t size = 12;
-  if (m_EhFrame.hasEhFrame())
-    size += 8 * m_EhFrame.getEhFrame()->numOfFDEs();
-  m_EhFrameHdr.setSize(size);
+/// radixSort - stable LSD radix sort of pEntries by their high words. Each
+/// pass builds per-thread histograms of one byte of the key and scatters the
+/// entries of every thread into their own disjoint slots of pBuffer. Passes
+/// whose byte is identical in every entry, e.g., the top bytes of offsets in
+/// a small image, are skipped.
+void EhFrameHdr::radixSort(std::vector<uint64_t>& pEntries,
+                           std::vector<uint64_t>& pBuffer,
+                           unsigned pNumThreads) {
+  const size_t size = pEntries.size();
+  const size_t chunks =
+      parallel::numOfChunks(pNumThreads, size, kMinFDEsPerThread);
+  std::vector<size_t> counts(chunks * 256);
+
+  for (unsigned shift = 32; shift < 64; shift += 8) {
+    std::fill(counts.begin(), counts.end(), 0);
+    parallel::forEachChunk(pNumThreads, size, kMinFDEsPerThread,
+        [&pEntries, &counts, shift](size_t pChunk, size_t pBegin, size_t pEnd) {
+          size_t* count = &counts[pChunk * 256];
+          for (size_t i = pBegin; i != pEnd; ++i)
+            ++count[(pEntries[i] >> shift) & 0xff];
+        });
+
+    // exclusive prefix sums in (digit, chunk) order keep the sort stable
+    size_t offset = 0;
+    bool trivial = false;
+    for (size_t digit = 0; digit < 256; ++digit) {
+      size_t total = 0;
+      for (size_t chunk = 0; chunk < chunks; ++chunk) {
+        size_t num = counts[chunk * 256 + digit];
+        counts[chunk * 256 + digit] = offset;
+        offset += num;
+        total += num;
+      }
+      if (total == size)
+        trivial = true;
+    }
+    if (trivial)
+      continue;
+
+    parallel::forEachChunk(pNumThreads, size, kMinFDEsPerThread,
+        [&pEntries, &pBuffer, &counts, shift](size_t pChunk,
+                                              size_t pBegin,
+                                              size_t pEnd) {
+          size_t* pos = &counts[pChunk * 256];
+          for (size_t i = pBegin; i != pEnd; ++i)
+            pBuffer[pos[(pEntries[i] >> shift) & 0xff]++] = pEntries[i];
+        });
+    pEntries.swap(pBuffer);
+  }
 }
 
 /// computePCBegin - return the address of FDE's pc
-uint32_t EhFrameHdr::computePCBegin(const EhFrame::FDE& pFDE,
-                                    const MemoryRegion& pEhFrameRegion) {
+template <size_t SIZE>
+typename SizeTraits<SIZE>::Address EhFrameHdr::computePCBegin(
+    const EhFrame::FDE& pFDE,
+    const MemoryRegion& pEhFrameRegion) const {
+  typedef typename SizeTraits<SIZE>::Address Address;
+
   uint8_t fde_encoding = pFDE.getCIE().getFDEEncode();
   unsigned int eh_value = fde_encoding & 0x7;
 
   // check the size to read in
-  if (eh_value == llvm::dwarf::DW_EH_PE_absptr) {
-    eh_value = llvm::dwarf::DW_EH_PE_udata4;
-  }
-
   size_t pc_size = 0x0;
   switch (eh_value) {
+    case llvm::dwarf::DW_EH_PE_absptr:
+      pc_size = SIZE / 8;
+      break;
     case llvm::dwarf::DW_EH_PE_udata2:
       pc_size = 2;
       break;
@@ -164,23 +273,27 @@ uint32_t EhFrameHdr::computePCBegin(const EhFrame::FDE& pFDE,
       break;
   }
 
-  SizeTraits<32>::Address pc = 0x0;
-  const uint8_t* offset = (const uint8_t*)pEhFrameRegion.begin() +
-                          pFDE.getOffset() + EhFrame::getDataStartOffset<32>();
-  std::memcpy(&pc, offset, pc_size);
+  // .eh_frame uses the 32-bit DWARF format in both ELF classes.
+  const size_t data_offset =
+      pFDE.getOffset() + EhFrame::getDataStartOffset<32>();
+
+  uint64_t value = 0x0;
+  std::memcpy(&value, pEhFrameRegion.begin() + data_offset, pc_size);
 
   // adjust the signed value
   bool is_signed = (fde_encoding & llvm::dwarf::DW_EH_PE_signed) != 0x0;
-  if (llvm::dwarf::DW_EH_PE_udata2 == eh_value && is_signed)
-    pc = (pc ^ 0x8000) - 0x8000;
+  if (is_signed && pc_size != 0 && pc_size < 8) {
+    uint64_t sign_bit = UINT64_C(1) << (pc_size * 8 - 1);
+    value = (value ^ sign_bit) - sign_bit;
+  }
+  Address pc = static_cast<Address>(value);
 
   // handle eh application
   switch (fde_encoding & 0x70) {
     case llvm::dwarf::DW_EH_PE_absptr:
       break;
     case llvm::dwarf::DW_EH_PE_pcrel:
-      pc += m_EhFrame.addr() + pFDE.getOffset() +
-            EhFrame::getDataStartOffset<32>();
+      pc += m_EhFrame.addr() + data_offset;
       break;
     case llvm::dwarf::DW_EH_PE_datarel:
       // TODO
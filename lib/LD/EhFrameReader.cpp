@@ -162,6 +162,13 @@ bool EhFrameReader::read<32, true>(Input& pInput, EhFrame& pEhFrame) {
   return true;
 }
 
+template <>
+bool EhFrameReader::read<64, true>(Input& pInput, EhFrame& pEhFrame) {
+  // 64-bit objects still use the 32-bit DWARF format for .eh_frame, so the
+  // CIEs and FDEs have the same layout as those in 32-bit objects.
+  return read<32, true>(pInput, pEhFrame);
+}
+
 bool EhFrameReader::addCIE(EhFrame& pEhFrame,
                            llvm::StringRef pRegion,
                            const EhFrameReader::Token& pToken) {
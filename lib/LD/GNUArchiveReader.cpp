@@ -15,6 +15,7 @@
 #include "mcld/MC/Attribute.h"
 #include "mcld/MC/Input.h"
 #include "mcld/LD/ELFObjectReader.h"
+#include "mcld/LD/ParsedInput.h"
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/Support/FileHandle.h"
 #include "mcld/Support/FileSystem.h"
@@ -273,6 +274,17 @@ bool GNUArchiveReader::readSymbolTable(Archive& pArchive) {
   pArchive.setSymTabSize(symtab_size);
 
   if (!pArchive.getARFile().attribute()->isWholeArchive()) {
+    // a link server has decoded the symbol index already
+    const ParsedInput* parsed = memory_area->parsed();
+    if (parsed != NULL && parsed->hasArchiveSymbols() &&
+        pArchive.getARFile().fileOffset() == 0x0) {
+      const std::vector<ParsedInput::ArchiveSymbol>& symbols =
+          parsed->archiveSymbols();
+      for (size_t i = 0; i < symbols.size(); ++i)
+        pArchive.addSymbol(symbols[i].name.c_str(), symbols[i].fileOffset);
+      return true;
+    }
+
     llvm::StringRef symtab_region = memory_area->request(
         (pArchive.getARFile().fileOffset() + Archive::MAGIC_LEN +
          sizeof(Archive::MemberHeader)),
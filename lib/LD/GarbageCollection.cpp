@@ -107,7 +107,7 @@ GarbageCollection::~GarbageCollection() {
 bool GarbageCollection::run() {
   // 1. traverse all the relocations to set up the reached sections of each
   // section
-  setUpReachedSections();
+  setUpReachedSections(m_Module, m_SectionReachedListMap);
   m_Backend.setUpReachedSectionsForGC(m_Module, m_SectionReachedListMap);
 
   // 2. get all sections defined the entry point
@@ -122,10 +122,11 @@ bool GarbageCollection::run() {
   return true;
 }
 
-void GarbageCollection::setUpReachedSections() {
+void GarbageCollection::setUpReachedSections(Module& pModule,
+                                             SectionReachedListMap& pMap) {
   // traverse all the input relocations to setup the reached sections
-  Module::obj_iterator input, inEnd = m_Module.obj_end();
-  for (input = m_Module.obj_begin(); input != inEnd; ++input) {
+  Module::obj_iterator input, inEnd = pModule.obj_end();
+  for (input = pModule.obj_begin(); input != inEnd; ++input) {
     LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
     for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
       // bypass the discarded relocation section
@@ -167,7 +168,7 @@ void GarbageCollection::setUpReachedSections() {
         // setup the reached list, if we first add the element to reached list
         // of this section, create an entry in ReachedSections map
         if (!add_first) {
-          reached_sects = &m_SectionReachedListMap.getReachedList(*apply_sect);
+          reached_sects = &pMap.getReachedList(*apply_sect);
           add_first = true;
         }
         reached_sects->insert(target_sect);
@@ -9,14 +9,16 @@
 #include "mcld/LD/LDSection.h"
 
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-typedef GCFactory<LDSection, MCLD_SECTIONS_PER_INPUT> SectionFactory;
+typedef ArenaGCFactory<LDSection, MCLD_SECTIONS_PER_INPUT> SectionFactory;
 
-static llvm::ManagedStatic<SectionFactory> g_SectFactory;
+static inline SectionFactory& CurrentSectFactory() {
+  return LinkContext::current().get<SectionFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // LDSection
@@ -69,19 +71,19 @@ LDSection* LDSection::Create(const std::string& pName,
                              uint32_t pFlag,
                              uint64_t pSize,
                              uint64_t pAddr) {
-  LDSection* result = g_SectFactory->allocate();
+  LDSection* result = CurrentSectFactory().allocate();
   new (result) LDSection(pName, pKind, pType, pFlag, pSize, pAddr);
   return result;
 }
 
 void LDSection::Destroy(LDSection*& pSection) {
-  g_SectFactory->destroy(pSection);
-  g_SectFactory->deallocate(pSection);
+  CurrentSectFactory().destroy(pSection);
+  CurrentSectFactory().deallocate(pSection);
   pSection = NULL;
 }
 
 void LDSection::Clear() {
-  g_SectFactory->clear();
+  CurrentSectFactory().clear();
 }
 
 bool LDSection::hasSectionData() const {
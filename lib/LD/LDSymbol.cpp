@@ -12,18 +12,23 @@
 #include "mcld/Fragment/FragmentRef.h"
 #include "mcld/Fragment/NullFragment.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 
 #include <llvm/Support/ManagedStatic.h>
 
 #include <cstring>
+#include <mutex>
 
 namespace mcld {
 
-typedef GCFactory<LDSymbol, MCLD_SYMBOLS_PER_INPUT> LDSymbolFactory;
+typedef ArenaGCFactory<LDSymbol, MCLD_SYMBOLS_PER_INPUT> LDSymbolFactory;
 
 static llvm::ManagedStatic<LDSymbol> g_NullSymbol;
 static llvm::ManagedStatic<NullFragment> g_NullSymbolFragment;
-static llvm::ManagedStatic<LDSymbolFactory> g_LDSymbolFactory;
+static std::once_flag g_NullSymbolFlag;
+static inline LDSymbolFactory& CurrentLDSymbolFactory() {
+  return LinkContext::current().get<LDSymbolFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // LDSymbol
@@ -48,7 +53,7 @@ LDSymbol& LDSymbol::operator=(const LDSymbol& pCopy) {
 }
 
 LDSymbol* LDSymbol::Create(ResolveInfo& pResolveInfo) {
-  LDSymbol* result = g_LDSymbolFactory->allocate();
+  LDSymbol* result = CurrentLDSymbolFactory().allocate();
   new (result) LDSymbol();
   result->setResolveInfo(pResolveInfo);
   return result;
@@ -56,21 +61,23 @@ LDSymbol* LDSymbol::Create(ResolveInfo& pResolveInfo) {
 
 void LDSymbol::Destroy(LDSymbol*& pSymbol) {
   pSymbol->~LDSymbol();
-  g_LDSymbolFactory->deallocate(pSymbol);
+  CurrentLDSymbolFactory().deallocate(pSymbol);
   pSymbol = NULL;
 }
 
 void LDSymbol::Clear() {
-  g_LDSymbolFactory->clear();
+  CurrentLDSymbolFactory().clear();
 }
 
 LDSymbol* LDSymbol::Null() {
-  // lazy initialization
-  if (g_NullSymbol->resolveInfo() == NULL) {
+  // lazy initialization. The null symbol is shared by all links, so its
+  // fragment reference is taken from the global context.
+  std::call_once(g_NullSymbolFlag, []() {
+    LinkContext::Scope scope(LinkContext::global());
     g_NullSymbol->setResolveInfo(*ResolveInfo::Null());
     g_NullSymbol->setFragmentRef(FragmentRef::Create(*g_NullSymbolFragment, 0));
     ResolveInfo::Null()->setSymPtr(&*g_NullSymbol);
-  }
+  });
   return &*g_NullSymbol;
 }
 
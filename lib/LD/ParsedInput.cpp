@@ -0,0 +1,277 @@
+//===- ParsedInput.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/LD/ParsedInput.h"
+
+#include "mcld/ADT/SizeTraits.h"
+#include "mcld/LD/Archive.h"
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/ELF.h>
+#include <llvm/Support/Host.h>
+
+#include <cstring>
+
+namespace mcld {
+
+namespace {
+
+/// Decode - convert a field read from the file to host byte order
+inline uint16_t Decode(uint16_t pValue, bool pSwap) {
+  return pSwap ? mcld::bswap16(pValue) : pValue;
+}
+
+inline uint32_t Decode(uint32_t pValue, bool pSwap) {
+  return pSwap ? mcld::bswap32(pValue) : pValue;
+}
+
+inline uint64_t Decode(uint64_t pValue, bool pSwap) {
+  return pSwap ? mcld::bswap64(pValue) : pValue;
+}
+
+/// InRange - is [pOffset, pOffset + pLength) within pSize bytes
+inline bool InRange(uint64_t pOffset, uint64_t pLength, uint64_t pSize) {
+  return pOffset <= pSize && pLength <= pSize - pOffset;
+}
+
+/// ParseObject - decode the section table and the symbol table of the
+/// object at pData the way ELFReader<SIZE, true> reads them.
+template <size_t SIZE>
+bool ParseObject(const char* pData,
+                 size_t pSize,
+                 bool pSwap,
+                 ParsedInput::Object& pObject) {
+  typedef typename ELFSizeTraits<SIZE>::Ehdr Ehdr;
+  typedef typename ELFSizeTraits<SIZE>::Shdr Shdr;
+  typedef typename ELFSizeTraits<SIZE>::Sym Sym;
+
+  pObject.symtabOffset = 0;
+  pObject.symtabSize = 0;
+  if (pSize < sizeof(Ehdr))
+    return false;
+  Ehdr ehdr;
+  std::memcpy(&ehdr, pData, sizeof(Ehdr));
+
+  uint64_t shoff = Decode(ehdr.e_shoff, pSwap);
+  uint32_t shnum = Decode(ehdr.e_shnum, pSwap);
+  uint32_t shstrndx = Decode(ehdr.e_shstrndx, pSwap);
+  uint16_t type = Decode(ehdr.e_type, pSwap);
+
+  // If the file has no section header table, e_shoff holds zero.
+  if (shoff == 0x0)
+    return true;
+  if (Decode(ehdr.e_shentsize, pSwap) != sizeof(Shdr))
+    return false;
+
+  Shdr shdr;
+  // if shnum and shstrtab overflow, the actual values are in the 1st shdr
+  if (shnum == llvm::ELF::SHN_UNDEF || shstrndx == llvm::ELF::SHN_XINDEX) {
+    if (!InRange(shoff, sizeof(Shdr), pSize))
+      return false;
+    std::memcpy(&shdr, pData + shoff, sizeof(Shdr));
+    if (shnum == llvm::ELF::SHN_UNDEF)
+      shnum = Decode(shdr.sh_size, pSwap);
+    if (shstrndx == llvm::ELF::SHN_XINDEX)
+      shstrndx = Decode(shdr.sh_link, pSwap);
+    shoff += sizeof(Shdr);
+  }
+
+  if (shstrndx >= shnum ||
+      !InRange(shoff, static_cast<uint64_t>(shnum) * sizeof(Shdr), pSize))
+    return false;
+
+  // get .shstrtab first
+  std::memcpy(&shdr, pData + shoff + shstrndx * sizeof(Shdr), sizeof(Shdr));
+  uint64_t names_offset = Decode(shdr.sh_offset, pSwap);
+  uint64_t names_size = Decode(shdr.sh_size, pSwap);
+  if (!InRange(names_offset, names_size, pSize))
+    return false;
+  llvm::StringRef names(pData + names_offset, names_size);
+
+  const char* symtab_name = NULL;
+  if (llvm::ELF::ET_REL == type)
+    symtab_name = ".symtab";
+  else if (llvm::ELF::ET_DYN == type)
+    symtab_name = ".dynsym";
+
+  const ParsedInput::Section* symtab = NULL;
+  pObject.sections.resize(shnum);
+  for (uint32_t idx = 0; idx < shnum; ++idx) {
+    std::memcpy(&shdr, pData + shoff + idx * sizeof(Shdr), sizeof(Shdr));
+    ParsedInput::Section& section = pObject.sections[idx];
+    uint32_t name = Decode(shdr.sh_name, pSwap);
+    size_t end = names.find('\0', name);
+    if (name >= names.size() || end == llvm::StringRef::npos)
+      return false;
+    section.name = names.slice(name, end).str();
+    section.type = Decode(shdr.sh_type, pSwap);
+    section.flags = Decode(shdr.sh_flags, pSwap);
+    section.offset = Decode(shdr.sh_offset, pSwap);
+    section.size = Decode(shdr.sh_size, pSwap);
+    section.link = Decode(shdr.sh_link, pSwap);
+    section.info = Decode(shdr.sh_info, pSwap);
+    section.addralign = Decode(shdr.sh_addralign, pSwap);
+
+    // the readers look the table up by name, so take the first one
+    if (symtab == NULL && symtab_name != NULL && section.name == symtab_name)
+      symtab = &section;
+  }
+
+  if (symtab == NULL)
+    return true;
+  if (!InRange(symtab->offset, symtab->size, pSize))
+    return false;
+  pObject.symtabOffset = symtab->offset;
+  pObject.symtabSize = symtab->size;
+
+  Sym sym;
+  pObject.symbols.resize(symtab->size / sizeof(Sym));
+  for (size_t idx = 0; idx < pObject.symbols.size(); ++idx) {
+    std::memcpy(&sym, pData + symtab->offset + idx * sizeof(Sym), sizeof(Sym));
+    ParsedInput::Symbol& symbol = pObject.symbols[idx];
+    symbol.name = Decode(sym.st_name, pSwap);
+    symbol.info = sym.st_info;
+    symbol.other = sym.st_other;
+    symbol.shndx = Decode(sym.st_shndx, pSwap);
+    symbol.value = Decode(sym.st_value, pSwap);
+    symbol.size = Decode(sym.st_size, pSwap);
+  }
+  return true;
+}
+
+/// ParseArchiveSymbols - decode the armap with SIZE-bit big-endian offsets
+template <size_t SIZE>
+bool ParseArchiveSymbols(llvm::StringRef pRegion,
+                         std::vector<ParsedInput::ArchiveSymbol>& pSymbols) {
+  typedef typename SizeTraits<SIZE>::Offset Offset;
+
+  Offset number;
+  if (pRegion.size() < sizeof(Offset))
+    return false;
+  std::memcpy(&number, pRegion.data(), sizeof(Offset));
+  number = Decode(number, llvm::sys::IsLittleEndianHost);
+  if (number >= pRegion.size() / sizeof(Offset))
+    return false;
+
+  size_t names = (number + 1) * sizeof(Offset);
+  pSymbols.resize(number);
+  for (Offset i = 0; i < number; ++i) {
+    Offset offset;
+    std::memcpy(&offset, pRegion.data() + (i + 1) * sizeof(Offset),
+                sizeof(Offset));
+    size_t end = pRegion.find('\0', names);
+    if (end == llvm::StringRef::npos)
+      return false;
+    pSymbols[i].name = pRegion.slice(names, end).str();
+    pSymbols[i].fileOffset = Decode(offset, llvm::sys::IsLittleEndianHost);
+    names = end + 1;
+  }
+  return true;
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// ParsedInput
+//===----------------------------------------------------------------------===//
+ParsedInput::ParsedInput(const char* pData, size_t pSize)
+    : m_bHasArchiveSymbols(false) {
+  if (pSize >= Archive::MAGIC_LEN &&
+      (0 == memcmp(pData, Archive::MAGIC, Archive::MAGIC_LEN) ||
+       0 == memcmp(pData, Archive::THIN_MAGIC, Archive::MAGIC_LEN)))
+    parseArchive(pData, pSize);
+  else
+    parseObject(pData, pSize, 0x0);
+}
+
+ParsedInput::~ParsedInput() {
+}
+
+const ParsedInput::Object* ParsedInput::getObject(uint64_t pFileOffset) const {
+  ObjectMap::const_iterator object = m_Objects.find(pFileOffset);
+  if (object == m_Objects.end())
+    return NULL;
+  return &object->second;
+}
+
+void ParsedInput::parseArchive(const char* pData, size_t pSize) {
+  // the members of a thin archive are files of their own
+  bool thin = (0 == memcmp(pData, Archive::THIN_MAGIC, Archive::MAGIC_LEN));
+
+  uint64_t offset = Archive::MAGIC_LEN;
+  while (InRange(offset, sizeof(Archive::MemberHeader), pSize)) {
+    const Archive::MemberHeader* header =
+        reinterpret_cast<const Archive::MemberHeader*>(pData + offset);
+    if (0 != memcmp(header->fmag, Archive::MEMBER_MAGIC, sizeof(header->fmag)))
+      return;
+
+    uint64_t size = 0;
+    llvm::StringRef(header->size, sizeof(header->size))
+        .rtrim(' ')
+        .getAsInteger(10, size);
+    uint64_t data = offset + sizeof(Archive::MemberHeader);
+    llvm::StringRef name(header->name, sizeof(header->name));
+
+    // GNUArchiveReader reads the symbol index of the first member only
+    bool first = (Archive::MAGIC_LEN == offset);
+    bool symtab32 = name.startswith(Archive::SVR4_SYMTAB_NAME);
+    bool symtab64 = name.startswith(Archive::IRIX6_SYMTAB_NAME);
+    bool special =
+        symtab32 || symtab64 || name.startswith(Archive::STRTAB_NAME);
+    bool inline_data = !thin || special;
+    if (inline_data && !InRange(data, size, pSize))
+      return;
+
+    if (first && (symtab32 || symtab64)) {
+      llvm::StringRef region(pData + data, size);
+      m_bHasArchiveSymbols =
+          symtab32 ? ParseArchiveSymbols<32>(region, m_ArchiveSymbols)
+                   : ParseArchiveSymbols<64>(region, m_ArchiveSymbols);
+      if (!m_bHasArchiveSymbols)
+        m_ArchiveSymbols.clear();
+    } else if (inline_data && !special) {
+      // including the members with long names, "/<offset into //>"
+      parseObject(pData + data, size, data);
+    }
+
+    if (!inline_data)
+      size = 0;
+    offset = data + size + (size & 1);
+  }
+}
+
+void ParsedInput::parseObject(const char* pData,
+                              size_t pSize,
+                              uint64_t pFileOffset) {
+  if (pSize < llvm::ELF::EI_NIDENT ||
+      0 != memcmp(pData, llvm::ELF::ElfMagic, 4))
+    return;
+
+  bool swap;
+  switch (pData[llvm::ELF::EI_DATA]) {
+    case llvm::ELF::ELFDATA2LSB:
+      swap = !llvm::sys::IsLittleEndianHost;
+      break;
+    case llvm::ELF::ELFDATA2MSB:
+      swap = llvm::sys::IsLittleEndianHost;
+      break;
+    default:
+      return;
+  }
+
+  Object& object = m_Objects[pFileOffset];
+  bool parsed = false;
+  if (llvm::ELF::ELFCLASS32 == pData[llvm::ELF::EI_CLASS])
+    parsed = ParseObject<32>(pData, pSize, swap, object);
+  else if (llvm::ELF::ELFCLASS64 == pData[llvm::ELF::EI_CLASS])
+    parsed = ParseObject<64>(pData, pSize, swap, object);
+  if (!parsed)
+    m_Objects.erase(pFileOffset);
+}
+
+}  // namespace mcld
@@ -9,14 +9,16 @@
 #include "mcld/LD/RelocData.h"
 
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-typedef GCFactory<RelocData, MCLD_SECTIONS_PER_INPUT> RelocDataFactory;
+typedef ArenaGCFactory<RelocData, MCLD_SECTIONS_PER_INPUT> RelocDataFactory;
 
-static llvm::ManagedStatic<RelocDataFactory> g_RelocDataFactory;
+static inline RelocDataFactory& CurrentRelocDataFactory() {
+  return LinkContext::current().get<RelocDataFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // RelocData
@@ -28,19 +30,19 @@ RelocData::RelocData(LDSection& pSection) : m_pSection(&pSection) {
 }
 
 RelocData* RelocData::Create(LDSection& pSection) {
-  RelocData* result = g_RelocDataFactory->allocate();
+  RelocData* result = CurrentRelocDataFactory().allocate();
   new (result) RelocData(pSection);
   return result;
 }
 
 void RelocData::Destroy(RelocData*& pSection) {
   pSection->~RelocData();
-  g_RelocDataFactory->deallocate(pSection);
+  CurrentRelocDataFactory().deallocate(pSection);
   pSection = NULL;
 }
 
 void RelocData::Clear() {
-  g_RelocDataFactory->clear();
+  CurrentRelocDataFactory().clear();
 }
 
 RelocData& RelocData::append(Relocation& pRelocation) {
@@ -23,7 +23,8 @@ namespace mcld {
 // RelocationFactory
 //===----------------------------------------------------------------------===//
 RelocationFactory::RelocationFactory()
-    : GCFactory<Relocation, MCLD_RELOCATIONS_PER_INPUT>(), m_pConfig(NULL) {
+    : ArenaGCFactory<Relocation, MCLD_RELOCATIONS_PER_INPUT>(),
+      m_pConfig(NULL) {
 }
 
 void RelocationFactory::setConfig(const LinkerConfig& pConfig) {
@@ -28,6 +28,46 @@ namespace mcld {
 Relocator::~Relocator() {
 }
 
+void Relocator::applyRelocations(Type pType,
+                                 Relocation* const* pBegin,
+                                 Relocation* const* pEnd) {
+  for (Relocation* const* reloc = pBegin; reloc != pEnd; ++reloc) {
+    assert((*reloc)->type() == pType);
+    Result result = applyRelocation(**reloc);
+    if (result != OK)
+      reportResult(**reloc, result);
+  }
+}
+
+void Relocator::reportResult(const Relocation& pReloc, Result pResult) const {
+  switch (pResult) {
+    case OK: {
+      // do nothing
+      return;
+    }
+    case Overflow: {
+      error(diag::result_overflow) << getName(pReloc.type())
+                                   << pReloc.symInfo()->name();
+      return;
+    }
+    case BadReloc: {
+      error(diag::result_badreloc) << getName(pReloc.type())
+                                   << pReloc.symInfo()->name();
+      return;
+    }
+    case Unsupported: {
+      fatal(diag::unsupported_relocation) << pReloc.type()
+                                          << "mclinker@googlegroups.com";
+      return;
+    }
+    case Unknown: {
+      fatal(diag::unknown_relocation) << pReloc.type()
+                                      << pReloc.symInfo()->name();
+      return;
+    }
+  }  // end of switch
+}
+
 void Relocator::partialScanRelocation(Relocation& pReloc,
                                       Module& pModule) {
   // if we meet a section symbol
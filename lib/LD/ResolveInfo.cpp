@@ -16,11 +16,13 @@
 
 #include <cstdlib>
 #include <cstring>
+#include <mutex>
 
 namespace mcld {
 
-/// g_NullResolveInfo - a pointer to Null ResolveInfo.
+/// g_NullResolveInfo - a pointer to Null ResolveInfo, shared by all links.
 static ResolveInfo* g_NullResolveInfo = NULL;
+static std::once_flag g_NullResolveInfoFlag;
 
 //===----------------------------------------------------------------------===//
 // ResolveInfo
@@ -260,14 +262,14 @@ void ResolveInfo::Destroy(ResolveInfo*& pInfo) {
 }
 
 ResolveInfo* ResolveInfo::Null() {
-  if (g_NullResolveInfo == NULL) {
+  std::call_once(g_NullResolveInfoFlag, []() {
     g_NullResolveInfo =
         static_cast<ResolveInfo*>(malloc(sizeof(ResolveInfo) + 1));
     new (g_NullResolveInfo) ResolveInfo();
     g_NullResolveInfo->m_Name[0] = '\0';
     g_NullResolveInfo->m_BitField = 0x0;
     g_NullResolveInfo->setBinding(Local);
-  }
+  });
   return g_NullResolveInfo;
 }
 
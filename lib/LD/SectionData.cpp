@@ -8,40 +8,66 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/LD/SectionData.h"
 
+#include "mcld/Fragment/FragmentIndex.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-typedef GCFactory<SectionData, MCLD_SECTIONS_PER_INPUT> SectDataFactory;
+typedef ArenaGCFactory<SectionData, MCLD_SECTIONS_PER_INPUT> SectDataFactory;
 
-static llvm::ManagedStatic<SectDataFactory> g_SectDataFactory;
+static inline SectDataFactory& CurrentSectDataFactory() {
+  return LinkContext::current().get<SectDataFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // SectionData
 //===----------------------------------------------------------------------===//
-SectionData::SectionData() : m_pSection(NULL) {
+SectionData::SectionData() : m_pSection(NULL), m_pIndex(NULL) {
+}
+
+SectionData::SectionData(LDSection& pSection)
+    : m_pSection(&pSection), m_pIndex(NULL) {
 }
 
-SectionData::SectionData(LDSection& pSection) : m_pSection(&pSection) {
+SectionData::~SectionData() {
+  dropIndex();
 }
 
 SectionData* SectionData::Create(LDSection& pSection) {
-  SectionData* result = g_SectDataFactory->allocate();
+  SectionData* result = CurrentSectDataFactory().allocate();
   new (result) SectionData(pSection);
   return result;
 }
 
 void SectionData::Destroy(SectionData*& pSection) {
   pSection->~SectionData();
-  g_SectDataFactory->deallocate(pSection);
+  CurrentSectDataFactory().deallocate(pSection);
   pSection = NULL;
 }
 
 void SectionData::Clear() {
-  g_SectDataFactory->clear();
+  CurrentSectDataFactory().clear();
+}
+
+void SectionData::updateOffsets(Fragment& pFirst, unsigned pNumThreads) {
+  assert(pFirst.getParent() == this);
+  FragmentIndex index;
+  index.build(pFirst, pNumThreads);
+  index.assignOffsets(pNumThreads);
+}
+
+void SectionData::buildIndex() {
+  if (m_pIndex == NULL)
+    m_pIndex = new FragmentIndex();
+  m_pIndex->build(*this);
+}
+
+void SectionData::dropIndex() {
+  delete m_pIndex;
+  m_pIndex = NULL;
 }
 
 }  // namespace mcld
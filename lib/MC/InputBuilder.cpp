@@ -26,6 +26,7 @@ InputBuilder::InputBuilder(const LinkerConfig& pConfig)
   m_pInputFactory = new InputFactory(MCLD_NUM_OF_INPUTS, pConfig);
   m_pContextFactory = new ContextFactory(MCLD_NUM_OF_INPUTS);
   m_pMemFactory = new MemoryAreaFactory(MCLD_NUM_OF_INPUTS);
+  m_pMemFactory->setPopulateLimit(pConfig.options().mmapPopulateLimit());
 }
 
 InputBuilder::InputBuilder(const LinkerConfig& pConfig,
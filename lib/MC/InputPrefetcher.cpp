@@ -0,0 +1,157 @@
+//===- InputPrefetcher.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/MC/InputPrefetcher.h"
+
+#include "mcld/InputTree.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Support/MemoryArea.h"
+#include "mcld/Support/Parallel.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace mcld {
+
+//===----------------------------------------------------------------------===//
+// InputPrefetcher
+//===----------------------------------------------------------------------===//
+InputPrefetcher::InputPrefetcher(unsigned pNumThreads,
+                                 size_t pLookahead,
+                                 size_t pBudget)
+    : m_NumThreads(pNumThreads),
+      m_Lookahead(pLookahead),
+      m_Budget(pBudget),
+      m_Next(0),
+      m_Consumed(0),
+      m_InFlight(0),
+      m_bStop(false),
+      m_NumPrefetched(0),
+      m_PrefetchedBytes(0),
+      m_SavedMicroseconds(0) {
+}
+
+InputPrefetcher::~InputPrefetcher() {
+  stop();
+}
+
+void InputPrefetcher::add(const MemoryArea& pArea) {
+  assert(m_Workers.empty() && "add an area after start()");
+  if (!pArea.isMapped() || m_IndexMap.count(&pArea) != 0)
+    return;
+
+  m_IndexMap[&pArea] = m_Entries.size();
+  Entry entry = {&pArea, Entry::Pending, 0};
+  m_Entries.push_back(entry);
+}
+
+void InputPrefetcher::start(const InputTree& pTree) {
+  InputTree::const_dfs_iterator input, inEnd = pTree.dfs_end();
+  for (input = pTree.dfs_begin(); input != inEnd; ++input) {
+    if ((*input)->hasMemArea())
+      add(*(*input)->memArea());
+  }
+  start();
+}
+
+void InputPrefetcher::start() {
+  // the calling thread is the reader
+  unsigned threads = parallel::getThreadCount(m_NumThreads);
+  if (threads <= 1 || m_Lookahead == 0 || m_Entries.empty())
+    return;
+
+  size_t workers = std::min<size_t>(threads - 1, m_Lookahead);
+  workers = std::min(workers, m_Entries.size());
+  m_Workers.reserve(workers);
+  for (size_t i = 0; i < workers; ++i)
+    m_Workers.push_back(std::thread(&InputPrefetcher::work, this));
+}
+
+void InputPrefetcher::advance(const MemoryArea& pArea) {
+  if (m_Workers.empty())
+    return;
+
+  llvm::DenseMap<const MemoryArea*, size_t>::iterator it =
+      m_IndexMap.find(&pArea);
+  if (it == m_IndexMap.end())
+    return;
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  size_t idx = it->second;
+  if (idx < m_Consumed)
+    return;
+
+  for (size_t i = m_Consumed; i <= idx; ++i) {
+    Entry& entry = m_Entries[i];
+    // running entries give their bytes back when they finish
+    if (Entry::Done == entry.state) {
+      m_InFlight -= entry.area->size();
+      ++m_NumPrefetched;
+      m_PrefetchedBytes += entry.area->size();
+      m_SavedMicroseconds += entry.micros;
+    }
+  }
+  m_Consumed = idx + 1;
+  // skip the entries that nobody got to
+  m_Next = std::max(m_Next, m_Consumed);
+  m_Cond.notify_all();
+}
+
+void InputPrefetcher::stop() {
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_bStop = true;
+  }
+  m_Cond.notify_all();
+
+  for (std::thread& worker : m_Workers)
+    worker.join();
+  m_Workers.clear();
+}
+
+bool InputPrefetcher::canPrefetch() const {
+  if (m_Next >= m_Consumed + m_Lookahead)
+    return false;
+  size_t size = m_Entries[m_Next].area->size();
+  return (0 == m_InFlight) || (m_InFlight + size <= m_Budget);
+}
+
+void InputPrefetcher::work() {
+  std::unique_lock<std::mutex> lock(m_Mutex);
+  while (!m_bStop && m_Next < m_Entries.size()) {
+    if (!canPrefetch()) {
+      m_Cond.wait(lock);
+      continue;
+    }
+
+    size_t idx = m_Next++;
+    Entry& entry = m_Entries[idx];
+    entry.state = Entry::Running;
+    m_InFlight += entry.area->size();
+    lock.unlock();
+
+    std::chrono::steady_clock::time_point begin =
+        std::chrono::steady_clock::now();
+    entry.area->populate();
+    std::chrono::steady_clock::duration elapsed =
+        std::chrono::steady_clock::now() - begin;
+
+    lock.lock();
+    entry.state = Entry::Done;
+    entry.micros =
+        std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+    if (idx < m_Consumed) {
+      // the reader got there first
+      m_InFlight -= entry.area->size();
+      m_Cond.notify_all();
+    }
+  }
+}
+
+}  // namespace mcld
@@ -84,6 +84,23 @@ bool MCLDDirectory::isInSysroot() const {
   return m_bInSysroot;
 }
 
+sys::fs::Path* MCLDDirectory::find(const std::string& pFileName) {
+  // bring all entries into the cache
+  if (!Directory::m_CacheFull) {
+    iterator entry = begin(), enEnd = end();
+    while (entry != enEnd)
+      ++entry;
+  }
+
+  // entries are keyed by their full path
+  std::string path(Directory::m_Path.native());
+  path += pFileName;
+  sys::fs::PathCache::iterator entry = Directory::m_Cache.find(path);
+  if (entry == Directory::m_Cache.end())
+    return NULL;
+  return &entry.getEntry()->value();
+}
+
 void MCLDDirectory::setSysroot(const sys::fs::Path& pSysroot) {
   if (m_bInSysroot) {
     std::string old_path = Directory::m_Path.native();
@@ -22,6 +22,47 @@ static inline void SpecToFilename(const std::string& pSpec,
   pFile += pSpec;
 }
 
+/// FindInDirs - search the directories in order. In each directory, the
+/// shared object lib<namespec>.so is preferred to the archive lib<namespec>.a
+/// if pType is Input::DynObj. Each directory is read only once, and the
+/// candidate names are probed in its cache directly.
+static mcld::sys::fs::Path* FindInDirs(const SearchDirs::DirList& pDirList,
+                                       const std::string& pNamespec,
+                                       mcld::Input::Type pType) {
+  assert(Input::DynObj == pType || Input::Archive == pType ||
+         Input::Script == pType);
+
+  std::string shared_file;
+  std::string static_file;
+  switch (pType) {
+    case Input::Script:
+      static_file.assign(pNamespec);
+      break;
+    case Input::DynObj:
+      SpecToFilename(pNamespec, shared_file);
+      shared_file += mcld::sys::fs::detail::shared_library_extension;
+    /** Fall through **/
+    case Input::Archive:
+      SpecToFilename(pNamespec, static_file);
+      static_file += mcld::sys::fs::detail::static_library_extension;
+      break;
+    default:
+      break;
+  }  // end of switch
+
+  // for all MCLDDirectorys
+  SearchDirs::DirList::const_iterator mcld_dir, mcld_dir_end = pDirList.end();
+  for (mcld_dir = pDirList.begin(); mcld_dir != mcld_dir_end; ++mcld_dir) {
+    mcld::sys::fs::Path* path = NULL;
+    if (!shared_file.empty() &&
+        (path = (*mcld_dir)->find(shared_file)) != NULL)
+      return path;
+    if ((path = (*mcld_dir)->find(static_file)) != NULL)
+      return path;
+  }  // end of for
+  return NULL;
+}
+
 //===----------------------------------------------------------------------===//
 // SearchDirs
 //===----------------------------------------------------------------------===//
@@ -69,132 +110,12 @@ bool SearchDirs::insert(const sys::fs::Path& pPath) {
 
 mcld::sys::fs::Path* SearchDirs::find(const std::string& pNamespec,
                                       mcld::Input::Type pType) {
-  assert(Input::DynObj == pType || Input::Archive == pType ||
-         Input::Script == pType);
-
-  std::string file;
-  switch (pType) {
-    case Input::Script:
-      file.assign(pNamespec);
-      break;
-    case Input::DynObj:
-    case Input::Archive:
-      SpecToFilename(pNamespec, file);
-      break;
-    default:
-      break;
-  }  // end of switch
-
-  // for all MCLDDirectorys
-  DirList::iterator mcld_dir, mcld_dir_end = m_DirList.end();
-  for (mcld_dir = m_DirList.begin(); mcld_dir != mcld_dir_end; ++mcld_dir) {
-    // for all entries in MCLDDirectory
-    MCLDDirectory::iterator entry = (*mcld_dir)->begin();
-    MCLDDirectory::iterator enEnd = (*mcld_dir)->end();
-
-    switch (pType) {
-      case Input::Script: {
-        while (entry != enEnd) {
-          if (file == entry.path()->filename().native())
-            return entry.path();
-          ++entry;
-        }
-        break;
-      }
-      case Input::DynObj: {
-        while (entry != enEnd) {
-          if (file == entry.path()->stem().native()) {
-            if (mcld::sys::fs::detail::shared_library_extension ==
-                entry.path()->extension().native()) {
-              return entry.path();
-            }
-          }
-          ++entry;
-        }
-      }
-      /** Fall through **/
-      case Input::Archive: {
-        entry = (*mcld_dir)->begin();
-        enEnd = (*mcld_dir)->end();
-        while (entry != enEnd) {
-          if (file == entry.path()->stem().native() &&
-              mcld::sys::fs::detail::static_library_extension ==
-                  entry.path()->extension().native()) {
-            return entry.path();
-          }
-          ++entry;
-        }
-      }
-      default:
-        break;
-    }  // end of switch
-  }    // end of for
-  return NULL;
+  return FindInDirs(m_DirList, pNamespec, pType);
 }
 
 const mcld::sys::fs::Path* SearchDirs::find(const std::string& pNamespec,
                                             mcld::Input::Type pType) const {
-  assert(Input::DynObj == pType || Input::Archive == pType ||
-         Input::Script == pType);
-
-  std::string file;
-  switch (pType) {
-    case Input::Script:
-      file.assign(pNamespec);
-      break;
-    case Input::DynObj:
-    case Input::Archive:
-      SpecToFilename(pNamespec, file);
-      break;
-    default:
-      break;
-  }  // end of switch
-
-  // for all MCLDDirectorys
-  DirList::const_iterator mcld_dir, mcld_dir_end = m_DirList.end();
-  for (mcld_dir = m_DirList.begin(); mcld_dir != mcld_dir_end; ++mcld_dir) {
-    // for all entries in MCLDDirectory
-    MCLDDirectory::iterator entry = (*mcld_dir)->begin();
-    MCLDDirectory::iterator enEnd = (*mcld_dir)->end();
-
-    switch (pType) {
-      case Input::Script: {
-        while (entry != enEnd) {
-          if (file == entry.path()->filename().native())
-            return entry.path();
-          ++entry;
-        }
-        break;
-      }
-      case Input::DynObj: {
-        while (entry != enEnd) {
-          if (file == entry.path()->stem().native()) {
-            if (mcld::sys::fs::detail::shared_library_extension ==
-                entry.path()->extension().native()) {
-              return entry.path();
-            }
-          }
-          ++entry;
-        }
-      }
-      /** Fall through **/
-      case Input::Archive: {
-        entry = (*mcld_dir)->begin();
-        enEnd = (*mcld_dir)->end();
-        while (entry != enEnd) {
-          if (file == entry.path()->stem().native() &&
-              mcld::sys::fs::detail::static_library_extension ==
-                  entry.path()->extension().native()) {
-            return entry.path();
-          }
-          ++entry;
-        }
-      }
-      default:
-        break;
-    }  // end of switch
-  }    // end of for
-  return NULL;
+  return FindInDirs(m_DirList, pNamespec, pType);
 }
 
 }  // namespace mcld
@@ -0,0 +1,214 @@
+//===- IncrementalState.cpp -----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Object/IncrementalState.h"
+
+#include "mcld/Support/FileHandle.h"
+#include "mcld/Support/Path.h"
+
+#include <llvm/Support/MD5.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace mcld {
+
+namespace {
+
+/// the first line of a state file
+const char kMagic[] = "mcld-incremental 1";
+
+/// Reader - splits a line of a state file into fields. The last field of a
+/// line, a name or a path, may contain spaces.
+class Reader {
+ public:
+  explicit Reader(llvm::StringRef pLine) : m_Rest(pLine), m_bGood(true) {}
+
+  template <typename T>
+  Reader& operator>>(T& pValue) {
+    llvm::StringRef field;
+    std::tie(field, m_Rest) = m_Rest.split(' ');
+    if (field.getAsInteger(10, pValue))
+      m_bGood = false;
+    return *this;
+  }
+
+  Reader& operator>>(IncrementalState::FileIdentity& pIdentity) {
+    return *this >> pIdentity.device >> pIdentity.inode >> pIdentity.size >>
+           pIdentity.mtime;
+  }
+
+  /// rest - the last field
+  std::string rest() const { return m_Rest.str(); }
+
+  bool good() const { return m_bGood; }
+
+ private:
+  llvm::StringRef m_Rest;
+  bool m_bGood;
+};
+
+llvm::raw_ostream& operator<<(llvm::raw_ostream& pOS,
+                              const IncrementalState::FileIdentity& pId) {
+  return pOS << pId.device << ' ' << pId.inode << ' ' << pId.size << ' '
+             << pId.mtime;
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// IncrementalState
+//===----------------------------------------------------------------------===//
+IncrementalState::IncrementalState()
+    : m_Key(0), m_CodePosition(0), m_SymTabOffset(0) {
+  m_Output.device = m_Output.inode = m_Output.size = 0;
+  m_Output.mtime = 0;
+}
+
+std::string IncrementalState::getPath(const std::string& pOutput) {
+  return pOutput + ".incr";
+}
+
+bool IncrementalState::identify(const std::string& pPath,
+                                FileIdentity& pIdentity) {
+  FileHandle file;
+  if (!file.open(sys::fs::Path(pPath),
+                 FileHandle::OpenMode(FileHandle::ReadOnly),
+                 FileHandle::Permission(FileHandle::System)))
+    return false;
+  return sys::fs::detail::file_identity(file.handler(), pIdentity);
+}
+
+uint64_t IncrementalState::digest(llvm::StringRef pData) {
+  llvm::MD5 hash;
+  hash.update(pData);
+  llvm::MD5::MD5Result result;
+  hash.final(result);
+  uint64_t value = 0;
+  for (unsigned i = 0; i < 8; ++i)
+    value = (value << 8) | result[i];
+  return value;
+}
+
+bool IncrementalState::read(const std::string& pPath) {
+  FileHandle file;
+  if (!file.open(sys::fs::Path(pPath),
+                 FileHandle::OpenMode(FileHandle::ReadOnly),
+                 FileHandle::Permission(FileHandle::System)))
+    return false;
+
+  std::string content(file.size(), '\0');
+  if (!file.read(&content[0], 0, content.size()))
+    return false;
+
+  llvm::StringRef text(content), line;
+  std::tie(line, text) = text.split('\n');
+  if (line != kMagic)
+    return false;
+
+  Object* object = NULL;
+  while (!text.empty()) {
+    std::tie(line, text) = text.split('\n');
+    llvm::StringRef tag;
+    std::tie(tag, line) = line.split(' ');
+    Reader reader(line);
+    if (tag == "key") {
+      reader >> m_Key;
+    } else if (tag == "code-position") {
+      reader >> m_CodePosition;
+    } else if (tag == "output") {
+      reader >> m_Output;
+    } else if (tag == "symtab") {
+      reader >> m_SymTabOffset;
+    } else if (tag == "file") {
+      File entry;
+      reader >> entry.identity;
+      entry.path = reader.rest();
+      m_Files.push_back(entry);
+    } else if (tag == "object") {
+      m_Objects.push_back(Object());
+      object = &m_Objects.back();
+      reader >> object->identity >> object->symbolDigest;
+      object->path = reader.rest();
+    } else if (tag == "section" && object != NULL) {
+      Section sect;
+      unsigned mode, placed;
+      reader >> mode >> sect.type >> sect.flag >> sect.align >> sect.link >>
+          sect.size >> sect.reserve >> placed >> sect.addr >> sect.offset >>
+          sect.digest;
+      sect.mode = static_cast<Section::Mode>(mode);
+      sect.placed = (placed != 0);
+      sect.name = reader.rest();
+      object->sections.push_back(sect);
+    } else if (tag == "symbol" && object != NULL) {
+      Symbol sym;
+      reader >> sym.size >> sym.outIndex;
+      object->symbols.push_back(sym);
+    } else if (tag == "global") {
+      Global global;
+      unsigned defined, plain;
+      reader >> defined >> plain >> global.value;
+      global.defined = (defined != 0);
+      global.plain = (plain != 0);
+      m_Globals[reader.rest()] = global;
+    } else {
+      return false;
+    }
+    if (!reader.good())
+      return false;
+  }
+  return true;
+}
+
+bool IncrementalState::write(const std::string& pPath) const {
+  std::string content;
+  llvm::raw_string_ostream os(content);
+  os << kMagic << '\n';
+  os << "key " << m_Key << '\n';
+  os << "code-position " << m_CodePosition << '\n';
+  os << "output " << m_Output << '\n';
+  os << "symtab " << m_SymTabOffset << '\n';
+
+  for (FileList::const_iterator file = m_Files.begin(), fEnd = m_Files.end();
+       file != fEnd; ++file)
+    os << "file " << file->identity << ' ' << file->path << '\n';
+
+  for (ObjectList::const_iterator obj = m_Objects.begin(),
+       oEnd = m_Objects.end(); obj != oEnd; ++obj) {
+    os << "object " << obj->identity << ' ' << obj->symbolDigest << ' '
+       << obj->path << '\n';
+    for (std::vector<Section>::const_iterator sect = obj->sections.begin(),
+         sEnd = obj->sections.end(); sect != sEnd; ++sect) {
+      os << "section " << static_cast<unsigned>(sect->mode) << ' '
+         << sect->type << ' ' << sect->flag << ' ' << sect->align << ' '
+         << sect->link << ' ' << sect->size << ' ' << sect->reserve << ' '
+         << (sect->placed ? 1 : 0) << ' ' << sect->addr << ' '
+         << sect->offset << ' ' << sect->digest << ' ' << sect->name << '\n';
+    }
+    for (std::vector<Symbol>::const_iterator sym = obj->symbols.begin(),
+         yEnd = obj->symbols.end(); sym != yEnd; ++sym)
+      os << "symbol " << sym->size << ' ' << sym->outIndex << '\n';
+  }
+
+  for (GlobalMap::const_iterator global = m_Globals.begin(),
+       gEnd = m_Globals.end(); global != gEnd; ++global) {
+    os << "global " << (global->getValue().defined ? 1 : 0) << ' '
+       << (global->getValue().plain ? 1 : 0) << ' '
+       << global->getValue().value << ' ' << global->getKey() << '\n';
+  }
+  os.flush();
+
+  FileHandle file;
+  if (!file.open(sys::fs::Path(pPath),
+                 FileHandle::OpenMode(FileHandle::ReadWrite |
+                                      FileHandle::Truncate |
+                                      FileHandle::Create),
+                 FileHandle::Permission(0x644)))
+    return false;
+  return file.write(content.data(), 0, content.size());
+}
+
+}  // namespace mcld
@@ -111,6 +111,13 @@ LDSection* ObjectBuilder::MergeSection(const Input& pInputFile,
         if (pair.first->prolog().hasSubAlign()) {
           pInputSection.setAlign(pair.second->getSection()->align());
         }
+
+        // a sorted description places its sections once it has them all
+        if (pair.second->isSorted()) {
+          pair.second->defer(pInputFile, pInputSection);
+          UpdateSectionAlign(*target, pInputSection);
+          return target;
+        }
       } else {
         // orphan section
         data = target->getSectionData();
@@ -13,11 +13,15 @@
 #include "mcld/LinkerConfig.h"
 #include "mcld/LinkerScript.h"
 #include "mcld/Module.h"
+#include "mcld/ADT/SizeTraits.h"
+#include "mcld/Fragment/FillFragment.h"
+#include "mcld/Fragment/FragmentRef.h"
 #include "mcld/Fragment/Relocation.h"
 #include "mcld/LD/Archive.h"
 #include "mcld/LD/ArchiveReader.h"
 #include "mcld/LD/BinaryReader.h"
 #include "mcld/LD/BranchIslandFactory.h"
+#include "mcld/LD/CallGraphSort.h"
 #include "mcld/LD/DebugString.h"
 #include "mcld/LD/DynObjReader.h"
 #include "mcld/LD/GarbageCollection.h"
@@ -25,12 +29,15 @@
 #include "mcld/LD/IdenticalCodeFolding.h"
 #include "mcld/LD/LDContext.h"
 #include "mcld/LD/LDSection.h"
+#include "mcld/LD/LDSymbol.h"
+#include "mcld/LD/NamePool.h"
 #include "mcld/LD/ObjectReader.h"
 #include "mcld/LD/ObjectWriter.h"
 #include "mcld/LD/Relocator.h"
 #include "mcld/LD/RelocData.h"
 #include "mcld/LD/ResolveInfo.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/MC/InputPrefetcher.h"
 #include "mcld/Object/ObjectBuilder.h"
 #include "mcld/Script/Assignment.h"
 #include "mcld/Script/Operand.h"
@@ -38,14 +45,24 @@
 #include "mcld/Script/ScriptFile.h"
 #include "mcld/Script/ScriptReader.h"
 #include "mcld/Support/FileOutputBuffer.h"
+#include "mcld/Support/ELF.h"
+#include "mcld/Support/MemoryArea.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/Parallel.h"
 #include "mcld/Support/RealPath.h"
+#include "mcld/Support/TimeTrace.h"
 #include "mcld/Target/TargetLDBackend.h"
 
+#include <llvm/ADT/DenseSet.h>
+#include <llvm/ADT/StringMap.h>
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/Host.h>
 
+#include <algorithm>
+#include <cstring>
+#include <set>
 #include <system_error>
+#include <vector>
 
 namespace mcld {
 
@@ -64,7 +81,8 @@ ObjectLinker::ObjectLinker(const LinkerConfig& pConfig,
       m_pGroupReader(NULL),
       m_pBinaryReader(NULL),
       m_pScriptReader(NULL),
-      m_pWriter(NULL) {
+      m_pWriter(NULL),
+      m_pPatchInput(NULL) {
 }
 
 ObjectLinker::~ObjectLinker() {
@@ -144,9 +162,19 @@ void ObjectLinker::addUndefinedSymbols() {
 }
 
 void ObjectLinker::normalize() {
+  // -----  start reading in inputs in the background  ----- //
+  InputPrefetcher prefetcher(m_Config.options().numThreads(),
+                             m_Config.options().prefetchInputs(),
+                             m_Config.options().prefetchBudget());
+  if (m_Config.options().prefetchInputs() > 0)
+    prefetcher.start(m_pModule->getInputTree());
+
   // -----  set up inputs  ----- //
   Module::input_iterator input, inEnd = m_pModule->input_end();
   for (input = m_pModule->input_begin(); input != inEnd; ++input) {
+    if (!isGroup(input) && (*input)->hasMemArea())
+      prefetcher.advance(*(*input)->memArea());
+
     // is a group node
     if (isGroup(input)) {
       getGroupReader()->readGroup(
@@ -171,6 +199,7 @@ void ObjectLinker::normalize() {
       continue;
     }
 
+    TimeTrace::Scope step("readInput", (*input)->path().native());
     bool doContinue = false;
     // read input as a binary file
     if (getBinaryReader()->isMyFormat(**input, doContinue)) {
@@ -224,6 +253,14 @@ void ObjectLinker::normalize() {
             << (*input)->path() << m_Config.targets().triple().str();
     }
   }  // end of for
+
+  prefetcher.stop();
+  if (prefetcher.size() > 0) {
+    note(diag::note_prefetch_inputs)
+        << prefetcher.numOfPrefetched() << prefetcher.size()
+        << prefetcher.prefetchedBytes()
+        << prefetcher.savedMicroseconds() / 1000;
+  }
 }
 
 bool ObjectLinker::linkable() const {
@@ -268,12 +305,14 @@ void ObjectLinker::dataStrippingOpt() {
 
   // Garbege collection
   if (m_Config.options().GCSections()) {
+    TimeTrace::Scope step("gcSections");
     GarbageCollection GC(m_Config, m_LDBackend, *m_pModule);
     GC.run();
   }
 
   // Identical code folding
   if (m_Config.options().getICFMode() != GeneralOptions::ICF::None) {
+    TimeTrace::Scope step("foldIdenticalCode");
     IdenticalCodeFolding icf(m_Config, m_LDBackend, *m_pModule);
     icf.foldIdenticalCode();
   }
@@ -335,73 +374,33 @@ bool ObjectLinker::mergeSections() {
     }  // for each output section description
   }
 
+  // the sections of the hot symbols go first, in order, so that they lead
+  // whatever output section or input section description they belong to. An
+  // ordering file of symbols takes precedence over a call graph.
   ObjectBuilder builder(*m_pModule);
+  SectionOrder order;
+  if (m_Config.options().hasSymbolOrder())
+    getSectionOrder(order);
+  else
+    getCallGraphOrder(order);
+  llvm::DenseSet<const LDSection*> placed;
+  SectionOrder::iterator hot, hotEnd = order.end();
+  for (hot = order.begin(); hot != hotEnd; ++hot) {
+    if (!mergeInputSection(*hot->first, *hot->second, builder))
+      return false;
+    placed.insert(hot->second);
+  }
+
   Module::obj_iterator obj, objEnd = m_pModule->obj_end();
   for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
     LDContext::sect_iterator sect, sectEnd = (*obj)->context()->sectEnd();
     for (sect = (*obj)->context()->sectBegin(); sect != sectEnd; ++sect) {
-      switch ((*sect)->kind()) {
-        // Some *INPUT sections should not be merged.
-        case LDFileFormat::Folded:
-        case LDFileFormat::Ignore:
-        case LDFileFormat::Null:
-        case LDFileFormat::NamePool:
-        case LDFileFormat::Group:
-        case LDFileFormat::StackNote:
-          // skip
-          continue;
-        case LDFileFormat::Relocation:
-          if (!(*sect)->hasRelocData())
-            continue;  // skip
-
-          if ((*sect)->getLink()->kind() == LDFileFormat::Ignore ||
-              (*sect)->getLink()->kind() == LDFileFormat::Folded)
-            (*sect)->setKind(LDFileFormat::Ignore);
-          break;
-        case LDFileFormat::Target:
-          if (!m_LDBackend.mergeSection(*m_pModule, **obj, **sect)) {
-            error(diag::err_cannot_merge_section) << (*sect)->name()
-                                                  << (*obj)->name();
-            return false;
-          }
-          break;
-        case LDFileFormat::EhFrame: {
-          if (!(*sect)->hasEhFrame())
-            continue;  // skip
-
-          LDSection* out_sect = NULL;
-          if ((out_sect = builder.MergeSection(**obj, **sect)) != NULL) {
-            if (!m_LDBackend.updateSectionFlags(*out_sect, **sect)) {
-              error(diag::err_cannot_merge_section) << (*sect)->name()
-                                                    << (*obj)->name();
-              return false;
-            }
-          }
-          break;
-        }
-        case LDFileFormat::DebugString: {
-          // FIXME: disable debug string merge when doing partial link.
-          if (LinkerConfig::Object == m_Config.codeGenType())
-            (*sect)->setKind(LDFileFormat::Debug);
-        }
-        // Fall through
-        default: {
-          if (!(*sect)->hasSectionData())
-            continue;  // skip
-
-          LDSection* out_sect = NULL;
-          if ((out_sect = builder.MergeSection(**obj, **sect)) != NULL) {
-            if (!m_LDBackend.updateSectionFlags(*out_sect, **sect)) {
-              error(diag::err_cannot_merge_section) << (*sect)->name()
-                                                    << (*obj)->name();
-              return false;
-            }
-          }
-          break;
-        }
-      }  // end of switch
-    }    // for each section
-  }      // for each obj
+      if (placed.count(*sect) != 0)
+        continue;
+      if (!mergeInputSection(**obj, **sect, builder))
+        return false;
+    }  // for each section
+  }    // for each obj
 
   {
     SectionMap::iterator out, outBegin, outEnd;
@@ -414,6 +413,7 @@ bool ObjectLinker::mergeSections() {
       inEnd = (*out)->end();
 
       for (in = inBegin; in != inEnd; ++in) {
+        (*in)->placeSorted();
         LDSection* in_sect = (*in)->getSection();
         if (builder.MoveSectionData(*in_sect->getSectionData(),
                                     *out_sect->getSectionData())) {
@@ -440,6 +440,73 @@ bool ObjectLinker::mergeSections() {
   return true;
 }
 
+/// mergeInputSection - merge pSection of pInput by its kind
+bool ObjectLinker::mergeInputSection(Input& pInput,
+                                     LDSection& pSection,
+                                     ObjectBuilder& pBuilder) {
+  switch (pSection.kind()) {
+    // Some *INPUT sections should not be merged.
+    case LDFileFormat::Folded:
+    case LDFileFormat::Ignore:
+    case LDFileFormat::Null:
+    case LDFileFormat::NamePool:
+    case LDFileFormat::Group:
+    case LDFileFormat::StackNote:
+      // skip
+      return true;
+    case LDFileFormat::Relocation:
+      if (!pSection.hasRelocData())
+        return true;  // skip
+
+      if (pSection.getLink()->kind() == LDFileFormat::Ignore ||
+          pSection.getLink()->kind() == LDFileFormat::Folded)
+        pSection.setKind(LDFileFormat::Ignore);
+      break;
+    case LDFileFormat::Target:
+      if (!m_LDBackend.mergeSection(*m_pModule, pInput, pSection)) {
+        error(diag::err_cannot_merge_section) << pSection.name()
+                                              << pInput.name();
+        return false;
+      }
+      break;
+    case LDFileFormat::EhFrame: {
+      if (!pSection.hasEhFrame())
+        return true;  // skip
+
+      LDSection* out_sect = NULL;
+      if ((out_sect = pBuilder.MergeSection(pInput, pSection)) != NULL) {
+        if (!m_LDBackend.updateSectionFlags(*out_sect, pSection)) {
+          error(diag::err_cannot_merge_section) << pSection.name()
+                                                << pInput.name();
+          return false;
+        }
+      }
+      break;
+    }
+    case LDFileFormat::DebugString: {
+      // FIXME: disable debug string merge when doing partial link.
+      if (LinkerConfig::Object == m_Config.codeGenType())
+        pSection.setKind(LDFileFormat::Debug);
+    }
+    // Fall through
+    default: {
+      if (!pSection.hasSectionData())
+        return true;  // skip
+
+      LDSection* out_sect = NULL;
+      if ((out_sect = mergeSection(pInput, pSection)) != NULL) {
+        if (!m_LDBackend.updateSectionFlags(*out_sect, pSection)) {
+          error(diag::err_cannot_merge_section) << pSection.name()
+                                                << pInput.name();
+          return false;
+        }
+      }
+      break;
+    }
+  }  // end of switch
+  return true;
+}
+
 void ObjectLinker::addSymbolToOutput(ResolveInfo& pInfo, Module& pModule) {
   // section symbols will be defined by linker later, we should not add section
   // symbols to output here
@@ -578,43 +645,114 @@ bool ObjectLinker::addScriptSymbols() {
   return true;
 }
 
-bool ObjectLinker::scanRelocations() {
-  // apply all relocations of all inputs
-  Module::obj_iterator input, inEnd = m_pModule->obj_end();
-  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
-    m_LDBackend.getRelocator()->initializeScan(**input);
-    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
-    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
-      // bypass the reloc section if
-      // 1. its section kind is changed to Ignore. (The target section is a
-      // discarded group section.)
-      // 2. it has no reloc data. (All symbols in the input relocs are in the
-      // discarded group sections)
-      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+/// the fewest inputs a thread classifies relocations of
+static const size_t kMinInputsPerScanThread = 4;
+
+/// ScanEntry - a relocation to scan and what classifyScan() said about it
+struct ScanEntry {
+  Relocation* reloc;
+  LDSection* section;
+  Relocator::Type type;
+  Relocator::ScanKind kind;
+  unsigned group;
+};
+
+typedef std::vector<ScanEntry> ScanList;
+
+/// IsDiscardedReloc - the symbol of pReloc is in a discarded input section
+static bool IsDiscardedReloc(const Relocation& pReloc) {
+  const ResolveInfo* info = pReloc.symInfo();
+  return !info->outSymbol()->hasFragRef() &&
+         ResolveInfo::Section == info->type() &&
+         ResolveInfo::Undefined == info->desc();
+}
+
+/// ClassifyScan - collect the relocations of pInput with their scan kinds
+static void ClassifyScan(const Relocator& pRelocator,
+                         Input& pInput,
+                         ScanList& pList) {
+  LDContext::sect_iterator rs, rsEnd = pInput.context()->relocSectEnd();
+  for (rs = pInput.context()->relocSectBegin(); rs != rsEnd; ++rs) {
+    // bypass the reloc section if
+    // 1. its section kind is changed to Ignore. (The target section is a
+    // discarded group section.)
+    // 2. it has no reloc data. (All symbols in the input relocs are in the
+    // discarded group sections)
+    if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+      continue;
+    RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+    for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+      Relocation* relocation = llvm::cast<Relocation>(reloc);
+      if (IsDiscardedReloc(*relocation))
         continue;
-      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
-      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
-        Relocation* relocation = llvm::cast<Relocation>(reloc);
+      ScanEntry entry = {relocation, *rs, relocation->type(),
+                         Relocator::ScanEach, 0};
+      entry.kind = pRelocator.classifyScan(*relocation, **rs, entry.group);
+      pList.push_back(entry);
+    }
+  }
+}
 
-        // bypass the reloc if the symbol is in the discarded input section
-        ResolveInfo* info = relocation->symInfo();
-        if (!info->outSymbol()->hasFragRef() &&
-            ResolveInfo::Section == info->type() &&
-            ResolveInfo::Undefined == info->desc())
+bool ObjectLinker::scanRelocations() {
+  Relocator& relocator = *m_LDBackend.getRelocator();
+  Module::ObjectList& inputs = m_pModule->getObjectList();
+
+  // partial linking only adjusts the relocations, in input order
+  if (LinkerConfig::Object == m_Config.codeGenType()) {
+    Module::obj_iterator input, inEnd = inputs.end();
+    for (input = inputs.begin(); input != inEnd; ++input) {
+      relocator.initializeScan(**input);
+      LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
+      for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+        if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
           continue;
-
-        // scan relocation
-        if (LinkerConfig::Object != m_Config.codeGenType()) {
-          m_LDBackend.getRelocator()->scanRelocation(
-              *relocation, *m_pBuilder, *m_pModule, **rs, **input);
-        } else {
-          m_LDBackend.getRelocator()->partialScanRelocation(
-              *relocation, *m_pModule);
+        RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+        for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+          Relocation* relocation = llvm::cast<Relocation>(reloc);
+          if (!IsDiscardedReloc(*relocation))
+            relocator.partialScanRelocation(*relocation, *m_pModule);
         }
-      }  // for all relocations
-    }    // for all relocation section
-    m_LDBackend.getRelocator()->finalizeScan(**input);
-  }  // for all inputs
+      }
+      relocator.finalizeScan(**input);
+    }
+    return true;
+  }
+
+  // classify the relocations of every input in parallel. classifyScan() only
+  // reads, so the workers share nothing but their own input's list.
+  std::vector<ScanList> lists(inputs.size());
+  parallel::forEach(m_Config.options().numThreads(),
+                    inputs.size(),
+                    kMinInputsPerScanThread,
+                    [&](size_t pIdx) {
+                      ClassifyScan(relocator, *inputs[pIdx], lists[pIdx]);
+                    });
+
+  // reserve the entries in input order, so that the GOT, PLT and dynamic
+  // relocation entries come out exactly as a serial scan would create them.
+  // A relocation whose type a neighbour's scan rewrote is scanned again as
+  // it is now.
+  llvm::DenseSet<std::pair<const ResolveInfo*, unsigned> > scanned;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    Input& input = *inputs[i];
+    relocator.initializeScan(input);
+    ScanList::iterator entry, eEnd = lists[i].end();
+    for (entry = lists[i].begin(); entry != eEnd; ++entry) {
+      Relocation& reloc = *entry->reloc;
+      if (reloc.type() == entry->type) {
+        if (Relocator::ScanNone == entry->kind)
+          continue;
+        if (Relocator::ScanSymbol == entry->kind &&
+            !scanned.insert(std::make_pair(reloc.symInfo(), entry->group))
+                 .second)
+          continue;
+      }
+      relocator.scanRelocation(
+          reloc, *m_pBuilder, *m_pModule, *entry->section, input);
+    }
+    relocator.finalizeScan(input);
+    ScanList().swap(lists[i]);
+  }
   return true;
 }
 
@@ -676,6 +814,7 @@ bool ObjectLinker::prelayout() {
   if (eh_frame_sect && eh_frame_sect->hasEhFrame())
     eh_frame_sect->getEhFrame()->computeOffsetSize();
   m_LDBackend.createAndSizeEhFrameHdr(*m_pModule);
+  m_LDBackend.createAndSizeBuildID(*m_pModule);
 
   // size debug string table and set up the debug string offset
   // we set the .debug_str size here so that there won't be a section symbol for
@@ -771,6 +910,26 @@ bool ObjectLinker::finalizeSymbolValue() {
   return finalized && scriptSymsFinalized && assertionsPassed;
 }
 
+/// ApplyByType - sort pRelocs by type and hand each run of equal types to
+/// the relocator at once.
+static void ApplyByType(Relocator& pRelocator,
+                        std::vector<Relocation*>& pRelocs) {
+  std::stable_sort(pRelocs.begin(), pRelocs.end(),
+                   [](const Relocation* pX, const Relocation* pY) {
+                     return pX->type() < pY->type();
+                   });
+  Relocation* const* begin = pRelocs.data();
+  Relocation* const* end = begin + pRelocs.size();
+  while (begin != end) {
+    Relocation::Type type = (*begin)->type();
+    Relocation* const* run = begin + 1;
+    while (run != end && (*run)->type() == type)
+      ++run;
+    pRelocator.applyRelocations(type, begin, run);
+    begin = run;
+  }
+}
+
 /// relocate - applying relocation entries and create relocation
 /// section in the output files
 /// Create relocation section, asking TargetLDBackend to
@@ -783,10 +942,18 @@ bool ObjectLinker::relocation() {
 
   LDSection* debug_str_sect = m_pModule->getSection(".debug_str");
 
+  // when the relocator allows it, collect the relocations of each input and
+  // apply them grouped by type
+  Relocator& relocator = *m_LDBackend.getRelocator();
+  bool by_type =
+      m_Config.options().batchApplyRelocs() && relocator.canApplyByType();
+  std::vector<Relocation*> batch;
+
   // apply all relocations of all inputs
   Module::obj_iterator input, inEnd = m_pModule->obj_end();
   for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
     m_LDBackend.getRelocator()->initializeApply(**input);
+    batch.clear();
     LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
     for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
       // bypass the reloc section if
@@ -820,9 +987,14 @@ bool ObjectLinker::relocation() {
           continue;
         }
 
-        relocation->apply(*m_LDBackend.getRelocator());
+        if (by_type)
+          batch.push_back(relocation);
+        else
+          relocation->apply(*m_LDBackend.getRelocator());
       }  // for all relocations
     }    // for all relocation section
+    if (!batch.empty())
+      ApplyByType(relocator, batch);
     m_LDBackend.getRelocator()->finalizeApply(**input);
   }  // for all inputs
 
@@ -860,11 +1032,31 @@ bool ObjectLinker::postProcessing(FileOutputBuffer& pOutput) {
 
   // emit .eh_frame_hdr
   // eh_frame_hdr should be emitted after syncRelocation, because eh_frame_hdr
-  // needs FDE PC value, which will be corrected at syncRelocation
+  // needs FDE PC value, which will be corrected at syncRelocation. The
+  // backend writes .note.gnu.build-id after everything else.
   m_LDBackend.postProcessing(pOutput);
   return true;
 }
 
+/// IsSynced - whether the result of the input relocation pReloc is written
+/// to the output
+static bool IsSynced(const Relocation& pReloc) {
+  // bypass the reloc if the symbol is in the discarded input section
+  const ResolveInfo* info = pReloc.symInfo();
+  if (!info->outSymbol()->hasFragRef() &&
+      ResolveInfo::Section == info->type() &&
+      ResolveInfo::Undefined == info->desc())
+    return false;
+
+  // bypass the relocation with NONE type. This is to avoid overwrite the
+  // target result by NONE type relocation if there is a place which has
+  // two relocations to apply to, and one of it is NONE type. The result
+  // we want is the value of the other relocation result. For example,
+  // in .exidx, there are usually an R_ARM_NONE and R_ARM_PREL31 apply to
+  // the same place
+  return pReloc.type() != 0x0;
+}
+
 void ObjectLinker::normalSyncRelocationResult(FileOutputBuffer& pOutput) {
   uint8_t* data = pOutput.getBufferStart();
 
@@ -884,20 +1076,7 @@ void ObjectLinker::normalSyncRelocationResult(FileOutputBuffer& pOutput) {
       for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
         Relocation* relocation = llvm::cast<Relocation>(reloc);
 
-        // bypass the reloc if the symbol is in the discarded input section
-        ResolveInfo* info = relocation->symInfo();
-        if (!info->outSymbol()->hasFragRef() &&
-            ResolveInfo::Section == info->type() &&
-            ResolveInfo::Undefined == info->desc())
-          continue;
-
-        // bypass the relocation with NONE type. This is to avoid overwrite the
-        // target result by NONE type relocation if there is a place which has
-        // two relocations to apply to, and one of it is NONE type. The result
-        // we want is the value of the other relocation result. For example,
-        // in .exidx, there are usually an R_ARM_NONE and R_ARM_PREL31 apply to
-        // the same place
-        if (relocation->type() == 0x0)
+        if (!IsSynced(*relocation))
           continue;
         writeRelocationResult(*relocation, data);
       }  // for all relocations
@@ -951,43 +1130,854 @@ void ObjectLinker::partialSyncRelocationResult(FileOutputBuffer& pOutput) {
   }
 }
 
-void ObjectLinker::writeRelocationResult(Relocation& pReloc, uint8_t* pOutput) {
-  // get output file offset
-  size_t out_offset =
-      pReloc.targetRef().frag()->getParent()->getSection().offset() +
-      pReloc.targetRef().getOutputOffset();
-
-  uint8_t* target_addr = pOutput + out_offset;
+/// WriteRelocationTarget - write the target data of pReloc, pSize bits, to
+/// pPlace in the byte order of the target
+static void WriteRelocationTarget(const Relocation& pReloc,
+                                  unsigned int pSize,
+                                  const LinkerConfig& pConfig,
+                                  uint8_t* pPlace) {
   // byte swapping if target and host has different endian, and then write back
-  if (llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian()) {
+  if (llvm::sys::IsLittleEndianHost != pConfig.targets().isLittleEndian()) {
     uint64_t tmp_data = 0;
 
-    switch (pReloc.size(*m_LDBackend.getRelocator())) {
+    switch (pSize) {
       case 8u:
-        std::memcpy(target_addr, &pReloc.target(), 1);
+        std::memcpy(pPlace, &pReloc.target(), 1);
         break;
 
       case 16u:
         tmp_data = mcld::bswap16(pReloc.target());
-        std::memcpy(target_addr, &tmp_data, 2);
+        std::memcpy(pPlace, &tmp_data, 2);
         break;
 
       case 32u:
         tmp_data = mcld::bswap32(pReloc.target());
-        std::memcpy(target_addr, &tmp_data, 4);
+        std::memcpy(pPlace, &tmp_data, 4);
         break;
 
       case 64u:
         tmp_data = mcld::bswap64(pReloc.target());
-        std::memcpy(target_addr, &tmp_data, 8);
+        std::memcpy(pPlace, &tmp_data, 8);
         break;
 
       default:
         break;
     }
   } else {
-    std::memcpy(target_addr, &pReloc.target(),
-                (pReloc.size(*m_LDBackend.getRelocator()) + 7) / 8);
+    std::memcpy(pPlace, &pReloc.target(), (pSize + 7) / 8);
+  }
+}
+
+void ObjectLinker::writeRelocationResult(Relocation& pReloc, uint8_t* pOutput) {
+  const LDSection& target = pReloc.targetRef().frag()->getParent()->getSection();
+
+  // the relocations of a compressed section are applied before it is
+  // compressed
+  if ((target.flag() & ELF::SHF_COMPRESSED) != 0)
+    return;
+
+  // get output file offset
+  size_t out_offset = target.offset() + pReloc.targetRef().getOutputOffset();
+
+  WriteRelocationTarget(pReloc,
+                        pReloc.size(*m_LDBackend.getRelocator()),
+                        m_Config,
+                        pOutput + out_offset);
+}
+
+/// IsCompressible - whether the output section pSection is a debug section
+/// that --compress-debug-sections compresses
+static bool IsCompressible(const LDSection& pSection) {
+  if (LDFileFormat::Debug != pSection.kind() &&
+      LDFileFormat::DebugString != pSection.kind())
+    return false;
+  return pSection.size() != 0 &&
+         llvm::StringRef(pSection.name()).startswith(".debug");
+}
+
+bool ObjectLinker::compressDebugSections() {
+  if (LinkerConfig::Object == m_Config.codeGenType() ||
+      GeneralOptions::DebugCompression::None ==
+          m_Config.options().getCompressDebugSections())
+    return true;
+
+  // only the non-allocatable sections at the end of the file can shrink
+  // without moving anything that is loaded
+  Module::iterator first = m_pModule->end();
+  while (first != m_pModule->begin()) {
+    const LDSection* prev = *(first - 1);
+    if (LDFileFormat::Null == prev->kind() ||
+        (prev->flag() & llvm::ELF::SHF_ALLOC) != 0)
+      break;
+    --first;
+  }
+  if (first == m_pModule->begin())
+    return true;
+
+  // render the debug sections
+  typedef llvm::DenseMap<const LDSection*, std::vector<uint8_t> > ContentMap;
+  ContentMap contents;
+  for (Module::iterator sect = first; sect != m_pModule->end(); ++sect) {
+    if (!IsCompressible(**sect))
+      continue;
+    std::vector<uint8_t>& data = contents[*sect];
+    data.resize((*sect)->size());
+    MemoryRegion region(data.data(), data.size());
+    getWriter()->emitSection(*m_pModule, **sect, region);
+  }
+  if (contents.empty())
+    return true;
+
+  // apply their relocations to the rendered contents
+  Module::obj_iterator input, inEnd = m_pModule->obj_end();
+  for (input = m_pModule->obj_begin(); input != inEnd; ++input) {
+    LDContext::sect_iterator rs, rsEnd = (*input)->context()->relocSectEnd();
+    for (rs = (*input)->context()->relocSectBegin(); rs != rsEnd; ++rs) {
+      if (LDFileFormat::Ignore == (*rs)->kind() || !(*rs)->hasRelocData())
+        continue;
+      RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+      for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+        Relocation* relocation = llvm::cast<Relocation>(reloc);
+        ContentMap::iterator data = contents.find(
+            &relocation->targetRef().frag()->getParent()->getSection());
+        if (data == contents.end() || !IsSynced(*relocation))
+          continue;
+        WriteRelocationTarget(
+            *relocation,
+            relocation->size(*m_LDBackend.getRelocator()),
+            m_Config,
+            data->second.data() + relocation->targetRef().getOutputOffset());
+      }
+    }
+  }
+
+  // compress them, a section that would not shrink is left as it is
+  for (Module::iterator sect = first; sect != m_pModule->end(); ++sect) {
+    ContentMap::const_iterator data = contents.find(*sect);
+    if (data != contents.end())
+      getWriter()->compressSection(**sect, data->second);
+  }
+
+  // lay out the non-allocatable sections again
+  for (Module::iterator sect = first; sect != m_pModule->end(); ++sect) {
+    const LDSection* prev = *(sect - 1);
+    uint64_t offset = prev->offset();
+    if (LDFileFormat::BSS != prev->kind())
+      offset += prev->size();
+    alignAddress(offset, (*sect)->align());
+    (*sect)->setOffset(offset);
+  }
+  return true;
+}
+
+//===----------------------------------------------------------------------===//
+// Incremental linking
+//===----------------------------------------------------------------------===//
+/// the room left after a code section to grow into when it is patched:
+/// 1/kReserveDivisor of its size, at least kMinReserve bytes
+static const uint64_t kReserveDivisor = 8;
+static const uint64_t kMinReserve = 16;
+
+/// SymEntry - where st_value and st_size are in an ELF symbol table entry
+struct SymEntry {
+  unsigned int size;
+  unsigned int word;
+  unsigned int value;
+  unsigned int symSize;
+};
+
+static SymEntry GetSymEntry(const LinkerConfig& pConfig) {
+  if (pConfig.targets().is32Bits()) {
+    SymEntry entry = {16, 4, 4, 8};
+    return entry;
+  }
+  SymEntry entry = {24, 8, 8, 16};
+  return entry;
+}
+
+/// WriteWord - write the pBytes-byte word pValue to pPlace
+static void WriteWord(uint8_t* pPlace,
+                      uint64_t pValue,
+                      unsigned int pBytes,
+                      bool pSwap) {
+  if (4 == pBytes) {
+    uint32_t word = pSwap ? mcld::bswap32(pValue) : pValue;
+    std::memcpy(pPlace, &word, 4);
+  } else {
+    uint64_t word = pSwap ? mcld::bswap64(pValue) : pValue;
+    std::memcpy(pPlace, &word, 8);
+  }
+}
+
+/// GetContents - the contents of pSection in the file of pInput
+static llvm::StringRef GetContents(Input& pInput, const LDSection& pSection) {
+  if (llvm::ELF::SHT_NOBITS == pSection.type() || 0 == pSection.size())
+    return llvm::StringRef();
+  return pInput.memArea()->request(pInput.fileOffset() + pSection.offset(),
+                                   pSection.size());
+}
+
+/// GetSection - the input section that pSymbol is defined in, or NULL
+static const LDSection* GetSection(const LDSymbol& pSymbol) {
+  if (!pSymbol.hasFragRef())
+    return NULL;
+  return &pSymbol.fragRef()->frag()->getParent()->getSection();
+}
+
+/// mergeSection - merge pSection of pInput into its output section and, in an
+/// incremental link, remember where it is placed. Only sections whose
+/// fragments move into the output are placed; the strings of .debug_str
+/// are copied and laid out again, so they are compared instead.
+LDSection* ObjectLinker::mergeSection(Input& pInput, LDSection& pSection) {
+  ObjectBuilder builder(*m_pModule);
+  SectionData* data = pSection.getSectionData();
+  if (!m_Config.options().incremental() || data->empty() ||
+      LDFileFormat::DebugString == pSection.kind() ||
+      LDFileFormat::EhFrame == pSection.kind())
+    return builder.MergeSection(pInput, pSection);
+
+  Placement place = {&data->front(), 0};
+  if (LDFileFormat::TEXT == pSection.kind() &&
+      (pSection.flag() & llvm::ELF::SHF_EXECINSTR) != 0) {
+    place.reserve = std::max(kMinReserve, pSection.size() / kReserveDivisor);
+    new FillFragment(0x0, 1, place.reserve, data);
+  }
+
+  LDSection* out_sect = builder.MergeSection(pInput, pSection);
+  if (out_sect != NULL && place.first->getParent() != data)
+    m_Placements[&pSection] = place;
+  return out_sect;
+}
+
+/// getSectionOrder - the input sections that define the symbols listed by
+/// --symbol-ordering-file, ordered by their first listed symbol
+void ObjectLinker::getSectionOrder(SectionOrder& pOrder) const {
+  const GeneralOptions::SymbolOrderList& symbols =
+      m_Config.options().getSymbolOrderList();
+  if (symbols.empty())
+    return;
+
+  llvm::StringMap<unsigned int> priorities;
+  for (unsigned int i = 0; i < symbols.size(); ++i)
+    priorities.insert(std::make_pair(symbols[i], i));
+
+  // a static function may share its name with others in other objects, so
+  // look through the symbol tables of the objects rather than the name pool
+  typedef std::pair<unsigned int, Input*> Priority;
+  llvm::DenseMap<LDSection*, Priority> sections;
+  std::vector<LDSection*> found;
+  llvm::DenseSet<unsigned int> used;
+  Module::const_obj_iterator obj, objEnd = m_pModule->obj_end();
+  for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sym_iterator sym, symEnd = (*obj)->context()->symTabEnd();
+    for (sym = (*obj)->context()->symTabBegin(); sym != symEnd; ++sym) {
+      if (*sym == NULL || (*sym)->resolveInfo() == NULL)
+        continue;
+      llvm::StringMap<unsigned int>::iterator entry =
+          priorities.find((*sym)->str());
+      if (entry == priorities.end())
+        continue;
+
+      const ResolveInfo* info = (*sym)->resolveInfo();
+      const LDSection* section = GetSection(**sym);
+      if (section == NULL)
+        continue;
+      // a global symbol belongs to the definition that won resolution
+      if (!info->isLocal() && (info->outSymbol() == NULL ||
+                               GetSection(*info->outSymbol()) != section))
+        continue;
+      used.insert(entry->getValue());
+
+      switch (section->kind()) {
+        case LDFileFormat::TEXT:
+        case LDFileFormat::DATA:
+        case LDFileFormat::BSS:
+          break;
+        default:
+          // discarded, folded or not a plain section
+          continue;
+      }
+
+      LDSection* target = const_cast<LDSection*>(section);
+      llvm::DenseMap<LDSection*, Priority>::iterator it = sections.find(target);
+      if (it == sections.end()) {
+        sections[target] = Priority(entry->getValue(), *obj);
+        found.push_back(target);
+      } else if (entry->getValue() < it->second.first) {
+        it->second.first = entry->getValue();
+      }
+    }
+  }
+
+  for (unsigned int i = 0; i < symbols.size(); ++i) {
+    if (used.count(i) == 0 && priorities[symbols[i]] == i)
+      warning(diag::warn_symbol_ordering_no_symbol) << symbols[i];
+  }
+
+  // keep the order of the inputs among sections of the same priority
+  std::stable_sort(found.begin(), found.end(),
+                   [&sections](LDSection* pA, LDSection* pB) {
+                     return sections[pA].first < sections[pB].first;
+                   });
+  for (std::vector<LDSection*>::iterator it = found.begin(), e = found.end();
+       it != e; ++it)
+    pOrder.push_back(std::make_pair(sections[*it].second, *it));
+}
+
+/// getCallGraphOrder - the input sections that define the symbols named by
+/// --call-graph-ordering-file, clustered by the calls between them
+void ObjectLinker::getCallGraphOrder(SectionOrder& pOrder) const {
+  const GeneralOptions::CallGraphProfile& profile =
+      m_Config.options().getCallGraphProfile();
+  if (profile.empty())
+    return;
+
+  llvm::StringMap<int> names;
+  for (unsigned int i = 0; i < profile.size(); ++i) {
+    names.insert(std::make_pair(profile[i].caller, -1));
+    names.insert(std::make_pair(profile[i].callee, -1));
+  }
+
+  // every code section that defines a named symbol is a node. A static
+  // function named in many objects stands for the first one.
+  SectionOrder nodes;
+  llvm::DenseMap<const LDSection*, unsigned int> node_of;
+  Module::const_obj_iterator obj, objEnd = m_pModule->obj_end();
+  for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
+    LDContext::sym_iterator sym, symEnd = (*obj)->context()->symTabEnd();
+    for (sym = (*obj)->context()->symTabBegin(); sym != symEnd; ++sym) {
+      if (*sym == NULL || (*sym)->resolveInfo() == NULL)
+        continue;
+      llvm::StringMap<int>::iterator entry = names.find((*sym)->str());
+      if (entry == names.end() || entry->getValue() != -1)
+        continue;
+
+      const ResolveInfo* info = (*sym)->resolveInfo();
+      const LDSection* section = GetSection(**sym);
+      if (section == NULL || section->kind() != LDFileFormat::TEXT)
+        continue;
+      if (!info->isLocal() && (info->outSymbol() == NULL ||
+                               GetSection(*info->outSymbol()) != section))
+        continue;
+
+      llvm::DenseMap<const LDSection*, unsigned int>::iterator node =
+          node_of.find(section);
+      if (node == node_of.end()) {
+        node = node_of.insert(std::make_pair(section, nodes.size())).first;
+        nodes.push_back(
+            std::make_pair(*obj, const_cast<LDSection*>(section)));
+      }
+      entry->getValue() = node->second;
+    }
+  }
+
+  for (llvm::StringMap<int>::iterator it = names.begin(), e = names.end();
+       it != e; ++it) {
+    if (it->getValue() == -1)
+      warning(diag::warn_call_graph_no_symbol) << it->getKey();
+  }
+
+  // calls only bring together sections of the same output section
+  std::vector<std::string> outputs(nodes.size());
+  for (unsigned int i = 0; i < nodes.size(); ++i) {
+    SectionMap::mapping pair = m_pModule->getScript().sectionMap().find(
+        nodes[i].first->path().native(), nodes[i].second->name());
+    outputs[i] = (pair.first == NULL) ? nodes[i].second->name()
+                                      : pair.first->name();
+  }
+
+  typedef std::pair<unsigned int, unsigned int> Edge;
+  llvm::DenseMap<Edge, uint64_t> weights;
+  for (unsigned int i = 0; i < profile.size(); ++i) {
+    int caller = names[profile[i].caller];
+    int callee = names[profile[i].callee];
+    if (caller == -1 || callee == -1 || outputs[caller] != outputs[callee])
+      continue;
+    weights[Edge(caller, callee)] += profile[i].count;
+  }
+
+  // the relocation graph that --gc-sections walks adds a call of weight one
+  // between named sections, for the calls that sampling missed
+  GarbageCollection::SectionReachedListMap references;
+  GarbageCollection::setUpReachedSections(*m_pModule, references);
+  for (unsigned int i = 0; i < nodes.size(); ++i) {
+    GarbageCollection::SectionListTy* reached =
+        references.findReachedList(*nodes[i].second);
+    if (reached == NULL)
+      continue;
+    GarbageCollection::SectionListTy::iterator it, itEnd = reached->end();
+    for (it = reached->begin(); it != itEnd; ++it) {
+      llvm::DenseMap<const LDSection*, unsigned int>::iterator node =
+          node_of.find(*it);
+      if (node == node_of.end() || outputs[i] != outputs[node->second])
+        continue;
+      weights[Edge(i, node->second)] += 1;
+    }
+  }
+
+  CallGraphSort sorter(m_LDBackend.commonPageSize());
+  for (unsigned int i = 0; i < nodes.size(); ++i)
+    sorter.addNode(nodes[i].second->size());
+  // visit the edges in a fixed order, ties between callers depend on it
+  std::vector<std::pair<Edge, uint64_t> > edges(weights.begin(),
+                                                weights.end());
+  std::sort(edges.begin(), edges.end());
+  for (unsigned int i = 0; i < edges.size(); ++i)
+    sorter.addEdge(edges[i].first.first, edges[i].first.second,
+                   edges[i].second);
+
+  std::vector<unsigned int> order;
+  sorter.sort(order);
+  for (unsigned int i = 0; i < order.size(); ++i)
+    pOrder.push_back(nodes[order[i]]);
+}
+
+/// describeObject - describe the sections and symbols of pInput in pRecord,
+/// leaving the modes and places to the caller
+bool ObjectLinker::describeObject(Input& pInput,
+                                  IncrementalState::Object& pRecord) const {
+  pRecord.path = pInput.path().native();
+  if (!IncrementalState::identify(pRecord.path, pRecord.identity))
+    return false;
+
+  const LDContext& context = *pInput.context();
+  const LDSection* symtab = context.getSection(".symtab");
+  if (symtab == NULL)
+    return false;
+
+  llvm::DenseMap<const LDSection*, uint32_t> index;
+  for (unsigned int i = 0; i < context.numOfSections(); ++i) {
+    if (context.getSection(i) != NULL)
+      index[context.getSection(i)] = i;
+  }
+
+  pRecord.sections.clear();
+  for (unsigned int i = 0; i < context.numOfSections(); ++i) {
+    const LDSection* sect = context.getSection(i);
+    IncrementalState::Section record;
+    record.mode = IncrementalState::Section::Skip;
+    record.type = record.flag = record.align = record.link = 0;
+    record.size = record.reserve = 0;
+    record.placed = false;
+    record.addr = record.offset = record.digest = 0;
+    if (sect == NULL) {
+      // a member of a group that was kept from another object
+      record.mode = IncrementalState::Section::Drop;
+    } else {
+      record.type = sect->type();
+      record.flag = sect->flag();
+      record.align = sect->align();
+      if (sect->getLink() != NULL)
+        record.link = index.lookup(sect->getLink());
+      record.size = sect->size();
+      record.name = sect->name();
+    }
+    pRecord.sections.push_back(record);
+  }
+
+  // digest the symbols without their values and sizes, which move and change
+  // as code grows into its reserve
+  SymEntry entry = GetSymEntry(m_Config);
+  bool swap =
+      llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian();
+  std::string symbols = GetContents(pInput, *symtab).str();
+  pRecord.symbols.clear();
+  for (size_t offset = 0; offset + entry.size <= symbols.size();
+       offset += entry.size) {
+    uint64_t size = 0;
+    if (4 == entry.word) {
+      uint32_t word;
+      std::memcpy(&word, &symbols[offset + entry.symSize], 4);
+      size = swap ? mcld::bswap32(word) : word;
+    } else {
+      std::memcpy(&size, &symbols[offset + entry.symSize], 8);
+      size = swap ? mcld::bswap64(size) : size;
+    }
+    IncrementalState::Symbol sym = {size,
+                                    IncrementalState::Symbol::NoEntry};
+    pRecord.symbols.push_back(sym);
+    std::memset(&symbols[offset + entry.value], 0, entry.word);
+    std::memset(&symbols[offset + entry.symSize], 0, entry.word);
+  }
+  if (symtab->getLink() != NULL)
+    symbols += GetContents(pInput, *symtab->getLink()).str();
+  pRecord.symbolDigest = IncrementalState::digest(symbols);
+  return true;
+}
+
+/// recordState - describe the emitted output in pState for a later
+/// incremental link
+bool ObjectLinker::recordState(IncrementalState& pState) {
+  // only the absolute code of executables is patched, and only when no
+  // section was folded, collected or moved by relaxation
+  if (LinkerConfig::Exec != m_Config.codeGenType() ||
+      m_Config.isCodeIndep() || m_Config.options().GCSections() ||
+      GeneralOptions::ICF::None != m_Config.options().getICFMode())
+    return false;
+  BranchIslandFactory* br_factory = m_LDBackend.getBRIslandFactory();
+  if (br_factory != NULL && br_factory->begin() != br_factory->end())
+    return false;
+
+  pState.setCodePosition(m_Config.codePosition());
+  pState.objects().clear();
+  pState.files().clear();
+  pState.globals().clear();
+
+  // the output symbol tables
+  const LDSection* symtab = m_pModule->getSection(".symtab");
+  const LDSection* dynsym = m_pModule->getSection(".dynsym");
+  bool has_dynsym = (dynsym != NULL && dynsym->size() != 0);
+  bool has_symtab = (symtab != NULL && symtab->size() != 0);
+  pState.setSymTabOffset(has_symtab ? symtab->offset() : 0);
+
+  llvm::DenseMap<const LDSymbol*, int64_t> out_index;
+  if (has_symtab) {
+    int64_t idx = 1;
+    Module::sym_iterator sym, symEnd = m_pModule->sym_end();
+    for (sym = m_pModule->sym_begin(); sym != symEnd; ++sym, ++idx)
+      out_index[*sym] = idx;
+  }
+
+  NamePool::syminfo_iterator info_it,
+      info_end = m_pModule->getNamePool().syminfo_end();
+  for (info_it = m_pModule->getNamePool().syminfo_begin();
+       info_it != info_end; ++info_it) {
+    const ResolveInfo* info = info_it.getEntry();
+    if (info->isLocal() || ResolveInfo::Section == info->type())
+      continue;
+    IncrementalState::Global global;
+    global.defined = !info->isUndef();
+    global.plain = (0x0 == info->reserved() && !info->isDyn());
+    global.value = (info->outSymbol() != NULL) ? info->outSymbol()->value() : 0;
+    pState.globals()[info->name()] = global;
+  }
+
+  // the objects to patch
+  std::set<std::string> objects;
+  Module::obj_iterator obj, objEnd = m_pModule->obj_end();
+  for (obj = m_pModule->obj_begin(); obj != objEnd; ++obj) {
+    Input& input = **obj;
+    if (0 != input.fileOffset() || !input.hasMemArea() ||
+        input.context()->getSection(".symtab") == NULL)
+      continue;
+
+    IncrementalState::Object record;
+    if (!describeObject(input, record))
+      return false;
+
+    const LDContext& context = *input.context();
+    for (unsigned int i = 0; i < context.numOfSections(); ++i) {
+      const LDSection* sect = context.getSection(i);
+      IncrementalState::Section& rec = record.sections[i];
+      if (sect == NULL)
+        continue;
+
+      PlacementMap::const_iterator place = m_Placements.find(sect);
+      if (place != m_Placements.end()) {
+        const Fragment* first = place->second.first;
+        const LDSection& out = first->getParent()->getSection();
+        rec.placed = true;
+        rec.reserve = place->second.reserve;
+        rec.addr = out.addr() + first->getOffset();
+        rec.offset = out.offset() + first->getOffset();
+      }
+
+      switch (sect->kind()) {
+        case LDFileFormat::Null:
+        case LDFileFormat::NamePool:
+          rec.mode = IncrementalState::Section::Skip;
+          break;
+        case LDFileFormat::Relocation:
+          // decided once the modes of their targets are known
+          break;
+        default:
+          if (rec.placed && llvm::ELF::SHT_NOBITS != rec.type)
+            rec.mode = IncrementalState::Section::Patch;
+          else
+            rec.mode = IncrementalState::Section::Compare;
+          break;
+      }
+    }
+
+    // relocations of patched sections are applied again, the others must
+    // not change
+    for (unsigned int i = 0; i < context.numOfSections(); ++i) {
+      const LDSection* sect = context.getSection(i);
+      IncrementalState::Section& rec = record.sections[i];
+      if (sect == NULL || LDFileFormat::Relocation != sect->kind())
+        continue;
+      if (IncrementalState::Section::Patch == record.sections[rec.link].mode)
+        rec.mode = IncrementalState::Section::Relocs;
+      else
+        rec.mode = IncrementalState::Section::Compare;
+    }
+
+    for (unsigned int i = 0; i < context.numOfSections(); ++i) {
+      IncrementalState::Section& rec = record.sections[i];
+      if (IncrementalState::Section::Compare == rec.mode)
+        rec.digest =
+            IncrementalState::digest(GetContents(input, *context.getSection(i)));
+    }
+
+    // the symbols whose output entries this object owns
+    for (size_t j = 1; j < record.symbols.size(); ++j) {
+      const LDSymbol* in = context.getSymbol(j);
+      if (in == NULL || ResolveInfo::Section == in->resolveInfo()->type())
+        continue;
+      const ResolveInfo* info = in->resolveInfo();
+      const LDSymbol* out = info->outSymbol();
+      if (out == NULL)
+        continue;
+      if (!info->isLocal() && has_dynsym) {
+        record.symbols[j].outIndex = IncrementalState::Symbol::Fixed;
+        continue;
+      }
+      bool owned = in->hasFragRef() && out->hasFragRef() &&
+                   in->fragRef()->frag() == out->fragRef()->frag() &&
+                   in->fragRef()->offset() == out->fragRef()->offset();
+      llvm::DenseMap<const LDSymbol*, int64_t>::const_iterator idx =
+          out_index.find(out);
+      if (owned && idx != out_index.end())
+        record.symbols[j].outIndex = idx->second;
+    }
+
+    objects.insert(record.path);
+    pState.objects().push_back(record);
+  }
+
+  // every other input must not change
+  std::set<std::string> files;
+  InputTree::const_dfs_iterator input,
+      inEnd = m_pModule->getInputTree().dfs_end();
+  for (input = m_pModule->getInputTree().dfs_begin(); input != inEnd;
+       ++input) {
+    if ((*input)->hasMemArea() && objects.count((*input)->path().native()) == 0)
+      files.insert((*input)->path().native());
+  }
+  GeneralOptions::const_script_iterator script,
+      scriptEnd = m_Config.options().script_end();
+  for (script = m_Config.options().script_begin(); script != scriptEnd;
+       ++script)
+    files.insert(*script);
+
+  for (std::set<std::string>::const_iterator file = files.begin(),
+       fEnd = files.end(); file != fEnd; ++file) {
+    IncrementalState::File record;
+    record.path = *file;
+    if (!IncrementalState::identify(record.path, record.identity))
+      return false;
+    pState.files().push_back(record);
+  }
+  return true;
+}
+
+/// preparePatch - check that the only object of this link can take the place
+/// of pRecord in the output described by pState, apply its relocations and
+/// describe it in pUpdate
+bool ObjectLinker::preparePatch(const IncrementalState& pState,
+                                const IncrementalState::Object& pRecord,
+                                IncrementalState::Object& pUpdate) {
+  if (m_pModule->getObjectList().size() != 1)
+    return false;
+  m_pPatchInput = m_pModule->getObjectList().front();
+  m_PatchRelocs.clear();
+  if (!describeObject(*m_pPatchInput, pUpdate))
+    return false;
+
+  // the same sections and symbols
+  if (pUpdate.symbolDigest != pRecord.symbolDigest ||
+      pUpdate.sections.size() != pRecord.sections.size() ||
+      pUpdate.symbols.size() != pRecord.symbols.size())
+    return false;
+
+  LDContext& context = *m_pPatchInput->context();
+  llvm::DenseMap<const LDSection*, uint32_t> index;
+  for (unsigned int i = 0; i < pRecord.sections.size(); ++i) {
+    const IncrementalState::Section& rec = pRecord.sections[i];
+    IncrementalState::Section& update = pUpdate.sections[i];
+    LDSection* sect = context.getSection(i);
+    if (sect == NULL)
+      return false;
+    index[sect] = i;
+    if (IncrementalState::Section::Drop == rec.mode) {
+      update = rec;
+      continue;
+    }
+    if (update.name != rec.name || update.type != rec.type ||
+        update.flag != rec.flag || update.align != rec.align ||
+        update.link != rec.link)
+      return false;
+
+    uint64_t size = update.size;
+    update = rec;
+    switch (rec.mode) {
+      case IncrementalState::Section::Compare:
+        if (size != rec.size ||
+            IncrementalState::digest(GetContents(*m_pPatchInput, *sect)) !=
+                rec.digest)
+          return false;
+        break;
+      case IncrementalState::Section::Patch:
+        // code may grow into its reserve, other sections keep their size
+        if (size > rec.size + rec.reserve)
+          return false;
+        update.size = size;
+        update.reserve = rec.size + rec.reserve - size;
+        break;
+      default:
+        break;
+    }
+
+    // put the section where it is in the output
+    if (rec.placed && sect->hasSectionData()) {
+      sect->setAddr(rec.addr);
+      uint64_t offset = 0;
+      SectionData::iterator frag, fragEnd = sect->getSectionData()->end();
+      for (frag = sect->getSectionData()->begin(); frag != fragEnd; ++frag) {
+        frag->setOffset(offset);
+        offset += frag->size();
+      }
+    }
+  }
+
+  // give the symbols their output values
+  llvm::DenseSet<const ResolveInfo*> unusable;
+  for (size_t j = 1; j < pRecord.symbols.size(); ++j) {
+    pUpdate.symbols[j].outIndex = pRecord.symbols[j].outIndex;
+    LDSymbol* in = context.getSymbol(j);
+    if (in == NULL || ResolveInfo::Section == in->resolveInfo()->type())
+      continue;
+    ResolveInfo* info = in->resolveInfo();
+    LDSymbol* out = info->outSymbol();
+    if (out == NULL)
+      return false;
+
+    // a global without a patchable entry must keep its size
+    if (!info->isLocal() && pRecord.symbols[j].outIndex < 0 &&
+        pUpdate.symbols[j].size != pRecord.symbols[j].size)
+      return false;
+
+    const LDSection* home = GetSection(*in);
+    const IncrementalState::Section* rec =
+        (home != NULL) ? &pRecord.sections[index.lookup(home)] : NULL;
+    bool here = (rec != NULL && IncrementalState::Section::Drop != rec->mode);
+    if (here && !rec->placed) {
+      unusable.insert(info);
+      continue;
+    }
+    uint64_t value = here ? rec->addr + in->fragRef()->getOutputOffset() : 0;
+
+    if (info->isLocal()) {
+      if (here)
+        out->setValue(value);
+      else if (!info->isAbsolute())
+        unusable.insert(info);
+      continue;
+    }
+
+    // the other objects see a global at the value it had
+    IncrementalState::GlobalMap::const_iterator global =
+        pState.globals().find(info->name());
+    if (global == pState.globals().end() || !global->getValue().defined) {
+      if (here)
+        return false;
+      unusable.insert(info);
+      continue;
+    }
+    if (here && value != global->getValue().value)
+      return false;
+    out->setValue(global->getValue().value);
+    info->setDesc(ResolveInfo::Define);
+    if (!global->getValue().plain)
+      unusable.insert(info);
+  }
+
+  // apply the relocations of the patched sections
+  Relocator& relocator = *m_LDBackend.getRelocator();
+  LDContext::sect_iterator rs, rsEnd = context.relocSectEnd();
+  for (rs = context.relocSectBegin(); rs != rsEnd; ++rs) {
+    if (IncrementalState::Section::Relocs !=
+            pRecord.sections[index.lookup(*rs)].mode ||
+        !(*rs)->hasRelocData())
+      continue;
+    const IncrementalState::Section& target =
+        pRecord.sections[index.lookup((*rs)->getLink())];
+    RelocData::iterator reloc, rEnd = (*rs)->getRelocData()->end();
+    for (reloc = (*rs)->getRelocData()->begin(); reloc != rEnd; ++reloc) {
+      Relocation* relocation = llvm::cast<Relocation>(reloc);
+      if (0x0 == relocation->type())
+        continue;
+
+      ResolveInfo* info = relocation->symInfo();
+      if (ResolveInfo::Section == info->type()) {
+        const LDSection* home = GetSection(*info->outSymbol());
+        if (home == NULL)
+          return false;
+        const IncrementalState::Section& rec =
+            pRecord.sections[index.lookup(home)];
+        // the full link left the relocations against dropped sections alone
+        if (IncrementalState::Section::Drop == rec.mode)
+          continue;
+        if (!rec.placed)
+          return false;
+      } else if (unusable.count(info) != 0) {
+        return false;
+      }
+
+      if (!relocator.canApplyAlone(relocation->type()) ||
+          Relocator::OK != relocator.applyRelocation(*relocation))
+        return false;
+      m_PatchRelocs.push_back(std::make_pair(
+          relocation, target.offset + relocation->targetRef().getOutputOffset()));
+    }
+  }
+  return true;
+}
+
+/// emitPatch - write the object checked by preparePatch() into pOutput
+void ObjectLinker::emitPatch(const IncrementalState& pState,
+                             const IncrementalState::Object& pUpdate,
+                             FileOutputBuffer& pOutput) {
+  assert(m_pPatchInput != NULL);
+  uint8_t* data = pOutput.getBufferStart();
+  LDContext& context = *m_pPatchInput->context();
+
+  // the new contents, with the rest of the reserve cleared
+  for (unsigned int i = 0; i < pUpdate.sections.size(); ++i) {
+    const IncrementalState::Section& rec = pUpdate.sections[i];
+    if (IncrementalState::Section::Patch != rec.mode)
+      continue;
+    llvm::StringRef contents =
+        GetContents(*m_pPatchInput, *context.getSection(i));
+    std::memcpy(data + rec.offset, contents.data(), contents.size());
+    std::memset(data + rec.offset + rec.size, 0x0, rec.reserve);
+  }
+
+  Relocator& relocator = *m_LDBackend.getRelocator();
+  for (PatchRelocList::const_iterator reloc = m_PatchRelocs.begin(),
+       rEnd = m_PatchRelocs.end(); reloc != rEnd; ++reloc) {
+    WriteRelocationTarget(*reloc->first,
+                          reloc->first->size(relocator),
+                          m_Config,
+                          data + reloc->second);
+  }
+
+  // the values and sizes of the symbols in the output .symtab
+  if (0 == pState.symtabOffset())
+    return;
+  SymEntry entry = GetSymEntry(m_Config);
+  bool swap =
+      llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian();
+  for (size_t j = 1; j < pUpdate.symbols.size(); ++j) {
+    const IncrementalState::Symbol& sym = pUpdate.symbols[j];
+    if (sym.outIndex < 0)
+      continue;
+    uint8_t* out = data + pState.symtabOffset() + sym.outIndex * entry.size;
+    WriteWord(out + entry.value,
+              context.getSymbol(j)->resolveInfo()->outSymbol()->value(),
+              entry.word,
+              swap);
+    WriteWord(out + entry.symSize, sym.size, entry.word, swap);
   }
 }
 
@@ -11,6 +11,8 @@
 #include "mcld/Fragment/NullFragment.h"
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/SectionData.h"
+#include "mcld/MC/Input.h"
+#include "mcld/Object/ObjectBuilder.h"
 #include "mcld/Script/Assignment.h"
 #include "mcld/Script/Operand.h"
 #include "mcld/Script/Operator.h"
@@ -20,6 +22,7 @@
 
 #include <llvm/Support/Casting.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <climits>
@@ -34,6 +37,74 @@
 
 namespace mcld {
 
+namespace {
+
+/// SortKey - an input section held back by a sorted input description
+struct SortKey {
+  const Input* file;
+  LDSection* section;
+  unsigned int pattern;  ///< the index of the pattern it matches
+  WildcardPattern::SortPolicy policy;
+};
+
+/// InitPriority - the priority that ends the name of an .init_array,
+/// .fini_array, .ctors or .dtors section. .ctors and .dtors run backwards,
+/// and a section without one goes last.
+uint64_t InitPriority(llvm::StringRef pName) {
+  const uint64_t none = 65536;
+  uint64_t priority;
+  if (pName.rsplit('.').second.getAsInteger(10, priority) || priority >= none)
+    return none;
+  if (pName.startswith(".ctors") || pName.startswith(".dtors"))
+    return 65535 - priority;
+  return priority;
+}
+
+/// SortCompare - order SortKeys by the file name if the file pattern is
+/// sorted, then by the pattern, then by the policy of the pattern
+class SortCompare {
+ public:
+  explicit SortCompare(bool pByFile) : m_bByFile(pByFile) {}
+
+  bool operator()(const SortKey& pA, const SortKey& pB) const {
+    if (m_bByFile) {
+      int order = pA.file->path().native().compare(pB.file->path().native());
+      if (order != 0)
+        return order < 0;
+    }
+    if (pA.pattern != pB.pattern)
+      return pA.pattern < pB.pattern;
+
+    const std::string& name_a = pA.section->name();
+    const std::string& name_b = pB.section->name();
+    // larger alignments first, the way GNU ld does
+    uint32_t align_a = pA.section->align(), align_b = pB.section->align();
+    switch (pA.policy) {
+      case WildcardPattern::SORT_BY_NAME:
+        return name_a < name_b;
+      case WildcardPattern::SORT_BY_ALIGNMENT:
+        return align_a > align_b;
+      case WildcardPattern::SORT_BY_NAME_ALIGNMENT:
+        if (name_a != name_b)
+          return name_a < name_b;
+        return align_a > align_b;
+      case WildcardPattern::SORT_BY_ALIGNMENT_NAME:
+        if (align_a != align_b)
+          return align_a > align_b;
+        return name_a < name_b;
+      case WildcardPattern::SORT_BY_INIT_PRIORITY:
+        return InitPriority(name_a) < InitPriority(name_b);
+      default:
+        return false;
+    }
+  }
+
+ private:
+  bool m_bByFile;
+};
+
+}  // anonymous namespace
+
 //===----------------------------------------------------------------------===//
 // SectionMap::Input
 //===----------------------------------------------------------------------===//
@@ -48,6 +119,7 @@ SectionMap::Input::Input(const std::string& pName,
   sections->push_back(
       WildcardPattern::create(pName, WildcardPattern::SORT_NONE));
   m_Spec.m_pWildcardSections = sections;
+  m_bSorted = false;
 
   m_pSection = LDSection::Create(pName, LDFileFormat::TEXT, 0, 0);
   SectionData* sd = SectionData::Create(*m_pSection);
@@ -61,6 +133,16 @@ SectionMap::Input::Input(const InputSectDesc& pInputDesc)
   m_Spec.m_pWildcardFile = pInputDesc.spec().m_pWildcardFile;
   m_Spec.m_pExcludeFiles = pInputDesc.spec().m_pExcludeFiles;
   m_Spec.m_pWildcardSections = pInputDesc.spec().m_pWildcardSections;
+  m_bSorted = m_Spec.hasFile() &&
+              m_Spec.file().sortPolicy() != WildcardPattern::SORT_NONE;
+  if (m_Spec.hasSections()) {
+    StringList::const_iterator sect, sectEnd = m_Spec.sections().end();
+    for (sect = m_Spec.sections().begin(); sect != sectEnd; ++sect) {
+      if (llvm::cast<WildcardPattern>(*sect)->sortPolicy() !=
+          WildcardPattern::SORT_NONE)
+        m_bSorted = true;
+    }
+  }
   m_pSection = LDSection::Create("", LDFileFormat::TEXT, 0, 0);
   SectionData* sd = SectionData::Create(*m_pSection);
   m_pSection->setSectionData(sd);
@@ -68,6 +150,43 @@ SectionMap::Input::Input(const InputSectDesc& pInputDesc)
   new NullFragment(sd);
 }
 
+void SectionMap::Input::placeSorted() {
+  if (m_SortList.empty())
+    return;
+
+  // every section is keyed by the first pattern it matches, and sections of
+  // different patterns keep the order of the patterns
+  std::vector<SortKey> keys;
+  keys.reserve(m_SortList.size());
+  for (SortList::iterator it = m_SortList.begin(), ie = m_SortList.end();
+       it != ie; ++it) {
+    SortKey key = {it->first, it->second, 0, WildcardPattern::SORT_NONE};
+    if (m_Spec.hasSections()) {
+      StringList::const_iterator sect, sectEnd = m_Spec.sections().end();
+      for (sect = m_Spec.sections().begin(); sect != sectEnd;
+           ++sect, ++key.pattern) {
+        const WildcardPattern& pattern = *llvm::cast<WildcardPattern>(*sect);
+        if (matched(pattern, it->second->name())) {
+          key.policy = pattern.sortPolicy();
+          break;
+        }
+      }
+    }
+    keys.push_back(key);
+  }
+
+  bool by_file = m_Spec.hasFile() &&
+                 m_Spec.file().sortPolicy() == WildcardPattern::SORT_BY_NAME;
+  std::stable_sort(keys.begin(), keys.end(), SortCompare(by_file));
+
+  for (std::vector<SortKey>::iterator key = keys.begin(), ie = keys.end();
+       key != ie; ++key) {
+    ObjectBuilder::MoveSectionData(*key->section->getSectionData(),
+                                   *m_pSection->getSectionData());
+  }
+  m_SortList.clear();
+}
+
 //===----------------------------------------------------------------------===//
 // SectionMap::Output
 //===----------------------------------------------------------------------===//
@@ -322,7 +441,7 @@ bool SectionMap::matched(const SectionMap::Input& pInput,
 }
 
 bool SectionMap::matched(const WildcardPattern& pPattern,
-                         const std::string& pName) const {
+                         const std::string& pName) {
   if (pPattern.isPrefix()) {
     llvm::StringRef name(pName);
     return name.startswith(pPattern.prefix());
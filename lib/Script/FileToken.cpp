@@ -9,13 +9,15 @@
 #include "mcld/Script/FileToken.h"
 
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-typedef GCFactory<FileToken, MCLD_SYMBOLS_PER_INPUT> FileTokenFactory;
-static llvm::ManagedStatic<FileTokenFactory> g_FileTokenFactory;
+typedef ArenaGCFactory<FileToken, MCLD_SYMBOLS_PER_INPUT> FileTokenFactory;
+static inline FileTokenFactory& CurrentFileTokenFactory() {
+  return LinkContext::current().get<FileTokenFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // FileToken
@@ -31,19 +33,19 @@ FileToken::~FileToken() {
 }
 
 FileToken* FileToken::create(const std::string& pName, bool pAsNeeded) {
-  FileToken* result = g_FileTokenFactory->allocate();
+  FileToken* result = CurrentFileTokenFactory().allocate();
   new (result) FileToken(pName, pAsNeeded);
   return result;
 }
 
 void FileToken::destroy(FileToken*& pFileToken) {
-  g_FileTokenFactory->destroy(pFileToken);
-  g_FileTokenFactory->deallocate(pFileToken);
+  CurrentFileTokenFactory().destroy(pFileToken);
+  CurrentFileTokenFactory().deallocate(pFileToken);
   pFileToken = NULL;
 }
 
 void FileToken::clear() {
-  g_FileTokenFactory->clear();
+  CurrentFileTokenFactory().clear();
 }
 
 }  // namespace mcld
@@ -77,6 +77,9 @@ void InputSectDesc::dump() const {
           case WildcardPattern::SORT_BY_ALIGNMENT_NAME:
             mcld::outs() << "SORT_BY_ALIGNMENT_NAME (";
             break;
+          case WildcardPattern::SORT_BY_INIT_PRIORITY:
+            mcld::outs() << "SORT_BY_INIT_PRIORITY (";
+            break;
           default:
             break;
         }
@@ -9,13 +9,15 @@
 #include "mcld/Script/NameSpec.h"
 
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-typedef GCFactory<NameSpec, MCLD_SYMBOLS_PER_INPUT> NameSpecFactory;
-static llvm::ManagedStatic<NameSpecFactory> g_NameSpecFactory;
+typedef ArenaGCFactory<NameSpec, MCLD_SYMBOLS_PER_INPUT> NameSpecFactory;
+static inline NameSpecFactory& CurrentNameSpecFactory() {
+  return LinkContext::current().get<NameSpecFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // NameSpec
@@ -31,19 +33,19 @@ NameSpec::~NameSpec() {
 }
 
 NameSpec* NameSpec::create(const std::string& pName, bool pAsNeeded) {
-  NameSpec* result = g_NameSpecFactory->allocate();
+  NameSpec* result = CurrentNameSpecFactory().allocate();
   new (result) NameSpec(pName, pAsNeeded);
   return result;
 }
 
 void NameSpec::destroy(NameSpec*& pNameSpec) {
-  g_NameSpecFactory->destroy(pNameSpec);
-  g_NameSpecFactory->deallocate(pNameSpec);
+  CurrentNameSpecFactory().destroy(pNameSpec);
+  CurrentNameSpecFactory().deallocate(pNameSpec);
   pNameSpec = NULL;
 }
 
 void NameSpec::clear() {
-  g_NameSpecFactory->clear();
+  CurrentNameSpecFactory().clear();
 }
 
 }  // namespace mcld
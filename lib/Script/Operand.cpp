@@ -12,9 +12,9 @@
 #include "mcld/LD/LDSection.h"
 #include "mcld/LD/SectionData.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 #include "mcld/Support/raw_ostream.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
@@ -30,8 +30,10 @@ Operand::~Operand() {
 //===----------------------------------------------------------------------===//
 // SymOperand
 //===----------------------------------------------------------------------===//
-typedef GCFactory<SymOperand, MCLD_SYMBOLS_PER_INPUT> SymOperandFactory;
-static llvm::ManagedStatic<SymOperandFactory> g_SymOperandFactory;
+typedef ArenaGCFactory<SymOperand, MCLD_SYMBOLS_PER_INPUT> SymOperandFactory;
+static inline SymOperandFactory& CurrentSymOperandFactory() {
+  return LinkContext::current().get<SymOperandFactory>();
+}
 
 SymOperand::SymOperand() : Operand(Operand::SYMBOL), m_Value(0) {
 }
@@ -50,26 +52,28 @@ bool SymOperand::isDot() const {
 }
 
 SymOperand* SymOperand::create(const std::string& pName) {
-  SymOperand* result = g_SymOperandFactory->allocate();
+  SymOperand* result = CurrentSymOperandFactory().allocate();
   new (result) SymOperand(pName);
   return result;
 }
 
 void SymOperand::destroy(SymOperand*& pOperand) {
-  g_SymOperandFactory->destroy(pOperand);
-  g_SymOperandFactory->deallocate(pOperand);
+  CurrentSymOperandFactory().destroy(pOperand);
+  CurrentSymOperandFactory().deallocate(pOperand);
   pOperand = NULL;
 }
 
 void SymOperand::clear() {
-  g_SymOperandFactory->clear();
+  CurrentSymOperandFactory().clear();
 }
 
 //===----------------------------------------------------------------------===//
 // IntOperand
 //===----------------------------------------------------------------------===//
-typedef GCFactory<IntOperand, MCLD_SYMBOLS_PER_INPUT> IntOperandFactory;
-static llvm::ManagedStatic<IntOperandFactory> g_IntOperandFactory;
+typedef ArenaGCFactory<IntOperand, MCLD_SYMBOLS_PER_INPUT> IntOperandFactory;
+static inline IntOperandFactory& CurrentIntOperandFactory() {
+  return LinkContext::current().get<IntOperandFactory>();
+}
 
 IntOperand::IntOperand() : Operand(Operand::INTEGER), m_Value(0) {
 }
@@ -83,26 +87,28 @@ void IntOperand::dump() const {
 }
 
 IntOperand* IntOperand::create(uint64_t pValue) {
-  IntOperand* result = g_IntOperandFactory->allocate();
+  IntOperand* result = CurrentIntOperandFactory().allocate();
   new (result) IntOperand(pValue);
   return result;
 }
 
 void IntOperand::destroy(IntOperand*& pOperand) {
-  g_IntOperandFactory->destroy(pOperand);
-  g_IntOperandFactory->deallocate(pOperand);
+  CurrentIntOperandFactory().destroy(pOperand);
+  CurrentIntOperandFactory().deallocate(pOperand);
   pOperand = NULL;
 }
 
 void IntOperand::clear() {
-  g_IntOperandFactory->clear();
+  CurrentIntOperandFactory().clear();
 }
 
 //===----------------------------------------------------------------------===//
 // SectOperand
 //===----------------------------------------------------------------------===//
-typedef GCFactory<SectOperand, MCLD_SECTIONS_PER_INPUT> SectOperandFactory;
-static llvm::ManagedStatic<SectOperandFactory> g_SectOperandFactory;
+typedef ArenaGCFactory<SectOperand, MCLD_SECTIONS_PER_INPUT> SectOperandFactory;
+static inline SectOperandFactory& CurrentSectOperandFactory() {
+  return LinkContext::current().get<SectOperandFactory>();
+}
 SectOperand::SectOperand() : Operand(Operand::SECTION) {
 }
 
@@ -115,27 +121,29 @@ void SectOperand::dump() const {
 }
 
 SectOperand* SectOperand::create(const std::string& pName) {
-  SectOperand* result = g_SectOperandFactory->allocate();
+  SectOperand* result = CurrentSectOperandFactory().allocate();
   new (result) SectOperand(pName);
   return result;
 }
 
 void SectOperand::destroy(SectOperand*& pOperand) {
-  g_SectOperandFactory->destroy(pOperand);
-  g_SectOperandFactory->deallocate(pOperand);
+  CurrentSectOperandFactory().destroy(pOperand);
+  CurrentSectOperandFactory().deallocate(pOperand);
   pOperand = NULL;
 }
 
 void SectOperand::clear() {
-  g_SectOperandFactory->clear();
+  CurrentSectOperandFactory().clear();
 }
 
 //===----------------------------------------------------------------------===//
 // SectDescOperand
 //===----------------------------------------------------------------------===//
-typedef GCFactory<SectDescOperand, MCLD_SECTIONS_PER_INPUT>
+typedef ArenaGCFactory<SectDescOperand, MCLD_SECTIONS_PER_INPUT>
     SectDescOperandFactory;
-static llvm::ManagedStatic<SectDescOperandFactory> g_SectDescOperandFactory;
+static inline SectDescOperandFactory& CurrentSectDescOperandFactory() {
+  return LinkContext::current().get<SectDescOperandFactory>();
+}
 SectDescOperand::SectDescOperand()
     : Operand(Operand::SECTION_DESC), m_pOutputDesc(NULL) {
 }
@@ -151,26 +159,28 @@ void SectDescOperand::dump() const {
 
 SectDescOperand* SectDescOperand::create(
     const SectionMap::Output* pOutputDesc) {
-  SectDescOperand* result = g_SectDescOperandFactory->allocate();
+  SectDescOperand* result = CurrentSectDescOperandFactory().allocate();
   new (result) SectDescOperand(pOutputDesc);
   return result;
 }
 
 void SectDescOperand::destroy(SectDescOperand*& pOperand) {
-  g_SectDescOperandFactory->destroy(pOperand);
-  g_SectDescOperandFactory->deallocate(pOperand);
+  CurrentSectDescOperandFactory().destroy(pOperand);
+  CurrentSectDescOperandFactory().deallocate(pOperand);
   pOperand = NULL;
 }
 
 void SectDescOperand::clear() {
-  g_SectDescOperandFactory->clear();
+  CurrentSectDescOperandFactory().clear();
 }
 
 //===----------------------------------------------------------------------===//
 // FragOperand
 //===----------------------------------------------------------------------===//
-typedef GCFactory<FragOperand, MCLD_SYMBOLS_PER_INPUT> FragOperandFactory;
-static llvm::ManagedStatic<FragOperandFactory> g_FragOperandFactory;
+typedef ArenaGCFactory<FragOperand, MCLD_SYMBOLS_PER_INPUT> FragOperandFactory;
+static inline FragOperandFactory& CurrentFragOperandFactory() {
+  return LinkContext::current().get<FragOperandFactory>();
+}
 
 FragOperand::FragOperand() : Operand(Operand::FRAGMENT), m_pFragment(NULL) {
 }
@@ -189,19 +199,19 @@ uint64_t FragOperand::value() const {
 }
 
 FragOperand* FragOperand::create(Fragment& pFragment) {
-  FragOperand* result = g_FragOperandFactory->allocate();
+  FragOperand* result = CurrentFragOperandFactory().allocate();
   new (result) FragOperand(pFragment);
   return result;
 }
 
 void FragOperand::destroy(FragOperand*& pOperand) {
-  g_FragOperandFactory->destroy(pOperand);
-  g_FragOperandFactory->deallocate(pOperand);
+  CurrentFragOperandFactory().destroy(pOperand);
+  CurrentFragOperandFactory().deallocate(pOperand);
   pOperand = NULL;
 }
 
 void FragOperand::clear() {
-  g_FragOperandFactory->clear();
+  CurrentFragOperandFactory().clear();
 }
 
 }  // namespace mcld
@@ -12,15 +12,17 @@
 #include "mcld/Script/Operand.h"
 #include "mcld/Script/Operator.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 #include "mcld/Support/raw_ostream.h"
 
-#include <llvm/Support/ManagedStatic.h>
 #include <llvm/Support/Casting.h>
 
 namespace mcld {
 
-typedef GCFactory<RpnExpr, MCLD_SYMBOLS_PER_INPUT> ExprFactory;
-static llvm::ManagedStatic<ExprFactory> g_ExprFactory;
+typedef ArenaGCFactory<RpnExpr, MCLD_SYMBOLS_PER_INPUT> ExprFactory;
+static inline ExprFactory& CurrentExprFactory() {
+  return LinkContext::current().get<ExprFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // RpnExpr
@@ -52,19 +54,19 @@ void RpnExpr::push_back(ExprToken* pToken) {
 }
 
 RpnExpr* RpnExpr::create() {
-  RpnExpr* result = g_ExprFactory->allocate();
+  RpnExpr* result = CurrentExprFactory().allocate();
   new (result) RpnExpr();
   return result;
 }
 
 void RpnExpr::destroy(RpnExpr*& pRpnExpr) {
-  g_ExprFactory->destroy(pRpnExpr);
-  g_ExprFactory->deallocate(pRpnExpr);
+  CurrentExprFactory().destroy(pRpnExpr);
+  CurrentExprFactory().deallocate(pRpnExpr);
   pRpnExpr = NULL;
 }
 
 void RpnExpr::clear() {
-  g_ExprFactory->clear();
+  CurrentExprFactory().clear();
 }
 
 RpnExpr::iterator RpnExpr::insert(iterator pPosition, ExprToken* pToken) {
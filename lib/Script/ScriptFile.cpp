@@ -27,11 +27,11 @@
 #include "mcld/Script/StrToken.h"
 #include "mcld/MC/Input.h"
 #include "mcld/MC/InputBuilder.h"
+#include "mcld/Support/LinkContext.h"
 #include "mcld/Support/MemoryArea.h"
 #include "mcld/InputTree.h"
 
 #include <llvm/Support/Casting.h>
-#include <llvm/Support/ManagedStatic.h>
 
 #include <cassert>
 
@@ -42,7 +42,9 @@ typedef HashEntry<std::string, void*, hash::StringCompare<std::string> >
 typedef HashTable<ParserStrEntry,
                   hash::StringHash<hash::DJB>,
                   EntryFactory<ParserStrEntry> > ParserStrPool;
-static llvm::ManagedStatic<ParserStrPool> g_ParserStrPool;
+static inline ParserStrPool& CurrentParserStrPool() {
+  return LinkContext::current().get<ParserStrPool>();
+}
 
 //===----------------------------------------------------------------------===//
 // ScriptFile
@@ -235,12 +237,12 @@ const std::string& ScriptFile::createParserStr(const char* pText,
                                                size_t pLength) {
   bool exist = false;
   ParserStrEntry* entry =
-      g_ParserStrPool->insert(std::string(pText, pLength), exist);
+      CurrentParserStrPool().insert(std::string(pText, pLength), exist);
   return entry->key();
 }
 
 void ScriptFile::clearParserStrPool() {
-  g_ParserStrPool->clear();
+  CurrentParserStrPool().clear();
 }
 
 }  // namespace mcld
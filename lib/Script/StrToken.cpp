@@ -9,13 +9,15 @@
 #include "mcld/Script/StrToken.h"
 
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-typedef GCFactory<StrToken, MCLD_SYMBOLS_PER_INPUT> StrTokenFactory;
-static llvm::ManagedStatic<StrTokenFactory> g_StrTokenFactory;
+typedef ArenaGCFactory<StrToken, MCLD_SYMBOLS_PER_INPUT> StrTokenFactory;
+static inline StrTokenFactory& CurrentStrTokenFactory() {
+  return LinkContext::current().get<StrTokenFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // StrToken
@@ -31,19 +33,19 @@ StrToken::~StrToken() {
 }
 
 StrToken* StrToken::create(const std::string& pString) {
-  StrToken* result = g_StrTokenFactory->allocate();
+  StrToken* result = CurrentStrTokenFactory().allocate();
   new (result) StrToken(String, pString);
   return result;
 }
 
 void StrToken::destroy(StrToken*& pStrToken) {
-  g_StrTokenFactory->destroy(pStrToken);
-  g_StrTokenFactory->deallocate(pStrToken);
+  CurrentStrTokenFactory().destroy(pStrToken);
+  CurrentStrTokenFactory().deallocate(pStrToken);
   pStrToken = NULL;
 }
 
 void StrToken::clear() {
-  g_StrTokenFactory->clear();
+  CurrentStrTokenFactory().clear();
 }
 
 }  // namespace mcld
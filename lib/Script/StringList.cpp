@@ -10,14 +10,16 @@
 
 #include "mcld/Script/StrToken.h"
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 #include "mcld/Support/raw_ostream.h"
 
-#include <llvm/Support/ManagedStatic.h>
 
 namespace mcld {
 
-typedef GCFactory<StringList, MCLD_SYMBOLS_PER_INPUT> StringListFactory;
-static llvm::ManagedStatic<StringListFactory> g_StringListFactory;
+typedef ArenaGCFactory<StringList, MCLD_SYMBOLS_PER_INPUT> StringListFactory;
+static inline StringListFactory& CurrentStringListFactory() {
+  return LinkContext::current().get<StringListFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // StringList
@@ -39,19 +41,19 @@ void StringList::dump() const {
 }
 
 StringList* StringList::create() {
-  StringList* result = g_StringListFactory->allocate();
+  StringList* result = CurrentStringListFactory().allocate();
   new (result) StringList();
   return result;
 }
 
 void StringList::destroy(StringList*& pStringList) {
-  g_StringListFactory->destroy(pStringList);
-  g_StringListFactory->deallocate(pStringList);
+  CurrentStringListFactory().destroy(pStringList);
+  CurrentStringListFactory().deallocate(pStringList);
   pStringList = NULL;
 }
 
 void StringList::clear() {
-  g_StringListFactory->clear();
+  CurrentStringListFactory().clear();
 }
 
 }  // namespace mcld
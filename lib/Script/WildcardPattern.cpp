@@ -9,16 +9,18 @@
 #include "mcld/Script/WildcardPattern.h"
 
 #include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
 #include "mcld/Support/raw_ostream.h"
 
-#include <llvm/Support/ManagedStatic.h>
 #include <cassert>
 
 namespace mcld {
 
-typedef GCFactory<WildcardPattern, MCLD_SYMBOLS_PER_INPUT>
+typedef ArenaGCFactory<WildcardPattern, MCLD_SYMBOLS_PER_INPUT>
     WildcardPatternFactory;
-static llvm::ManagedStatic<WildcardPatternFactory> g_WildcardPatternFactory;
+static inline WildcardPatternFactory& CurrentWildcardPatternFactory() {
+  return LinkContext::current().get<WildcardPatternFactory>();
+}
 
 //===----------------------------------------------------------------------===//
 // WildcardPattern
@@ -47,19 +49,19 @@ llvm::StringRef WildcardPattern::prefix() const {
 
 WildcardPattern* WildcardPattern::create(const std::string& pPattern,
                                          SortPolicy pPolicy) {
-  WildcardPattern* result = g_WildcardPatternFactory->allocate();
+  WildcardPattern* result = CurrentWildcardPatternFactory().allocate();
   new (result) WildcardPattern(pPattern, pPolicy);
   return result;
 }
 
 void WildcardPattern::destroy(WildcardPattern*& pWildcardPattern) {
-  g_WildcardPatternFactory->destroy(pWildcardPattern);
-  g_WildcardPatternFactory->deallocate(pWildcardPattern);
+  CurrentWildcardPatternFactory().destroy(pWildcardPattern);
+  CurrentWildcardPatternFactory().deallocate(pWildcardPattern);
   pWildcardPattern = NULL;
 }
 
 void WildcardPattern::clear() {
-  g_WildcardPatternFactory->clear();
+  CurrentWildcardPatternFactory().clear();
 }
 
 }  // namespace mcld
@@ -0,0 +1,200 @@
+//===- Arena.cpp ----------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/Arena.h"
+
+#include "mcld/Support/LinkContext.h"
+#include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/SystemUtils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+namespace mcld {
+
+namespace {
+
+const size_t kHugePageSize = 2 * 1024 * 1024;
+
+/// the bump pointer of this thread for an arena
+struct CacheEntry {
+  uint64_t id;
+  void* state;
+};
+
+/// the number of arenas whose bump pointers a thread keeps at hand
+const size_t kCacheEntries = 8;
+
+}  // anonymous namespace
+
+/// t_Cache - the bump pointers of this thread, by arena id
+static thread_local CacheEntry t_Cache[kCacheEntries];
+
+/// g_NextArenaId - arena ids are never reused, so an entry of a gone arena
+/// never matches. 0 marks an empty entry.
+static std::atomic<uint64_t> g_NextArenaId(1);
+
+static size_t AlignTo(size_t pValue, size_t pAlign) {
+  return (pValue + pAlign - 1) & ~(pAlign - 1);
+}
+
+static Arena::Policy DefaultPolicy() {
+  Arena::Policy policy = {64 * 1024, 16 * 1024 * 1024, false};
+  return policy;
+}
+
+//===----------------------------------------------------------------------===//
+// Arena
+//===----------------------------------------------------------------------===//
+Arena::Arena()
+    : m_Policy(DefaultPolicy()),
+      m_Id(g_NextArenaId++),
+      m_NextSlabSize(m_Policy.initialSlabSize) {
+}
+
+Arena::Arena(const Policy& pPolicy)
+    : m_Policy(pPolicy),
+      m_Id(g_NextArenaId++),
+      m_NextSlabSize(pPolicy.initialSlabSize) {
+  assert(pPolicy.initialSlabSize != 0 &&
+         pPolicy.initialSlabSize <= pPolicy.maxSlabSize);
+}
+
+Arena::~Arena() {
+  unmapSlabs();
+}
+
+Arena& Arena::current() {
+  return LinkContext::current().get<Arena>();
+}
+
+void Arena::setHugePages(bool pEnable) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Policy.hugePages = pEnable;
+}
+
+void* Arena::bump(ThreadState& pState, size_t pSize, size_t pAlign) {
+  if (pState.cur == NULL)
+    return NULL;
+  size_t begin = AlignTo(reinterpret_cast<size_t>(pState.cur), pAlign);
+  if (begin + pSize > reinterpret_cast<size_t>(pState.end))
+    return NULL;
+  pState.cur = reinterpret_cast<char*>(begin + pSize);
+  pState.allocated += pSize;
+  return reinterpret_cast<void*>(begin);
+}
+
+void* Arena::allocate(size_t pSize, size_t pAlign) {
+  assert((pAlign & (pAlign - 1)) == 0 && "alignment is not a power of two");
+  if (pSize == 0)
+    pSize = 1;
+
+  CacheEntry& entry = t_Cache[m_Id % kCacheEntries];
+  if (entry.id == m_Id) {
+    void* result = bump(*static_cast<ThreadState*>(entry.state), pSize, pAlign);
+    if (result != NULL)
+      return result;
+  }
+  return allocateSlow(pSize, pAlign);
+}
+
+void* Arena::allocateSlow(size_t pSize, size_t pAlign) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  ThreadState& state = getThreadState();
+  CacheEntry& entry = t_Cache[m_Id % kCacheEntries];
+  entry.id = m_Id;
+  entry.state = &state;
+
+  // another arena may have taken the entry while this slab had room
+  void* result = bump(state, pSize, pAlign);
+  if (result != NULL)
+    return result;
+
+  // a large allocation takes a slab of its own, and the thread keeps the
+  // rest of its slab
+  if (pSize + pAlign > m_NextSlabSize / 4) {
+    Slab slab = mapSlab(pSize + pAlign);
+    state.allocated += pSize;
+    return reinterpret_cast<void*>(
+        AlignTo(reinterpret_cast<size_t>(slab.begin), pAlign));
+  }
+
+  Slab slab = mapSlab(m_NextSlabSize);
+  m_NextSlabSize = std::min(m_NextSlabSize * 2, m_Policy.maxSlabSize);
+  state.cur = slab.begin;
+  state.end = slab.begin + slab.size;
+  return bump(state, pSize, pAlign);
+}
+
+Arena::ThreadState& Arena::getThreadState() {
+  std::thread::id id = std::this_thread::get_id();
+  for (size_t i = 0; i < m_Threads.size(); ++i) {
+    if (m_Threads[i]->owner == id)
+      return *m_Threads[i];
+  }
+  ThreadState* state = new ThreadState();
+  state->owner = id;
+  state->cur = NULL;
+  state->end = NULL;
+  state->allocated = 0;
+  m_Threads.push_back(state);
+  return *state;
+}
+
+Arena::Slab Arena::mapSlab(size_t pSize) {
+  size_t page = m_Policy.hugePages ? kHugePageSize : sys::GetPageSize();
+  Slab slab;
+  slab.size = AlignTo(pSize, page);
+  slab.begin =
+      static_cast<char*>(sys::AllocatePages(slab.size, m_Policy.hugePages));
+  if (slab.begin == NULL)
+    fatal(diag::fatal_cannot_map_arena) << slab.size;
+  m_Slabs.push_back(slab);
+  return slab;
+}
+
+void Arena::unmapSlabs() {
+  for (size_t i = 0; i < m_Slabs.size(); ++i)
+    sys::FreePages(m_Slabs[i].begin, m_Slabs[i].size);
+  m_Slabs.clear();
+  for (size_t i = 0; i < m_Threads.size(); ++i)
+    delete m_Threads[i];
+  m_Threads.clear();
+}
+
+void Arena::reset() {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  unmapSlabs();
+  // forget the bump pointers cached by the threads
+  m_Id = g_NextArenaId++;
+  m_NextSlabSize = m_Policy.initialSlabSize;
+}
+
+size_t Arena::numOfSlabs() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Slabs.size();
+}
+
+uint64_t Arena::bytesReserved() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  uint64_t result = 0;
+  for (size_t i = 0; i < m_Slabs.size(); ++i)
+    result += m_Slabs[i].size;
+  return result;
+}
+
+uint64_t Arena::bytesAllocated() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  uint64_t result = 0;
+  for (size_t i = 0; i < m_Threads.size(); ++i)
+    result += m_Threads[i]->allocated;
+  return result;
+}
+
+}  // namespace mcld
@@ -0,0 +1,105 @@
+//===- Compression.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/Compression.h"
+
+#include "mcld/Support/Parallel.h"
+
+#include <cassert>
+#include <cstring>
+
+#include <zlib.h>
+
+namespace mcld {
+namespace zlib {
+
+namespace {
+
+/// the size of the chunks deflated by one thread at a time
+const size_t kChunkSize = 1024 * 1024;
+
+/// DeflateChunk - deflate pChunk into raw deflate data without the zlib
+/// header and trailer. Only the last chunk ends the stream.
+void DeflateChunk(llvm::ArrayRef<uint8_t> pChunk,
+                  bool pLast,
+                  std::vector<uint8_t>& pOutput) {
+  z_stream stream;
+  std::memset(&stream, 0, sizeof(stream));
+  int result = deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS,
+                            8, Z_DEFAULT_STRATEGY);
+  assert(Z_OK == result && "cannot initialize deflate");
+  (void)result;
+
+  // leave room for the empty block of a sync flush
+  pOutput.resize(deflateBound(&stream, pChunk.size()) + 16);
+  stream.next_in = const_cast<Bytef*>(pChunk.data());
+  stream.avail_in = pChunk.size();
+  stream.next_out = pOutput.data();
+  stream.avail_out = pOutput.size();
+
+  int flush = pLast ? Z_FINISH : Z_SYNC_FLUSH;
+  while (true) {
+    result = deflate(&stream, flush);
+    if (pLast ? (Z_STREAM_END == result)
+              : (0 == stream.avail_in && 0 != stream.avail_out))
+      break;
+    size_t used = pOutput.size() - stream.avail_out;
+    pOutput.resize(pOutput.size() * 2);
+    stream.next_out = pOutput.data() + used;
+    stream.avail_out = pOutput.size() - used;
+  }
+  pOutput.resize(pOutput.size() - stream.avail_out);
+  deflateEnd(&stream);
+}
+
+}  // anonymous namespace
+
+void compress(llvm::ArrayRef<uint8_t> pInput,
+              unsigned pNumThreads,
+              std::vector<uint8_t>& pOutput) {
+  size_t num_of_chunks =
+      std::max<size_t>(1, (pInput.size() + kChunkSize - 1) / kChunkSize);
+  std::vector<std::vector<uint8_t> > shards(num_of_chunks);
+  std::vector<uLong> checksums(num_of_chunks);
+  parallel::forEach(pNumThreads, num_of_chunks, 1, [&](size_t pChunk) {
+    size_t begin = pChunk * kChunkSize;
+    llvm::ArrayRef<uint8_t> chunk =
+        pInput.slice(begin, std::min(kChunkSize, pInput.size() - begin));
+    DeflateChunk(chunk, (pChunk + 1 == num_of_chunks), shards[pChunk]);
+    checksums[pChunk] = adler32(adler32(0, Z_NULL, 0), chunk.data(),
+                                chunk.size());
+  });
+
+  // a zlib header of 32K window and fastest compression
+  pOutput.clear();
+  pOutput.push_back(0x78);
+  pOutput.push_back(0x01);
+
+  uLong checksum = checksums[0];
+  pOutput.insert(pOutput.end(), shards[0].begin(), shards[0].end());
+  for (size_t i = 1; i < num_of_chunks; ++i) {
+    size_t length = std::min(kChunkSize, pInput.size() - i * kChunkSize);
+    checksum = adler32_combine(checksum, checksums[i], length);
+    pOutput.insert(pOutput.end(), shards[i].begin(), shards[i].end());
+  }
+
+  // the checksum is stored in big endian
+  for (int shift = 24; shift >= 0; shift -= 8)
+    pOutput.push_back(static_cast<uint8_t>(checksum >> shift));
+}
+
+bool uncompress(llvm::ArrayRef<uint8_t> pInput,
+                uint8_t* pOutput,
+                size_t pSize) {
+  uLongf length = pSize;
+  int result = ::uncompress(pOutput, &length, pInput.data(), pInput.size());
+  return (Z_OK == result) && (length == pSize);
+}
+
+}  // namespace zlib
+}  // namespace mcld
@@ -0,0 +1,192 @@
+//===- Digest.cpp ---------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/Digest.h"
+
+#include <cstring>
+
+namespace mcld {
+namespace digest {
+
+namespace {
+
+uint64_t Rotl64(uint64_t pValue, unsigned pBits) {
+  return (pValue << pBits) | (pValue >> (64 - pBits));
+}
+
+uint32_t Rotl32(uint32_t pValue, unsigned pBits) {
+  return (pValue << pBits) | (pValue >> (32 - pBits));
+}
+
+/// Read64LE - read a little-endian 64-bit word on any host
+uint64_t Read64LE(const uint8_t* pData) {
+  uint64_t result = 0;
+  for (unsigned i = 0; i < 8; ++i)
+    result |= static_cast<uint64_t>(pData[i]) << (8 * i);
+  return result;
+}
+
+uint32_t Read32LE(const uint8_t* pData) {
+  uint32_t result = 0;
+  for (unsigned i = 0; i < 4; ++i)
+    result |= static_cast<uint32_t>(pData[i]) << (8 * i);
+  return result;
+}
+
+uint32_t Read32BE(const uint8_t* pData) {
+  return (static_cast<uint32_t>(pData[0]) << 24) |
+         (static_cast<uint32_t>(pData[1]) << 16) |
+         (static_cast<uint32_t>(pData[2]) << 8) |
+         static_cast<uint32_t>(pData[3]);
+}
+
+//===----------------------------------------------------------------------===//
+// xxHash64
+//===----------------------------------------------------------------------===//
+const uint64_t kPrime1 = 11400714785074694791ULL;
+const uint64_t kPrime2 = 14029467366897019727ULL;
+const uint64_t kPrime3 = 1609587929392839161ULL;
+const uint64_t kPrime4 = 9650029242287828579ULL;
+const uint64_t kPrime5 = 2870177450012600261ULL;
+
+uint64_t Round(uint64_t pAcc, uint64_t pInput) {
+  pAcc += pInput * kPrime2;
+  pAcc = Rotl64(pAcc, 31);
+  return pAcc * kPrime1;
+}
+
+uint64_t MergeRound(uint64_t pAcc, uint64_t pValue) {
+  pAcc ^= Round(0, pValue);
+  return pAcc * kPrime1 + kPrime4;
+}
+
+//===----------------------------------------------------------------------===//
+// SHA-1
+//===----------------------------------------------------------------------===//
+/// SHA1Block - fold the 64-byte block pBlock into pState
+void SHA1Block(uint32_t* pState, const uint8_t* pBlock) {
+  uint32_t w[80];
+  for (unsigned i = 0; i < 16; ++i)
+    w[i] = Read32BE(pBlock + 4 * i);
+  for (unsigned i = 16; i < 80; ++i)
+    w[i] = Rotl32(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+  uint32_t a = pState[0], b = pState[1], c = pState[2], d = pState[3],
+           e = pState[4];
+  for (unsigned i = 0; i < 80; ++i) {
+    uint32_t f, k;
+    if (i < 20) {
+      f = (b & c) | (~b & d);
+      k = 0x5a827999;
+    } else if (i < 40) {
+      f = b ^ c ^ d;
+      k = 0x6ed9eba1;
+    } else if (i < 60) {
+      f = (b & c) | (b & d) | (c & d);
+      k = 0x8f1bbcdc;
+    } else {
+      f = b ^ c ^ d;
+      k = 0xca62c1d6;
+    }
+    uint32_t temp = Rotl32(a, 5) + f + e + k + w[i];
+    e = d;
+    d = c;
+    c = Rotl32(b, 30);
+    b = a;
+    a = temp;
+  }
+  pState[0] += a;
+  pState[1] += b;
+  pState[2] += c;
+  pState[3] += d;
+  pState[4] += e;
+}
+
+}  // anonymous namespace
+
+uint64_t xxHash64(llvm::ArrayRef<uint8_t> pData) {
+  const uint8_t* p = pData.data();
+  const uint8_t* end = p + pData.size();
+  uint64_t hash;
+
+  if (pData.size() >= 32) {
+    uint64_t v1 = kPrime1 + kPrime2;
+    uint64_t v2 = kPrime2;
+    uint64_t v3 = 0;
+    uint64_t v4 = 0 - kPrime1;
+    for (; p + 32 <= end; p += 32) {
+      v1 = Round(v1, Read64LE(p));
+      v2 = Round(v2, Read64LE(p + 8));
+      v3 = Round(v3, Read64LE(p + 16));
+      v4 = Round(v4, Read64LE(p + 24));
+    }
+    hash = Rotl64(v1, 1) + Rotl64(v2, 7) + Rotl64(v3, 12) + Rotl64(v4, 18);
+    hash = MergeRound(hash, v1);
+    hash = MergeRound(hash, v2);
+    hash = MergeRound(hash, v3);
+    hash = MergeRound(hash, v4);
+  } else {
+    hash = kPrime5;
+  }
+
+  hash += pData.size();
+  for (; p + 8 <= end; p += 8) {
+    hash ^= Round(0, Read64LE(p));
+    hash = Rotl64(hash, 27) * kPrime1 + kPrime4;
+  }
+  if (p + 4 <= end) {
+    hash ^= static_cast<uint64_t>(Read32LE(p)) * kPrime1;
+    hash = Rotl64(hash, 23) * kPrime2 + kPrime3;
+    p += 4;
+  }
+  for (; p != end; ++p) {
+    hash ^= (*p) * kPrime5;
+    hash = Rotl64(hash, 11) * kPrime1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= kPrime2;
+  hash ^= hash >> 29;
+  hash *= kPrime3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+void SHA1(llvm::ArrayRef<uint8_t> pData, uint8_t* pResult) {
+  uint32_t state[5] = {
+      0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+  size_t size = pData.size();
+  size_t full = size - size % 64;
+  for (size_t offset = 0; offset != full; offset += 64)
+    SHA1Block(state, pData.data() + offset);
+
+  // pad the rest with 0x80, zeros and the length in bits
+  uint8_t tail[128];
+  size_t rest = size - full;
+  std::memset(tail, 0, sizeof(tail));
+  if (rest != 0)
+    std::memcpy(tail, pData.data() + full, rest);
+  tail[rest] = 0x80;
+  size_t tail_size = (rest < 56) ? 64 : 128;
+  uint64_t bits = static_cast<uint64_t>(size) * 8;
+  for (unsigned i = 0; i < 8; ++i)
+    tail[tail_size - 1 - i] = static_cast<uint8_t>(bits >> (8 * i));
+  for (size_t offset = 0; offset != tail_size; offset += 64)
+    SHA1Block(state, tail + offset);
+
+  for (unsigned i = 0; i < 5; ++i) {
+    pResult[4 * i] = static_cast<uint8_t>(state[i] >> 24);
+    pResult[4 * i + 1] = static_cast<uint8_t>(state[i] >> 16);
+    pResult[4 * i + 2] = static_cast<uint8_t>(state[i] >> 8);
+    pResult[4 * i + 3] = static_cast<uint8_t>(state[i]);
+  }
+}
+
+}  // namespace digest
+}  // namespace mcld
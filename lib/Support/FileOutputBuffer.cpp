@@ -8,16 +8,45 @@
 //===----------------------------------------------------------------------===//
 #include "mcld/Support/FileOutputBuffer.h"
 #include "mcld/Support/FileHandle.h"
+#include "mcld/Support/FileSystem.h"
 #include "mcld/Support/Path.h"
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+
 namespace mcld {
 
+namespace {
+
+// The size of a single pwrite() of a Direct buffer.
+const size_t kWriteChunkSize = 8 * 1024 * 1024;
+
+}  // anonymous namespace
+
 FileOutputBuffer::FileOutputBuffer(llvm::sys::fs::mapped_file_region* pRegion,
                                    FileHandle& pFileHandle)
-    : m_pRegion(pRegion), m_FileHandle(pFileHandle) {
+    : m_pRegion(pRegion),
+      m_FileHandle(pFileHandle),
+      m_Mode(Mapped),
+      m_pData(reinterpret_cast<uint8_t*>(pRegion->data())),
+      m_Size(pRegion->size()) {
+}
+
+FileOutputBuffer::FileOutputBuffer(uint8_t* pBuffer,
+                                   size_t pSize,
+                                   FileHandle& pFileHandle)
+    : m_FileHandle(pFileHandle),
+      m_Mode(Direct),
+      m_pData(pBuffer),
+      m_Size(pSize) {
 }
 
 FileOutputBuffer::~FileOutputBuffer() {
+  if (Direct == m_Mode) {
+    free(m_pData);
+    return;
+  }
   // Unmap buffer, letting OS flush dirty pages to file on disk.
   m_pRegion.reset();
 }
@@ -26,13 +55,31 @@ std::error_code
 FileOutputBuffer::create(FileHandle& pFileHandle,
                          size_t pSize,
                          std::unique_ptr<FileOutputBuffer>& pResult) {
+  return create(pFileHandle, pSize, Mapped, pResult);
+}
+
+std::error_code
+FileOutputBuffer::create(FileHandle& pFileHandle,
+                         size_t pSize,
+                         Mode pMode,
+                         std::unique_ptr<FileOutputBuffer>& pResult) {
   std::error_code ec;
 
-  // Resize the file before mapping the file region.
+  // Resize the file before mapping the file region. A Direct buffer does not
+  // need it, but pre-sizing lets the file system allocate the file at once.
   ec = llvm::sys::fs::resize_file(pFileHandle.handler(), pSize);
   if (ec)
     return ec;
 
+  if (Direct == pMode) {
+    // calloc() hands out lazily zeroed anonymous pages for large sizes.
+    uint8_t* buffer = reinterpret_cast<uint8_t*>(calloc(pSize ? pSize : 1, 1));
+    if (buffer == NULL)
+      return std::make_error_code(std::errc::not_enough_memory);
+    pResult.reset(new FileOutputBuffer(buffer, pSize, pFileHandle));
+    return std::error_code();
+  }
+
   std::unique_ptr<llvm::sys::fs::mapped_file_region> mapped_file(
       new llvm::sys::fs::mapped_file_region(pFileHandle.handler(),
           llvm::sys::fs::mapped_file_region::readwrite, pSize, 0, ec));
@@ -52,6 +99,29 @@ MemoryRegion FileOutputBuffer::request(size_t pOffset, size_t pLength) {
   return MemoryRegion(getBufferStart() + pOffset, pLength);
 }
 
+std::error_code FileOutputBuffer::commit() {
+  if (Direct != m_Mode)
+    return std::error_code();
+
+  // Write in file order, so that a reader of a partially written file never
+  // sees a later part without all earlier parts.
+  size_t offset = 0;
+  while (offset < m_Size) {
+    size_t length = std::min(kWriteChunkSize, m_Size - offset);
+    ssize_t written = sys::fs::detail::pwrite(
+        m_FileHandle.handler(), m_pData + offset, length, offset);
+    if (written < 0) {
+      if (EINTR == errno)
+        continue;
+      return std::error_code(errno, std::generic_category());
+    }
+    if (0 == written)
+      return std::make_error_code(std::errc::io_error);
+    offset += written;
+  }
+  return std::error_code();
+}
+
 llvm::StringRef FileOutputBuffer::getPath() const {
   return m_FileHandle.path().native();
 }
@@ -0,0 +1,192 @@
+//===- InputCache.cpp -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/InputCache.h"
+
+#include "mcld/Support/FileHandle.h"
+#include "mcld/Support/Path.h"
+
+#include <atomic>
+
+namespace mcld {
+
+static std::atomic<InputCache*> g_pSharedCache(NULL);
+
+namespace {
+
+/// Unmap - the deleter of a Mapping
+struct Unmap {
+  size_t size;
+
+  void operator()(const char* pData) const {
+    sys::fs::detail::unmap_file(const_cast<char*>(pData), size);
+  }
+};
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// InputCache
+//===----------------------------------------------------------------------===//
+InputCache::InputCache(size_t pBudget)
+    : m_Budget(pBudget),
+      m_CachedBytes(0),
+      m_Clock(0),
+      m_NumOfHits(0),
+      m_NumOfMisses(0) {
+}
+
+InputCache::~InputCache() {
+  InputCache* self = this;
+  g_pSharedCache.compare_exchange_strong(self, NULL);
+}
+
+std::string InputCache::getKey(llvm::StringRef pPath) {
+  // key by absolute path, the working directory may change between links
+  sys::fs::Path path(pPath.str());
+  if (!path.isFromRoot()) {
+    sys::fs::Path pwd;
+    sys::fs::detail::get_pwd(pwd);
+    path = pwd.append(path);
+  }
+  return path.native();
+}
+
+bool InputCache::acquire(llvm::StringRef pPath,
+                         bool pPopulate,
+                         Mapping& pMapping,
+                         size_t& pSize,
+                         Parsed* pParsed) {
+  FileHandle file;
+  if (!file.open(sys::fs::Path(pPath.str()),
+                 FileHandle::OpenMode(FileHandle::ReadOnly),
+                 FileHandle::Permission(FileHandle::System)))
+    return false;
+
+  sys::fs::detail::FileIdentity identity;
+  if (!sys::fs::detail::file_identity(file.handler(), identity) ||
+      identity.size == 0)
+    return false;
+
+  std::string key = getKey(pPath);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  EntryMap::iterator entry = m_Entries.find(key);
+  if (entry != m_Entries.end()) {
+    if (entry->second.identity == identity) {
+      ++m_NumOfHits;
+      entry->second.lastUse = ++m_Clock;
+      pMapping = entry->second.mapping;
+      pSize = identity.size;
+      if (pParsed != NULL)
+        *pParsed = entry->second.parsed;
+      return true;
+    }
+    // the file has changed since it was mapped
+    m_CachedBytes -= entry->second.identity.size;
+    m_Entries.erase(entry);
+  }
+
+  void* addr =
+      sys::fs::detail::map_file(file.handler(), identity.size, pPopulate);
+  if (addr == NULL)
+    return false;
+
+  ++m_NumOfMisses;
+  Unmap unmap = {static_cast<size_t>(identity.size)};
+  Entry& created = m_Entries[key];
+  created.identity = identity;
+  created.mapping = Mapping(reinterpret_cast<const char*>(addr), unmap);
+  created.lastUse = ++m_Clock;
+  m_CachedBytes += identity.size;
+  m_NewPaths.push_back(key);
+  evict(key);
+
+  pMapping = created.mapping;
+  pSize = identity.size;
+  if (pParsed != NULL)
+    pParsed->reset();
+  return true;
+}
+
+bool InputCache::setParsed(llvm::StringRef pPath,
+                           const Mapping& pMapping,
+                           const Parsed& pParsed) {
+  std::string key = getKey(pPath);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  EntryMap::iterator entry = m_Entries.find(key);
+  if (entry == m_Entries.end() || entry->second.mapping != pMapping)
+    return false;
+  entry->second.parsed = pParsed;
+  return true;
+}
+
+void InputCache::evict(const std::string& pKeep) {
+  while (m_CachedBytes > m_Budget && m_Entries.size() > 1) {
+    EntryMap::iterator victim = m_Entries.end();
+    for (EntryMap::iterator it = m_Entries.begin(), ie = m_Entries.end();
+         it != ie; ++it) {
+      if (it->first == pKeep)
+        continue;
+      if (victim == m_Entries.end() ||
+          it->second.lastUse < victim->second.lastUse)
+        victim = it;
+    }
+    m_CachedBytes -= victim->second.identity.size;
+    m_Entries.erase(victim);
+  }
+}
+
+std::vector<std::string> InputCache::takeNewPaths() {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  std::vector<std::string> result;
+  result.swap(m_NewPaths);
+  return result;
+}
+
+InputCache* InputCache::shared() {
+  return g_pSharedCache.load();
+}
+
+void InputCache::setShared(InputCache* pCache) {
+  g_pSharedCache.store(pCache);
+}
+
+size_t InputCache::size() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+size_t InputCache::cachedBytes() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_CachedBytes;
+}
+
+size_t InputCache::numOfHits() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumOfHits;
+}
+
+size_t InputCache::numOfMisses() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumOfMisses;
+}
+
+size_t InputCache::numOfParsed() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  size_t result = 0;
+  for (EntryMap::const_iterator it = m_Entries.begin(), ie = m_Entries.end();
+       it != ie; ++it) {
+    if (it->second.parsed)
+      ++result;
+  }
+  return result;
+}
+
+}  // namespace mcld
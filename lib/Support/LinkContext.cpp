@@ -0,0 +1,115 @@
+//===- LinkContext.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/LinkContext.h"
+
+#include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/ManagedStatic.h>
+
+#include <atomic>
+#include <cassert>
+
+namespace mcld {
+
+static llvm::ManagedStatic<LinkContext> g_GlobalContext;
+
+/// g_pCurrentContext - the context entered by this thread, or NULL
+static thread_local LinkContext* g_pCurrentContext = NULL;
+
+static std::atomic<size_t> g_NumOfSlots(0);
+
+//===----------------------------------------------------------------------===//
+// LinkContext::Scope
+//===----------------------------------------------------------------------===//
+LinkContext::Scope::Scope(LinkContext& pContext)
+    : m_pPrevious(g_pCurrentContext) {
+  g_pCurrentContext = &pContext;
+}
+
+LinkContext::Scope::~Scope() {
+  g_pCurrentContext = m_pPrevious;
+}
+
+//===----------------------------------------------------------------------===//
+// LinkContext
+//===----------------------------------------------------------------------===//
+LinkContext::LinkContext() {
+  for (size_t i = 0; i < kMaxBlocks; ++i)
+    m_Blocks[i].store(NULL, std::memory_order_relaxed);
+}
+
+LinkContext::~LinkContext() {
+  assert(g_pCurrentContext != this && "destroying the current context");
+  release();
+  for (size_t i = 0; i < kMaxBlocks; ++i)
+    delete[] m_Blocks[i].load(std::memory_order_relaxed);
+}
+
+LinkContext& LinkContext::current() {
+  if (g_pCurrentContext != NULL)
+    return *g_pCurrentContext;
+  return *g_GlobalContext;
+}
+
+LinkContext& LinkContext::global() {
+  return *g_GlobalContext;
+}
+
+void LinkContext::release() {
+  // Objects may refer to the ones created before them, such as a RelocData
+  // to its relocations, so tear down from the newest one.
+  std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+  while (!m_Order.empty()) {
+    size_t id = m_Order.back();
+    Slot& slot = m_Blocks[id / kSlotsPerBlock].load(
+        std::memory_order_relaxed)[id % kSlotsPerBlock];
+    m_Order.pop_back();
+    slot.destruct(slot.object.load(std::memory_order_relaxed));
+    slot.object.store(NULL, std::memory_order_relaxed);
+  }
+}
+
+size_t LinkContext::newSlotId() {
+  size_t id = g_NumOfSlots++;
+  if (id >= kMaxBlocks * kSlotsPerBlock)
+    llvm::report_fatal_error("too many object types in LinkContext");
+  return id;
+}
+
+void* LinkContext::create(size_t pId,
+                          Constructor pConstruct,
+                          Destructor pDestruct) {
+  std::lock_guard<std::recursive_mutex> lock(m_Mutex);
+  std::atomic<Slot*>& block = m_Blocks[pId / kSlotsPerBlock];
+  if (block.load(std::memory_order_relaxed) == NULL) {
+    Slot* slots = new Slot[kSlotsPerBlock];
+    for (size_t i = 0; i < kSlotsPerBlock; ++i) {
+      slots[i].object.store(NULL, std::memory_order_relaxed);
+      slots[i].destruct = NULL;
+    }
+    block.store(slots, std::memory_order_release);
+  }
+  Slot& slot = block.load(std::memory_order_relaxed)[pId % kSlotsPerBlock];
+  void* object = slot.object.load(std::memory_order_relaxed);
+  if (object != NULL)
+    return object;
+
+  // construct before publishing the slot, the constructor may create other
+  // objects of this context. Make this context current meanwhile, so that
+  // they are created here even if another context is current.
+  {
+    Scope scope(*this);
+    object = pConstruct();
+  }
+  slot.destruct = pDestruct;
+  slot.object.store(object, std::memory_order_release);
+  m_Order.push_back(pId);
+  return object;
+}
+
+}  // namespace mcld
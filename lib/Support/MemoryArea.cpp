@@ -7,19 +7,87 @@
 //
 //===----------------------------------------------------------------------===//
 #include "mcld/Support/MemoryArea.h"
+#include "mcld/Support/FileHandle.h"
+#include "mcld/Support/FileSystem.h"
+#include "mcld/Support/InputCache.h"
 #include "mcld/Support/MsgHandling.h"
 
 #include <llvm/Support/ErrorOr.h>
 
+#include <algorithm>
 #include <cassert>
 #include <system_error>
 
 namespace mcld {
 
+namespace {
+
+// The granularity of the touched-bytes accounting. It does not need to match
+// the page size of the host.
+const size_t kPageSize = 4096;
+
+}  // anonymous namespace
+
 //===--------------------------------------------------------------------===//
 // MemoryArea
 //===--------------------------------------------------------------------===//
-MemoryArea::MemoryArea(llvm::StringRef pFilename) {
+MemoryArea::MemoryArea(llvm::StringRef pFilename)
+    : m_pData(NULL), m_Size(0), m_bMapped(false) {
+  open(pFilename, 0);
+}
+
+MemoryArea::MemoryArea(llvm::StringRef pFilename, size_t pPopulateLimit)
+    : m_pData(NULL), m_Size(0), m_bMapped(false) {
+  open(pFilename, pPopulateLimit);
+}
+
+MemoryArea::MemoryArea(const char* pMemBuffer, size_t pSize)
+    : m_pData(pMemBuffer), m_Size(pSize), m_bMapped(false) {
+}
+
+MemoryArea::~MemoryArea() {
+  if (m_bMapped && !m_pSharedMapping)
+    sys::fs::detail::unmap_file(const_cast<char*>(m_pData), m_Size);
+}
+
+void MemoryArea::open(llvm::StringRef pFilename, size_t pPopulateLimit) {
+  if (InputCache* cache = InputCache::shared()) {
+    size_t size = 0;
+    if (cache->acquire(pFilename, false, m_pSharedMapping, size, &m_pParsed)) {
+      m_pData = m_pSharedMapping.get();
+      m_Size = size;
+      m_bMapped = true;
+      m_TouchedPages.resize((m_Size + kPageSize - 1) / kPageSize, 0);
+      if (m_Size <= pPopulateLimit)
+        populate();
+      return;
+    }
+  }
+
+  FileHandle file;
+  if (file.open(sys::fs::Path(pFilename.str()),
+                FileHandle::OpenMode(FileHandle::ReadOnly),
+                FileHandle::Permission(FileHandle::System))) {
+    m_Size = file.size();
+    if (m_Size == 0) {
+      file.close();
+      return;
+    }
+
+    void* addr = sys::fs::detail::map_file(
+        file.handler(), m_Size, m_Size <= pPopulateLimit);
+    file.close();
+    if (addr != NULL) {
+      m_pData = reinterpret_cast<const char*>(addr);
+      m_bMapped = true;
+      m_TouchedPages.resize((m_Size + kPageSize - 1) / kPageSize, 0);
+      sys::fs::detail::advise_map(
+          m_pData, m_Size, sys::fs::detail::MapSequential);
+      return;
+    }
+  }
+
+  // Not a regular file, or mmap is not available. Read it into a buffer.
   llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > buffer_or_error =
       llvm::MemoryBuffer::getFile(pFilename,
                                   /*FileSize*/ -1,
@@ -28,22 +96,60 @@ MemoryArea::MemoryArea(llvm::StringRef pFilename) {
     fatal(diag::fatal_cannot_read_input) << pFilename.str();
   }
   m_pMemoryBuffer = std::move(buffer_or_error.get());
+  m_pData = m_pMemoryBuffer->getBufferStart();
+  m_Size = m_pMemoryBuffer->getBufferSize();
 }
 
-MemoryArea::MemoryArea(const char* pMemBuffer, size_t pSize) {
-  llvm::StringRef mem(pMemBuffer, pSize);
-  m_pMemoryBuffer =
-      llvm::MemoryBuffer::getMemBuffer(mem,
-                                       /*BufferName*/ "NaN",
-                                       /*RequiresNullTerminator*/ false);
+llvm::StringRef MemoryArea::request(size_t pOffset, size_t pLength) {
+  if (m_bMapped)
+    touch(pOffset, pLength);
+  return llvm::StringRef(m_pData + pOffset, pLength);
 }
 
-llvm::StringRef MemoryArea::request(size_t pOffset, size_t pLength) {
-  return llvm::StringRef(m_pMemoryBuffer->getBufferStart() + pOffset, pLength);
+llvm::StringRef MemoryArea::keep(std::unique_ptr<char[]> pData, size_t pSize) {
+  m_KeptBuffers.push_back(std::move(pData));
+  return llvm::StringRef(m_KeptBuffers.back().get(), pSize);
+}
+
+void MemoryArea::prefetch(size_t pOffset, size_t pLength) {
+  if (!m_bMapped || pLength == 0 || pOffset >= m_Size)
+    return;
+  pLength = std::min(pLength, m_Size - pOffset);
+  sys::fs::detail::advise_map(m_pData + pOffset,
+                              pLength,
+                              sys::fs::detail::MapWillNeed);
+}
+
+void MemoryArea::populate() const {
+  if (!m_bMapped)
+    return;
+  sys::fs::detail::advise_map(m_pData, m_Size, sys::fs::detail::MapWillNeed);
+  // Reading one byte per page faults in the pages that are not yet resident.
+  const volatile char* data = m_pData;
+  char sum = 0;
+  for (size_t offset = 0; offset < m_Size; offset += kPageSize)
+    sum ^= data[offset];
+  (void)sum;
+}
+
+void MemoryArea::touch(size_t pOffset, size_t pLength) {
+  if (pLength == 0 || pOffset >= m_Size)
+    return;
+  size_t first = pOffset / kPageSize;
+  size_t last = (std::min(pOffset + pLength, m_Size) - 1) / kPageSize;
+  for (size_t page = first; page <= last; ++page)
+    m_TouchedPages[page] = 1;
 }
 
-size_t MemoryArea::size() const {
-  return m_pMemoryBuffer->getBufferSize();
+size_t MemoryArea::touchedBytes() const {
+  if (m_TouchedPages.empty())
+    return 0;
+  size_t pages = std::count(m_TouchedPages.begin(), m_TouchedPages.end(), 1);
+  size_t bytes = pages * kPageSize;
+  // the last page is partial
+  if (m_TouchedPages.back() != 0)
+    bytes -= m_TouchedPages.size() * kPageSize - m_Size;
+  return bytes;
 }
 
 }  // namespace mcld
@@ -16,7 +16,7 @@ namespace mcld {
 // MemoryAreaFactory
 //===----------------------------------------------------------------------===//
 MemoryAreaFactory::MemoryAreaFactory(size_t pNum)
-    : GCFactory<MemoryArea, 0>(pNum) {
+    : GCFactory<MemoryArea, 0>(pNum), m_PopulateLimit(0) {
 }
 
 MemoryAreaFactory::~MemoryAreaFactory() {
@@ -27,7 +27,7 @@ MemoryArea* MemoryAreaFactory::produce(const sys::fs::Path& pPath,
   llvm::StringRef name(pPath.native());
   if (m_AreaMap.find(name) == m_AreaMap.end()) {
     MemoryArea* result = allocate();
-    new (result) MemoryArea(name);
+    new (result) MemoryArea(name, m_PopulateLimit);
     m_AreaMap[name] = result;
     return result;
   }
@@ -41,7 +41,7 @@ MemoryArea* MemoryAreaFactory::produce(const sys::fs::Path& pPath,
   llvm::StringRef name(pPath.native());
   if (m_AreaMap.find(name) == m_AreaMap.end()) {
     MemoryArea* result = allocate();
-    new (result) MemoryArea(name);
+    new (result) MemoryArea(name, m_PopulateLimit);
     m_AreaMap[name] = result;
     return result;
   }
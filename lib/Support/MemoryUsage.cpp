@@ -0,0 +1,142 @@
+//===- MemoryUsage.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/MemoryUsage.h"
+
+#include "mcld/Support/LinkContext.h"
+#include "mcld/Support/SystemUtils.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+
+namespace mcld {
+
+/// MoreAllocated - order the usage by allocated bytes, then by name
+static bool MoreAllocated(const AllocatorUsage& pX, const AllocatorUsage& pY) {
+  if (pX.allocatedBytes() != pY.allocatedBytes())
+    return pX.allocatedBytes() > pY.allocatedBytes();
+  return pX.name < pY.name;
+}
+
+static uint64_t ToKB(uint64_t pBytes) {
+  return (pBytes + 1023) / 1024;
+}
+
+//===----------------------------------------------------------------------===//
+// TrackedAllocator
+//===----------------------------------------------------------------------===//
+TrackedAllocator::TrackedAllocator(llvm::StringRef pName)
+    : m_Name(pName), m_pUsage(NULL), m_Index(0) {
+  MemoryUsage::current().add(*this);
+}
+
+TrackedAllocator::~TrackedAllocator() {
+  if (m_pUsage != NULL)
+    m_pUsage->remove(*this);
+}
+
+//===----------------------------------------------------------------------===//
+// MemoryUsage
+//===----------------------------------------------------------------------===//
+MemoryUsage::MemoryUsage() {
+}
+
+MemoryUsage::~MemoryUsage() {
+  // allocators that outlive their context no longer report to it
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (size_t i = 0; i < m_Allocators.size(); ++i)
+    m_Allocators[i]->m_pUsage = NULL;
+}
+
+MemoryUsage& MemoryUsage::current() {
+  return LinkContext::current().get<MemoryUsage>();
+}
+
+void MemoryUsage::add(TrackedAllocator& pAllocator) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  pAllocator.m_pUsage = this;
+  pAllocator.m_Index = m_Allocators.size();
+  m_Allocators.push_back(&pAllocator);
+}
+
+void MemoryUsage::remove(TrackedAllocator& pAllocator) {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  // move the last allocator into the hole
+  TrackedAllocator* last = m_Allocators.back();
+  m_Allocators[pAllocator.m_Index] = last;
+  last->m_Index = pAllocator.m_Index;
+  m_Allocators.pop_back();
+  pAllocator.m_pUsage = NULL;
+}
+
+size_t MemoryUsage::numOfAllocators() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Allocators.size();
+}
+
+void MemoryUsage::getUsage(UsageList& pUsage) const {
+  pUsage.clear();
+  llvm::StringMap<size_t> index;
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (size_t i = 0; i < m_Allocators.size(); ++i) {
+    AllocatorUsage usage = {m_Allocators[i]->allocatorName(), 0, 1, 0, 0, 0};
+    m_Allocators[i]->getUsage(usage);
+
+    std::pair<llvm::StringMap<size_t>::iterator, bool> entry =
+        index.insert(std::make_pair(usage.name, pUsage.size()));
+    if (entry.second) {
+      pUsage.push_back(usage);
+      continue;
+    }
+    AllocatorUsage& total = pUsage[entry.first->getValue()];
+    ++total.instances;
+    total.chunks += usage.chunks;
+    total.objects += usage.objects;
+    total.capacity += usage.capacity;
+  }
+  std::sort(pUsage.begin(), pUsage.end(), MoreAllocated);
+}
+
+void MemoryUsage::print(llvm::raw_ostream& pOS, llvm::StringRef pPhase) const {
+  UsageList usage;
+  getUsage(usage);
+
+  pOS << "Memory usage after " << pPhase << ":\n";
+  pOS << "  allocator                             count   chunks    objects"
+         " allocated KB  wasted KB\n";
+  uint64_t allocated = 0, wasted = 0;
+  for (size_t i = 0; i < usage.size(); ++i) {
+    const AllocatorUsage& entry = usage[i];
+    pOS << llvm::format("  %-36s %6zu %8zu %10zu %12llu %10llu\n",
+                        entry.name.str().c_str(),
+                        entry.instances,
+                        entry.chunks,
+                        entry.objects,
+                        static_cast<unsigned long long>(
+                            ToKB(entry.allocatedBytes())),
+                        static_cast<unsigned long long>(
+                            ToKB(entry.wastedBytes())));
+    allocated += entry.allocatedBytes();
+    wasted += entry.wastedBytes();
+  }
+  pOS << "  total"
+      << llvm::format("%71llu %10llu\n",
+                      static_cast<unsigned long long>(ToKB(allocated)),
+                      static_cast<unsigned long long>(ToKB(wasted)));
+
+  uint64_t peak = sys::GetPeakMemoryUsage();
+  if (peak != 0) {
+    pOS << llvm::format("  peak resident set size: %llu KB\n",
+                        static_cast<unsigned long long>(ToKB(peak)));
+  }
+}
+
+}  // namespace mcld
@@ -11,10 +11,10 @@
 #include "mcld/LD/DiagnosticPrinter.h"
 #include "mcld/LD/MsgHandler.h"
 #include "mcld/LD/TextDiagnosticPrinter.h"
+#include "mcld/Support/LinkContext.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Support/raw_ostream.h"
 
-#include <llvm/Support/ManagedStatic.h>
 #include <llvm/Support/raw_ostream.h>
 #include <llvm/Support/Signals.h>
 
@@ -25,39 +25,41 @@ namespace mcld {
 //===----------------------------------------------------------------------===//
 // static variables
 //===----------------------------------------------------------------------===//
-static llvm::ManagedStatic<DiagnosticEngine> g_pEngine;
+static inline DiagnosticEngine& CurrentEngine() {
+  return LinkContext::current().get<DiagnosticEngine>();
+}
 
 void InitializeDiagnosticEngine(const LinkerConfig& pConfig,
                                 DiagnosticPrinter* pPrinter) {
-  g_pEngine->reset(pConfig);
+  CurrentEngine().reset(pConfig);
   if (pPrinter != NULL)
-    g_pEngine->setPrinter(*pPrinter, false);
+    CurrentEngine().setPrinter(*pPrinter, false);
   else {
     DiagnosticPrinter* printer =
         new TextDiagnosticPrinter(errs(), pConfig);
-    g_pEngine->setPrinter(*printer, true);
+    CurrentEngine().setPrinter(*printer, true);
   }
 }
 
 DiagnosticEngine& getDiagnosticEngine() {
-  return *g_pEngine;
+  return CurrentEngine();
 }
 
 bool Diagnose() {
-  if (g_pEngine->getPrinter()->getNumErrors() > 0) {
+  if (CurrentEngine().getPrinter()->getNumErrors() > 0) {
     // If we reached here, we are failing ungracefully. Run the interrupt
     // handlers
     // to make sure any special cleanups get done, in particular that we remove
     // files registered with RemoveFileOnSignal.
     llvm::sys::RunInterruptHandlers();
-    g_pEngine->getPrinter()->finish();
+    CurrentEngine().getPrinter()->finish();
     return false;
   }
   return true;
 }
 
 void FinalizeDiagnosticEngine() {
-  g_pEngine->getPrinter()->finish();
+  CurrentEngine().getPrinter()->finish();
 }
 
 }  // namespace mcld
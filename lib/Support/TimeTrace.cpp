@@ -0,0 +1,189 @@
+//===- TimeTrace.cpp ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Support/TimeTrace.h"
+
+#include "mcld/Support/LinkContext.h"
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/raw_ostream.h>
+
+namespace mcld {
+
+/// WriteString - write pStr as a JSON string
+static void WriteString(llvm::raw_ostream& pOS, llvm::StringRef pStr) {
+  pOS << '"';
+  for (size_t i = 0; i < pStr.size(); ++i) {
+    unsigned char c = pStr[i];
+    if (c == '"' || c == '\\')
+      pOS << '\\' << c;
+    else if (c < 0x20)
+      pOS << llvm::format("\\u%04x", c);
+    else
+      pOS << c;
+  }
+  pOS << '"';
+}
+
+//===----------------------------------------------------------------------===//
+// TimeTrace::Scope
+//===----------------------------------------------------------------------===//
+TimeTrace::Scope::Scope(llvm::StringRef pName, llvm::StringRef pDetail)
+    : m_pTrace(NULL), m_Name(pName), m_Detail(pDetail), m_Start(0) {
+  TimeTrace& trace = TimeTrace::current();
+  if (trace.isEnabled()) {
+    m_pTrace = &trace;
+    m_Start = trace.now();
+  }
+}
+
+TimeTrace::Scope::~Scope() {
+  if (m_pTrace != NULL)
+    m_pTrace->addStep(m_Name, m_Detail, m_Start, m_pTrace->now() - m_Start);
+}
+
+//===----------------------------------------------------------------------===//
+// TimeTrace
+//===----------------------------------------------------------------------===//
+TimeTrace::TimeTrace() : m_bEnabled(false) {
+}
+
+TimeTrace::~TimeTrace() {
+}
+
+TimeTrace& TimeTrace::current() {
+  return LinkContext::current().get<TimeTrace>();
+}
+
+void TimeTrace::enable() {
+  if (m_bEnabled)
+    return;
+  m_Origin = std::chrono::steady_clock::now();
+  m_bEnabled = true;
+}
+
+uint64_t TimeTrace::now() const {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now() - m_Origin).count();
+}
+
+void TimeTrace::addCounter(llvm::StringRef pName, uint64_t pValue) {
+  if (!m_bEnabled)
+    return;
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  Event event = {Counter, pName.str(), std::string(), now(), pValue,
+                 getThreadIndex()};
+  m_Events.push_back(event);
+}
+
+void TimeTrace::addStep(llvm::StringRef pName,
+                        llvm::StringRef pDetail,
+                        uint64_t pStart,
+                        uint64_t pDuration) {
+  if (!m_bEnabled)
+    return;
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  Event event = {Step, pName.str(), pDetail.str(), pStart, pDuration,
+                 getThreadIndex()};
+  m_Events.push_back(event);
+}
+
+unsigned TimeTrace::getThreadIndex() {
+  std::thread::id id = std::this_thread::get_id();
+  for (size_t i = 0; i < m_Threads.size(); ++i) {
+    if (m_Threads[i] == id)
+      return i;
+  }
+  m_Threads.push_back(id);
+  return m_Threads.size() - 1;
+}
+
+size_t TimeTrace::numOfEvents() const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Events.size();
+}
+
+void TimeTrace::write(llvm::raw_ostream& pOS) const {
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  pOS << "{\"traceEvents\":[";
+  for (size_t i = 0; i < m_Events.size(); ++i) {
+    const Event& event = m_Events[i];
+    pOS << (i == 0 ? "\n" : ",\n") << "{\"name\":";
+    WriteString(pOS, event.name);
+    pOS << ",\"cat\":\"mcld\",\"pid\":1,\"tid\":" << event.tid
+        << ",\"ts\":" << event.start;
+    if (Step == event.kind) {
+      pOS << ",\"ph\":\"X\",\"dur\":" << event.value;
+      if (!event.detail.empty()) {
+        pOS << ",\"args\":{\"detail\":";
+        WriteString(pOS, event.detail);
+        pOS << "}";
+      }
+    } else {
+      pOS << ",\"ph\":\"C\",\"args\":{";
+      WriteString(pOS, event.name);
+      pOS << ":" << event.value << "}";
+    }
+    pOS << "}";
+  }
+
+  // name the threads, the first one to record is the main thread
+  for (size_t i = 0; i < m_Threads.size(); ++i) {
+    pOS << (m_Events.empty() && i == 0 ? "\n" : ",\n")
+        << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+        << ",\"args\":{\"name\":\"" << (i == 0 ? "mcld" : "mcld worker")
+        << "\"}}";
+  }
+  pOS << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void TimeTrace::printStats(llvm::raw_ostream& pOS) const {
+  struct Total {
+    uint64_t time;
+    unsigned count;
+  };
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  std::vector<std::string> steps, counters;
+  llvm::StringMap<Total> totals;
+  llvm::StringMap<uint64_t> values;
+  for (size_t i = 0; i < m_Events.size(); ++i) {
+    const Event& event = m_Events[i];
+    if (Step == event.kind) {
+      Total empty = {0, 0};
+      std::pair<llvm::StringMap<Total>::iterator, bool> entry =
+          totals.insert(std::make_pair(event.name, empty));
+      if (entry.second)
+        steps.push_back(event.name);
+      entry.first->getValue().time += event.value;
+      ++entry.first->getValue().count;
+    } else {
+      if (values.insert(std::make_pair(event.name, 0)).second)
+        counters.push_back(event.name);
+      values[event.name] = event.value;
+    }
+  }
+
+  pOS << "Link steps:\n";
+  for (size_t i = 0; i < steps.size(); ++i) {
+    const Total& total = totals[steps[i]];
+    pOS << llvm::format("  %-28s %10.3f ms %8u\n",
+                        steps[i].c_str(),
+                        total.time / 1000.0,
+                        total.count);
+  }
+  pOS << "Link statistics:\n";
+  for (size_t i = 0; i < counters.size(); ++i) {
+    pOS << llvm::format("  %-28s %14llu\n",
+                        counters[i].c_str(),
+                        static_cast<unsigned long long>(values[counters[i]]));
+  }
+}
+
+}  // namespace mcld
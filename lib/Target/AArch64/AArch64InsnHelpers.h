@@ -265,10 +265,54 @@ class AArch64InsnHelpers {
     return false;
   }
 
+  // Return true if INSN is adrp.
+  static bool isADRP(InsnType insn) {
+    return (insn & 0x9f000000) == 0x90000000;
+  }
+
+  // Return true if INSN is ldr Xt, [Xn, #imm] with an unsigned offset.
+  static bool isLDR64UIMM(InsnType insn) {
+    return (insn & 0xffc00000) == 0xf9400000;
+  }
+
+  // Return true if INSN is add Xd, Xn, #imm without a shift.
+  static bool isADD64IMM(InsnType insn) {
+    return (insn & 0xffc00000) == 0x91000000;
+  }
+
+  // Return true if INSN is blr Xn.
+  static bool isBLR(InsnType insn) {
+    return (insn & 0xfffffc1f) == 0xd63f0000;
+  }
+
   static InsnType buildBranchInsn() {
     return 0x14000000;
   }
 
+  static InsnType buildNOP() {
+    return 0xd503201f;
+  }
+
+  // movz Xd, #0, lsl #(16 * hw)
+  static InsnType buildMOVZ(unsigned rd, unsigned hw) {
+    return 0xd2800000 | (hw << 21) | rd;
+  }
+
+  // movk Xd, #0, lsl #(16 * hw)
+  static InsnType buildMOVK(unsigned rd, unsigned hw) {
+    return 0xf2800000 | (hw << 21) | rd;
+  }
+
+  // ldr Xt, [Xn, #0]
+  static InsnType buildLDR64(unsigned rt, unsigned rn) {
+    return 0xf9400000 | (rn << 5) | rt;
+  }
+
+  // add Xd, Xn, #0
+  static InsnType buildADD64(unsigned rd, unsigned rn) {
+    return 0x91000000 | (rn << 5) | rd;
+  }
+
  private:
   DISALLOW_IMPLICIT_CONSTRUCTORS(AArch64InsnHelpers);
 };
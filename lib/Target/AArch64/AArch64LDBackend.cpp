@@ -461,11 +461,8 @@ bool AArch64GNULDBackend::doRelax(Module& pModule,
   for (auto it = invalid_frags.begin(), ie = invalid_frags.end(); it != ie;
        ++it) {
     Fragment* invalid = *it;
-    while (invalid != NULL) {
-      invalid->setOffset(invalid->getPrevNode()->getOffset() +
-                         invalid->getPrevNode()->size());
-      invalid = invalid->getNextNode();
-    }
+    invalid->getParent()->updateOffsets(*invalid,
+                                        config().options().numThreads());
   }
 
   // Fix up the size of .symtab, .strtab, and TEXT sections
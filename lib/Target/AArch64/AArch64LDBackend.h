@@ -142,6 +142,11 @@ class AArch64GNULDBackend : public GNULDBackend {
   /// getRelEntrySize - the size in BYTE of rela type relocation
   size_t getRelaEntrySize() { return 24; }
 
+  /// getRelativeRelocType - R_AARCH64_RELATIVE
+  uint32_t getRelativeRelocType() const {
+    return llvm::ELF::R_AARCH64_RELATIVE;
+  }
+
   /// doCreateProgramHdrs - backend can implement this function to create the
   /// target-dependent segments
   virtual void doCreateProgramHdrs(Module& pModule);
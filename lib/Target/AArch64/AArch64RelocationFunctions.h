@@ -25,93 +25,130 @@
   DECL_AARCH64_APPLY_RELOC_FUNC(adr_got_page)     \
   DECL_AARCH64_APPLY_RELOC_FUNC(ld64_got_lo12)    \
   DECL_AARCH64_APPLY_RELOC_FUNC(ldst_abs_lo12)    \
+  DECL_AARCH64_APPLY_RELOC_FUNC(tls_movw)         \
+  DECL_AARCH64_APPLY_RELOC_FUNC(tls_add)          \
+  DECL_AARCH64_APPLY_RELOC_FUNC(tls_ldst)         \
+  DECL_AARCH64_APPLY_RELOC_FUNC(gottprel_page)    \
+  DECL_AARCH64_APPLY_RELOC_FUNC(gottprel_lo12)    \
+  DECL_AARCH64_APPLY_RELOC_FUNC(tlsdesc_page)     \
+  DECL_AARCH64_APPLY_RELOC_FUNC(tlsdesc_lo12)     \
   DECL_AARCH64_APPLY_RELOC_FUNC(unsupported)
 
-#define DECL_AARCH64_APPLY_RELOC_FUNC_PTRS(ValueType, MappedType)                              /* NOLINT */\
-  ValueType(0x0,   MappedType(&none,             "R_AARCH64_NULL",                        0)), /* NOLINT */\
-  ValueType(0x1,   MappedType(&none,             "R_AARCH64_REWRITE_INSN",               32)), /* NOLINT */\
-  ValueType(0x100, MappedType(&none,             "R_AARCH64_NONE",                        0)), /* NOLINT */\
-  ValueType(0x101, MappedType(&abs,              "R_AARCH64_ABS64",                      64)), /* NOLINT */\
-  ValueType(0x102, MappedType(&abs,              "R_AARCH64_ABS32",                      32)), /* NOLINT */\
-  ValueType(0x103, MappedType(&abs,              "R_AARCH64_ABS16",                      16)), /* NOLINT */\
-  ValueType(0x104, MappedType(&rel,              "R_AARCH64_PREL64",                     64)), /* NOLINT */\
-  ValueType(0x105, MappedType(&rel,              "R_AARCH64_PREL32",                     32)), /* NOLINT */\
-  ValueType(0x106, MappedType(&rel,              "R_AARCH64_PREL16",                     16)), /* NOLINT */\
-  ValueType(0x107, MappedType(&unsupported,      "R_AARCH64_MOVW_UABS_G0",                0)), /* NOLINT */\
-  ValueType(0x108, MappedType(&unsupported,      "R_AARCH64_MOVW_UABS_G0_NC",             0)), /* NOLINT */\
-  ValueType(0x109, MappedType(&unsupported,      "R_AARCH64_MOVW_UABS_G1",                0)), /* NOLINT */\
-  ValueType(0x10a, MappedType(&unsupported,      "R_AARCH64_MOVW_UABS_G1_NC",             0)), /* NOLINT */\
-  ValueType(0x10b, MappedType(&unsupported,      "R_AARCH64_MOVW_UABS_G2",                0)), /* NOLINT */\
-  ValueType(0x10c, MappedType(&unsupported,      "R_AARCH64_MOVW_UABS_G2_NC",             0)), /* NOLINT */\
-  ValueType(0x10d, MappedType(&unsupported,      "R_AARCH64_MOVW_UABS_G3",                0)), /* NOLINT */\
-  ValueType(0x10e, MappedType(&unsupported,      "R_AARCH64_MOVW_SABS_G0",                0)), /* NOLINT */\
-  ValueType(0x10f, MappedType(&unsupported,      "R_AARCH64_MOVW_SABS_G1",                0)), /* NOLINT */\
-  ValueType(0x110, MappedType(&unsupported,      "R_AARCH64_MOVW_SABS_G2",                0)), /* NOLINT */\
-  ValueType(0x111, MappedType(&unsupported,      "R_AARCH64_LD_PREL_LO19",                0)), /* NOLINT */\
-  ValueType(0x112, MappedType(&adr_prel_lo21,    "R_AARCH64_ADR_PREL_LO21",              32)), /* NOLINT */\
-  ValueType(0x113, MappedType(&adr_prel_pg_hi21, "R_AARCH64_ADR_PREL_PG_HI21",           32)), /* NOLINT */\
-  ValueType(0x114, MappedType(&adr_prel_pg_hi21, "R_AARCH64_ADR_PREL_PG_HI21_NC",        32)), /* NOLINT */\
-  ValueType(0x115, MappedType(&add_abs_lo12,     "R_AARCH64_ADD_ABS_LO12_NC",            32)), /* NOLINT */\
-  ValueType(0x116, MappedType(&ldst_abs_lo12,    "R_AARCH64_LDST8_ABS_LO12_NC",          32)), /* NOLINT */\
-  ValueType(0x117, MappedType(&unsupported,      "R_AARCH64_TSTBR14",                     0)), /* NOLINT */\
-  ValueType(0x118, MappedType(&condbr,           "R_AARCH64_CONDBR19",                   32)), /* NOLINT */\
-  ValueType(0x11a, MappedType(&call,             "R_AARCH64_JUMP26",                     32)), /* NOLINT */\
-  ValueType(0x11b, MappedType(&call,             "R_AARCH64_CALL26",                     32)), /* NOLINT */\
-  ValueType(0x11c, MappedType(&ldst_abs_lo12,    "R_AARCH64_LDST16_ABS_LO12_NC",         32)), /* NOLINT */\
-  ValueType(0x11d, MappedType(&ldst_abs_lo12,    "R_AARCH64_LDST32_ABS_LO12_NC",         32)), /* NOLINT */\
-  ValueType(0x11e, MappedType(&ldst_abs_lo12,    "R_AARCH64_LDST64_ABS_LO12_NC",         32)), /* NOLINT */\
-  ValueType(0x12b, MappedType(&ldst_abs_lo12,    "R_AARCH64_LDST128_ABS_LO12_NC",        32)), /* NOLINT */\
-  ValueType(0x137, MappedType(&adr_got_page,     "R_AARCH64_ADR_GOT_PAGE",               32)), /* NOLINT */\
-  ValueType(0x138, MappedType(&ld64_got_lo12,    "R_AARCH64_LD64_GOT_LO12_NC",           32)), /* NOLINT */\
-  ValueType(0x20b, MappedType(&unsupported,      "R_AARCH64_TLSLD_MOVW_DTPREL_G2",        0)), /* NOLINT */\
-  ValueType(0x20c, MappedType(&unsupported,      "R_AARCH64_TLSLD_MOVW_DTPREL_G1",        0)), /* NOLINT */\
-  ValueType(0x20d, MappedType(&unsupported,      "R_AARCH64_TLSLD_MOVW_DTPREL_G1_NC",     0)), /* NOLINT */\
-  ValueType(0x20e, MappedType(&unsupported,      "R_AARCH64_TLSLD_MOVW_DTPREL_G0",        0)), /* NOLINT */\
-  ValueType(0x20f, MappedType(&unsupported,      "R_AARCH64_TLSLD_MOVW_DTPREL_G0_NC",     0)), /* NOLINT */\
-  ValueType(0x210, MappedType(&unsupported,      "R_AARCH64_TLSLD_ADD_DTPREL_HI12",       0)), /* NOLINT */\
-  ValueType(0x211, MappedType(&unsupported,      "R_AARCH64_TLSLD_ADD_DTPREL_LO12",       0)), /* NOLINT */\
-  ValueType(0x212, MappedType(&unsupported,      "R_AARCH64_TLSLD_ADD_DTPREL_LO12_NC",    0)), /* NOLINT */\
-  ValueType(0x213, MappedType(&unsupported,      "R_AARCH64_TLSLD_LDST8_DTPREL_LO12",     0)), /* NOLINT */\
-  ValueType(0x214, MappedType(&unsupported,      "R_AARCH64_TLSLD_LDST8_DTPREL_LO12_NC",  0)), /* NOLINT */\
-  ValueType(0x215, MappedType(&unsupported,      "R_AARCH64_TLSLD_LDST16_DTPREL_LO12",    0)), /* NOLINT */\
-  ValueType(0x216, MappedType(&unsupported,      "R_AARCH64_TLSLD_LDST16_DTPREL_LO12_NC", 0)), /* NOLINT */\
-  ValueType(0x217, MappedType(&unsupported,      "R_AARCH64_TLSLD_LDST32_DTPREL_LO12",    0)), /* NOLINT */\
-  ValueType(0x218, MappedType(&unsupported,      "R_AARCH64_TLSLD_LDST32_DTPREL_LO12_NC", 0)), /* NOLINT */\
-  ValueType(0x219, MappedType(&unsupported,      "R_AARCH64_TLSLD_LDST64_DTPREL_LO12",    0)), /* NOLINT */\
-  ValueType(0x21a, MappedType(&unsupported,      "R_AARCH64_TLSLD_LDST64_DTPREL_LO12_NC", 0)), /* NOLINT */\
-  ValueType(0x21b, MappedType(&unsupported,      "R_AARCH64_TLSIE_MOVW_GOTTPREL_G1",      0)), /* NOLINT */\
-  ValueType(0x21c, MappedType(&unsupported,      "R_AARCH64_TLSIE_MOVW_GOTTPREL_G0_NC",   0)), /* NOLINT */\
-  ValueType(0x21d, MappedType(&unsupported,      "R_AARCH64_TLSIE_ADR_GOTTPREL_PAGE21",   0)), /* NOLINT */\
-  ValueType(0x21e, MappedType(&unsupported,      "R_AARCH64_TLSIE_LD64_GOTTPREL_LO12_NC", 0)), /* NOLINT */\
-  ValueType(0x21f, MappedType(&unsupported,      "R_AARCH64_TLSIE_LD_GOTTPREL_PREL19",    0)), /* NOLINT */\
-  ValueType(0x220, MappedType(&unsupported,      "R_AARCH64_TLSLE_MOVW_TPREL_G2",         0)), /* NOLINT */\
-  ValueType(0x221, MappedType(&unsupported,      "R_AARCH64_TLSLE_MOVW_TPREL_G1",         0)), /* NOLINT */\
-  ValueType(0x222, MappedType(&unsupported,      "R_AARCH64_TLSLE_MOVW_TPREL_G1_NC",      0)), /* NOLINT */\
-  ValueType(0x223, MappedType(&unsupported,      "R_AARCH64_TLSLE_MOVW_TPREL_G0",         0)), /* NOLINT */\
-  ValueType(0x224, MappedType(&unsupported,      "R_AARCH64_TLSLE_MOVW_TPREL_G0_NC",      0)), /* NOLINT */\
-  ValueType(0x225, MappedType(&unsupported,      "R_AARCH64_TLSLE_ADD_TPREL_HI12",        0)), /* NOLINT */\
-  ValueType(0x226, MappedType(&unsupported,      "R_AARCH64_TLSLE_ADD_TPREL_LO12",        0)), /* NOLINT */\
-  ValueType(0x227, MappedType(&unsupported,      "R_AARCH64_TLSLE_ADD_TPREL_LO12_NC",     0)), /* NOLINT */\
-  ValueType(0x228, MappedType(&unsupported,      "R_AARCH64_TLSLE_LDST8_TPREL_LO12",      0)), /* NOLINT */\
-  ValueType(0x229, MappedType(&unsupported,      "R_AARCH64_TLSLE_LDST8_TPREL_LO12_NC",   0)), /* NOLINT */\
-  ValueType(0x22a, MappedType(&unsupported,      "R_AARCH64_TLSLE_LDST16_TPREL_LO12",     0)), /* NOLINT */\
-  ValueType(0x22b, MappedType(&unsupported,      "R_AARCH64_TLSLE_LDST16_TPREL_LO12_NC",  0)), /* NOLINT */\
-  ValueType(0x22c, MappedType(&unsupported,      "R_AARCH64_TLSLE_LDST32_TPREL_LO12",     0)), /* NOLINT */\
-  ValueType(0x22d, MappedType(&unsupported,      "R_AARCH64_TLSLE_LDST32_TPREL_LO12_NC",  0)), /* NOLINT */\
-  ValueType(0x22e, MappedType(&unsupported,      "R_AARCH64_TLSLE_LDST64_TPREL_LO12",     0)), /* NOLINT */\
-  ValueType(0x22f, MappedType(&unsupported,      "R_AARCH64_TLSLE_LDST64_TPREL_LO12_NC",  0)), /* NOLINT */\
-  ValueType(0x232, MappedType(&unsupported,      "R_AARCH64_TLSDESC_ADR_PAGE",            0)), /* NOLINT */\
-  ValueType(0x233, MappedType(&unsupported,      "R_AARCH64_TLSDESC_LD64_LO12_NC",        0)), /* NOLINT */\
-  ValueType(0x234, MappedType(&unsupported,      "R_AARCH64_TLSDESC_ADD_LO12_NC",         0)), /* NOLINT */\
-  ValueType(0x239, MappedType(&unsupported,      "R_AARCH64_TLSDESC_CALL",                0)), /* NOLINT */\
-  ValueType(1024,  MappedType(&unsupported,      "R_AARCH64_COPY",                        0)), /* NOLINT */\
-  ValueType(1025,  MappedType(&unsupported,      "R_AARCH64_GLOB_DAT",                    0)), /* NOLINT */\
-  ValueType(1026,  MappedType(&unsupported,      "R_AARCH64_JUMP_SLOT",                   0)), /* NOLINT */\
-  ValueType(1027,  MappedType(&unsupported,      "R_AARCH64_RELATIVE",                    0)), /* NOLINT */\
-  ValueType(1028,  MappedType(&unsupported,      "R_AARCH64_TLS_DTPREL64",                0)), /* NOLINT */\
-  ValueType(1029,  MappedType(&unsupported,      "R_AARCH64_TLS_DTPMOD64",                0)), /* NOLINT */\
-  ValueType(1030,  MappedType(&unsupported,      "R_AARCH64_TLS_TPREL64",                 0)), /* NOLINT */\
-  ValueType(1031,  MappedType(&unsupported,      "R_AARCH64_TLSDESC",                     0)), /* NOLINT */\
-  ValueType(1032,  MappedType(&unsupported,      "R_AARCH64_IRELATIVE",                   0))  /* NOLINT */
+#define DECL_AARCH64_APPLY_RELOC_FUNC_PTRS                                   \
+  { &none,             0x000, "R_AARCH64_NULL",                         0 }, \
+  { &none,             0x001, "R_AARCH64_REWRITE_INSN",                32 }, \
+  { &none,             0x100, "R_AARCH64_NONE",                         0 }, \
+  { &abs,              0x101, "R_AARCH64_ABS64",                       64 }, \
+  { &abs,              0x102, "R_AARCH64_ABS32",                       32 }, \
+  { &abs,              0x103, "R_AARCH64_ABS16",                       16 }, \
+  { &rel,              0x104, "R_AARCH64_PREL64",                      64 }, \
+  { &rel,              0x105, "R_AARCH64_PREL32",                      32 }, \
+  { &rel,              0x106, "R_AARCH64_PREL16",                      16 }, \
+  { &unsupported,      0x107, "R_AARCH64_MOVW_UABS_G0",                 0 }, \
+  { &unsupported,      0x108, "R_AARCH64_MOVW_UABS_G0_NC",              0 }, \
+  { &unsupported,      0x109, "R_AARCH64_MOVW_UABS_G1",                 0 }, \
+  { &unsupported,      0x10a, "R_AARCH64_MOVW_UABS_G1_NC",              0 }, \
+  { &unsupported,      0x10b, "R_AARCH64_MOVW_UABS_G2",                 0 }, \
+  { &unsupported,      0x10c, "R_AARCH64_MOVW_UABS_G2_NC",              0 }, \
+  { &unsupported,      0x10d, "R_AARCH64_MOVW_UABS_G3",                 0 }, \
+  { &unsupported,      0x10e, "R_AARCH64_MOVW_SABS_G0",                 0 }, \
+  { &unsupported,      0x10f, "R_AARCH64_MOVW_SABS_G1",                 0 }, \
+  { &unsupported,      0x110, "R_AARCH64_MOVW_SABS_G2",                 0 }, \
+  { &unsupported,      0x111, "R_AARCH64_LD_PREL_LO19",                 0 }, \
+  { &adr_prel_lo21,    0x112, "R_AARCH64_ADR_PREL_LO21",               32 }, \
+  { &adr_prel_pg_hi21, 0x113, "R_AARCH64_ADR_PREL_PG_HI21",            32 }, \
+  { &adr_prel_pg_hi21, 0x114, "R_AARCH64_ADR_PREL_PG_HI21_NC",         32 }, \
+  { &add_abs_lo12,     0x115, "R_AARCH64_ADD_ABS_LO12_NC",             32 }, \
+  { &ldst_abs_lo12,    0x116, "R_AARCH64_LDST8_ABS_LO12_NC",           32 }, \
+  { &unsupported,      0x117, "R_AARCH64_TSTBR14",                      0 }, \
+  { &condbr,           0x118, "R_AARCH64_CONDBR19",                    32 }, \
+  { &unsupported,      0x119, "",                                       0 }, \
+  { &call,             0x11a, "R_AARCH64_JUMP26",                      32 }, \
+  { &call,             0x11b, "R_AARCH64_CALL26",                      32 }, \
+  { &ldst_abs_lo12,    0x11c, "R_AARCH64_LDST16_ABS_LO12_NC",          32 }, \
+  { &ldst_abs_lo12,    0x11d, "R_AARCH64_LDST32_ABS_LO12_NC",          32 }, \
+  { &ldst_abs_lo12,    0x11e, "R_AARCH64_LDST64_ABS_LO12_NC",          32 }, \
+  { &unsupported,      0x11f, "",                                       0 }, \
+  { &unsupported,      0x120, "",                                       0 }, \
+  { &unsupported,      0x121, "",                                       0 }, \
+  { &unsupported,      0x122, "",                                       0 }, \
+  { &unsupported,      0x123, "",                                       0 }, \
+  { &unsupported,      0x124, "",                                       0 }, \
+  { &unsupported,      0x125, "",                                       0 }, \
+  { &unsupported,      0x126, "",                                       0 }, \
+  { &unsupported,      0x127, "",                                       0 }, \
+  { &unsupported,      0x128, "",                                       0 }, \
+  { &unsupported,      0x129, "",                                       0 }, \
+  { &unsupported,      0x12a, "",                                       0 }, \
+  { &ldst_abs_lo12,    0x12b, "R_AARCH64_LDST128_ABS_LO12_NC",         32 }, \
+  { &unsupported,      0x12c, "",                                       0 }, \
+  { &unsupported,      0x12d, "",                                       0 }, \
+  { &unsupported,      0x12e, "",                                       0 }, \
+  { &unsupported,      0x12f, "",                                       0 }, \
+  { &unsupported,      0x130, "",                                       0 }, \
+  { &unsupported,      0x131, "",                                       0 }, \
+  { &unsupported,      0x132, "",                                       0 }, \
+  { &unsupported,      0x133, "",                                       0 }, \
+  { &unsupported,      0x134, "",                                       0 }, \
+  { &unsupported,      0x135, "",                                       0 }, \
+  { &unsupported,      0x136, "",                                       0 }, \
+  { &adr_got_page,     0x137, "R_AARCH64_ADR_GOT_PAGE",                32 }, \
+  { &ld64_got_lo12,    0x138, "R_AARCH64_LD64_GOT_LO12_NC",            32 }, \
+  { &tls_movw,         0x20b, "R_AARCH64_TLSLD_MOVW_DTPREL_G2",        32 }, \
+  { &tls_movw,         0x20c, "R_AARCH64_TLSLD_MOVW_DTPREL_G1",        32 }, \
+  { &tls_movw,         0x20d, "R_AARCH64_TLSLD_MOVW_DTPREL_G1_NC",     32 }, \
+  { &tls_movw,         0x20e, "R_AARCH64_TLSLD_MOVW_DTPREL_G0",        32 }, \
+  { &tls_movw,         0x20f, "R_AARCH64_TLSLD_MOVW_DTPREL_G0_NC",     32 }, \
+  { &tls_add,          0x210, "R_AARCH64_TLSLD_ADD_DTPREL_HI12",       32 }, \
+  { &tls_add,          0x211, "R_AARCH64_TLSLD_ADD_DTPREL_LO12",       32 }, \
+  { &tls_add,          0x212, "R_AARCH64_TLSLD_ADD_DTPREL_LO12_NC",    32 }, \
+  { &tls_ldst,         0x213, "R_AARCH64_TLSLD_LDST8_DTPREL_LO12",     32 }, \
+  { &tls_ldst,         0x214, "R_AARCH64_TLSLD_LDST8_DTPREL_LO12_NC",  32 }, \
+  { &tls_ldst,         0x215, "R_AARCH64_TLSLD_LDST16_DTPREL_LO12",    32 }, \
+  { &tls_ldst,         0x216, "R_AARCH64_TLSLD_LDST16_DTPREL_LO12_NC", 32 }, \
+  { &tls_ldst,         0x217, "R_AARCH64_TLSLD_LDST32_DTPREL_LO12",    32 }, \
+  { &tls_ldst,         0x218, "R_AARCH64_TLSLD_LDST32_DTPREL_LO12_NC", 32 }, \
+  { &tls_ldst,         0x219, "R_AARCH64_TLSLD_LDST64_DTPREL_LO12",    32 }, \
+  { &tls_ldst,         0x21a, "R_AARCH64_TLSLD_LDST64_DTPREL_LO12_NC", 32 }, \
+  { &unsupported,      0x21b, "R_AARCH64_TLSIE_MOVW_GOTTPREL_G1",       0 }, \
+  { &unsupported,      0x21c, "R_AARCH64_TLSIE_MOVW_GOTTPREL_G0_NC",    0 }, \
+  { &gottprel_page,    0x21d, "R_AARCH64_TLSIE_ADR_GOTTPREL_PAGE21",   32 }, \
+  { &gottprel_lo12,    0x21e, "R_AARCH64_TLSIE_LD64_GOTTPREL_LO12_NC", 32 }, \
+  { &unsupported,      0x21f, "R_AARCH64_TLSIE_LD_GOTTPREL_PREL19",     0 }, \
+  { &tls_movw,         0x220, "R_AARCH64_TLSLE_MOVW_TPREL_G2",         32 }, \
+  { &tls_movw,         0x221, "R_AARCH64_TLSLE_MOVW_TPREL_G1",         32 }, \
+  { &tls_movw,         0x222, "R_AARCH64_TLSLE_MOVW_TPREL_G1_NC",      32 }, \
+  { &tls_movw,         0x223, "R_AARCH64_TLSLE_MOVW_TPREL_G0",         32 }, \
+  { &tls_movw,         0x224, "R_AARCH64_TLSLE_MOVW_TPREL_G0_NC",      32 }, \
+  { &tls_add,          0x225, "R_AARCH64_TLSLE_ADD_TPREL_HI12",        32 }, \
+  { &tls_add,          0x226, "R_AARCH64_TLSLE_ADD_TPREL_LO12",        32 }, \
+  { &tls_add,          0x227, "R_AARCH64_TLSLE_ADD_TPREL_LO12_NC",     32 }, \
+  { &tls_ldst,         0x228, "R_AARCH64_TLSLE_LDST8_TPREL_LO12",      32 }, \
+  { &tls_ldst,         0x229, "R_AARCH64_TLSLE_LDST8_TPREL_LO12_NC",   32 }, \
+  { &tls_ldst,         0x22a, "R_AARCH64_TLSLE_LDST16_TPREL_LO12",     32 }, \
+  { &tls_ldst,         0x22b, "R_AARCH64_TLSLE_LDST16_TPREL_LO12_NC",  32 }, \
+  { &tls_ldst,         0x22c, "R_AARCH64_TLSLE_LDST32_TPREL_LO12",     32 }, \
+  { &tls_ldst,         0x22d, "R_AARCH64_TLSLE_LDST32_TPREL_LO12_NC",  32 }, \
+  { &tls_ldst,         0x22e, "R_AARCH64_TLSLE_LDST64_TPREL_LO12",     32 }, \
+  { &tls_ldst,         0x22f, "R_AARCH64_TLSLE_LDST64_TPREL_LO12_NC",  32 }, \
+  { &unsupported,      0x230, "R_AARCH64_TLSDESC_LD_PREL19",            0 }, \
+  { &unsupported,      0x231, "R_AARCH64_TLSDESC_ADR_PREL21",           0 }, \
+  { &tlsdesc_page,     0x232, "R_AARCH64_TLSDESC_ADR_PAGE21",          32 }, \
+  { &tlsdesc_lo12,     0x233, "R_AARCH64_TLSDESC_LD64_LO12",           32 }, \
+  { &tlsdesc_lo12,     0x234, "R_AARCH64_TLSDESC_ADD_LO12",            32 }, \
+  { &unsupported,      0x235, "R_AARCH64_TLSDESC_OFF_G1",               0 }, \
+  { &unsupported,      0x236, "R_AARCH64_TLSDESC_OFF_G0_NC",            0 }, \
+  { &unsupported,      0x237, "R_AARCH64_TLSDESC_LDR",                  0 }, \
+  { &unsupported,      0x238, "R_AARCH64_TLSDESC_ADD",                  0 }, \
+  { &none,             0x239, "R_AARCH64_TLSDESC_CALL",                 0 }, \
+  { &unsupported,      0x400, "R_AARCH64_COPY",                         0 }, \
+  { &unsupported,      0x401, "R_AARCH64_GLOB_DAT",                     0 }, \
+  { &unsupported,      0x402, "R_AARCH64_JUMP_SLOT",                    0 }, \
+  { &unsupported,      0x403, "R_AARCH64_RELATIVE",                     0 }, \
+  { &unsupported,      0x404, "R_AARCH64_TLS_DTPMOD64",                 0 }, \
+  { &unsupported,      0x405, "R_AARCH64_TLS_DTPREL64",                 0 }, \
+  { &unsupported,      0x406, "R_AARCH64_TLS_TPREL64",                  0 }, \
+  { &unsupported,      0x407, "R_AARCH64_TLSDESC",                      0 }, \
+  { &unsupported,      0x408, "R_AARCH64_IRELATIVE",                    0 }
 
 #endif  // TARGET_AARCH64_AARCH64RELOCATIONFUNCTIONS_H_
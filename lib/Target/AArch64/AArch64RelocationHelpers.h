@@ -10,6 +10,9 @@
 #define TARGET_AARCH64_AARCH64RELOCATIONHELPERS_H_
 
 #include "AArch64Relocator.h"
+#include "mcld/ADT/SizeTraits.h"
+#include "mcld/LD/ELFSegment.h"
+#include "mcld/LD/ELFSegmentFactory.h"
 #include <llvm/Support/Host.h>
 
 namespace mcld {
@@ -154,6 +157,39 @@ static inline Relocator::Address helper_GOT_ORG(AArch64Relocator& pParent) {
   return pParent.getTarget().getGOT().addr();
 }
 
+/// helper_TLS_is_local - Check if the TLS symbol is in the TLS block of the
+/// output
+static inline bool helper_TLS_is_local(const ResolveInfo& pSym,
+                                       const AArch64Relocator& pParent) {
+  return pSym.isLocal() || helper_use_relative_reloc(pSym, pParent);
+}
+
+/// helper_get_TP_offset - the offset of the TLS segment from the thread
+/// pointer. AArch64 puts the TLS block of executables after the 16-byte TCB.
+static inline Relocator::Address helper_get_TP_offset(
+    AArch64Relocator& pParent) {
+  ELFSegmentFactory::const_iterator tls_seg =
+      pParent.getTarget().elfSegmentTable().find(
+          llvm::ELF::PT_TLS, llvm::ELF::PF_R, 0x0);
+  assert(tls_seg != pParent.getTarget().elfSegmentTable().end());
+  uint64_t offset = 16;
+  alignAddress(offset, (*tls_seg)->align());
+  return offset;
+}
+
+/// helper_get_TLS_offset - the offset of the TLS symbol from the thread
+/// pointer for TPREL relocations, or in the TLS block for DTPREL ones
+static inline Relocator::DWord helper_get_TLS_offset(
+    Relocation& pReloc,
+    AArch64Relocator& pParent) {
+  // the value of a TLS symbol is its offset in the TLS block
+  Relocator::DWord X = pReloc.symValue() + pReloc.addend();
+  if (pReloc.type() >= llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G2 &&
+      pReloc.type() <= llvm::ELF::R_AARCH64_TLSLE_LDST64_TPREL_LO12_NC)
+    X += helper_get_TP_offset(pParent);
+  return X;
+}
+
 static inline AArch64GOTEntry& helper_GOT_init(Relocation& pReloc,
                                                bool pHasRel,
                                                AArch64Relocator& pParent) {
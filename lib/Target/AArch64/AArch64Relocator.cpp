@@ -14,6 +14,7 @@
 #include "mcld/LD/ELFFileFormat.h"
 #include "mcld/Object/ObjectBuilder.h"
 
+#include "AArch64InsnHelpers.h"
 #include "AArch64Relocator.h"
 #include "AArch64RelocationFunctions.h"
 #include "AArch64RelocationHelpers.h"
@@ -35,28 +36,69 @@ typedef Relocator::Result (*ApplyFunctionType)(Relocation& pReloc,
                                                AArch64Relocator& pParent);
 
 // the table entry of applying functions
-class ApplyFunctionEntry {
- public:
-  ApplyFunctionEntry() {}
-  ApplyFunctionEntry(ApplyFunctionType pFunc,
-                     const char* pName,
-                     size_t pSize = 0)
-      : func(pFunc), name(pName), size(pSize) {}
+struct ApplyFunctionTriple {
   ApplyFunctionType func;
+  unsigned int type;
   const char* name;
-  size_t size;
+  unsigned int size;
 };
-typedef std::map<Relocator::Type, ApplyFunctionEntry> ApplyFunctionMap;
-
-static const ApplyFunctionMap::value_type ApplyFunctionList[] = {
-    DECL_AARCH64_APPLY_RELOC_FUNC_PTRS(ApplyFunctionMap::value_type,
-                                       ApplyFunctionEntry)};
 
 // declare the table of applying functions
-static ApplyFunctionMap ApplyFunctions(ApplyFunctionList,
-                                       ApplyFunctionList +
-                                           sizeof(ApplyFunctionList) /
-                                               sizeof(ApplyFunctionList[0]));
+static const ApplyFunctionTriple ApplyFunctions[] = {
+    DECL_AARCH64_APPLY_RELOC_FUNC_PTRS};
+
+// AArch64 relocation types live in four disjoint ranges. getApplyIndex()
+// folds them into a compact index of ApplyFunctions.
+static const unsigned int kStaticBegin = 0x100;  // R_AARCH64_NONE
+static const unsigned int kStaticEnd = 0x139;
+static const unsigned int kTLSBegin = 0x20b;  // R_AARCH64_TLSLD_MOVW_DTPREL_G2
+static const unsigned int kTLSEnd = 0x23a;
+static const unsigned int kDynBegin = 0x400;  // R_AARCH64_COPY
+static const unsigned int kDynEnd = 0x409;
+static const unsigned int kNumOfApplyFunctions =
+    2 + (kStaticEnd - kStaticBegin) + (kTLSEnd - kTLSBegin) +
+    (kDynEnd - kDynBegin);
+static const unsigned int kInvalidIndex = ~0U;
+
+static_assert(sizeof(ApplyFunctions) / sizeof(ApplyFunctions[0]) ==
+                  kNumOfApplyFunctions,
+              "AArch64 relocation table does not match its index ranges");
+
+/// getApplyIndex - the index of pType in ApplyFunctions, or kInvalidIndex
+static constexpr unsigned int getApplyIndex(Relocator::Type pType) {
+  return (pType <= 0x1) ? pType :
+         (pType >= kStaticBegin && pType < kStaticEnd) ?
+             2 + (pType - kStaticBegin) :
+         (pType >= kTLSBegin && pType < kTLSEnd) ?
+             2 + (kStaticEnd - kStaticBegin) + (pType - kTLSBegin) :
+         (pType >= kDynBegin && pType < kDynEnd) ?
+             2 + (kStaticEnd - kStaticBegin) + (kTLSEnd - kTLSBegin) +
+                 (pType - kDynBegin) :
+         kInvalidIndex;
+}
+
+// LLVM has renamed these between releases, so use the values of the ABI
+static const Relocator::Type kTLSDescLD64Lo12 = 0x233;
+static const Relocator::Type kTLSDescAddLo12 = 0x234;
+
+static_assert(getApplyIndex(llvm::ELF::R_AARCH64_ABS64) == 3,
+              "unexpected index of R_AARCH64_ABS64");
+static_assert(getApplyIndex(llvm::ELF::R_AARCH64_IRELATIVE) ==
+                  kNumOfApplyFunctions - 1,
+              "unexpected index of R_AARCH64_IRELATIVE");
+
+/// ApplyBatch - apply a run of relocations through one known function, so
+/// that the call can be inlined into the loop.
+template <ApplyFunctionType FUNC>
+static void ApplyBatch(Relocation* const* pBegin,
+                       Relocation* const* pEnd,
+                       AArch64Relocator& pParent) {
+  for (Relocation* const* reloc = pBegin; reloc != pEnd; ++reloc) {
+    Relocator::Result result = FUNC(**reloc, pParent);
+    if (result != Relocator::OK)
+      pParent.reportResult(**reloc, result);
+  }
+}
 
 //===----------------------------------------------------------------------===//
 // AArch64Relocator
@@ -71,23 +113,76 @@ AArch64Relocator::~AArch64Relocator() {
 
 Relocator::Result AArch64Relocator::applyRelocation(Relocation& pRelocation) {
   Relocation::Type type = pRelocation.type();
-  // valid types are 0x0, 0x100-1032, and R_AARCH64_REWRITE_INSN
-  if ((type < 0x100 || type > 1032) &&
-      (type != 0x0) &&
-      (type != R_AARCH64_REWRITE_INSN)) {
+  unsigned int index = getApplyIndex(type);
+  if (index == kInvalidIndex)
     return Relocator::Unknown;
+  assert(ApplyFunctions[index].type == type);
+  return ApplyFunctions[index].func(pRelocation, *this);
+}
+
+void AArch64Relocator::applyRelocations(Type pType,
+                                        Relocation* const* pBegin,
+                                        Relocation* const* pEnd) {
+  switch (pType) {
+    case llvm::ELF::R_AARCH64_ABS64:
+      ApplyBatch<&abs>(pBegin, pEnd, *this);
+      return;
+    case llvm::ELF::R_AARCH64_PREL32:
+      ApplyBatch<&rel>(pBegin, pEnd, *this);
+      return;
+    case llvm::ELF::R_AARCH64_JUMP26:
+    case llvm::ELF::R_AARCH64_CALL26:
+      ApplyBatch<&call>(pBegin, pEnd, *this);
+      return;
+    case llvm::ELF::R_AARCH64_ADR_PREL_PG_HI21:
+      ApplyBatch<&adr_prel_pg_hi21>(pBegin, pEnd, *this);
+      return;
+    case llvm::ELF::R_AARCH64_ADD_ABS_LO12_NC:
+      ApplyBatch<&add_abs_lo12>(pBegin, pEnd, *this);
+      return;
+    case llvm::ELF::R_AARCH64_LDST64_ABS_LO12_NC:
+      ApplyBatch<&ldst_abs_lo12>(pBegin, pEnd, *this);
+      return;
+    default:
+      Relocator::applyRelocations(pType, pBegin, pEnd);
+      return;
+  }
+}
+
+bool AArch64Relocator::canApplyAlone(Type pType) const {
+  switch (pType) {
+    case llvm::ELF::R_AARCH64_ABS64:
+    case llvm::ELF::R_AARCH64_ABS32:
+    case llvm::ELF::R_AARCH64_ABS16:
+    case llvm::ELF::R_AARCH64_PREL64:
+    case llvm::ELF::R_AARCH64_PREL32:
+    case llvm::ELF::R_AARCH64_PREL16:
+    case llvm::ELF::R_AARCH64_ADR_PREL_LO21:
+    case llvm::ELF::R_AARCH64_ADR_PREL_PG_HI21:
+    case llvm::ELF::R_AARCH64_ADR_PREL_PG_HI21_NC:
+    case llvm::ELF::R_AARCH64_ADD_ABS_LO12_NC:
+    case llvm::ELF::R_AARCH64_CONDBR19:
+    case llvm::ELF::R_AARCH64_JUMP26:
+    case llvm::ELF::R_AARCH64_CALL26:
+    case llvm::ELF::R_AARCH64_LDST8_ABS_LO12_NC:
+    case llvm::ELF::R_AARCH64_LDST16_ABS_LO12_NC:
+    case llvm::ELF::R_AARCH64_LDST32_ABS_LO12_NC:
+    case llvm::ELF::R_AARCH64_LDST64_ABS_LO12_NC:
+    case llvm::ELF::R_AARCH64_LDST128_ABS_LO12_NC:
+      return true;
+    default:
+      return false;
   }
-  assert(ApplyFunctions.find(type) != ApplyFunctions.end());
-  return ApplyFunctions[type].func(pRelocation, *this);
 }
 
 const char* AArch64Relocator::getName(Relocator::Type pType) const {
-  assert(ApplyFunctions.find(pType) != ApplyFunctions.end());
-  return ApplyFunctions[pType].name;
+  assert(getApplyIndex(pType) != kInvalidIndex);
+  return ApplyFunctions[getApplyIndex(pType)].name;
 }
 
 Relocator::Size AArch64Relocator::getSize(Relocation::Type pType) const {
-  return ApplyFunctions[pType].size;
+  assert(getApplyIndex(pType) != kInvalidIndex);
+  return ApplyFunctions[getApplyIndex(pType)].size;
 }
 
 void AArch64Relocator::addCopyReloc(ResolveInfo& pSym) {
@@ -148,8 +243,55 @@ LDSymbol& AArch64Relocator::defineSymbolforCopyReloc(IRBuilder& pBuilder,
   return *cpy_sym;
 }
 
+Relocator::ScanKind AArch64Relocator::classifyLocalScan(
+    const Relocation& pReloc,
+    unsigned& pGroup) const {
+  switch (pReloc.type()) {
+    case llvm::ELF::R_AARCH64_ABS64:
+    case llvm::ELF::R_AARCH64_ABS32:
+    case llvm::ELF::R_AARCH64_ABS16:
+      return config().isCodeIndep() ? ScanEach : ScanNone;
+
+    // GOT loads may be relaxed one by one
+    case llvm::ELF::R_AARCH64_ADR_GOT_PAGE:
+    case llvm::ELF::R_AARCH64_LD64_GOT_LO12_NC:
+      return ScanEach;
+
+    default:
+      return ScanNone;
+  }
+}
+
+Relocator::ScanKind AArch64Relocator::classifyGlobalScan(
+    const Relocation& pReloc,
+    unsigned& pGroup) const {
+  switch (pReloc.type()) {
+    case llvm::ELF::R_AARCH64_CONDBR19:
+    case llvm::ELF::R_AARCH64_JUMP26:
+    case llvm::ELF::R_AARCH64_CALL26:
+      pGroup = ReservePLT;
+      return ScanSymbol;
+
+    case llvm::ELF::R_AARCH64_ABS64:
+    case llvm::ELF::R_AARCH64_ABS32:
+    case llvm::ELF::R_AARCH64_ABS16:
+    case llvm::ELF::R_AARCH64_PREL64:
+    case llvm::ELF::R_AARCH64_PREL32:
+    case llvm::ELF::R_AARCH64_PREL16:
+    case llvm::ELF::R_AARCH64_ADR_PREL_LO21:
+    case llvm::ELF::R_AARCH64_ADR_PREL_PG_HI21:
+    case llvm::ELF::R_AARCH64_ADR_PREL_PG_HI21_NC:
+    case llvm::ELF::R_AARCH64_ADR_GOT_PAGE:
+    case llvm::ELF::R_AARCH64_LD64_GOT_LO12_NC:
+      return ScanEach;
+
+    default:
+      return ScanNone;
+  }
+}
+
 void AArch64Relocator::scanLocalReloc(Relocation& pReloc,
-                                      const LDSection& pSection) {
+                                      LDSection& pSection) {
   // rsym - The relocation target symbol
   ResolveInfo* rsym = pReloc.symInfo();
   switch (pReloc.type()) {
@@ -192,6 +334,10 @@ void AArch64Relocator::scanLocalReloc(Relocation& pReloc,
 
     case llvm::ELF::R_AARCH64_ADR_GOT_PAGE:
     case llvm::ELF::R_AARCH64_LD64_GOT_LO12_NC: {
+      // the address of a local symbol is computed without the GOT
+      if (pReloc.type() == llvm::ELF::R_AARCH64_ADR_GOT_PAGE &&
+          relaxGOTLoad(pReloc, pSection))
+        return;
       // Symbol needs GOT entry, reserve entry in .got
       // return if we already create GOT for this symbol
       if (rsym->reserved() & ReserveGOT)
@@ -214,7 +360,7 @@ void AArch64Relocator::scanLocalReloc(Relocation& pReloc,
 
 void AArch64Relocator::scanGlobalReloc(Relocation& pReloc,
                                        IRBuilder& pBuilder,
-                                       const LDSection& pSection) {
+                                       LDSection& pSection) {
   // rsym - The relocation target symbol
   ResolveInfo* rsym = pReloc.symInfo();
   switch (pReloc.type()) {
@@ -351,6 +497,10 @@ void AArch64Relocator::scanGlobalReloc(Relocation& pReloc,
 
     case llvm::ELF::R_AARCH64_ADR_GOT_PAGE:
     case llvm::ELF::R_AARCH64_LD64_GOT_LO12_NC: {
+      // the address of a non-preemptible symbol is computed without the GOT
+      if (pReloc.type() == llvm::ELF::R_AARCH64_ADR_GOT_PAGE &&
+          relaxGOTLoad(pReloc, pSection))
+        return;
       // Symbol needs GOT entry, reserve entry in .got
       // return if we already create GOT for this symbol
       if (rsym->reserved() & ReserveGOT)
@@ -386,10 +536,13 @@ void AArch64Relocator::scanRelocation(Relocation& pReloc,
 
   // Scan relocation type to determine if an GOT/PLT/Dynamic Relocation
   // entries should be created.
-  // FIXME: Below judgements concern nothing about TLS related relocation
 
+  // TLS relocations are handled alike for local and external symbols
+  if (pReloc.type() >= llvm::ELF::R_AARCH64_TLSLD_MOVW_DTPREL_G2 &&
+      pReloc.type() <= llvm::ELF::R_AARCH64_TLSDESC_CALL)
+    scanTLSReloc(pReloc);
   // rsym is local
-  if (rsym->isLocal())
+  else if (rsym->isLocal())
     scanLocalReloc(pReloc, pSection);
   // rsym is external
   else
@@ -401,6 +554,267 @@ void AArch64Relocator::scanRelocation(Relocation& pReloc,
     issueUndefRef(pReloc, pSection, pInput);
 }
 
+Relocator::ScanKind AArch64Relocator::classifyScan(const Relocation& pReloc,
+                                                   const LDSection& pSection,
+                                                   unsigned& pGroup) const {
+  const ResolveInfo* rsym = pReloc.symInfo();
+  assert(pSection.getLink() != NULL);
+  if ((pSection.getLink()->flag() & llvm::ELF::SHF_ALLOC) == 0)
+    return ScanNone;
+
+  // an undefined reference is reported for every relocation, and the TLS
+  // code sequences are relaxed one by one
+  if ((rsym->isUndef() && !rsym->isDyn() && !rsym->isWeak() &&
+       !rsym->isNull()) ||
+      (pReloc.type() >= llvm::ELF::R_AARCH64_TLSLD_MOVW_DTPREL_G2 &&
+       pReloc.type() <= llvm::ELF::R_AARCH64_TLSDESC_CALL))
+    return ScanEach;
+
+  if (rsym->isLocal())
+    return classifyLocalScan(pReloc, pGroup);
+  return classifyGlobalScan(pReloc, pGroup);
+}
+
+void AArch64Relocator::scanTLSReloc(Relocation& pReloc) {
+  // rsym - The relocation target symbol
+  ResolveInfo* rsym = pReloc.symInfo();
+
+  // an executable reaches its own TLS block from the thread pointer, so the
+  // dynamic TLS models are relaxed to the static ones
+  bool relax = (LinkerConfig::DynObj != config().codeGenType());
+  bool is_local = helper_TLS_is_local(*rsym, *this);
+
+  switch (pReloc.type()) {
+    case llvm::ELF::R_AARCH64_TLSDESC_ADR_PAGE21:
+    case kTLSDescLD64Lo12:
+    case kTLSDescAddLo12:
+    case llvm::ELF::R_AARCH64_TLSDESC_CALL: {
+      if (relax) {
+        if (!relaxTLSDesc(pReloc, is_local)) {
+          error(diag::result_badreloc) << getName(pReloc.type())
+                                       << rsym->name();
+          return;
+        }
+        // TLSDESC to IE loads the offset from the GOT
+        if (!is_local && pReloc.type() != R_AARCH64_REWRITE_INSN)
+          scanTLSReloc(pReloc);
+        return;
+      }
+
+      // return if the call needs nothing or if we already create the GOT
+      // entries for this symbol
+      if (pReloc.type() == llvm::ELF::R_AARCH64_TLSDESC_CALL ||
+          getSymTLSDescMap().lookUpFirstEntry(*rsym) != NULL)
+        return;
+
+      // set up a pair of got entries for the descriptor, which is filled
+      // non-lazily by R_AARCH64_TLSDESC in .rela.dyn
+      AArch64GOTEntry* got_entry1 = getTarget().getGOT().createGOT();
+      AArch64GOTEntry* got_entry2 = getTarget().getGOT().createGOT();
+      getSymTLSDescMap().record(*rsym, *got_entry1, *got_entry2);
+      got_entry1->setValue(0x0);
+      got_entry2->setValue(0x0);
+      if (is_local) {
+        Relocation& rel_entry = helper_DynRela_init(
+            NULL, *got_entry1, 0x0, llvm::ELF::R_AARCH64_TLSDESC, *this);
+        rel_entry.setAddend(SymVal);
+        getRelRelMap().record(pReloc, rel_entry);
+      } else {
+        helper_DynRela_init(
+            rsym, *got_entry1, 0x0, llvm::ELF::R_AARCH64_TLSDESC, *this);
+        getTarget().getRelaDyn().addSymbolToDynSym(*rsym->outSymbol());
+      }
+      return;
+    }
+
+    case llvm::ELF::R_AARCH64_TLSIE_ADR_GOTTPREL_PAGE21:
+    case llvm::ELF::R_AARCH64_TLSIE_LD64_GOTTPREL_LO12_NC: {
+      getTarget().setHasStaticTLS();
+      if (relax && is_local && relaxTLSIEtoLE(pReloc))
+        return;
+
+      // return if we already create GOT for this symbol
+      if (rsym->reserved() & ReserveGOT)
+        return;
+
+      // set up the got and the corresponding dyn rel
+      AArch64GOTEntry* got_entry = getTarget().getGOT().createGOT();
+      getSymGOTMap().record(*rsym, *got_entry);
+      if (relax && is_local) {
+        // the offset from the thread pointer is set during apply relocation
+        got_entry->setValue(SymVal);
+      } else if (is_local) {
+        got_entry->setValue(0x0);
+        Relocation& rel_entry = helper_DynRela_init(
+            NULL, *got_entry, 0x0, llvm::ELF::R_AARCH64_TLS_TPREL64, *this);
+        rel_entry.setAddend(SymVal);
+        getRelRelMap().record(pReloc, rel_entry);
+      } else {
+        got_entry->setValue(0x0);
+        helper_DynRela_init(
+            rsym, *got_entry, 0x0, llvm::ELF::R_AARCH64_TLS_TPREL64, *this);
+        getTarget().getRelaDyn().addSymbolToDynSym(*rsym->outSymbol());
+      }
+      // set GOT bit
+      rsym->setReserved(rsym->reserved() | ReserveGOT);
+      return;
+    }
+
+    case llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G2:
+    case llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G1:
+    case llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G1_NC:
+    case llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G0:
+    case llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G0_NC:
+    case llvm::ELF::R_AARCH64_TLSLE_ADD_TPREL_HI12:
+    case llvm::ELF::R_AARCH64_TLSLE_ADD_TPREL_LO12:
+    case llvm::ELF::R_AARCH64_TLSLE_ADD_TPREL_LO12_NC:
+    case llvm::ELF::R_AARCH64_TLSLE_LDST8_TPREL_LO12:
+    case llvm::ELF::R_AARCH64_TLSLE_LDST8_TPREL_LO12_NC:
+    case llvm::ELF::R_AARCH64_TLSLE_LDST16_TPREL_LO12:
+    case llvm::ELF::R_AARCH64_TLSLE_LDST16_TPREL_LO12_NC:
+    case llvm::ELF::R_AARCH64_TLSLE_LDST32_TPREL_LO12:
+    case llvm::ELF::R_AARCH64_TLSLE_LDST32_TPREL_LO12_NC:
+    case llvm::ELF::R_AARCH64_TLSLE_LDST64_TPREL_LO12:
+    case llvm::ELF::R_AARCH64_TLSLE_LDST64_TPREL_LO12_NC:
+      getTarget().setHasStaticTLS();
+      // there is no dynamic relocation for the offset from the thread pointer
+      if (!relax)
+        error(diag::non_pic_relocation) << getName(pReloc.type())
+                                        << rsym->name();
+      return;
+
+    default:
+      // the DTPREL relocations are the offsets in the TLS block and need
+      // no entry
+      break;
+  }  // end switch
+}
+
+/// helper_next_reloc - get the relocation after pReloc if it applies to
+/// pOffset bytes after the place of pReloc
+static Relocation* helper_next_reloc(Relocation& pReloc,
+                                     LDSection& pSection,
+                                     uint64_t pOffset) {
+  RelocData::iterator next(pReloc);
+  if (++next == pSection.getRelocData()->end())
+    return NULL;
+  Relocation& reloc = *next;
+  if (reloc.targetRef().frag() != pReloc.targetRef().frag() ||
+      reloc.targetRef().offset() != pReloc.targetRef().offset() + pOffset)
+    return NULL;
+  return &reloc;
+}
+
+bool AArch64Relocator::relaxGOTLoad(Relocation& pReloc, LDSection& pSection) {
+  assert(pReloc.type() == llvm::ELF::R_AARCH64_ADR_GOT_PAGE);
+
+  // the symbol must be in the output, and not be preempted or be absolute
+  const ResolveInfo* rsym = pReloc.symInfo();
+  if (!rsym->isLocal() &&
+      (!rsym->isDefine() || rsym->isDyn() ||
+       getTarget().isSymbolPreemptible(*rsym)))
+    return false;
+  if (rsym->isAbsolute() || rsym->type() == ResolveInfo::IndirectFunc)
+    return false;
+
+  // check the sequence
+  //   adrp xN, :got:sym
+  //   ldr  xN, [xN, #:got_lo12:sym]
+  // The ldr has to overwrite xN; otherwise another ldr may still use the
+  // page of the GOT entry in xN.
+  Relocation* ldr = helper_next_reloc(pReloc, pSection, 4);
+  if (ldr == NULL ||
+      ldr->type() != llvm::ELF::R_AARCH64_LD64_GOT_LO12_NC ||
+      ldr->symInfo() != rsym || ldr->addend() != pReloc.addend())
+    return false;
+  uint32_t adrp = pReloc.target();
+  uint32_t insn = ldr->target();
+  if (!AArch64InsnHelpers::isADRP(adrp) ||
+      !AArch64InsnHelpers::isLDR64UIMM(insn) ||
+      AArch64InsnHelpers::getRn(insn) != AArch64InsnHelpers::getRd(adrp) ||
+      AArch64InsnHelpers::getRt(insn) != AArch64InsnHelpers::getRd(adrp))
+    return false;
+
+  // rewrite the sequence
+  //   adrp xN, sym
+  //   add  xN, xN, #:lo12:sym
+  pReloc.setType(llvm::ELF::R_AARCH64_ADR_PREL_PG_HI21);
+  ldr->setType(llvm::ELF::R_AARCH64_ADD_ABS_LO12_NC);
+  ldr->target() = AArch64InsnHelpers::buildADD64(
+      AArch64InsnHelpers::getRt(insn), AArch64InsnHelpers::getRn(insn));
+  return true;
+}
+
+bool AArch64Relocator::relaxTLSDesc(Relocation& pReloc, bool pToLE) {
+  // the descriptor sequence is fixed to x0
+  //   adrp x0, :tlsdesc:x               movz x0, #:tprel_g1:x    adrp x0, ...
+  //   ldr  x1, [x0, #:tlsdesc_lo12:x]   movk x0, #:tprel_g0_nc:x ldr x0, ...
+  //   add  x0, x0, #:tlsdesc_lo12:x  -> nop                   or nop
+  //   blr  x1                           nop                      nop
+  uint32_t insn = pReloc.target();
+  switch (pReloc.type()) {
+    case llvm::ELF::R_AARCH64_TLSDESC_ADR_PAGE21:
+      if (!AArch64InsnHelpers::isADRP(insn))
+        return false;
+      if (pToLE) {
+        pReloc.target() = AArch64InsnHelpers::buildMOVZ(0, 1);
+        pReloc.setType(llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G1);
+      } else {
+        pReloc.setType(llvm::ELF::R_AARCH64_TLSIE_ADR_GOTTPREL_PAGE21);
+      }
+      return true;
+
+    case kTLSDescLD64Lo12:
+      if (!AArch64InsnHelpers::isLDR64UIMM(insn))
+        return false;
+      if (pToLE) {
+        pReloc.target() = AArch64InsnHelpers::buildMOVK(0, 0);
+        pReloc.setType(llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G0_NC);
+      } else {
+        pReloc.target() = AArch64InsnHelpers::buildLDR64(0, 0);
+        pReloc.setType(llvm::ELF::R_AARCH64_TLSIE_LD64_GOTTPREL_LO12_NC);
+      }
+      return true;
+
+    case kTLSDescAddLo12:
+      if (!AArch64InsnHelpers::isADD64IMM(insn))
+        return false;
+      pReloc.target() = AArch64InsnHelpers::buildNOP();
+      pReloc.setType(R_AARCH64_REWRITE_INSN);
+      return true;
+
+    case llvm::ELF::R_AARCH64_TLSDESC_CALL:
+      if (!AArch64InsnHelpers::isBLR(insn))
+        return false;
+      pReloc.target() = AArch64InsnHelpers::buildNOP();
+      pReloc.setType(R_AARCH64_REWRITE_INSN);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+bool AArch64Relocator::relaxTLSIEtoLE(Relocation& pReloc) {
+  //   adrp xN, :gottprel:x                 movz xN, #:tprel_g1:x
+  //   ldr  xN, [xN, #:gottprel_lo12:x]  -> movk xN, #:tprel_g0_nc:x
+  uint32_t insn = pReloc.target();
+  if (pReloc.type() == llvm::ELF::R_AARCH64_TLSIE_ADR_GOTTPREL_PAGE21) {
+    if (!AArch64InsnHelpers::isADRP(insn))
+      return false;
+    pReloc.target() =
+        AArch64InsnHelpers::buildMOVZ(AArch64InsnHelpers::getRd(insn), 1);
+    pReloc.setType(llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G1);
+  } else {
+    if (!AArch64InsnHelpers::isLDR64UIMM(insn))
+      return false;
+    pReloc.target() =
+        AArch64InsnHelpers::buildMOVK(AArch64InsnHelpers::getRt(insn), 0);
+    pReloc.setType(llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G0_NC);
+  }
+  return true;
+}
+
 bool
 AArch64Relocator::mayHaveFunctionPointerAccess(const Relocation& pReloc) const {
   switch (pReloc.type()) {
@@ -729,4 +1143,182 @@ Relocator::Result ldst_abs_lo12(Relocation& pReloc, AArch64Relocator& pParent) {
   return Relocator::OK;
 }
 
+// R_AARCH64_TLSLD_MOVW_DTPREL_G2: DTPREL(S + A) >> 32
+// R_AARCH64_TLSLD_MOVW_DTPREL_G1: DTPREL(S + A) >> 16
+// R_AARCH64_TLSLD_MOVW_DTPREL_G0: DTPREL(S + A)
+// R_AARCH64_TLSLE_MOVW_TPREL_G2: TPREL(S + A) >> 32
+// R_AARCH64_TLSLE_MOVW_TPREL_G1: TPREL(S + A) >> 16
+// R_AARCH64_TLSLE_MOVW_TPREL_G0: TPREL(S + A)
+// and the _NC variants without the overflow check
+Relocator::Result tls_movw(Relocation& pReloc, AArch64Relocator& pParent) {
+  Relocator::DWord X = helper_get_TLS_offset(pReloc, pParent);
+  unsigned int shift = 0;
+  bool check = true;
+  switch (pReloc.type()) {
+    case llvm::ELF::R_AARCH64_TLSLD_MOVW_DTPREL_G2:
+    case llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G2:
+      shift = 32;
+      break;
+    case llvm::ELF::R_AARCH64_TLSLD_MOVW_DTPREL_G1_NC:
+    case llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G1_NC:
+      check = false;
+      // fall through
+    case llvm::ELF::R_AARCH64_TLSLD_MOVW_DTPREL_G1:
+    case llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G1:
+      shift = 16;
+      break;
+    case llvm::ELF::R_AARCH64_TLSLD_MOVW_DTPREL_G0_NC:
+    case llvm::ELF::R_AARCH64_TLSLE_MOVW_TPREL_G0_NC:
+      check = false;
+      break;
+    default:
+      break;
+  }
+
+  uint32_t imm = (X >> shift) & get_mask(16);
+  pReloc.target() = (pReloc.target() & ~(get_mask(16) << 5)) | (imm << 5);
+  if (check && (X >> (shift + 16)) != 0)
+    return Relocator::Overflow;
+  return Relocator::OK;
+}
+
+// R_AARCH64_TLSLD_ADD_DTPREL_HI12: DTPREL(S + A) >> 12
+// R_AARCH64_TLSLD_ADD_DTPREL_LO12: DTPREL(S + A)
+// R_AARCH64_TLSLE_ADD_TPREL_HI12: TPREL(S + A) >> 12
+// R_AARCH64_TLSLE_ADD_TPREL_LO12: TPREL(S + A)
+// and the _NC variants without the overflow check
+Relocator::Result tls_add(Relocation& pReloc, AArch64Relocator& pParent) {
+  Relocator::DWord X = helper_get_TLS_offset(pReloc, pParent);
+  switch (pReloc.type()) {
+    case llvm::ELF::R_AARCH64_TLSLD_ADD_DTPREL_HI12:
+    case llvm::ELF::R_AARCH64_TLSLE_ADD_TPREL_HI12:
+      pReloc.target() = helper_reencode_add_imm(pReloc.target(), X >> 12);
+      if ((X >> 24) != 0)
+        return Relocator::Overflow;
+      break;
+    case llvm::ELF::R_AARCH64_TLSLD_ADD_DTPREL_LO12:
+    case llvm::ELF::R_AARCH64_TLSLE_ADD_TPREL_LO12:
+      pReloc.target() = helper_reencode_add_imm(pReloc.target(), X);
+      if ((X >> 12) != 0)
+        return Relocator::Overflow;
+      break;
+    default:
+      pReloc.target() = helper_reencode_add_imm(pReloc.target(), X);
+      break;
+  }
+  return Relocator::OK;
+}
+
+// R_AARCH64_TLSLD_LDST*_DTPREL_LO12: DTPREL(S + A)
+// R_AARCH64_TLSLE_LDST*_TPREL_LO12: TPREL(S + A)
+// and the _NC variants without the overflow check
+Relocator::Result tls_ldst(Relocation& pReloc, AArch64Relocator& pParent) {
+  Relocator::DWord X = helper_get_TLS_offset(pReloc, pParent);
+  // the types go by pairs of the checked and the _NC one, from 8 to 64 bits
+  unsigned int index = pReloc.type();
+  if (index >= llvm::ELF::R_AARCH64_TLSLE_LDST8_TPREL_LO12)
+    index -= llvm::ELF::R_AARCH64_TLSLE_LDST8_TPREL_LO12;
+  else
+    index -= llvm::ELF::R_AARCH64_TLSLD_LDST8_DTPREL_LO12;
+  unsigned int shift = index / 2;
+  bool check = ((index % 2) == 0);
+
+  pReloc.target() = helper_reencode_ldst_pos_imm(
+      pReloc.target(), helper_get_page_offset(X) >> shift);
+  if (check && (X >> 12) != 0)
+    return Relocator::Overflow;
+  return Relocator::OK;
+}
+
+// R_AARCH64_TLSIE_ADR_GOTTPREL_PAGE21: Page(G(GTPREL(S+A))) - Page(P)
+Relocator::Result gottprel_page(Relocation& pReloc,
+                                AArch64Relocator& pParent) {
+  if (!(pReloc.symInfo()->reserved() & AArch64Relocator::ReserveGOT))
+    return Relocator::BadReloc;
+
+  Relocator::Address GOT_S = helper_get_GOT_address(*pReloc.symInfo(), pParent);
+  Relocator::DWord A = pReloc.addend();
+  Relocator::Address P = pReloc.place();
+  Relocator::DWord X =
+      helper_get_page_address(GOT_S + A) - helper_get_page_address(P);
+
+  pReloc.target() = helper_reencode_adr_imm(pReloc.target(), (X >> 12));
+
+  // set the offset from the thread pointer if the output knows it
+  AArch64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
+  if (AArch64Relocator::SymVal == got_entry->getValue())
+    got_entry->setValue(pReloc.symValue() + helper_get_TP_offset(pParent));
+
+  // setup relocation addend if needed
+  Relocation* dyn_rela = pParent.getRelRelMap().lookUp(pReloc);
+  if ((dyn_rela != NULL) && (AArch64Relocator::SymVal == dyn_rela->addend()))
+    dyn_rela->setAddend(pReloc.symValue());
+  return Relocator::OK;
+}
+
+// R_AARCH64_TLSIE_LD64_GOTTPREL_LO12_NC: G(GTPREL(S+A))
+Relocator::Result gottprel_lo12(Relocation& pReloc,
+                                AArch64Relocator& pParent) {
+  if (!(pReloc.symInfo()->reserved() & AArch64Relocator::ReserveGOT))
+    return Relocator::BadReloc;
+
+  Relocator::Address GOT_S = helper_get_GOT_address(*pReloc.symInfo(), pParent);
+  Relocator::DWord A = pReloc.addend();
+  Relocator::DWord X = helper_get_page_offset(GOT_S + A);
+
+  pReloc.target() = helper_reencode_ldst_pos_imm(pReloc.target(), (X >> 3));
+
+  // set the offset from the thread pointer if the output knows it
+  AArch64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
+  if (AArch64Relocator::SymVal == got_entry->getValue())
+    got_entry->setValue(pReloc.symValue() + helper_get_TP_offset(pParent));
+
+  // setup relocation addend if needed
+  Relocation* dyn_rela = pParent.getRelRelMap().lookUp(pReloc);
+  if ((dyn_rela != NULL) && (AArch64Relocator::SymVal == dyn_rela->addend()))
+    dyn_rela->setAddend(pReloc.symValue());
+  return Relocator::OK;
+}
+
+// R_AARCH64_TLSDESC_ADR_PAGE21: Page(G(GTLSDESC(S+A))) - Page(P)
+Relocator::Result tlsdesc_page(Relocation& pReloc, AArch64Relocator& pParent) {
+  AArch64GOTEntry* got_entry1 =
+      pParent.getSymTLSDescMap().lookUpFirstEntry(*pReloc.symInfo());
+  if (got_entry1 == NULL)
+    return Relocator::BadReloc;
+
+  // setup relocation addend if needed
+  Relocation* dyn_rela = pParent.getRelRelMap().lookUp(pReloc);
+  if ((dyn_rela != NULL) && (AArch64Relocator::SymVal == dyn_rela->addend()))
+    dyn_rela->setAddend(pReloc.symValue());
+
+  Relocator::Address GOT_S = helper_GOT_ORG(pParent) + got_entry1->getOffset();
+  Relocator::DWord A = pReloc.addend();
+  Relocator::Address P = pReloc.place();
+  Relocator::DWord X =
+      helper_get_page_address(GOT_S + A) - helper_get_page_address(P);
+
+  pReloc.target() = helper_reencode_adr_imm(pReloc.target(), (X >> 12));
+  return Relocator::OK;
+}
+
+// R_AARCH64_TLSDESC_LD64_LO12: G(GTLSDESC(S+A))
+// R_AARCH64_TLSDESC_ADD_LO12: G(GTLSDESC(S+A))
+Relocator::Result tlsdesc_lo12(Relocation& pReloc, AArch64Relocator& pParent) {
+  AArch64GOTEntry* got_entry1 =
+      pParent.getSymTLSDescMap().lookUpFirstEntry(*pReloc.symInfo());
+  if (got_entry1 == NULL)
+    return Relocator::BadReloc;
+
+  Relocator::Address GOT_S = helper_GOT_ORG(pParent) + got_entry1->getOffset();
+  Relocator::DWord A = pReloc.addend();
+  Relocator::DWord X = helper_get_page_offset(GOT_S + A);
+
+  if (pReloc.type() == kTLSDescLD64Lo12)
+    pReloc.target() = helper_reencode_ldst_pos_imm(pReloc.target(), (X >> 3));
+  else
+    pReloc.target() = helper_reencode_add_imm(pReloc.target(), X);
+  return Relocator::OK;
+}
+
 }  // namespace mcld
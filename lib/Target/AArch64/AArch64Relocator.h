@@ -69,6 +69,15 @@ class AArch64Relocator : public Relocator {
 
   Result applyRelocation(Relocation& pRelocation);
 
+  void applyRelocations(Type pType,
+                        Relocation* const* pBegin,
+                        Relocation* const* pEnd);
+
+  /// canApplyByType - every apply function only touches its own relocation
+  bool canApplyByType() const { return true; }
+
+  bool canApplyAlone(Type pType) const;
+
   AArch64GNULDBackend& getTarget() { return m_Target; }
 
   const AArch64GNULDBackend& getTarget() const { return m_Target; }
@@ -89,6 +98,10 @@ class AArch64Relocator : public Relocator {
   const RelRelMap& getRelRelMap() const { return m_RelRelMap; }
   RelRelMap& getRelRelMap() { return m_RelRelMap; }
 
+  /// the pairs of GOT entries of R_AARCH64_TLSDESC_ADR_PAGE21
+  const SymGOTMap& getSymTLSDescMap() const { return m_SymTLSDescMap; }
+  SymGOTMap& getSymTLSDescMap() { return m_SymTLSDescMap; }
+
   /// scanRelocation - determine the empty entries are needed or not and create
   /// the empty entries if needed.
   /// For AArch64, following entries are check to create:
@@ -101,6 +114,11 @@ class AArch64Relocator : public Relocator {
                       LDSection& pSection,
                       Input& pInput);
 
+  /// classifyScan - tell what scanRelocation() would do for pReloc
+  ScanKind classifyScan(const Relocation& pReloc,
+                        const LDSection& pSection,
+                        unsigned& pGroup) const;
+
   /// mayHaveFunctionPointerAccess - check if the given reloc would possibly
   /// access a function pointer.
   virtual bool mayHaveFunctionPointerAccess(const Relocation& pReloc) const;
@@ -114,11 +132,30 @@ class AArch64Relocator : public Relocator {
   void applyDebugStringOffset(Relocation& pReloc, uint32_t pOffset);
 
  private:
-  void scanLocalReloc(Relocation& pReloc, const LDSection& pSection);
+  ScanKind classifyLocalScan(const Relocation& pReloc, unsigned& pGroup) const;
+
+  ScanKind classifyGlobalScan(const Relocation& pReloc,
+                              unsigned& pGroup) const;
+
+  void scanLocalReloc(Relocation& pReloc, LDSection& pSection);
 
   void scanGlobalReloc(Relocation& pReloc,
                        IRBuilder& pBuilder,
-                       const LDSection& pSection);
+                       LDSection& pSection);
+
+  void scanTLSReloc(Relocation& pReloc);
+
+  /// relaxGOTLoad - turn adrp+ldr from the GOT into adrp+add of the address
+  /// of a symbol that is known at link time
+  bool relaxGOTLoad(Relocation& pReloc, LDSection& pSection);
+
+  /// relaxTLSDesc - rewrite an instruction of the TLS descriptor sequence to
+  /// load the offset from the thread pointer (pToLE) or from the GOT
+  bool relaxTLSDesc(Relocation& pReloc, bool pToLE);
+
+  /// relaxTLSIEtoLE - rewrite adrp+ldr of the GOT entry to movz+movk of the
+  /// offset from the thread pointer
+  bool relaxTLSIEtoLE(Relocation& pReloc);
 
   /// addCopyReloc - add a copy relocation into .rel.dyn for pSym
   /// @param pSym - A resolved copy symbol that defined in BSS section
@@ -136,6 +173,7 @@ class AArch64Relocator : public Relocator {
   SymPLTMap m_SymPLTMap;
   SymGOTMap m_SymGOTPLTMap;
   RelRelMap m_RelRelMap;
+  SymGOTMap m_SymTLSDescMap;
 };
 
 }  // namespace mcld
@@ -932,11 +932,8 @@ bool ARMGNULDBackend::doRelax(Module& pModule,
   for (auto it = invalid_frags.begin(), ie = invalid_frags.end(); it != ie;
        ++it) {
     Fragment* invalid = *it;
-    while (invalid != NULL) {
-      invalid->setOffset(invalid->getPrevNode()->getOffset() +
-                         invalid->getPrevNode()->size());
-      invalid = invalid->getNextNode();
-    }
+    invalid->getParent()->updateOffsets(*invalid,
+                                        config().options().numThreads());
   }
 
   // reset the size of section that has stubs inserted.
@@ -426,6 +426,151 @@ bool ARMRelocator::mayHaveFunctionPointerAccess(
   }
 }
 
+Relocator::ScanKind ARMRelocator::classifyLocalScan(const Relocation& pReloc,
+                                                    unsigned& pGroup) const {
+  switch (pReloc.type()) {
+    case llvm::ELF::R_ARM_ABS32:
+    case llvm::ELF::R_ARM_ABS32_NOI:
+    case llvm::ELF::R_ARM_ABS16:
+    case llvm::ELF::R_ARM_ABS12:
+    case llvm::ELF::R_ARM_THM_ABS5:
+    case llvm::ELF::R_ARM_ABS8:
+    case llvm::ELF::R_ARM_BASE_ABS:
+    case llvm::ELF::R_ARM_MOVW_ABS_NC:
+    case llvm::ELF::R_ARM_MOVT_ABS:
+    case llvm::ELF::R_ARM_THM_MOVW_ABS_NC:
+    case llvm::ELF::R_ARM_THM_MOVT_ABS:
+      return config().isCodeIndep() ? ScanEach : ScanNone;
+
+    case llvm::ELF::R_ARM_GOTOFF32:
+    case llvm::ELF::R_ARM_GOTOFF12:
+      return ScanNone;
+
+    case llvm::ELF::R_ARM_GOT_BREL:
+    case llvm::ELF::R_ARM_GOT_PREL:
+      pGroup = ReserveGOT;
+      return ScanSymbol;
+
+    // R_ARM_TARGET1 and R_ARM_TARGET2 are rewritten, the others are checked
+    case llvm::ELF::R_ARM_TARGET1:
+    case llvm::ELF::R_ARM_TARGET2:
+    case llvm::ELF::R_ARM_BASE_PREL:
+    case llvm::ELF::R_ARM_COPY:
+    case llvm::ELF::R_ARM_GLOB_DAT:
+    case llvm::ELF::R_ARM_JUMP_SLOT:
+    case llvm::ELF::R_ARM_RELATIVE:
+      return ScanEach;
+
+    default:
+      return ScanNone;
+  }
+}
+
+Relocator::ScanKind ARMRelocator::classifyGlobalScan(const Relocation& pReloc,
+                                                     unsigned& pGroup) const {
+  const ResolveInfo* rsym = pReloc.symInfo();
+  switch (pReloc.type()) {
+    case llvm::ELF::R_ARM_GOTOFF32:
+    case llvm::ELF::R_ARM_GOTOFF12:
+      return ScanNone;
+
+    case llvm::ELF::R_ARM_REL32:
+    case llvm::ELF::R_ARM_LDR_PC_G0:
+    case llvm::ELF::R_ARM_SBREL32:
+    case llvm::ELF::R_ARM_THM_PC8:
+    case llvm::ELF::R_ARM_MOVW_PREL_NC:
+    case llvm::ELF::R_ARM_MOVT_PREL:
+    case llvm::ELF::R_ARM_THM_MOVW_PREL_NC:
+    case llvm::ELF::R_ARM_THM_MOVT_PREL:
+    case llvm::ELF::R_ARM_THM_ALU_PREL_11_0:
+    case llvm::ELF::R_ARM_THM_PC12:
+    case llvm::ELF::R_ARM_REL32_NOI:
+    case llvm::ELF::R_ARM_ALU_PC_G0_NC:
+    case llvm::ELF::R_ARM_ALU_PC_G0:
+    case llvm::ELF::R_ARM_ALU_PC_G1_NC:
+    case llvm::ELF::R_ARM_ALU_PC_G1:
+    case llvm::ELF::R_ARM_ALU_PC_G2:
+    case llvm::ELF::R_ARM_LDR_PC_G1:
+    case llvm::ELF::R_ARM_LDR_PC_G2:
+    case llvm::ELF::R_ARM_LDRS_PC_G0:
+    case llvm::ELF::R_ARM_LDRS_PC_G1:
+    case llvm::ELF::R_ARM_LDRS_PC_G2:
+    case llvm::ELF::R_ARM_LDC_PC_G0:
+    case llvm::ELF::R_ARM_LDC_PC_G1:
+    case llvm::ELF::R_ARM_LDC_PC_G2:
+    case llvm::ELF::R_ARM_ALU_SB_G0_NC:
+    case llvm::ELF::R_ARM_ALU_SB_G0:
+    case llvm::ELF::R_ARM_ALU_SB_G1_NC:
+    case llvm::ELF::R_ARM_ALU_SB_G1:
+    case llvm::ELF::R_ARM_ALU_SB_G2:
+    case llvm::ELF::R_ARM_LDR_SB_G0:
+    case llvm::ELF::R_ARM_LDR_SB_G1:
+    case llvm::ELF::R_ARM_LDR_SB_G2:
+    case llvm::ELF::R_ARM_LDRS_SB_G0:
+    case llvm::ELF::R_ARM_LDRS_SB_G1:
+    case llvm::ELF::R_ARM_LDRS_SB_G2:
+    case llvm::ELF::R_ARM_LDC_SB_G0:
+    case llvm::ELF::R_ARM_LDC_SB_G1:
+    case llvm::ELF::R_ARM_LDC_SB_G2:
+    case llvm::ELF::R_ARM_MOVW_BREL_NC:
+    case llvm::ELF::R_ARM_MOVT_BREL:
+    case llvm::ELF::R_ARM_MOVW_BREL:
+      // having a PLT entry never adds a dynamic relocation
+      if (getTarget().symbolNeedsDynRel(*rsym, false, false))
+        return ScanEach;
+      return ScanNone;
+
+    case llvm::ELF::R_ARM_PC24:
+    case llvm::ELF::R_ARM_THM_CALL:
+    case llvm::ELF::R_ARM_PLT32:
+    case llvm::ELF::R_ARM_CALL:
+    case llvm::ELF::R_ARM_JUMP24:
+    case llvm::ELF::R_ARM_THM_JUMP24:
+    case llvm::ELF::R_ARM_SBREL31:
+    case llvm::ELF::R_ARM_PREL31:
+    case llvm::ELF::R_ARM_THM_JUMP19:
+    case llvm::ELF::R_ARM_THM_JUMP6:
+    case llvm::ELF::R_ARM_THM_JUMP11:
+    case llvm::ELF::R_ARM_THM_JUMP8:
+      pGroup = ReservePLT;
+      return ScanSymbol;
+
+    case llvm::ELF::R_ARM_GOT_BREL:
+    case llvm::ELF::R_ARM_GOT_ABS:
+    case llvm::ELF::R_ARM_GOT_PREL:
+      pGroup = ReserveGOT;
+      return ScanSymbol;
+
+    // absolute relocations, R_ARM_TARGET1 and R_ARM_TARGET2 which are
+    // rewritten, and the relocations against _GLOBAL_OFFSET_TABLE_ only
+    case llvm::ELF::R_ARM_TARGET1:
+    case llvm::ELF::R_ARM_TARGET2:
+    case llvm::ELF::R_ARM_ABS32:
+    case llvm::ELF::R_ARM_ABS16:
+    case llvm::ELF::R_ARM_ABS12:
+    case llvm::ELF::R_ARM_THM_ABS5:
+    case llvm::ELF::R_ARM_ABS8:
+    case llvm::ELF::R_ARM_BASE_ABS:
+    case llvm::ELF::R_ARM_MOVW_ABS_NC:
+    case llvm::ELF::R_ARM_MOVT_ABS:
+    case llvm::ELF::R_ARM_THM_MOVW_ABS_NC:
+    case llvm::ELF::R_ARM_THM_MOVT_ABS:
+    case llvm::ELF::R_ARM_ABS32_NOI:
+    case llvm::ELF::R_ARM_BASE_PREL:
+    case llvm::ELF::R_ARM_THM_MOVW_BREL_NC:
+    case llvm::ELF::R_ARM_THM_MOVW_BREL:
+    case llvm::ELF::R_ARM_THM_MOVT_BREL:
+    case llvm::ELF::R_ARM_COPY:
+    case llvm::ELF::R_ARM_GLOB_DAT:
+    case llvm::ELF::R_ARM_JUMP_SLOT:
+    case llvm::ELF::R_ARM_RELATIVE:
+      return ScanEach;
+
+    default:
+      return ScanNone;
+  }
+}
+
 void ARMRelocator::scanLocalReloc(Relocation& pReloc,
                                   const LDSection& pSection) {
   // rsym - The relocation target symbol
@@ -757,6 +902,23 @@ void ARMRelocator::scanRelocation(Relocation& pReloc,
     issueUndefRef(pReloc, pSection, pInput);
 }
 
+Relocator::ScanKind ARMRelocator::classifyScan(const Relocation& pReloc,
+                                               const LDSection& pSection,
+                                               unsigned& pGroup) const {
+  const ResolveInfo* rsym = pReloc.symInfo();
+  assert(pSection.getLink() != NULL);
+  if ((pSection.getLink()->flag() & llvm::ELF::SHF_ALLOC) == 0)
+    return ScanNone;
+
+  // an undefined reference is reported for every relocation
+  if (rsym->isUndef() && !rsym->isDyn() && !rsym->isWeak() && !rsym->isNull())
+    return ScanEach;
+
+  if (rsym->isLocal())
+    return classifyLocalScan(pReloc, pGroup);
+  return classifyGlobalScan(pReloc, pGroup);
+}
+
 uint32_t ARMRelocator::getDebugStringOffset(Relocation& pReloc) const {
   if (pReloc.type() != llvm::ELF::R_ARM_ABS32)
     error(diag::unsupport_reloc_for_debug_string)
@@ -92,6 +92,11 @@ class ARMRelocator : public Relocator {
                       LDSection& pSection,
                       Input& pInput);
 
+  /// classifyScan - tell what scanRelocation() would do for pReloc
+  ScanKind classifyScan(const Relocation& pReloc,
+                        const LDSection& pSection,
+                        unsigned& pGroup) const;
+
   /// mayHaveFunctionPointerAccess - check if the given reloc would possibly
   /// access a function pointer.
   virtual bool mayHaveFunctionPointerAccess(const Relocation& pReloc) const;
@@ -105,6 +110,11 @@ class ARMRelocator : public Relocator {
   void applyDebugStringOffset(Relocation& pReloc, uint32_t pOffset);
 
  private:
+  ScanKind classifyLocalScan(const Relocation& pReloc, unsigned& pGroup) const;
+
+  ScanKind classifyGlobalScan(const Relocation& pReloc,
+                              unsigned& pGroup) const;
+
   void scanLocalReloc(Relocation& pReloc, const LDSection& pSection);
 
   void scanGlobalReloc(Relocation& pReloc,
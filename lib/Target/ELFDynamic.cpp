@@ -7,6 +7,7 @@
 //
 //===----------------------------------------------------------------------===//
 #include "mcld/LD/ELFFileFormat.h"
+#include "mcld/Support/ELF.h"
 #include "mcld/Support/MsgHandling.h"
 #include "mcld/Target/ELFDynamic.h"
 #include "mcld/Target/GNULDBackend.h"
@@ -153,6 +154,12 @@ void ELFDynamic::reserveEntries(const ELFFileFormat& pFormat) {
     reserveOne(llvm::ELF::DT_RELAENT);
   }
 
+  if (pFormat.hasRelrDyn()) {
+    reserveOne(ELF::DT_RELR);
+    reserveOne(ELF::DT_RELRSZ);
+    reserveOne(ELF::DT_RELRENT);
+  }
+
   uint64_t dt_flags = 0x0;
   if (m_Config.options().hasOrigin())
     dt_flags |= llvm::ELF::DF_ORIGIN;
@@ -257,6 +264,12 @@ void ELFDynamic::applyEntries(const ELFFileFormat& pFormat) {
     applyOne(llvm::ELF::DT_RELAENT, m_pEntryFactory->relaSize());
   }
 
+  if (pFormat.hasRelrDyn()) {
+    applyOne(ELF::DT_RELR, pFormat.getRelrDyn().addr());
+    applyOne(ELF::DT_RELRSZ, pFormat.getRelrDyn().size());
+    applyOne(ELF::DT_RELRENT, m_Config.targets().bitclass() / 8);
+  }
+
   if (m_Backend.hasTextRel()) {
     applyOne(llvm::ELF::DT_TEXTREL, 0x0);
 
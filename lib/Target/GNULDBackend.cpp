@@ -18,6 +18,7 @@
 #include "mcld/Fragment/FillFragment.h"
 #include "mcld/LD/BranchIslandFactory.h"
 #include "mcld/LD/EhFrame.h"
+#include "mcld/LD/BuildID.h"
 #include "mcld/LD/EhFrameHdr.h"
 #include "mcld/LD/ELFDynObjFileFormat.h"
 #include "mcld/LD/ELFExecFileFormat.h"
@@ -38,9 +39,11 @@
 #include "mcld/Script/RpnEvaluator.h"
 #include "mcld/Support/FileOutputBuffer.h"
 #include "mcld/Support/MsgHandling.h"
+#include "mcld/Support/TimeTrace.h"
 #include "mcld/Target/ELFAttribute.h"
 #include "mcld/Target/ELFDynamic.h"
 #include "mcld/Target/GNUInfo.h"
+#include "mcld/Target/RelrSection.h"
 
 #include <llvm/ADT/StringRef.h>
 #include <llvm/Support/Host.h>
@@ -87,6 +90,8 @@ GNULDBackend::GNULDBackend(const LinkerConfig& pConfig, GNUInfo* pInfo)
       m_pBRIslandFactory(NULL),
       m_pStubFactory(NULL),
       m_pEhFrameHdr(NULL),
+      m_pBuildID(NULL),
+      m_pRelrDyn(NULL),
       m_pAttribute(NULL),
       m_bHasTextRel(false),
       m_bHasStaticTLS(false),
@@ -122,6 +127,8 @@ GNULDBackend::~GNULDBackend() {
   delete m_pObjectFileFormat;
   delete m_pSymIndexMap;
   delete m_pEhFrameHdr;
+  delete m_pBuildID;
+  delete m_pRelrDyn;
   delete m_pAttribute;
   delete m_pBRIslandFactory;
   delete m_pStubFactory;
@@ -2280,10 +2287,9 @@ void GNULDBackend::setOutputSectionAddress(Module& pModule) {
     }    // for each input description
 
     if (changed) {
-      while (invalid != NULL) {
-        Fragment* prev = invalid->getPrevNode();
-        invalid->setOffset(prev->getOffset() + prev->size());
-        invalid = invalid->getNextNode();
+      if (invalid != NULL) {
+        invalid->getParent()->updateOffsets(*invalid,
+                                            config().options().numThreads());
       }
 
       cur->setSize(cur->getSectionData()->back().getOffset() +
@@ -2482,12 +2488,61 @@ void GNULDBackend::createAndSizeEhFrameHdr(Module& pModule) {
       config().options().hasEhFrameHdr() && getOutputFormat()->hasEhFrame()) {
     // init EhFrameHdr and size the output section
     ELFFileFormat* format = getOutputFormat();
-    m_pEhFrameHdr =
-        new EhFrameHdr(format->getEhFrameHdr(), format->getEhFrame());
+    m_pEhFrameHdr = new EhFrameHdr(format->getEhFrameHdr(),
+                                   format->getEhFrame(),
+                                   config().options().numThreads());
     m_pEhFrameHdr->sizeOutput();
   }
 }
 
+void GNULDBackend::createAndSizeBuildID(Module& pModule) {
+  if (LinkerConfig::Object != config().codeGenType() &&
+      config().options().hasBuildID()) {
+    m_pBuildID = new BuildID(getOutputFormat()->getNoteGNUBuildID(),
+                             config().options().getBuildIDStyle(),
+                             config().options().buildIDBytes(),
+                             config().targets().isLittleEndian(),
+                             config().options().numThreads());
+    m_pBuildID->sizeOutput();
+  }
+}
+
+void GNULDBackend::packRelativeRelocs() {
+  if (LinkerConfig::Object == config().codeGenType() ||
+      config().isCodeStatic() ||
+      GeneralOptions::DynRelocPacking::Relr !=
+          config().options().getPackDynRelocs() ||
+      0x0 == getRelativeRelocType())
+    return;
+
+  ELFFileFormat* file_format = getOutputFormat();
+  LDSection& rela_dyn = file_format->getRelaDyn();
+  if (!rela_dyn.hasRelocData())
+    return;
+
+  m_pRelrDyn = new RelrSection(file_format->getRelrDyn(), config());
+  RelocData* reloc_data = rela_dyn.getRelocData();
+  RelocData::iterator reloc = reloc_data->begin();
+  while (reloc != reloc_data->end()) {
+    Relocation& relocation = *reloc++;
+    if (getRelativeRelocType() == relocation.type() &&
+        m_pRelrDyn->canPack(relocation)) {
+      reloc_data->remove(relocation);
+      m_pRelrDyn->add(relocation);
+    }
+  }
+
+  if (m_pRelrDyn->empty()) {
+    delete m_pRelrDyn;
+    m_pRelrDyn = NULL;
+    return;
+  }
+
+  rela_dyn.setSize(reloc_data->size() * getRelaEntrySize());
+  // reserve a word so that .relr.dyn is laid out, it is sized after layout
+  file_format->getRelrDyn().setSize(config().targets().bitclass() / 8);
+}
+
 /// mayHaveUnsafeFunctionPointerAccess - check if the section may have unsafe
 /// function pointer access
 bool GNULDBackend::mayHaveUnsafeFunctionPointerAccess(
@@ -2504,6 +2559,9 @@ void GNULDBackend::preLayout(Module& pModule, IRBuilder& pBuilder) {
   // prelayout target first
   doPreLayout(pBuilder);
 
+  // the dynamic relocations are known and .rela.dyn is sized
+  packRelativeRelocs();
+
   // change .tbss and .tdata section symbol from Local to LocalDyn category
   if (f_pTDATA != NULL)
     pModule.getSymbolTable().changeToDynamic(*f_pTDATA);
@@ -2575,6 +2633,10 @@ void GNULDBackend::postLayout(Module& pModule, IRBuilder& pBuilder) {
   if (LinkerConfig::Object != config().codeGenType()) {
     // do relaxation
     relax(pModule, pBuilder);
+    // size .relr.dyn by the final addresses, which may move the sections
+    // after it
+    while (m_pRelrDyn != NULL && m_pRelrDyn->finalizeSectionSize())
+      setOutputSectionAddress(pModule);
     // set up the attributes of program headers
     setupProgramHdrs(pModule.getScript());
   }
@@ -2583,11 +2645,25 @@ void GNULDBackend::postLayout(Module& pModule, IRBuilder& pBuilder) {
 }
 
 void GNULDBackend::postProcessing(FileOutputBuffer& pOutput) {
+  // the words relocated by .relr.dyn hold their addends
+  if (m_pRelrDyn != NULL)
+    m_pRelrDyn->applyAddends(pOutput);
+
   if (LinkerConfig::Object != config().codeGenType() &&
       config().options().hasEhFrameHdr() && getOutputFormat()->hasEhFrame()) {
     // emit eh_frame_hdr
-    m_pEhFrameHdr->emitOutput<32>(pOutput);
+    if (config().targets().is32Bits())
+      m_pEhFrameHdr->emitOutput<32>(pOutput);
+    else if (config().targets().is64Bits())
+      m_pEhFrameHdr->emitOutput<64>(pOutput);
+    else
+      fatal(diag::unsupported_bitclass) << config().targets().triple().str()
+                                        << config().targets().bitclass();
   }
+
+  // the build id hashes the whole output, so it goes last
+  if (m_pBuildID != NULL)
+    m_pBuildID->emitOutput(pOutput);
 }
 
 /// getHashBucketCount - calculate hash bucket count.
@@ -2919,6 +2995,7 @@ bool GNULDBackend::relax(Module& pModule, IRBuilder& pBuilder) {
 
   bool finished = true;
   do {
+    TimeTrace::Scope step("relaxIteration");
     if (doRelax(pModule, pBuilder, finished)) {
       setOutputSectionAddress(pModule);
     }
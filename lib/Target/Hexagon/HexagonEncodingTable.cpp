@@ -0,0 +1,127 @@
+//===- HexagonEncodingTable.cpp -------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "HexagonEncodingTable.h"
+#include "HexagonEncodings.h"
+
+#include <cassert>
+
+namespace mcld {
+
+namespace {
+
+/// the most bits of a key, so that a level has at most 256 entries
+const unsigned kMaxKeyBits = 8;
+
+/// the parse bits of a duplex instruction are 0b00
+bool isDuplexInsn(uint32_t pInsn) {
+  return (pInsn & 0xc000) == 0;
+}
+
+/// keepHighBits - keep the highest pMaxBits set bits of pMask
+uint32_t keepHighBits(uint32_t pMask, unsigned pMaxBits) {
+  uint32_t result = 0;
+  for (int bit = 31; bit >= 0 && pMaxBits != 0; --bit) {
+    if ((pMask >> bit) & 1) {
+      result |= 1u << bit;
+      --pMaxBits;
+    }
+  }
+  return result;
+}
+
+/// numBits - the number of set bits in pMask
+unsigned numBits(uint32_t pMask) {
+  unsigned count = 0;
+  for (; pMask != 0; pMask &= pMask - 1)
+    ++count;
+  return count;
+}
+
+/// gatherBits - pack the bits of pInsn selected by pMask into the low bits
+uint32_t gatherBits(uint32_t pInsn, uint32_t pMask) {
+  uint32_t result = 0;
+  unsigned off = 0;
+  for (; pMask != 0; pMask &= pMask - 1) {
+    uint32_t lowest = pMask & -pMask;
+    if (pInsn & lowest)
+      result |= 1u << off;
+    ++off;
+  }
+  return result;
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// HexagonEncodingTable
+//===----------------------------------------------------------------------===//
+HexagonEncodingTable::HexagonEncodingTable(const Instruction* pEncodings,
+                                           size_t pNumEncodings)
+    : m_Encodings(pEncodings), m_NumEncodings(pNumEncodings) {
+  assert(pNumEncodings <= 0xffff && "too many encodings for the slot index");
+  buildClass(m_Classes[0], false);
+  buildClass(m_Classes[1], true);
+}
+
+const HexagonEncodingTable& HexagonEncodingTable::instance() {
+  static const HexagonEncodingTable table(
+      insn_encodings, sizeof(insn_encodings) / sizeof(Instruction));
+  return table;
+}
+
+void HexagonEncodingTable::buildClass(Class& pClass, bool pIsDuplex) {
+  // the bits fixed by every encoding of the class select the bucket
+  uint32_t common = ~0u;
+  for (size_t i = 0; i < m_NumEncodings; ++i) {
+    if (m_Encodings[i].isDuplex == pIsDuplex)
+      common &= m_Encodings[i].insnMask;
+  }
+  pClass.mask = keepHighBits(common, kMaxKeyBits);
+  pClass.buckets.resize(1u << numBits(pClass.mask));
+
+  std::vector<std::vector<uint16_t> > members(pClass.buckets.size());
+  for (size_t i = 0; i < m_NumEncodings; ++i) {
+    const Instruction& encoding = m_Encodings[i];
+    if (encoding.isDuplex != pIsDuplex)
+      continue;
+    members[gatherBits(encoding.insnCmpMask, pClass.mask)].push_back(i);
+  }
+
+  // the bits fixed by every encoding of a bucket select the slot. Members are
+  // pushed in table order, so each slot keeps the first-match order.
+  for (size_t b = 0; b < members.size(); ++b) {
+    Bucket& bucket = pClass.buckets[b];
+    common = ~pClass.mask;
+    for (size_t m = 0; m < members[b].size(); ++m)
+      common &= m_Encodings[members[b][m]].insnMask;
+    bucket.mask = members[b].empty() ? 0 : keepHighBits(common, kMaxKeyBits);
+    bucket.slots.resize(1u << numBits(bucket.mask));
+
+    for (size_t m = 0; m < members[b].size(); ++m) {
+      uint16_t idx = members[b][m];
+      uint32_t key = gatherBits(m_Encodings[idx].insnCmpMask, bucket.mask);
+      bucket.slots[key].push_back(idx);
+    }
+  }
+}
+
+const Instruction* HexagonEncodingTable::lookUp(uint32_t pInsn) const {
+  const Class& klass = m_Classes[isDuplexInsn(pInsn) ? 1 : 0];
+  const Bucket& bucket = klass.buckets[gatherBits(pInsn, klass.mask)];
+  const Slot& slot = bucket.slots[gatherBits(pInsn, bucket.mask)];
+  for (Slot::const_iterator it = slot.begin(), ie = slot.end(); it != ie;
+       ++it) {
+    const Instruction& encoding = m_Encodings[*it];
+    if ((encoding.insnMask & pInsn) == encoding.insnCmpMask)
+      return &encoding;
+  }
+  return NULL;
+}
+
+}  // namespace mcld
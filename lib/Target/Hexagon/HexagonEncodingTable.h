@@ -0,0 +1,85 @@
+//===- HexagonEncodingTable.h ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef TARGET_HEXAGON_HEXAGONENCODINGTABLE_H_
+#define TARGET_HEXAGON_HEXAGONENCODINGTABLE_H_
+
+#include "mcld/Support/Compiler.h"
+
+#include <llvm/Support/DataTypes.h>
+
+#include <cstddef>
+#include <vector>
+
+typedef struct {
+  const char* insnSyntax;
+  uint32_t insnMask;
+  uint32_t insnCmpMask;
+  uint32_t insnBitMask;
+  bool isDuplex;
+} Instruction;
+
+namespace mcld {
+
+/** \class HexagonEncodingTable
+ *  \brief HexagonEncodingTable decodes an instruction word to its entry in
+ *  the encoding table of HexagonEncodings.h.
+ *
+ *  The entries are split by the duplex flag, then bucketed by the bits that
+ *  every encoding of the class fixes (the major opcode), and each bucket is
+ *  split again by the bits that all of its encodings fix. An instruction can
+ *  only match the entries of the slot its own bits select, and the entries of
+ *  a slot keep their table order, so lookUp() returns the same entry as a
+ *  linear scan of the table does.
+ */
+class HexagonEncodingTable {
+ public:
+  /// instance - the table decoding the entries of HexagonEncodings.h
+  static const HexagonEncodingTable& instance();
+
+  /// lookUp - find the first encoding matching pInsn, or NULL if none does
+  const Instruction* lookUp(uint32_t pInsn) const;
+
+  /// size - the number of encodings in the table
+  size_t size() const { return m_NumEncodings; }
+
+  /// getEncoding - the pIdx-th encoding in table order
+  const Instruction& getEncoding(size_t pIdx) const {
+    return m_Encodings[pIdx];
+  }
+
+ private:
+  typedef std::vector<uint16_t> Slot;
+
+  struct Bucket {
+    uint32_t mask;
+    std::vector<Slot> slots;
+  };
+
+  struct Class {
+    uint32_t mask;
+    std::vector<Bucket> buckets;
+  };
+
+ private:
+  HexagonEncodingTable(const Instruction* pEncodings, size_t pNumEncodings);
+
+  void buildClass(Class& pClass, bool pIsDuplex);
+
+ private:
+  const Instruction* m_Encodings;
+  size_t m_NumEncodings;
+  Class m_Classes[2];
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HexagonEncodingTable);
+};
+
+}  // namespace mcld
+
+#endif  // TARGET_HEXAGON_HEXAGONENCODINGTABLE_H_
@@ -9,13 +9,7 @@
 #ifndef TARGET_HEXAGON_HEXAGONRELOCATIONFUNCTIONS_H_
 #define TARGET_HEXAGON_HEXAGONRELOCATIONFUNCTIONS_H_
 
-typedef struct {
-  const char* insnSyntax;
-  uint32_t insnMask;
-  uint32_t insnCmpMask;
-  uint32_t insnBitMask;
-  bool isDuplex;
-} Instruction;
+#include "HexagonEncodingTable.h"
 
 //===--------------------------------------------------------------------===//
 // Relocation helper function
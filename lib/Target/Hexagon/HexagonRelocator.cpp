@@ -8,7 +8,7 @@
 //===----------------------------------------------------------------------===//
 #include "HexagonRelocator.h"
 #include "HexagonRelocationFunctions.h"
-#include "HexagonEncodings.h"
+#include "HexagonEncodingTable.h"
 
 #include "mcld/LD/ELFFileFormat.h"
 #include "mcld/LD/LDSymbol.h"
@@ -138,29 +138,17 @@ struct ApplyFunctionTriple {
 static const ApplyFunctionTriple ApplyFunctions[] = {
     DECL_HEXAGON_APPLY_RELOC_FUNC_PTRS};
 
-static uint32_t findBitMask(uint32_t insn,
-                            Instruction* encodings,
-                            int32_t numInsns) {
-  for (int32_t i = 0; i < numInsns; ++i) {
-    if (((insn & 0xc000) == 0) && !(encodings[i].isDuplex))
-      continue;
-
-    if (((insn & 0xc000) != 0) && (encodings[i].isDuplex))
-      continue;
-
-    if (((encodings[i].insnMask) & insn) == encodings[i].insnCmpMask)
-      return encodings[i].insnBitMask;
+static uint32_t findBitMask(uint32_t insn) {
+  const Instruction* encoding = HexagonEncodingTable::instance().lookUp(insn);
+  assert(encoding != NULL);
+  if (encoding == NULL) {
+    // Should not be here, every relocated instruction has an encoding
+    return -1;
   }
-  assert(0);
-  // Should not be here, but add a return for -Werror=return-type
-  // error: control reaches end of non-void function
-  return -1;
+  return encoding->insnBitMask;
 }
 
-#define FINDBITMASK(INSN)     \
-  findBitMask((uint32_t)INSN, \
-              insn_encodings, \
-              sizeof(insn_encodings) / sizeof(Instruction))
+#define FINDBITMASK(INSN) findBitMask((uint32_t)INSN)
 
 //===--------------------------------------------------------------------===//
 // HexagonRelocator
@@ -223,6 +211,26 @@ void HexagonRelocator::scanRelocation(Relocation& pReloc,
     issueUndefRef(pReloc, pSection, pInput);
 }
 
+Relocator::ScanKind HexagonRelocator::classifyScan(const Relocation& pReloc,
+                                                   const LDSection& pSection,
+                                                   unsigned& pGroup) const {
+  if (LinkerConfig::Object == config().codeGenType() ||
+      config().isCodeStatic())
+    return ScanNone;
+  const ResolveInfo* rsym = pReloc.symInfo();
+  assert(pSection.getLink() != NULL);
+  if ((pSection.getLink()->flag() & llvm::ELF::SHF_ALLOC) == 0)
+    return ScanNone;
+
+  // an undefined reference is reported for every relocation
+  if (rsym->isUndef() && !rsym->isDyn() && !rsym->isWeak() && !rsym->isNull())
+    return ScanEach;
+
+  if (rsym->isLocal())
+    return classifyLocalScan(pReloc, pGroup);
+  return classifyGlobalScan(pReloc, pGroup);
+}
+
 void HexagonRelocator::addCopyReloc(ResolveInfo& pSym,
                                     HexagonLDBackend& pTarget) {
   Relocation& rel_entry = *pTarget.getRelaDyn().create();
@@ -232,6 +240,57 @@ void HexagonRelocator::addCopyReloc(ResolveInfo& pSym,
   rel_entry.setSymInfo(&pSym);
 }
 
+Relocator::ScanKind HexagonRelocator::classifyLocalScan(
+    const Relocation& pReloc,
+    unsigned& pGroup) const {
+  if (llvm::ELF::R_HEX_32 == pReloc.type() && config().isCodeIndep())
+    return ScanEach;
+  return ScanNone;
+}
+
+Relocator::ScanKind HexagonRelocator::classifyGlobalScan(
+    const Relocation& pReloc,
+    unsigned& pGroup) const {
+  switch (pReloc.type()) {
+    case llvm::ELF::R_HEX_32:
+      return ScanEach;
+
+    case llvm::ELF::R_HEX_GOT_LO16:
+    case llvm::ELF::R_HEX_GOT_HI16:
+    case llvm::ELF::R_HEX_GOT_32:
+    case llvm::ELF::R_HEX_GOT_16:
+    case llvm::ELF::R_HEX_GOT_32_6_X:
+    case llvm::ELF::R_HEX_GOT_16_X:
+    case llvm::ELF::R_HEX_GOT_11_X:
+      pGroup = ReserveGOT;
+      return ScanSymbol;
+
+    case llvm::ELF::R_HEX_B22_PCREL:
+    case llvm::ELF::R_HEX_B15_PCREL:
+    case llvm::ELF::R_HEX_B7_PCREL:
+    case llvm::ELF::R_HEX_B13_PCREL:
+    case llvm::ELF::R_HEX_B9_PCREL:
+    case llvm::ELF::R_HEX_B32_PCREL_X:
+    case llvm::ELF::R_HEX_B22_PCREL_X:
+    case llvm::ELF::R_HEX_B15_PCREL_X:
+    case llvm::ELF::R_HEX_B13_PCREL_X:
+    case llvm::ELF::R_HEX_B9_PCREL_X:
+    case llvm::ELF::R_HEX_B7_PCREL_X:
+    case llvm::ELF::R_HEX_32_PCREL:
+    case llvm::ELF::R_HEX_6_PCREL_X:
+      // only a symbol needing a PLT entry gets one by a branch
+      if (!getTarget().symbolNeedsPLT(*pReloc.symInfo()))
+        return ScanNone;
+    // fall through
+    case llvm::ELF::R_HEX_PLT_B22_PCREL:
+      pGroup = ReservePLT;
+      return ScanSymbol;
+
+    default:
+      return ScanNone;
+  }
+}
+
 void HexagonRelocator::scanLocalReloc(Relocation& pReloc,
                                       IRBuilder& pBuilder,
                                       Module& pModule,
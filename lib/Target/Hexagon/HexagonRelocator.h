@@ -81,6 +81,11 @@ class HexagonRelocator : public Relocator {
                       LDSection& pSection,
                       Input& pInput);
 
+  /// classifyScan - tell what scanRelocation() would do for pReloc
+  ScanKind classifyScan(const Relocation& pReloc,
+                        const LDSection& pSection,
+                        unsigned& pGroup) const;
+
   // Handle partial linking
   void partialScanRelocation(Relocation& pReloc,
                              Module& pModule);
@@ -126,6 +131,11 @@ class HexagonRelocator : public Relocator {
                                      HexagonLDBackend& pTarget);
 
  private:
+  ScanKind classifyLocalScan(const Relocation& pReloc, unsigned& pGroup) const;
+
+  ScanKind classifyGlobalScan(const Relocation& pReloc,
+                              unsigned& pGroup) const;
+
   virtual void scanLocalReloc(Relocation& pReloc,
                               IRBuilder& pBuilder,
                               Module& pModule,
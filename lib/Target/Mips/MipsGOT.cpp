@@ -14,9 +14,12 @@
 #include "MipsGOT.h"
 #include "MipsRelocator.h"
 
+#include <llvm/ADT/Hashing.h>
 #include <llvm/Support/Casting.h>
 #include <llvm/Support/ELF.h>
 
+#include <algorithm>
+
 namespace {
 const uint32_t Mips32ModulePtr = 1 << 31;
 const uint64_t Mips64ModulePtr = 1ull << 63;
@@ -27,12 +30,85 @@ const size_t MipsGOTSize = MipsGOTGpOffset + 0x7FFF;
 
 namespace mcld {
 
+//===----------------------------------------------------------------------===//
+// MipsGOT::LocalEntry
+//===----------------------------------------------------------------------===//
+MipsGOT::LocalEntry::LocalEntry(const ResolveInfo* pInfo,
+                                Relocation::DWord addend,
+                                bool isGot16)
+    : m_pInfo(pInfo), m_Addend(addend), m_IsGot16(isGot16) {
+}
+
+bool MipsGOT::LocalEntry::operator==(const LocalEntry& O) const {
+  return m_pInfo == O.m_pInfo && m_Addend == O.m_Addend &&
+         m_IsGot16 == O.m_IsGot16;
+}
+
+MipsGOT::LocalEntry MipsGOT::LocalEntryInfo::getEmptyKey() {
+  return LocalEntry(llvm::DenseMapInfo<const ResolveInfo*>::getEmptyKey(), 0,
+                    false);
+}
+
+MipsGOT::LocalEntry MipsGOT::LocalEntryInfo::getTombstoneKey() {
+  return LocalEntry(llvm::DenseMapInfo<const ResolveInfo*>::getTombstoneKey(),
+                    0, false);
+}
+
+unsigned MipsGOT::LocalEntryInfo::getHashValue(const LocalEntry& pEntry) {
+  return llvm::hash_combine(pEntry.m_pInfo, pEntry.m_Addend, pEntry.m_IsGot16);
+}
+
+bool MipsGOT::LocalEntryInfo::isEqual(const LocalEntry& pX,
+                                      const LocalEntry& pY) {
+  return pX == pY;
+}
+
+//===----------------------------------------------------------------------===//
+// MipsGOT::GotEntryKeyInfo
+//===----------------------------------------------------------------------===//
+MipsGOT::GotEntryKey MipsGOT::GotEntryKeyInfo::getEmptyKey() {
+  GotEntryKey key;
+  key.m_GOTPage = 0;
+  key.m_pInfo = llvm::DenseMapInfo<const ResolveInfo*>::getEmptyKey();
+  key.m_Addend = 0;
+  return key;
+}
+
+MipsGOT::GotEntryKey MipsGOT::GotEntryKeyInfo::getTombstoneKey() {
+  GotEntryKey key;
+  key.m_GOTPage = 0;
+  key.m_pInfo = llvm::DenseMapInfo<const ResolveInfo*>::getTombstoneKey();
+  key.m_Addend = 0;
+  return key;
+}
+
+unsigned MipsGOT::GotEntryKeyInfo::getHashValue(const GotEntryKey& pKey) {
+  return llvm::hash_combine(pKey.m_GOTPage, pKey.m_pInfo, pKey.m_Addend);
+}
+
+bool MipsGOT::GotEntryKeyInfo::isEqual(const GotEntryKey& pX,
+                                       const GotEntryKey& pY) {
+  return pX == pY;
+}
+
+//===----------------------------------------------------------------------===//
+// MipsGOT::InputEntries
+//===----------------------------------------------------------------------===//
+MipsGOT::InputEntries::InputEntries(const Input& pInput)
+    : m_pInput(&pInput), m_HasTLSLdm(false) {
+}
+
+size_t MipsGOT::InputEntries::size() const {
+  return m_Locals.size() + m_Globals.size() + 2 * m_TLSGdSymbols.size() +
+         m_TLSGotSymbols.size() + (m_HasTLSLdm ? 2 : 0);
+}
+
 //===----------------------------------------------------------------------===//
 // MipsGOT::GOTMultipart
 //===----------------------------------------------------------------------===//
-MipsGOT::GOTMultipart::GOTMultipart(size_t local, size_t global)
-    : m_LocalNum(local),
-      m_GlobalNum(global),
+MipsGOT::GOTMultipart::GOTMultipart()
+    : m_LocalNum(0),
+      m_GlobalNum(0),
       m_TLSNum(0),
       m_TLSDynNum(0),
       m_ConsumedLocal(0),
@@ -40,12 +116,77 @@ MipsGOT::GOTMultipart::GOTMultipart(size_t local, size_t global)
       m_ConsumedTLS(0),
       m_pLastLocal(NULL),
       m_pLastGlobal(NULL),
-      m_pLastTLS(NULL) {
+      m_pLastTLS(NULL),
+      m_pTLSLdmEntry(NULL),
+      m_Offset(0),
+      m_HasTLSLdm(false) {
 }
 
-bool MipsGOT::GOTMultipart::isConsumed() const {
-  return m_LocalNum == m_ConsumedLocal && m_GlobalNum == m_ConsumedGlobal &&
-         m_TLSNum == m_ConsumedTLS;
+bool MipsGOT::GOTMultipart::addLocal(const LocalEntry& pEntry) {
+  if (!m_LocalSymbols.insert(pEntry).second)
+    return false;
+  ++m_LocalNum;
+  return true;
+}
+
+bool MipsGOT::GOTMultipart::addGlobal(const ResolveInfo* pInfo) {
+  if (!m_GlobalSymbols.insert(pInfo).second)
+    return false;
+  ++m_GlobalNum;
+  return true;
+}
+
+bool MipsGOT::GOTMultipart::addTLSGd(const ResolveInfo* pInfo) {
+  if (!m_TLSGdSymbols.insert(pInfo).second)
+    return false;
+  m_TLSNum += 2;
+  m_TLSDynNum += 2;
+  return true;
+}
+
+bool MipsGOT::GOTMultipart::addTLSGot(const ResolveInfo* pInfo) {
+  if (!m_TLSGotSymbols.insert(pInfo).second)
+    return false;
+  m_TLSNum += 1;
+  m_TLSDynNum += 1;
+  return true;
+}
+
+bool MipsGOT::GOTMultipart::addTLSLdm() {
+  if (m_HasTLSLdm)
+    return false;
+  m_HasTLSLdm = true;
+  m_TLSNum += 2;
+  m_TLSDynNum += 1;
+  return true;
+}
+
+size_t MipsGOT::GOTMultipart::countNew(const InputEntries& pInput) const {
+  size_t count = 0;
+  for (size_t i = 0; i < pInput.m_Locals.size(); ++i)
+    count += m_LocalSymbols.count(pInput.m_Locals[i]) ? 0 : 1;
+  for (size_t i = 0; i < pInput.m_Globals.size(); ++i)
+    count += m_GlobalSymbols.count(pInput.m_Globals[i]) ? 0 : 1;
+  for (size_t i = 0; i < pInput.m_TLSGdSymbols.size(); ++i)
+    count += m_TLSGdSymbols.count(pInput.m_TLSGdSymbols[i]) ? 0 : 2;
+  for (size_t i = 0; i < pInput.m_TLSGotSymbols.size(); ++i)
+    count += m_TLSGotSymbols.count(pInput.m_TLSGotSymbols[i]) ? 0 : 1;
+  if (pInput.m_HasTLSLdm && !m_HasTLSLdm)
+    count += 2;
+  return count;
+}
+
+void MipsGOT::GOTMultipart::add(const InputEntries& pInput) {
+  for (size_t i = 0; i < pInput.m_Locals.size(); ++i)
+    addLocal(pInput.m_Locals[i]);
+  for (size_t i = 0; i < pInput.m_Globals.size(); ++i)
+    addGlobal(pInput.m_Globals[i]);
+  for (size_t i = 0; i < pInput.m_TLSGdSymbols.size(); ++i)
+    addTLSGd(pInput.m_TLSGdSymbols[i]);
+  for (size_t i = 0; i < pInput.m_TLSGotSymbols.size(); ++i)
+    addTLSGot(pInput.m_TLSGotSymbols[i]);
+  if (pInput.m_HasTLSLdm)
+    addTLSLdm();
 }
 
 void MipsGOT::GOTMultipart::consumeLocal() {
@@ -61,41 +202,22 @@ void MipsGOT::GOTMultipart::consumeGlobal() {
   m_pLastGlobal = m_pLastGlobal->getNextNode();
 }
 
-void MipsGOT::GOTMultipart::consumeTLS(Relocation::Type pType) {
+Fragment* MipsGOT::GOTMultipart::consumeTLS(Relocation::Type pType) {
   assert(m_ConsumedTLS < m_TLSNum &&
          "Consumed too many TLS GOT entries");
-  m_ConsumedTLS += pType == llvm::ELF::R_MIPS_TLS_GOTTPREL ? 1 : 2;
-  m_pLastTLS = m_pLastTLS->getNextNode();
-}
-
-//===----------------------------------------------------------------------===//
-// MipsGOT::LocalEntry
-//===----------------------------------------------------------------------===//
-MipsGOT::LocalEntry::LocalEntry(const ResolveInfo* pInfo,
-                                Relocation::DWord addend,
-                                bool isGot16)
-    : m_pInfo(pInfo), m_Addend(addend), m_IsGot16(isGot16) {
-}
-
-bool MipsGOT::LocalEntry::operator<(const LocalEntry& O) const {
-  if (m_pInfo != O.m_pInfo)
-    return m_pInfo < O.m_pInfo;
-
-  if (m_Addend != O.m_Addend)
-    return m_Addend < O.m_Addend;
-
-  return m_IsGot16 < O.m_IsGot16;
+  size_t num = pType == llvm::ELF::R_MIPS_TLS_GOTTPREL ? 1 : 2;
+  m_ConsumedTLS += num;
+  // R_MIPS_TLS_GD and R_MIPS_TLS_LDM take a pair of entries
+  Fragment* entry = m_pLastTLS->getNextNode();
+  m_pLastTLS = num == 1 ? entry : entry->getNextNode();
+  return entry;
 }
 
 //===----------------------------------------------------------------------===//
 // MipsGOT
 //===----------------------------------------------------------------------===//
 MipsGOT::MipsGOT(LDSection& pSection)
-    : GOT(pSection),
-      m_pInput(NULL),
-      m_HasTLSLdmSymbol(false),
-      m_CurrentGOTPart(0),
-      m_GotTLSLdmEntry(nullptr) {
+    : GOT(pSection), m_CurrentGOTPart(0) {
 }
 
 uint64_t MipsGOT::getGPDispAddress() const {
@@ -108,17 +230,163 @@ void MipsGOT::reserve(size_t pNum) {
 }
 
 bool MipsGOT::hasGOT1() const {
-  return !m_MultipartList.empty();
+  return !m_InputEntries.empty();
 }
 
 bool MipsGOT::hasMultipleGOT() const {
+  // Before partition() the entries scanned so far tell if one GOT is enough.
+  if (m_MultipartList.empty())
+    return !fits(m_AllEntries.size());
   return m_MultipartList.size() > 1;
 }
 
+bool MipsGOT::fits(size_t pNum) const {
+  return (MipsGOT0Num + pNum) * getEntrySize() <= MipsGOTSize;
+}
+
+void MipsGOT::split(const std::vector<size_t>& pOrder,
+                    bool pBestFit,
+                    MultipartListType& pParts,
+                    std::vector<size_t>& pPartOf) const {
+  pParts.clear();
+  pPartOf.assign(m_InputEntries.size(), 0);
+  for (size_t i = 0; i < pOrder.size(); ++i) {
+    const InputEntries& input = m_InputEntries[pOrder[i]];
+
+    // Prefer the GOT that already has most entries of the input.
+    size_t best = pParts.size();
+    size_t bestNew = 0;
+    size_t first = (pBestFit || pParts.empty()) ? 0 : pParts.size() - 1;
+    for (size_t p = first; p < pParts.size(); ++p) {
+      size_t num = pParts[p].countNew(input);
+      if (!fits(pParts[p].size() + num))
+        continue;
+      if (best == pParts.size() || num < bestNew) {
+        best = p;
+        bestNew = num;
+      }
+    }
+
+    if (best == pParts.size())
+      pParts.push_back(GOTMultipart());
+    pParts[best].add(input);
+    pPartOf[pOrder[i]] = best;
+  }
+}
+
+size_t MipsGOT::getDynRelNum(const MultipartListType& pParts) {
+  size_t count = 0;
+  for (size_t p = 0; p < pParts.size(); ++p) {
+    // Entries of secondary GOTs need R_MIPS_REL32 relocations.
+    if (p != 0)
+      count += pParts[p].m_LocalNum + pParts[p].m_GlobalNum;
+    count += pParts[p].m_TLSDynNum;
+  }
+  return count;
+}
+
+void MipsGOT::partition() {
+  m_MultipartList.clear();
+  m_InputPartMap.clear();
+  if (m_InputEntries.empty())
+    return;
+
+  if (fits(m_AllEntries.size())) {
+    // All inputs share the primary GOT.
+    m_MultipartList.resize(1);
+    std::swap(m_MultipartList[0], m_AllEntries);
+    return;
+  }
+
+  // The order of inputs in the command line.
+  std::vector<size_t> order(m_InputEntries.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+
+  MultipartListType inputOrderParts;
+  std::vector<size_t> inputOrderPartOf;
+  split(order, false, inputOrderParts, inputOrderPartOf);
+
+  // Place the inputs with most entries first, each into the GOT sharing most
+  // of its entries, so that inputs referring to the same globals end up in
+  // the same GOT.
+  std::stable_sort(order.begin(), order.end(), [this](size_t pX, size_t pY) {
+    return m_InputEntries[pX].size() > m_InputEntries[pY].size();
+  });
+  std::vector<size_t> partOf;
+  split(order, true, m_MultipartList, partOf);
+
+  // The entries of the primary GOT need no dynamic relocations, so make the
+  // largest GOT primary.
+  size_t primary = 0;
+  for (size_t p = 1; p < m_MultipartList.size(); ++p) {
+    if (m_MultipartList[p].m_LocalNum + m_MultipartList[p].m_GlobalNum >
+        m_MultipartList[primary].m_LocalNum +
+            m_MultipartList[primary].m_GlobalNum)
+      primary = p;
+  }
+  if (primary != 0) {
+    std::swap(m_MultipartList[0], m_MultipartList[primary]);
+    for (size_t i = 0; i < partOf.size(); ++i) {
+      if (partOf[i] == 0)
+        partOf[i] = primary;
+      else if (partOf[i] == primary)
+        partOf[i] = 0;
+    }
+  }
+
+  size_t inputOrderDynRel = getDynRelNum(inputOrderParts);
+  if (inputOrderDynRel < getDynRelNum(m_MultipartList) ||
+      (inputOrderDynRel == getDynRelNum(m_MultipartList) &&
+       inputOrderParts.size() < m_MultipartList.size())) {
+    m_MultipartList.swap(inputOrderParts);
+    partOf.swap(inputOrderPartOf);
+  }
+
+  note(diag::note_Mips_multi_got)
+      << m_MultipartList.size() << getDynRelNum(m_MultipartList)
+      << inputOrderParts.size() << getDynRelNum(inputOrderParts);
+
+  for (size_t i = 0; i < m_InputEntries.size(); ++i)
+    m_InputPartMap[m_InputEntries[i].m_pInput] = partOf[i];
+
+  // The primary GOT holds all global entries in the order of .dynsym. The
+  // globals of the primary GOT come first to keep them in the reach of gp,
+  // in the order the relocations consume them.
+  std::vector<const LDSymbol*> oldOrder(m_SymbolOrderMap.size());
+  for (SymbolOrderMapType::iterator it = m_SymbolOrderMap.begin(),
+                                    ie = m_SymbolOrderMap.end();
+       it != ie;
+       ++it) {
+    assert(it->second < oldOrder.size() && oldOrder[it->second] == NULL &&
+           "the symbol orders are not 0..N-1");
+    oldOrder[it->second] = it->first;
+  }
+
+  m_SymbolOrderMap.clear();
+  for (size_t i = 0; i < m_InputEntries.size(); ++i) {
+    if (partOf[i] != 0)
+      continue;
+    const InputEntries& input = m_InputEntries[i];
+    for (size_t g = 0; g < input.m_Globals.size(); ++g) {
+      const LDSymbol* sym = input.m_Globals[g]->outSymbol();
+      m_SymbolOrderMap.insert(std::make_pair(sym, m_SymbolOrderMap.size()));
+    }
+  }
+  for (size_t i = 0; i < oldOrder.size(); ++i) {
+    const LDSymbol* sym = oldOrder[i];
+    m_SymbolOrderMap.insert(std::make_pair(sym, m_SymbolOrderMap.size()));
+  }
+}
+
 void MipsGOT::finalizeScanning(OutputRelocSection& pRelDyn) {
+  partition();
+
+  size_t offset = 0;
   for (MultipartListType::iterator it = m_MultipartList.begin();
        it != m_MultipartList.end();
        ++it) {
+    it->m_Offset = offset;
     reserveHeader();
     it->m_pLastLocal = &m_SectionData->back();
     reserve(it->m_LocalNum);
@@ -126,12 +394,14 @@ void MipsGOT::finalizeScanning(OutputRelocSection& pRelDyn) {
     reserve(it->m_GlobalNum);
     it->m_pLastTLS = &m_SectionData->back();
     reserve(it->m_TLSNum);
+    offset += MipsGOT0Num + it->size();
 
     if (it == m_MultipartList.begin()) {
       // Reserve entries in the second part of the primary GOT.
       // These entries correspond to the global symbols in all
       // non-primary GOTs.
       reserve(getGlobalNum() - it->m_GlobalNum);
+      offset += getGlobalNum() - it->m_GlobalNum;
     } else {
       // Reserve reldyn entries for R_MIPS_REL32 relocations
       // for all global entries of secondary GOTs.
@@ -156,84 +426,20 @@ bool MipsGOT::dynSymOrderCompare(const LDSymbol* pX, const LDSymbol* pY) const {
   return itX == m_SymbolOrderMap.end() && itY != m_SymbolOrderMap.end();
 }
 
-void MipsGOT::initGOTList() {
-  m_SymbolOrderMap.clear();
-
-  m_MultipartList.clear();
-  m_MultipartList.push_back(GOTMultipart());
-
-  m_MultipartList.back().m_Inputs.insert(m_pInput);
-
-  m_MergedGlobalSymbols.clear();
-  m_InputGlobalSymbols.clear();
-  m_MergedLocalSymbols.clear();
-  m_InputLocalSymbols.clear();
-  m_InputTLSGdSymbols.clear();
-  m_HasTLSLdmSymbol = false;
-}
-
-void MipsGOT::changeInput() {
-  m_MultipartList.back().m_Inputs.insert(m_pInput);
-
-  for (LocalSymbolSetType::iterator it = m_InputLocalSymbols.begin(),
-                                    end = m_InputLocalSymbols.end();
-       it != end;
-       ++it)
-    m_MergedLocalSymbols.insert(*it);
+void MipsGOT::initializeScan(const Input& pInput) {
+  m_InputEntries.push_back(InputEntries(pInput));
 
   m_InputLocalSymbols.clear();
-
-  for (SymbolUniqueMapType::iterator it = m_InputGlobalSymbols.begin(),
-                                     end = m_InputGlobalSymbols.end();
-       it != end;
-       ++it)
-    m_MergedGlobalSymbols.insert(it->first);
-
   m_InputGlobalSymbols.clear();
+  m_InputTLSGdSymbols.clear();
+  m_InputTLSGotSymbols.clear();
 }
 
-bool MipsGOT::isGOTFull() const {
-  uint64_t gotCount = MipsGOT0Num + m_MultipartList.back().m_LocalNum +
-                      m_MultipartList.back().m_GlobalNum;
-
-  gotCount += 1;
-
-  return gotCount * getEntrySize() > MipsGOTSize;
-}
-
-void MipsGOT::split() {
-  m_MergedLocalSymbols.clear();
-  m_MergedGlobalSymbols.clear();
-
-  size_t uniqueCount = 0;
-  for (SymbolUniqueMapType::const_iterator it = m_InputGlobalSymbols.begin(),
-                                           end = m_InputGlobalSymbols.end();
-       it != end;
-       ++it) {
-    if (it->second)
-      ++uniqueCount;
-  }
-
-  m_MultipartList.back().m_LocalNum -= m_InputLocalSymbols.size();
-  m_MultipartList.back().m_GlobalNum -= uniqueCount;
-  m_MultipartList.back().m_Inputs.erase(m_pInput);
-
-  m_MultipartList.push_back(
-      GOTMultipart(m_InputLocalSymbols.size(), m_InputGlobalSymbols.size()));
-  m_MultipartList.back().m_Inputs.insert(m_pInput);
-}
-
-void MipsGOT::initializeScan(const Input& pInput) {
-  if (m_pInput == NULL) {
-    m_pInput = &pInput;
-    initGOTList();
-  } else {
-    m_pInput = &pInput;
-    changeInput();
-  }
+void MipsGOT::finalizeScan(const Input& pInput) {
 }
 
-void MipsGOT::finalizeScan(const Input& pInput) {
+void MipsGOT::initializeApply(const Input& pInput) {
+  m_CurrentGOTPart = m_InputPartMap.lookup(&pInput);
 }
 
 bool MipsGOT::reserveLocalEntry(ResolveInfo& pInfo,
@@ -241,81 +447,52 @@ bool MipsGOT::reserveLocalEntry(ResolveInfo& pInfo,
                                 Relocation::DWord pAddend) {
   LocalEntry entry(&pInfo, pAddend, reloc == llvm::ELF::R_MIPS_GOT16);
 
-  if (m_InputLocalSymbols.count(entry))
-    // Do nothing, if we have seen this symbol
-    // in the current input already.
-    return false;
-
-  if (m_MergedLocalSymbols.count(entry)) {
-    // We have seen this symbol in previous inputs.
-    // Remember that it exists in the current input too.
-    m_InputLocalSymbols.insert(entry);
+  // Do nothing, if we have seen this symbol in the current input already.
+  if (!m_InputLocalSymbols.insert(entry).second)
     return false;
-  }
-
-  if (isGOTFull())
-    split();
 
-  m_InputLocalSymbols.insert(entry);
-
-  ++m_MultipartList.back().m_LocalNum;
-  return true;
+  m_InputEntries.back().m_Locals.push_back(entry);
+  return m_AllEntries.addLocal(entry);
 }
 
 bool MipsGOT::reserveGlobalEntry(ResolveInfo& pInfo) {
-  if (m_InputGlobalSymbols.count(&pInfo))
+  if (!m_InputGlobalSymbols.insert(&pInfo).second)
     return false;
 
-  if (m_MergedGlobalSymbols.count(&pInfo)) {
-    m_InputGlobalSymbols[&pInfo] = false;
-    return false;
-  }
-
-  if (isGOTFull())
-    split();
-
-  m_InputGlobalSymbols[&pInfo] = true;
-  ++m_MultipartList.back().m_GlobalNum;
+  m_InputEntries.back().m_Globals.push_back(&pInfo);
 
   if (!(pInfo.reserved() & MipsRelocator::ReserveGot)) {
-    m_SymbolOrderMap[pInfo.outSymbol()] = m_SymbolOrderMap.size();
+    // read the size first, operator[] may insert before or after it is read
+    unsigned int order = m_SymbolOrderMap.size();
+    m_SymbolOrderMap[pInfo.outSymbol()] = order;
     pInfo.setReserved(pInfo.reserved() | MipsRelocator::ReserveGot);
   }
 
-  return true;
+  return m_AllEntries.addGlobal(&pInfo);
 }
 
 bool MipsGOT::reserveTLSGdEntry(ResolveInfo& pInfo) {
-  if (m_InputTLSGdSymbols.count(&pInfo))
+  if (!m_InputTLSGdSymbols.insert(&pInfo).second)
     return false;
 
-  m_InputTLSGdSymbols.insert(&pInfo);
-  m_MultipartList.back().m_TLSNum += 2;
-  m_MultipartList.back().m_TLSDynNum += 2;
-
-  return true;
+  m_InputEntries.back().m_TLSGdSymbols.push_back(&pInfo);
+  return m_AllEntries.addTLSGd(&pInfo);
 }
 
 bool MipsGOT::reserveTLSLdmEntry() {
-  if (m_HasTLSLdmSymbol)
+  if (m_InputEntries.back().m_HasTLSLdm)
     return false;
 
-  m_HasTLSLdmSymbol = true;
-  m_MultipartList.back().m_TLSNum += 2;
-  m_MultipartList.back().m_TLSDynNum += 1;
-
-  return true;
+  m_InputEntries.back().m_HasTLSLdm = true;
+  return m_AllEntries.addTLSLdm();
 }
 
 bool MipsGOT::reserveTLSGotEntry(ResolveInfo& pInfo) {
-  if (m_InputTLSGotSymbols.count(&pInfo))
+  if (!m_InputTLSGotSymbols.insert(&pInfo).second)
     return false;
 
-  m_InputTLSGotSymbols.insert(&pInfo);
-  m_MultipartList.back().m_TLSNum += 1;
-  m_MultipartList.back().m_TLSDynNum += 1;
-
-  return true;
+  m_InputEntries.back().m_TLSGotSymbols.push_back(&pInfo);
+  return m_AllEntries.addTLSGot(&pInfo);
 }
 
 bool MipsGOT::isPrimaryGOTConsumed() {
@@ -326,9 +503,6 @@ Fragment* MipsGOT::consumeLocal() {
   assert(m_CurrentGOTPart < m_MultipartList.size() &&
          "GOT number is out of range!");
 
-  if (m_MultipartList[m_CurrentGOTPart].isConsumed())
-    ++m_CurrentGOTPart;
-
   m_MultipartList[m_CurrentGOTPart].consumeLocal();
 
   return m_MultipartList[m_CurrentGOTPart].m_pLastLocal;
@@ -338,9 +512,6 @@ Fragment* MipsGOT::consumeGlobal() {
   assert(m_CurrentGOTPart < m_MultipartList.size() &&
          "GOT number is out of range!");
 
-  if (m_MultipartList[m_CurrentGOTPart].isConsumed())
-    ++m_CurrentGOTPart;
-
   m_MultipartList[m_CurrentGOTPart].consumeGlobal();
 
   return m_MultipartList[m_CurrentGOTPart].m_pLastGlobal;
@@ -350,27 +521,13 @@ Fragment* MipsGOT::consumeTLS(Relocation::Type pType) {
   assert(m_CurrentGOTPart < m_MultipartList.size() &&
          "GOT number is out of range!");
 
-  if (m_MultipartList[m_CurrentGOTPart].isConsumed())
-    ++m_CurrentGOTPart;
-
-  m_MultipartList[m_CurrentGOTPart].consumeTLS(pType);
-
-  return m_MultipartList[m_CurrentGOTPart].m_pLastTLS;
+  return m_MultipartList[m_CurrentGOTPart].consumeTLS(pType);
 }
 
 uint64_t MipsGOT::getGPAddr(const Input& pInput) const {
   uint64_t gotSize = 0;
-  for (MultipartListType::const_iterator it = m_MultipartList.begin(),
-                                         ie = m_MultipartList.end();
-       it != ie;
-       ++it) {
-    if (it->m_Inputs.count(&pInput))
-      break;
-
-    gotSize += (MipsGOT0Num + it->m_LocalNum + it->m_GlobalNum);
-    if (it == m_MultipartList.begin())
-      gotSize += getGlobalNum() - it->m_GlobalNum;
-  }
+  if (!m_MultipartList.empty())
+    gotSize = m_MultipartList[m_InputPartMap.lookup(&pInput)].m_Offset;
 
   return addr() + gotSize * getEntrySize() + MipsGOTGpOffset;
 }
@@ -404,7 +561,7 @@ Fragment* MipsGOT::lookupGlobalEntry(const ResolveInfo* pInfo) {
 void MipsGOT::recordTLSEntry(const ResolveInfo* pInfo, Fragment* pEntry,
                              Relocation::Type pType) {
   if (pType == llvm::ELF::R_MIPS_TLS_LDM) {
-    m_GotTLSLdmEntry = pEntry;
+    m_MultipartList[m_CurrentGOTPart].m_pTLSLdmEntry = pEntry;
   } else if (pType == llvm::ELF::R_MIPS_TLS_GD) {
     GotEntryKey key;
     key.m_GOTPage = m_CurrentGOTPart;
@@ -425,7 +582,7 @@ void MipsGOT::recordTLSEntry(const ResolveInfo* pInfo, Fragment* pEntry,
 Fragment* MipsGOT::lookupTLSEntry(const ResolveInfo* pInfo,
                                   Relocation::Type pType) {
   if (pType == llvm::ELF::R_MIPS_TLS_LDM)
-    return m_GotTLSLdmEntry;
+    return m_MultipartList[m_CurrentGOTPart].m_pTLSLdmEntry;
   if (pType == llvm::ELF::R_MIPS_TLS_GD) {
     GotEntryKey key;
     key.m_GOTPage = m_CurrentGOTPart;
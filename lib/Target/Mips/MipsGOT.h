@@ -16,8 +16,6 @@
 #include <llvm/ADT/DenseMap.h>
 #include <llvm/ADT/DenseSet.h>
 
-#include <map>
-#include <set>
 #include <vector>
 
 namespace mcld {
@@ -46,6 +44,9 @@ class MipsGOT : public GOT {
   void initializeScan(const Input& pInput);
   void finalizeScan(const Input& pInput);
 
+  /// initializeApply - select the GOT of pInput for the entries it consumes
+  void initializeApply(const Input& pInput);
+
   bool reserveLocalEntry(ResolveInfo& pInfo,
                          int reloc,
                          Relocation::DWord pAddend);
@@ -101,13 +102,56 @@ class MipsGOT : public GOT {
   virtual void reserveHeader() = 0;
 
  private:
+  /** \class LocalEntry
+   *  \brief LocalEntry local GOT entry descriptor.
+   */
+  struct LocalEntry {
+    const ResolveInfo* m_pInfo;
+    Relocation::DWord m_Addend;
+    bool m_IsGot16;
+
+    LocalEntry(const ResolveInfo* pInfo,
+               Relocation::DWord addend,
+               bool isGot16);
+
+    bool operator==(const LocalEntry& O) const;
+  };
+
+  struct LocalEntryInfo {
+    static LocalEntry getEmptyKey();
+    static LocalEntry getTombstoneKey();
+    static unsigned getHashValue(const LocalEntry& pEntry);
+    static bool isEqual(const LocalEntry& pX, const LocalEntry& pY);
+  };
+
+  // Set of global symbols.
+  typedef llvm::DenseSet<const ResolveInfo*> SymbolSetType;
+
+  // Set of local symbols.
+  typedef llvm::DenseSet<LocalEntry, LocalEntryInfo> LocalSymbolSetType;
+
+  /** \class InputEntries
+   *  \brief InputEntries lists the GOT entries referred by an input, in the
+   *  order of their first references.
+   */
+  struct InputEntries {
+    explicit InputEntries(const Input& pInput);
+
+    const Input* m_pInput;
+    std::vector<LocalEntry> m_Locals;
+    std::vector<const ResolveInfo*> m_Globals;
+    std::vector<const ResolveInfo*> m_TLSGdSymbols;
+    std::vector<const ResolveInfo*> m_TLSGotSymbols;
+    bool m_HasTLSLdm;
+
+    size_t size() const;
+  };
+
   /** \class GOTMultipart
    *  \brief GOTMultipart counts local and global entries in the GOT.
    */
   struct GOTMultipart {
-    explicit GOTMultipart(size_t local = 0, size_t global = 0);
-
-    typedef llvm::DenseSet<const Input*> InputSetType;
+    GOTMultipart();
 
     size_t m_LocalNum;   ///< number of reserved local entries
     size_t m_GlobalNum;  ///< number of reserved global entries
@@ -121,73 +165,76 @@ class MipsGOT : public GOT {
     Fragment* m_pLastLocal;   ///< the last consumed local entry
     Fragment* m_pLastGlobal;  ///< the last consumed global entry
     Fragment* m_pLastTLS;     ///< the last consumed TLS entry
+    Fragment* m_pTLSLdmEntry;  ///< the entry of R_MIPS_TLS_LDM
 
-    InputSetType m_Inputs;
+    size_t m_Offset;  ///< index of the first entry in .got
 
-    bool isConsumed() const;
+    // The entries reserved in this GOT.
+    LocalSymbolSetType m_LocalSymbols;
+    SymbolSetType m_GlobalSymbols;
+    SymbolSetType m_TLSGdSymbols;
+    SymbolSetType m_TLSGotSymbols;
+    bool m_HasTLSLdm;
 
-    void consumeLocal();
-    void consumeGlobal();
-    void consumeTLS(Relocation::Type pType);
-  };
+    /// size - number of entries except the header
+    size_t size() const { return m_LocalNum + m_GlobalNum + m_TLSNum; }
 
-  /** \class LocalEntry
-   *  \brief LocalEntry local GOT entry descriptor.
-   */
-  struct LocalEntry {
-    const ResolveInfo* m_pInfo;
-    Relocation::DWord m_Addend;
-    bool m_IsGot16;
+    bool addLocal(const LocalEntry& pEntry);
+    bool addGlobal(const ResolveInfo* pInfo);
+    bool addTLSGd(const ResolveInfo* pInfo);
+    bool addTLSGot(const ResolveInfo* pInfo);
+    bool addTLSLdm();
 
-    LocalEntry(const ResolveInfo* pInfo,
-               Relocation::DWord addend,
-               bool isGot16);
+    /// countNew - number of entries add(pInput) would reserve
+    size_t countNew(const InputEntries& pInput) const;
+    void add(const InputEntries& pInput);
 
-    bool operator<(const LocalEntry& O) const;
+    void consumeLocal();
+    void consumeGlobal();
+    Fragment* consumeTLS(Relocation::Type pType);
   };
 
   typedef std::vector<GOTMultipart> MultipartListType;
 
-  // Set of global symbols.
-  typedef llvm::DenseSet<const ResolveInfo*> SymbolSetType;
-  // Map of symbols. If value is true, the symbol is referenced
-  // in the current input only. If value is false, the symbol
-  // is referenced in the other modules merged to the current GOT.
-  typedef llvm::DenseMap<const ResolveInfo*, bool> SymbolUniqueMapType;
-
-  // Set of local symbols.
-  typedef std::set<LocalEntry> LocalSymbolSetType;
+  // Map of inputs to the index of their GOT.
+  typedef llvm::DenseMap<const Input*, size_t> InputPartMapType;
 
   MultipartListType m_MultipartList;  ///< list of GOT's descriptors
-  const Input* m_pInput;              ///< current input
-
-  // Global symbols merged to the current GOT
-  // except symbols from the current input.
-  SymbolSetType m_MergedGlobalSymbols;
-  // Global symbols from the current input.
-  SymbolUniqueMapType m_InputGlobalSymbols;
-  // Set of symbols referenced by TLS GD relocations.
+  InputPartMapType m_InputPartMap;
+
+  // GOT entries of every input, in input order.
+  std::vector<InputEntries> m_InputEntries;
+  // All entries as if they were in a single GOT.
+  GOTMultipart m_AllEntries;
+
+  // Entries of the current input.
+  LocalSymbolSetType m_InputLocalSymbols;
+  SymbolSetType m_InputGlobalSymbols;
   SymbolSetType m_InputTLSGdSymbols;
-  // Set of symbols referenced by TLS GOTTPREL relocation.
   SymbolSetType m_InputTLSGotSymbols;
-  // There is a symbol referenced by TLS LDM relocations.
-  bool m_HasTLSLdmSymbol;
-  // Local symbols merged to the current GOT
-  // except symbols from the current input.
-  LocalSymbolSetType m_MergedLocalSymbols;
-  // Local symbols from the current input.
-  LocalSymbolSetType m_InputLocalSymbols;
 
   size_t m_CurrentGOTPart;
 
   typedef llvm::DenseMap<const LDSymbol*, unsigned> SymbolOrderMapType;
   SymbolOrderMapType m_SymbolOrderMap;
 
-  void initGOTList();
+  /// fits - return true if pNum entries and the header fit into one GOT
+  bool fits(size_t pNum) const;
+
+  /// split - assign the inputs in pOrder to GOTs. If pBestFit is set, an
+  /// input goes to the GOT it shares most entries with, otherwise to the
+  /// last GOT while it has room.
+  void split(const std::vector<size_t>& pOrder,
+             bool pBestFit,
+             MultipartListType& pParts,
+             std::vector<size_t>& pPartOf) const;
+
+  /// getDynRelNum - number of dynamic relocations the GOTs need
+  static size_t getDynRelNum(const MultipartListType& pParts);
+
+  /// partition - assign the inputs to GOTs that each fit in the reach of gp
+  void partition();
 
-  void changeInput();
-  bool isGOTFull() const;
-  void split();
   void reserve(size_t pNum);
 
  private:
@@ -196,23 +243,25 @@ class MipsGOT : public GOT {
     const ResolveInfo* m_pInfo;
     Relocation::DWord m_Addend;
 
-    bool operator<(const GotEntryKey& key) const {
-      if (m_GOTPage != key.m_GOTPage)
-        return m_GOTPage < key.m_GOTPage;
-
-      if (m_pInfo != key.m_pInfo)
-        return m_pInfo < key.m_pInfo;
-
-      return m_Addend < key.m_Addend;
+    bool operator==(const GotEntryKey& key) const {
+      return m_GOTPage == key.m_GOTPage && m_pInfo == key.m_pInfo &&
+             m_Addend == key.m_Addend;
     }
   };
 
-  typedef std::map<GotEntryKey, Fragment*> GotEntryMapType;
+  struct GotEntryKeyInfo {
+    static GotEntryKey getEmptyKey();
+    static GotEntryKey getTombstoneKey();
+    static unsigned getHashValue(const GotEntryKey& pKey);
+    static bool isEqual(const GotEntryKey& pX, const GotEntryKey& pY);
+  };
+
+  typedef llvm::DenseMap<GotEntryKey, Fragment*, GotEntryKeyInfo>
+      GotEntryMapType;
   GotEntryMapType m_GotLocalEntriesMap;
   GotEntryMapType m_GotGlobalEntriesMap;
   GotEntryMapType m_GotTLSGdEntriesMap;
   GotEntryMapType m_GotTLSGotEntriesMap;
-  Fragment* m_GotTLSLdmEntry;
 };
 
 /** \class Mips32GOT
@@ -219,6 +219,22 @@ void MipsRelocator::scanRelocation(Relocation& pReloc,
     issueUndefRef(pReloc, pSection, pInput);
 }
 
+Relocator::ScanKind MipsRelocator::classifyScan(const Relocation& pReloc,
+                                                const LDSection& pSection,
+                                                unsigned& pGroup) const {
+  // Skip relocation against _gp_disp
+  if (getTarget().getGpDispSymbol() != NULL &&
+      pReloc.symInfo() == getTarget().getGpDispSymbol()->resolveInfo())
+    return ScanNone;
+
+  assert(pSection.getLink() != NULL);
+  if ((pSection.getLink()->flag() & llvm::ELF::SHF_ALLOC) == 0)
+    return ScanNone;
+
+  // every relocation records its GOT entries in the GOT of its input
+  return ScanEach;
+}
+
 bool MipsRelocator::initializeScan(Input& pInput) {
   if (LinkerConfig::Object != config().codeGenType())
     getTarget().getGOT().initializeScan(pInput);
@@ -233,6 +249,8 @@ bool MipsRelocator::finalizeScan(Input& pInput) {
 
 bool MipsRelocator::initializeApply(Input& pInput) {
   m_pApplyingInput = &pInput;
+  if (LinkerConfig::Object != config().codeGenType())
+    getTarget().getGOT().initializeApply(pInput);
   return true;
 }
 
@@ -47,6 +47,11 @@ class MipsRelocator : public Relocator {
                       LDSection& pSection,
                       Input& pInput);
 
+  /// classifyScan - tell what scanRelocation() would do for pReloc
+  ScanKind classifyScan(const Relocation& pReloc,
+                        const LDSection& pSection,
+                        unsigned& pGroup) const;
+
   /// initializeScan - do initialization before scan relocations in pInput
   /// @return - return true for initialization success
   bool initializeScan(Input& pInput);
@@ -0,0 +1,150 @@
+//===- RelrSection.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "mcld/Target/RelrSection.h"
+
+#include "mcld/LinkerConfig.h"
+#include "mcld/ADT/SizeTraits.h"
+#include "mcld/Fragment/Relocation.h"
+#include "mcld/LD/LDSection.h"
+#include "mcld/LD/SectionData.h"
+#include "mcld/Support/FileOutputBuffer.h"
+
+#include <llvm/Support/ELF.h>
+#include <llvm/Support/Host.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace mcld {
+
+namespace {
+
+/// WriteWord - write the pBytes-byte word pValue to pPlace
+void WriteWord(uint8_t* pPlace, uint64_t pValue, unsigned int pBytes,
+               bool pSwap) {
+  if (4 == pBytes) {
+    uint32_t word = pSwap ? mcld::bswap32(pValue) : pValue;
+    std::memcpy(pPlace, &word, 4);
+  } else {
+    uint64_t word = pSwap ? mcld::bswap64(pValue) : pValue;
+    std::memcpy(pPlace, &word, 8);
+  }
+}
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// RelrSection
+//===----------------------------------------------------------------------===//
+RelrSection::RelrSection(LDSection& pSection, const LinkerConfig& pConfig)
+    : m_Section(pSection), m_Config(pConfig) {
+}
+
+RelrSection::~RelrSection() {
+}
+
+bool RelrSection::canPack(const Relocation& pReloc) const {
+  const LDSection& target =
+      pReloc.targetRef().frag()->getParent()->getSection();
+  // code may still move by relaxation
+  if ((target.flag() & llvm::ELF::SHF_EXECINSTR) != 0)
+    return false;
+  return target.align() >= wordSize() &&
+         (pReloc.targetRef().getOutputOffset() % wordSize()) == 0;
+}
+
+void RelrSection::add(Relocation& pReloc) {
+  m_Relocs.push_back(&pReloc);
+}
+
+bool RelrSection::finalizeSectionSize() {
+  std::vector<uint64_t> words;
+  encode(words);
+  uint64_t size = words.size() * wordSize();
+  if (size <= m_Section.size())
+    return false;
+  m_Section.setSize(size);
+  return true;
+}
+
+void RelrSection::emit(MemoryRegion& pRegion) const {
+  std::vector<uint64_t> words;
+  encode(words);
+  assert(words.size() * wordSize() <= pRegion.size());
+
+  bool swap =
+      (llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian());
+  size_t num_of_words = pRegion.size() / wordSize();
+  for (size_t i = 0; i < num_of_words; ++i) {
+    // pad with empty bitmaps
+    uint64_t word = (i < words.size()) ? words[i] : 0x1;
+    WriteWord(pRegion.begin() + i * wordSize(), word, wordSize(), swap);
+  }
+}
+
+void RelrSection::applyAddends(FileOutputBuffer& pOutput) const {
+  bool swap =
+      (llvm::sys::IsLittleEndianHost != m_Config.targets().isLittleEndian());
+  uint8_t* data = pOutput.getBufferStart();
+  for (RelocList::const_iterator reloc = m_Relocs.begin(),
+       rEnd = m_Relocs.end(); reloc != rEnd; ++reloc) {
+    const LDSection& target =
+        (*reloc)->targetRef().frag()->getParent()->getSection();
+    uint64_t offset = target.offset() + (*reloc)->targetRef().getOutputOffset();
+    WriteWord(data + offset, (*reloc)->addend(), wordSize(), swap);
+  }
+}
+
+void RelrSection::encode(const std::vector<uint64_t>& pAddrs,
+                         unsigned int pWordSize,
+                         std::vector<uint64_t>& pResult) {
+  // the bits of a bitmap but the marker bit
+  const uint64_t num_of_bits = pWordSize * 8 - 1;
+
+  pResult.clear();
+  size_t i = 0;
+  while (i < pAddrs.size()) {
+    pResult.push_back(pAddrs[i]);
+    uint64_t where = pAddrs[i] + pWordSize;
+    ++i;
+
+    while (true) {
+      uint64_t bitmap = 0;
+      for (; i < pAddrs.size(); ++i) {
+        // an address before where wraps around to a large delta
+        uint64_t delta = pAddrs[i] - where;
+        if (delta >= num_of_bits * pWordSize || (delta % pWordSize) != 0)
+          break;
+        bitmap |= UINT64_C(1) << (delta / pWordSize);
+      }
+      if (0 == bitmap)
+        break;
+      pResult.push_back((bitmap << 1) | 0x1);
+      where += num_of_bits * pWordSize;
+    }
+  }
+}
+
+void RelrSection::encode(std::vector<uint64_t>& pResult) const {
+  std::vector<uint64_t> addrs;
+  addrs.reserve(m_Relocs.size());
+  for (RelocList::const_iterator reloc = m_Relocs.begin(),
+       rEnd = m_Relocs.end(); reloc != rEnd; ++reloc)
+    addrs.push_back((*reloc)->place());
+  std::sort(addrs.begin(), addrs.end());
+  addrs.erase(std::unique(addrs.begin(), addrs.end()), addrs.end());
+  encode(addrs, wordSize(), pResult);
+}
+
+unsigned int RelrSection::wordSize() const {
+  return m_Config.targets().bitclass() / 8;
+}
+
+}  // namespace mcld
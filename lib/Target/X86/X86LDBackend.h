@@ -227,6 +227,11 @@ class X86_64GNULDBackend : public X86GNULDBackend {
   void setRelDynSize();
   void setRelPLTSize();
 
+  /// getRelativeRelocType - R_X86_64_RELATIVE
+  uint32_t getRelativeRelocType() const {
+    return llvm::ELF::R_X86_64_RELATIVE;
+  }
+
   llvm::StringRef createCIERegionForPLT();
   llvm::StringRef createFDERegionForPLT();
 
@@ -87,6 +87,12 @@
   DECL_X86_64_APPLY_RELOC_FUNC(gotpcrel) \
   DECL_X86_64_APPLY_RELOC_FUNC(plt32)    \
   DECL_X86_64_APPLY_RELOC_FUNC(rel)      \
+  DECL_X86_64_APPLY_RELOC_FUNC(tls_gd)   \
+  DECL_X86_64_APPLY_RELOC_FUNC(tls_ld)   \
+  DECL_X86_64_APPLY_RELOC_FUNC(dtpoff)   \
+  DECL_X86_64_APPLY_RELOC_FUNC(gottpoff) \
+  DECL_X86_64_APPLY_RELOC_FUNC(tpoff)    \
+  DECL_X86_64_APPLY_RELOC_FUNC(tlsdesc)  \
   DECL_X86_64_APPLY_RELOC_FUNC(unsupported)
 
 #define DECL_X86_64_APPLY_RELOC_FUNC_PTRS               \
@@ -107,13 +113,13 @@
   { &abs,         14, "R_X86_64_8",               8  }, \
   { &rel,         15, "R_X86_64_PC8",             8  }, \
   { &none,        16, "R_X86_64_DTPMOD64",        0  }, \
-  { &unsupported, 17, "R_X86_64_DTPOFF64",        0  }, \
-  { &none,        18, "R_X86_64_TPOFF64",         0  }, \
-  { &unsupported, 19, "R_X86_64_TLSGD",           0  }, \
-  { &unsupported, 20, "R_X86_64_TLSLD",           0  }, \
-  { &unsupported, 21, "R_X86_64_DTPOFF32",        0  }, \
-  { &unsupported, 22, "R_X86_64_GOTTPOFF",        0  }, \
-  { &unsupported, 23, "R_X86_64_TPOFF32",         0  }, \
+  { &dtpoff,      17, "R_X86_64_DTPOFF64",        64 }, \
+  { &tpoff,       18, "R_X86_64_TPOFF64",         64 }, \
+  { &tls_gd,      19, "R_X86_64_TLSGD",           32 }, \
+  { &tls_ld,      20, "R_X86_64_TLSLD",           32 }, \
+  { &dtpoff,      21, "R_X86_64_DTPOFF32",        32 }, \
+  { &gottpoff,    22, "R_X86_64_GOTTPOFF",        32 }, \
+  { &tpoff,       23, "R_X86_64_TPOFF32",         32 }, \
   { &unsupported, 24, "R_X86_64_PC64",            64 }, \
   { &unsupported, 25, "R_X86_64_GOTOFF64",        64 }, \
   { &unsupported, 26, "R_X86_64_GOTPC32",         32 }, \
@@ -124,10 +130,16 @@
   { &unsupported, 31, "R_X86_64_PLTOFF64",        64 }, \
   { &unsupported, 32, "R_X86_64_SIZE32",          32 }, \
   { &unsupported, 33, "R_X86_64_SIZE64",          64 }, \
-  { &unsupported, 34, "R_X86_64_GOTPC32_TLSDESC", 0  }, \
-  { &unsupported, 35, "R_X86_64_TLSDESC_CALL",    0  }, \
+  { &tlsdesc,     34, "R_X86_64_GOTPC32_TLSDESC", 32 }, \
+  { &none,        35, "R_X86_64_TLSDESC_CALL",    0  }, \
   { &none,        36, "R_X86_64_TLSDESC",         0  }, \
   { &none,        37, "R_X86_64_IRELATIVE",       0  }, \
-  { &none,        38, "R_X86_64_RELATIVE64",      0  }
+  { &none,        38, "R_X86_64_RELATIVE64",      0  }, \
+  { &unsupported, 39, "",                         0  }, \
+  { &unsupported, 40, "",                         0  }, \
+  { &gotpcrel,    41, "R_X86_64_GOTPCRELX",       32 }, \
+  { &gotpcrel,    42, "R_X86_64_REX_GOTPCRELX",   32 }, \
+  { &none,        43, "R_X86_64_OPT",             32 }, \
+  { &none,        44, "R_X86_64_OPT16",           16 }
 
 #endif  // TARGET_X86_X86RELOCATIONFUNCTIONS_H_
@@ -11,6 +11,7 @@
 
 #include "mcld/IRBuilder.h"
 #include "mcld/LinkerConfig.h"
+#include "mcld/ADT/SizeTraits.h"
 #include "mcld/LD/ELFFileFormat.h"
 #include "mcld/LD/ELFSegmentFactory.h"
 #include "mcld/LD/ELFSegment.h"
@@ -22,6 +23,9 @@
 #include <llvm/Support/DataTypes.h>
 #include <llvm/Support/ELF.h>
 
+#include <algorithm>
+#include <cstring>
+
 namespace mcld {
 
 //===--------------------------------------------------------------------===//
@@ -186,6 +190,37 @@ void X86Relocator::scanRelocation(Relocation& pReloc,
     issueUndefRef(pReloc, pSection, pInput);
 }
 
+Relocator::ScanKind X86Relocator::classifyScan(const Relocation& pReloc,
+                                               const LDSection& pSection,
+                                               unsigned& pGroup) const {
+  if (LinkerConfig::Object == config().codeGenType())
+    return ScanNone;
+  const ResolveInfo* rsym = pReloc.symInfo();
+  assert(pSection.getLink() != NULL);
+  if ((pSection.getLink()->flag() & llvm::ELF::SHF_ALLOC) == 0)
+    return ScanNone;
+
+  // an undefined reference is reported for every relocation
+  if (rsym->isUndef() && !rsym->isDyn() && !rsym->isWeak() && !rsym->isNull())
+    return ScanEach;
+
+  if (rsym->isLocal())
+    return classifyLocalScan(pReloc, pGroup);
+  return classifyGlobalScan(pReloc, pGroup);
+}
+
+/// helper_PC_reloc_needs_scan - check if a PC-relative relocation against the
+/// global pSym may need a PLT entry or a dynamic relocation
+static bool helper_PC_reloc_needs_scan(const ResolveInfo& pSym,
+                                       const GNULDBackend& pTarget,
+                                       const LinkerConfig& pConfig) {
+  if (pTarget.symbolNeedsPLT(pSym) &&
+      LinkerConfig::DynObj != pConfig.codeGenType())
+    return true;
+  // having a PLT entry never adds a dynamic relocation
+  return pTarget.symbolNeedsDynRel(pSym, false, false);
+}
+
 void X86Relocator::addCopyReloc(ResolveInfo& pSym, X86GNULDBackend& pTarget) {
   Relocation& rel_entry = *pTarget.getRelDyn().create();
   rel_entry.setType(pTarget.getCopyRelType());
@@ -308,6 +343,60 @@ bool X86_32Relocator::mayHaveFunctionPointerAccess(
   }
 }
 
+Relocator::ScanKind X86_32Relocator::classifyLocalScan(
+    const Relocation& pReloc,
+    unsigned& pGroup) const {
+  switch (pReloc.type()) {
+    case llvm::ELF::R_386_32:
+    case llvm::ELF::R_386_16:
+    case llvm::ELF::R_386_8:
+      return config().isCodeIndep() ? ScanEach : ScanNone;
+
+    case llvm::ELF::R_386_PLT32:
+    case llvm::ELF::R_386_GOTOFF:
+    case llvm::ELF::R_386_GOTPC:
+    case llvm::ELF::R_386_PC32:
+    case llvm::ELF::R_386_PC16:
+    case llvm::ELF::R_386_PC8:
+      return ScanNone;
+
+    case llvm::ELF::R_386_GOT32:
+      pGroup = ReserveGOT;
+      return ScanSymbol;
+
+    default:
+      return ScanEach;
+  }
+}
+
+Relocator::ScanKind X86_32Relocator::classifyGlobalScan(
+    const Relocation& pReloc,
+    unsigned& pGroup) const {
+  switch (pReloc.type()) {
+    case llvm::ELF::R_386_GOTOFF:
+    case llvm::ELF::R_386_GOTPC:
+      return ScanNone;
+
+    case llvm::ELF::R_386_PLT32:
+      pGroup = ReservePLT;
+      return ScanSymbol;
+
+    case llvm::ELF::R_386_GOT32:
+      pGroup = ReserveGOT;
+      return ScanSymbol;
+
+    case llvm::ELF::R_386_PC32:
+    case llvm::ELF::R_386_PC16:
+    case llvm::ELF::R_386_PC8:
+      if (helper_PC_reloc_needs_scan(*pReloc.symInfo(), getTarget(), config()))
+        return ScanEach;
+      return ScanNone;
+
+    default:
+      return ScanEach;
+  }
+}
+
 void X86_32Relocator::scanLocalReloc(Relocation& pReloc,
                                      IRBuilder& pBuilder,
                                      Module& pModule,
@@ -1205,6 +1294,57 @@ static PLTEntryBase& helper_PLT_init(Relocation& pReloc,
   return *plt_entry;
 }
 
+/// helper_TLS_is_local - Check if the TLS symbol is in the TLS block of the
+/// output
+static bool helper_TLS_is_local(const ResolveInfo& pSym,
+                                const X86_64Relocator& pParent) {
+  return pSym.isLocal() || helper_use_relative_reloc(pSym, pParent);
+}
+
+/// helper_TP_offset - the offset of the thread pointer from the start of the
+/// TLS segment. X86-64 puts the TLS block of executables right below it.
+static Relocator::Address helper_TP_offset(X86_64Relocator& pParent) {
+  ELFSegmentFactory::const_iterator tls_seg =
+      pParent.getTarget().elfSegmentTable().find(
+          llvm::ELF::PT_TLS, llvm::ELF::PF_R, 0x0);
+  assert(tls_seg != pParent.getTarget().elfSegmentTable().end());
+  uint64_t size = (*tls_seg)->memsz();
+  alignAddress(size, (*tls_seg)->align());
+  return size;
+}
+
+/// helper_read_code - copy pSize bytes of code from pOffset bytes after the
+/// place of pReloc. Return false if they are out of the fragment.
+static bool helper_read_code(Relocation& pReloc,
+                             int64_t pOffset,
+                             uint8_t* pCode,
+                             size_t pSize) {
+  Fragment* frag = pReloc.targetRef().frag();
+  int64_t begin = static_cast<int64_t>(pReloc.targetRef().offset()) + pOffset;
+  if (begin < 0 || begin + pSize > frag->size())
+    return false;
+  // the additional offset wraps around, so a negative one reads before the
+  // place without creating another FragmentRef
+  pReloc.targetRef().memcpy(
+      pCode, pSize, static_cast<FragmentRef::Offset>(pOffset));
+  return true;
+}
+
+/// helper_next_reloc - get the relocation after pReloc if it applies to
+/// pOffset bytes after the place of pReloc
+static Relocation* helper_next_reloc(Relocation& pReloc,
+                                     LDSection& pSection,
+                                     uint64_t pOffset) {
+  RelocData::iterator next(pReloc);
+  if (++next == pSection.getRelocData()->end())
+    return NULL;
+  Relocation& reloc = *next;
+  if (reloc.targetRef().frag() != pReloc.targetRef().frag() ||
+      reloc.targetRef().offset() != pReloc.targetRef().offset() + pOffset)
+    return NULL;
+  return &reloc;
+}
+
 //===----------------------------------------------------------------------===//
 // X86_64 Relocation Functions and Tables
 //===----------------------------------------------------------------------===//
@@ -1226,12 +1366,25 @@ struct X86_64ApplyFunctionTriple {
 static const X86_64ApplyFunctionTriple X86_64ApplyFunctions[] = {
     DECL_X86_64_APPLY_RELOC_FUNC_PTRS};
 
+/// X86_64ApplyBatch - apply a run of relocations through one known function,
+/// so that the call can be inlined into the loop.
+template <X86_64ApplyFunctionType FUNC>
+static void X86_64ApplyBatch(Relocation* const* pBegin,
+                             Relocation* const* pEnd,
+                             X86_64Relocator& pParent) {
+  for (Relocation* const* reloc = pBegin; reloc != pEnd; ++reloc) {
+    Relocator::Result result = FUNC(**reloc, pParent);
+    if (result != Relocator::OK)
+      pParent.reportResult(**reloc, result);
+  }
+}
+
 //===--------------------------------------------------------------------===//
 // X86_64Relocator
 //===--------------------------------------------------------------------===//
 X86_64Relocator::X86_64Relocator(X86_64GNULDBackend& pParent,
                                  const LinkerConfig& pConfig)
-    : X86Relocator(pConfig), m_Target(pParent) {
+    : X86Relocator(pConfig), m_Target(pParent), m_pTLSModuleID(NULL) {
 }
 
 Relocator::Result X86_64Relocator::applyRelocation(Relocation& pRelocation) {
@@ -1245,6 +1398,53 @@ Relocator::Result X86_64Relocator::applyRelocation(Relocation& pRelocation) {
   return X86_64ApplyFunctions[type].func(pRelocation, *this);
 }
 
+void X86_64Relocator::applyRelocations(Type pType,
+                                       Relocation* const* pBegin,
+                                       Relocation* const* pEnd) {
+  switch (pType) {
+    case llvm::ELF::R_X86_64_64:
+      X86_64ApplyBatch<&abs>(pBegin, pEnd, *this);
+      return;
+    case llvm::ELF::R_X86_64_PC32:
+      X86_64ApplyBatch<&rel>(pBegin, pEnd, *this);
+      return;
+    case llvm::ELF::R_X86_64_PLT32:
+      X86_64ApplyBatch<&plt32>(pBegin, pEnd, *this);
+      return;
+    case llvm::ELF::R_X86_64_GOTPCREL:
+    case llvm::ELF::R_X86_64_GOTPCRELX:
+    case llvm::ELF::R_X86_64_REX_GOTPCRELX:
+      X86_64ApplyBatch<&gotpcrel>(pBegin, pEnd, *this);
+      return;
+    case llvm::ELF::R_X86_64_32:
+      X86_64ApplyBatch<&abs>(pBegin, pEnd, *this);
+      return;
+    case llvm::ELF::R_X86_64_32S:
+      X86_64ApplyBatch<&signed32>(pBegin, pEnd, *this);
+      return;
+    default:
+      Relocator::applyRelocations(pType, pBegin, pEnd);
+      return;
+  }
+}
+
+bool X86_64Relocator::canApplyAlone(Type pType) const {
+  switch (pType) {
+    case llvm::ELF::R_X86_64_64:
+    case llvm::ELF::R_X86_64_PC32:
+    case llvm::ELF::R_X86_64_PLT32:
+    case llvm::ELF::R_X86_64_32:
+    case llvm::ELF::R_X86_64_32S:
+    case llvm::ELF::R_X86_64_16:
+    case llvm::ELF::R_X86_64_PC16:
+    case llvm::ELF::R_X86_64_8:
+    case llvm::ELF::R_X86_64_PC8:
+      return true;
+    default:
+      return false;
+  }
+}
+
 const char* X86_64Relocator::getName(Relocation::Type pType) const {
   return X86_64ApplyFunctions[pType].name;
 }
@@ -1266,6 +1466,8 @@ bool X86_64Relocator::mayHaveFunctionPointerAccess(
     case llvm::ELF::R_X86_64_GOT32:
     case llvm::ELF::R_X86_64_GOTPCREL64:
     case llvm::ELF::R_X86_64_GOTPCREL:
+    case llvm::ELF::R_X86_64_GOTPCRELX:
+    case llvm::ELF::R_X86_64_REX_GOTPCRELX:
     case llvm::ELF::R_X86_64_GOTPLT64: {
       possible_funcptr_reloc = true;
       break;
@@ -1286,6 +1488,60 @@ bool X86_64Relocator::mayHaveFunctionPointerAccess(
   }
 }
 
+Relocator::ScanKind X86_64Relocator::classifyLocalScan(
+    const Relocation& pReloc,
+    unsigned& pGroup) const {
+  switch (pReloc.type()) {
+    case llvm::ELF::R_X86_64_64:
+    case llvm::ELF::R_X86_64_32:
+    case llvm::ELF::R_X86_64_16:
+    case llvm::ELF::R_X86_64_8:
+    case llvm::ELF::R_X86_64_32S:
+      return config().isCodeIndep() ? ScanEach : ScanNone;
+
+    case llvm::ELF::R_X86_64_NONE:
+    case llvm::ELF::R_X86_64_PC32:
+    case llvm::ELF::R_X86_64_PC16:
+    case llvm::ELF::R_X86_64_PC8:
+      return ScanNone;
+
+    case llvm::ELF::R_X86_64_GOTPCREL:
+      pGroup = ReserveGOT;
+      return ScanSymbol;
+
+    default:
+      // GOTPCRELX and TLS relocations may be relaxed one by one
+      return ScanEach;
+  }
+}
+
+Relocator::ScanKind X86_64Relocator::classifyGlobalScan(
+    const Relocation& pReloc,
+    unsigned& pGroup) const {
+  switch (pReloc.type()) {
+    case llvm::ELF::R_X86_64_NONE:
+      return ScanNone;
+
+    case llvm::ELF::R_X86_64_PLT32:
+      pGroup = ReservePLT;
+      return ScanSymbol;
+
+    case llvm::ELF::R_X86_64_GOTPCREL:
+      pGroup = ReserveGOT;
+      return ScanSymbol;
+
+    case llvm::ELF::R_X86_64_PC32:
+    case llvm::ELF::R_X86_64_PC16:
+    case llvm::ELF::R_X86_64_PC8:
+      if (helper_PC_reloc_needs_scan(*pReloc.symInfo(), getTarget(), config()))
+        return ScanEach;
+      return ScanNone;
+
+    default:
+      return ScanEach;
+  }
+}
+
 void X86_64Relocator::scanLocalReloc(Relocation& pReloc,
                                      IRBuilder& pBuilder,
                                      Module& pModule,
@@ -1331,11 +1587,29 @@ void X86_64Relocator::scanLocalReloc(Relocation& pReloc,
       }
       return;
 
+    case llvm::ELF::R_X86_64_NONE:
     case llvm::ELF::R_X86_64_PC32:
     case llvm::ELF::R_X86_64_PC16:
     case llvm::ELF::R_X86_64_PC8:
       return;
 
+    case llvm::ELF::R_X86_64_TLSGD:
+    case llvm::ELF::R_X86_64_TLSLD:
+    case llvm::ELF::R_X86_64_DTPOFF32:
+    case llvm::ELF::R_X86_64_DTPOFF64:
+    case llvm::ELF::R_X86_64_GOTTPOFF:
+    case llvm::ELF::R_X86_64_TPOFF32:
+    case llvm::ELF::R_X86_64_GOTPC32_TLSDESC:
+    case llvm::ELF::R_X86_64_TLSDESC_CALL:
+      scanTLSReloc(pReloc, pSection);
+      return;
+
+    case llvm::ELF::R_X86_64_GOTPCRELX:
+    case llvm::ELF::R_X86_64_REX_GOTPCRELX:
+      // a local symbol is addressed PC-relatively without the GOT
+      if (relaxGOTPCRELX(pReloc, pSection))
+        return;
+    // fall through
     case llvm::ELF::R_X86_64_GOTPCREL:
       // Symbol needs GOT entry, reserve entry in .got
       // return if we already create GOT for this symbol
@@ -1418,6 +1692,12 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
       }
       return;
 
+    case llvm::ELF::R_X86_64_GOTPCRELX:
+    case llvm::ELF::R_X86_64_REX_GOTPCRELX:
+      // a symbol that is not preemptible is addressed PC-relatively
+      if (relaxGOTPCRELX(pReloc, pSection))
+        return;
+    // fall through
     case llvm::ELF::R_X86_64_GOTPCREL:
       // Symbol needs GOT entry, reserve entry in .got
       // return if we already create GOT for this symbol
@@ -1460,6 +1740,20 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
       rsym->setReserved(rsym->reserved() | ReservePLT);
       return;
 
+    case llvm::ELF::R_X86_64_NONE:
+      return;
+
+    case llvm::ELF::R_X86_64_TLSGD:
+    case llvm::ELF::R_X86_64_TLSLD:
+    case llvm::ELF::R_X86_64_DTPOFF32:
+    case llvm::ELF::R_X86_64_DTPOFF64:
+    case llvm::ELF::R_X86_64_GOTTPOFF:
+    case llvm::ELF::R_X86_64_TPOFF32:
+    case llvm::ELF::R_X86_64_GOTPC32_TLSDESC:
+    case llvm::ELF::R_X86_64_TLSDESC_CALL:
+      scanTLSReloc(pReloc, pSection);
+      return;
+
     case llvm::ELF::R_X86_64_PC32:
     case llvm::ELF::R_X86_64_PC16:
     case llvm::ELF::R_X86_64_PC8:
@@ -1499,6 +1793,444 @@ void X86_64Relocator::scanGlobalReloc(Relocation& pReloc,
   }  // end switch
 }
 
+/// relax R_X86_64_GOTPCRELX and R_X86_64_REX_GOTPCRELX to R_X86_64_PC32
+bool X86_64Relocator::relaxGOTPCRELX(Relocation& pReloc,
+                                     LDSection& pSection) {
+  assert(pReloc.type() == llvm::ELF::R_X86_64_GOTPCRELX ||
+         pReloc.type() == llvm::ELF::R_X86_64_REX_GOTPCRELX);
+  assert(pReloc.targetRef().frag() != NULL);
+
+  // 1. only a symbol bound to its definition in the output can be addressed
+  // PC-relatively, and only when the displacement ends the instruction
+  ResolveInfo* rsym = pReloc.symInfo();
+  if (rsym->isAbsolute() || rsym->type() == ResolveInfo::IndirectFunc)
+    return false;
+  if (!rsym->isLocal() &&
+      (!rsym->isDefine() || rsym->isDyn() ||
+       getTarget().isSymbolPreemptible(*rsym)))
+    return false;
+  if (static_cast<int64_t>(pReloc.addend()) != -4)
+    return false;
+
+  // 2. check the opcodes before creating anything
+  uint8_t op[2];
+  if (!helper_read_code(pReloc, -2, op, sizeof(op)))
+    return false;
+  if (op[0] == 0x8b) {
+    // movq foo@GOTPCREL(%rip), %reg -> leaq foo(%rip), %reg
+    op[0] = 0x8d;
+  } else if (op[0] == 0xff && op[1] == 0x15 &&
+             pReloc.type() == llvm::ELF::R_X86_64_GOTPCRELX) {
+    // call *foo@GOTPCREL(%rip) -> addr32 call foo
+    op[0] = 0x67;
+    op[1] = 0xe8;
+  } else if (op[0] == 0xff && op[1] == 0x25 &&
+             pReloc.type() == llvm::ELF::R_X86_64_GOTPCRELX) {
+    // jmp *foo@GOTPCREL(%rip) -> nop; jmp foo
+    op[0] = 0x90;
+    op[1] = 0xe9;
+  } else {
+    // other instructions still load from the GOT
+    return false;
+  }
+
+  // 3. rewrite the opcode and the ModR/M byte by a reloc "BEFORE" the
+  // original reloc
+  rewriteCode(pReloc, pSection, -2, op, sizeof(op));
+
+  // 4. change the type of the original reloc
+  pReloc.setType(llvm::ELF::R_X86_64_PC32);
+  return true;
+}
+
+void X86_64Relocator::scanTLSReloc(Relocation& pReloc, LDSection& pSection) {
+  // rsym - The relocation target symbol
+  ResolveInfo* rsym = pReloc.symInfo();
+
+  // an executable reaches its own TLS block from the thread pointer, so the
+  // dynamic TLS models are relaxed to the static ones
+  bool relax = (LinkerConfig::DynObj != config().codeGenType());
+  bool is_local = helper_TLS_is_local(*rsym, *this);
+
+  switch (pReloc.type()) {
+    case llvm::ELF::R_X86_64_TLSGD: {
+      if (relax) {
+        if (!convertTLSGD(pReloc, pSection, is_local)) {
+          error(diag::result_badreloc) << getName(pReloc.type())
+                                       << rsym->name();
+          return;
+        }
+        // GD to IE loads the offset from the GOT
+        if (!is_local)
+          scanTLSReloc(pReloc, pSection);
+        return;
+      }
+
+      // return if we already create the GOT entries for this symbol
+      if (getSymTLSGDMap().lookUpFirstEntry(*rsym) != NULL)
+        return;
+
+      // set up a pair of got entries for the module id and the offset
+      X86_64GOTEntry* got_entry1 = getTarget().getGOT().create();
+      X86_64GOTEntry* got_entry2 = getTarget().getGOT().create();
+      getSymTLSGDMap().record(*rsym, *got_entry1, *got_entry2);
+      got_entry1->setValue(0x0);
+      if (is_local) {
+        // the module id is of the output itself, and the offset of the
+        // symbol is set during apply relocation
+        helper_DynRel_init(
+            NULL, *got_entry1, 0x0, llvm::ELF::R_X86_64_DTPMOD64, *this);
+        got_entry2->setValue(X86Relocator::SymVal);
+      } else {
+        helper_DynRel_init(
+            rsym, *got_entry1, 0x0, llvm::ELF::R_X86_64_DTPMOD64, *this);
+        helper_DynRel_init(
+            rsym, *got_entry2, 0x0, llvm::ELF::R_X86_64_DTPOFF64, *this);
+        got_entry2->setValue(0x0);
+        getTarget().getRelDyn().addSymbolToDynSym(*rsym->outSymbol());
+      }
+      return;
+    }
+
+    case llvm::ELF::R_X86_64_TLSLD:
+      if (relax) {
+        if (!convertTLSLDtoLE(pReloc, pSection))
+          error(diag::result_badreloc) << getName(pReloc.type())
+                                       << rsym->name();
+        return;
+      }
+      getTLSModuleID();
+      return;
+
+    case llvm::ELF::R_X86_64_DTPOFF32:
+      // the relaxed local-dynamic code adds the offset to the thread pointer
+      if (relax)
+        pReloc.setType(llvm::ELF::R_X86_64_TPOFF32);
+      return;
+
+    case llvm::ELF::R_X86_64_DTPOFF64:
+      if (relax)
+        pReloc.setType(llvm::ELF::R_X86_64_TPOFF64);
+      return;
+
+    case llvm::ELF::R_X86_64_GOTTPOFF: {
+      getTarget().setHasStaticTLS();
+      if (relax && is_local && convertTLSIEtoLE(pReloc, pSection))
+        return;
+
+      // return if we already create GOT for this symbol
+      if (rsym->reserved() & ReserveGOT)
+        return;
+
+      // set up the got and the corresponding dyn rel
+      X86_64GOTEntry* got_entry = getTarget().getGOT().create();
+      getSymGOTMap().record(*rsym, *got_entry);
+      if (relax && is_local) {
+        // the offset from the thread pointer is set during apply relocation
+        got_entry->setValue(X86Relocator::SymVal);
+      } else if (is_local) {
+        got_entry->setValue(0x0);
+        Relocation& rel_entry = helper_DynRel_init(
+            NULL, *got_entry, 0x0, llvm::ELF::R_X86_64_TPOFF64, *this);
+        rel_entry.setAddend(X86Relocator::SymVal);
+        getRelRelMap().record(pReloc, rel_entry);
+      } else {
+        got_entry->setValue(0x0);
+        helper_DynRel_init(
+            rsym, *got_entry, 0x0, llvm::ELF::R_X86_64_TPOFF64, *this);
+        getTarget().getRelDyn().addSymbolToDynSym(*rsym->outSymbol());
+      }
+      // set GOT bit
+      rsym->setReserved(rsym->reserved() | ReserveGOT);
+      return;
+    }
+
+    case llvm::ELF::R_X86_64_TPOFF32:
+      getTarget().setHasStaticTLS();
+      // there is no 32-bit dynamic relocation for the offset
+      if (!relax)
+        error(diag::non_pic_relocation) << getName(pReloc.type())
+                                        << rsym->name();
+      return;
+
+    case llvm::ELF::R_X86_64_GOTPC32_TLSDESC: {
+      if (relax) {
+        if (!convertTLSDesc(pReloc, pSection, is_local)) {
+          error(diag::result_badreloc) << getName(pReloc.type())
+                                       << rsym->name();
+          return;
+        }
+        // TLSDESC to IE loads the offset from the GOT
+        if (!is_local)
+          scanTLSReloc(pReloc, pSection);
+        return;
+      }
+
+      // return if we already create the GOT entries for this symbol
+      if (getSymTLSDescMap().lookUpFirstEntry(*rsym) != NULL)
+        return;
+
+      // set up a pair of got entries for the descriptor, which is filled
+      // non-lazily by R_X86_64_TLSDESC in .rela.dyn
+      X86_64GOTEntry* got_entry1 = getTarget().getGOT().create();
+      X86_64GOTEntry* got_entry2 = getTarget().getGOT().create();
+      getSymTLSDescMap().record(*rsym, *got_entry1, *got_entry2);
+      got_entry1->setValue(0x0);
+      got_entry2->setValue(0x0);
+      if (is_local) {
+        Relocation& rel_entry = helper_DynRel_init(
+            NULL, *got_entry1, 0x0, llvm::ELF::R_X86_64_TLSDESC, *this);
+        rel_entry.setAddend(X86Relocator::SymVal);
+        getRelRelMap().record(pReloc, rel_entry);
+      } else {
+        helper_DynRel_init(
+            rsym, *got_entry1, 0x0, llvm::ELF::R_X86_64_TLSDESC, *this);
+        getTarget().getRelDyn().addSymbolToDynSym(*rsym->outSymbol());
+      }
+      return;
+    }
+
+    case llvm::ELF::R_X86_64_TLSDESC_CALL:
+      if (relax && !convertTLSDescCall(pReloc, pSection))
+        error(diag::result_badreloc) << getName(pReloc.type())
+                                     << rsym->name();
+      return;
+
+    default:
+      fatal(diag::unsupported_relocation) << static_cast<int>(pReloc.type())
+                                          << "mclinker@googlegroups.com";
+      break;
+  }  // end switch
+}
+
+// Create a GOT entry for the TLS module index
+X86_64GOTEntry& X86_64Relocator::getTLSModuleID() {
+  if (m_pTLSModuleID != NULL)
+    return *m_pTLSModuleID;
+
+  // Allocate 2 got entries and 1 dynamic reloc for R_X86_64_TLSLD
+  m_pTLSModuleID = getTarget().getGOT().create();
+  m_pTLSModuleID->setValue(0x0);
+  getTarget().getGOT().create()->setValue(0x0);
+
+  helper_DynRel_init(
+      NULL, *m_pTLSModuleID, 0x0, llvm::ELF::R_X86_64_DTPMOD64, *this);
+  return *m_pTLSModuleID;
+}
+
+/// convert the R_X86_64_TLSGD sequence to IE or LE
+bool X86_64Relocator::convertTLSGD(Relocation& pReloc,
+                                   LDSection& pSection,
+                                   bool pToLE) {
+  assert(pReloc.type() == llvm::ELF::R_X86_64_TLSGD);
+  assert(pReloc.targetRef().frag() != NULL);
+
+  // 1. check the sequence
+  //   data16 leaq x@tlsgd(%rip), %rdi          66 48 8d 3d <x@tlsgd>
+  //   data16 data16 rex64 call __tls_get_addr  66 66 48 e8 <__tls_get_addr>
+  // or, without PLT,
+  //   data16 rex64 call *__tls_get_addr@GOTPCREL(%rip)
+  //                                            66 48 ff 15 <__tls_get_addr>
+  uint8_t code[16];
+  if (!helper_read_code(pReloc, -4, code, sizeof(code)) ||
+      std::memcmp(code, "\x66\x48\x8d\x3d", 4) != 0 ||
+      (std::memcmp(code + 8, "\x66\x66\x48\xe8", 4) != 0 &&
+       std::memcmp(code + 8, "\x66\x48\xff\x15", 4) != 0))
+    return false;
+  Relocation* call = helper_next_reloc(pReloc, pSection, 8);
+  if (call == NULL)
+    return false;
+
+  // 2. rewrite the sequence
+  //   movq %fs:0, %rax             64 48 8b 04 25 00 00 00 00
+  //   leaq x@tpoff(%rax), %rax     48 8d 80 <x@tpoff>
+  // or
+  //   addq x@gottpoff(%rip), %rax  48 03 05 <x@gottpoff>
+  static const uint8_t to_le[] = {0x64, 0x48, 0x8b, 0x04, 0x25, 0x00,
+                                  0x00, 0x00, 0x00, 0x48, 0x8d, 0x80};
+  static const uint8_t to_ie[] = {0x64, 0x48, 0x8b, 0x04, 0x25, 0x00,
+                                  0x00, 0x00, 0x00, 0x48, 0x03, 0x05};
+  rewriteCode(pReloc, pSection, -4, pToLE ? to_le : to_ie, sizeof(to_le));
+
+  // 3. drop the call to __tls_get_addr
+  call->setType(llvm::ELF::R_X86_64_NONE);
+  call->setSymInfo(pReloc.symInfo());
+
+  // 4. move the original reloc to the operand of the last instruction and
+  // change its type
+  pReloc.targetRef().assign(*pReloc.targetRef().frag(),
+                            pReloc.targetRef().offset() + 8);
+  pReloc.target() = 0x0;
+  if (pToLE) {
+    // the operand of leaq is not PC-relative
+    pReloc.setType(llvm::ELF::R_X86_64_TPOFF32);
+    pReloc.setAddend(pReloc.addend() + 4);
+  } else {
+    pReloc.setType(llvm::ELF::R_X86_64_GOTTPOFF);
+  }
+  return true;
+}
+
+/// convert the R_X86_64_TLSLD sequence to LE
+bool X86_64Relocator::convertTLSLDtoLE(Relocation& pReloc,
+                                       LDSection& pSection) {
+  assert(pReloc.type() == llvm::ELF::R_X86_64_TLSLD);
+  assert(pReloc.targetRef().frag() != NULL);
+
+  // 1. check the sequence
+  //   leaq x@tlsld(%rip), %rdi              48 8d 3d <x@tlsld>
+  //   call __tls_get_addr                   e8 <__tls_get_addr>
+  // or, without PLT,
+  //   call *__tls_get_addr@GOTPCREL(%rip)   ff 15 <__tls_get_addr>
+  uint8_t code[9];
+  if (!helper_read_code(pReloc, -3, code, sizeof(code)) ||
+      std::memcmp(code, "\x48\x8d\x3d", 3) != 0)
+    return false;
+  size_t size = 0;
+  Relocation* call = NULL;
+  if (code[7] == 0xe8) {
+    size = 12;
+    call = helper_next_reloc(pReloc, pSection, 5);
+  } else if (code[7] == 0xff && code[8] == 0x15) {
+    size = 13;
+    call = helper_next_reloc(pReloc, pSection, 6);
+  }
+  if (call == NULL)
+    return false;
+
+  // 2. rewrite the sequence, and leave the module base in %rax
+  //   data16 data16 data16 (data16) movq %fs:0, %rax
+  static const uint8_t to_le[] = {0x66, 0x66, 0x66, 0x66, 0x64, 0x48, 0x8b,
+                                  0x04, 0x25, 0x00, 0x00, 0x00, 0x00};
+  rewriteCode(pReloc, pSection, -3, to_le + sizeof(to_le) - size, size);
+
+  // 3. drop the call to __tls_get_addr and the original reloc
+  call->setType(llvm::ELF::R_X86_64_NONE);
+  call->setSymInfo(pReloc.symInfo());
+  pReloc.setType(llvm::ELF::R_X86_64_NONE);
+  return true;
+}
+
+/// convert R_X86_64_GOTTPOFF to R_X86_64_TPOFF32
+bool X86_64Relocator::convertTLSIEtoLE(Relocation& pReloc,
+                                       LDSection& pSection) {
+  assert(pReloc.type() == llvm::ELF::R_X86_64_GOTTPOFF);
+  assert(pReloc.targetRef().frag() != NULL);
+
+  // the last 4 bytes are the operand, which the original reloc writes
+  uint8_t code[7] = {0x0};
+  if (!helper_read_code(pReloc, -3, code, 3) ||
+      (code[0] != 0x48 && code[0] != 0x4c) || (code[2] & 0xc7) != 0x05)
+    return false;
+
+  bool rex_r = (code[0] == 0x4c);
+  uint8_t reg = (code[2] >> 3) & 0x7;
+  switch (code[1]) {
+    case 0x8b:
+      // movq x@gottpoff(%rip), %reg -> movq $x@tpoff, %reg
+      code[0] = rex_r ? 0x49 : 0x48;
+      code[1] = 0xc7;
+      code[2] = 0xc0 | reg;
+      break;
+    case 0x03:
+      if (reg == 0x4) {
+        // %rsp and %r12 cannot be the base without SIB
+        // addq x@gottpoff(%rip), %reg -> addq $x@tpoff, %reg
+        code[0] = rex_r ? 0x49 : 0x48;
+        code[1] = 0x81;
+        code[2] = 0xc0 | reg;
+      } else {
+        // addq x@gottpoff(%rip), %reg -> leaq x@tpoff(%reg), %reg
+        code[0] = rex_r ? 0x4d : 0x48;
+        code[1] = 0x8d;
+        code[2] = 0x80 | (reg << 3) | reg;
+      }
+      break;
+    default:
+      return false;
+  }
+  rewriteCode(pReloc, pSection, -3, code, sizeof(code));
+
+  // the operand is no longer PC-relative
+  pReloc.setType(llvm::ELF::R_X86_64_TPOFF32);
+  pReloc.setAddend(pReloc.addend() + 4);
+  return true;
+}
+
+/// convert R_X86_64_GOTPC32_TLSDESC to IE or LE
+bool X86_64Relocator::convertTLSDesc(Relocation& pReloc,
+                                     LDSection& pSection,
+                                     bool pToLE) {
+  assert(pReloc.type() == llvm::ELF::R_X86_64_GOTPC32_TLSDESC);
+  assert(pReloc.targetRef().frag() != NULL);
+
+  // leaq x@tlsdesc(%rip), %rax  48 8d 05 <x@tlsdesc>
+  uint8_t code[7] = {0x0};
+  if (!helper_read_code(pReloc, -3, code, 3) ||
+      std::memcmp(code, "\x48\x8d\x05", 3) != 0)
+    return false;
+
+  if (pToLE) {
+    // movq $x@tpoff, %rax  48 c7 c0 <x@tpoff>
+    code[1] = 0xc7;
+    code[2] = 0xc0;
+    pReloc.setType(llvm::ELF::R_X86_64_TPOFF32);
+    pReloc.setAddend(pReloc.addend() + 4);
+  } else {
+    // movq x@gottpoff(%rip), %rax  48 8b 05 <x@gottpoff>
+    code[1] = 0x8b;
+    pReloc.setType(llvm::ELF::R_X86_64_GOTTPOFF);
+  }
+  rewriteCode(pReloc, pSection, -3, code, sizeof(code));
+  return true;
+}
+
+/// convert R_X86_64_TLSDESC_CALL to a nop
+bool X86_64Relocator::convertTLSDescCall(Relocation& pReloc,
+                                         LDSection& pSection) {
+  assert(pReloc.type() == llvm::ELF::R_X86_64_TLSDESC_CALL);
+  assert(pReloc.targetRef().frag() != NULL);
+
+  // call *x@tlscall(%rax) -> xchg %ax, %ax
+  uint8_t code[2];
+  if (!helper_read_code(pReloc, 0, code, sizeof(code)) || code[0] != 0xff ||
+      code[1] != 0x10)
+    return false;
+
+  static const uint8_t nop[] = {0x66, 0x90};
+  rewriteCode(pReloc, pSection, 0, nop, sizeof(nop));
+  pReloc.setType(llvm::ELF::R_X86_64_NONE);
+  return true;
+}
+
+void X86_64Relocator::rewriteCode(Relocation& pReloc,
+                                  LDSection& pSection,
+                                  int64_t pOffset,
+                                  const uint8_t* pCode,
+                                  size_t pSize) {
+  assert(pSize == 2 || pSize >= 4);
+  Relocation::Type type = (pSize == 2) ? X86_64Relocator::R_X86_64_OPT16
+                                       : X86_64Relocator::R_X86_64_OPT;
+  size_t chunk = getSize(type) / 8;
+
+  for (size_t i = 0; i < pSize; i += chunk) {
+    // the last chunk overlaps the previous one rather than the code after
+    size_t begin = std::min(i, pSize - chunk);
+    Relocation* reloc = Relocation::Create(
+        type,
+        *FragmentRef::Create(*pReloc.targetRef().frag(),
+                             pReloc.targetRef().offset() + pOffset + begin),
+        0x0);
+    reloc->setSymInfo(pReloc.symInfo());
+    reloc->target() = 0x0;
+    std::memcpy(&reloc->target(), pCode + begin, chunk);
+
+    // insert the new relocs "BEFORE" the original reloc.
+    pSection.getRelocData()->getRelocationList().insert(
+        RelocData::iterator(pReloc), reloc);
+  }
+}
+
 uint32_t X86_64Relocator::getDebugStringOffset(Relocation& pReloc) const {
   if (pReloc.type() != llvm::ELF::R_X86_64_32)
     error(diag::unsupport_reloc_for_debug_string)
@@ -1682,6 +2414,94 @@ Relocator::Result rel(Relocation& pReloc, X86_64Relocator& pParent) {
   return Relocator::OK;
 }
 
+// R_X86_64_TLSGD: GOT(S) + GOT_ORG + A - P
+Relocator::Result tls_gd(Relocation& pReloc, X86_64Relocator& pParent) {
+  ResolveInfo* rsym = pReloc.symInfo();
+  X86_64GOTEntry* got_entry1 =
+      pParent.getSymTLSGDMap().lookUpFirstEntry(*rsym);
+  if (got_entry1 == NULL)
+    return Relocator::BadReloc;
+
+  // set the offset of a local symbol if needed
+  X86_64GOTEntry* got_entry2 =
+      pParent.getSymTLSGDMap().lookUpSecondEntry(*rsym);
+  if (X86Relocator::SymVal == got_entry2->getValue())
+    got_entry2->setValue(pReloc.symValue());
+
+  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  pReloc.target() = helper_GOT_ORG(pParent) + got_entry1->getOffset() + A -
+                    pReloc.place();
+  return Relocator::OK;
+}
+
+// R_X86_64_TLSLD: GOT(module id) + GOT_ORG + A - P
+Relocator::Result tls_ld(Relocation& pReloc, X86_64Relocator& pParent) {
+  const X86_64GOTEntry& got_entry = pParent.getTLSModuleID();
+  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  pReloc.target() = helper_GOT_ORG(pParent) + got_entry.getOffset() + A -
+                    pReloc.place();
+  return Relocator::OK;
+}
+
+// R_X86_64_DTPOFF32: S + A
+// R_X86_64_DTPOFF64
+Relocator::Result dtpoff(Relocation& pReloc, X86_64Relocator& pParent) {
+  // the value of a TLS symbol is its offset in the TLS block
+  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord S = pReloc.symValue();
+  pReloc.target() = S + A;
+  return Relocator::OK;
+}
+
+// R_X86_64_GOTTPOFF: GOT(S) + GOT_ORG + A - P
+Relocator::Result gottpoff(Relocation& pReloc, X86_64Relocator& pParent) {
+  if (!(pReloc.symInfo()->reserved() & X86Relocator::ReserveGOT))
+    return Relocator::BadReloc;
+
+  // set the offset from the thread pointer if the output knows it
+  X86_64GOTEntry* got_entry = pParent.getSymGOTMap().lookUp(*pReloc.symInfo());
+  if (X86Relocator::SymVal == got_entry->getValue())
+    got_entry->setValue(pReloc.symValue() - helper_TP_offset(pParent));
+
+  // setup relocation addend if needed
+  Relocation* dyn_rel = pParent.getRelRelMap().lookUp(pReloc);
+  if ((dyn_rel != NULL) && (X86Relocator::SymVal == dyn_rel->addend()))
+    dyn_rel->setAddend(pReloc.symValue());
+
+  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  pReloc.target() = helper_GOT_ORG(pParent) +
+                    helper_get_GOT_address(pReloc, pParent) + A -
+                    pReloc.place();
+  return Relocator::OK;
+}
+
+// R_X86_64_TPOFF32: S + A - TP
+// R_X86_64_TPOFF64
+Relocator::Result tpoff(Relocation& pReloc, X86_64Relocator& pParent) {
+  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  Relocator::DWord S = pReloc.symValue();
+  pReloc.target() = S + A - helper_TP_offset(pParent);
+  return Relocator::OK;
+}
+
+// R_X86_64_GOTPC32_TLSDESC: GOT(S) + GOT_ORG + A - P
+Relocator::Result tlsdesc(Relocation& pReloc, X86_64Relocator& pParent) {
+  X86_64GOTEntry* got_entry1 =
+      pParent.getSymTLSDescMap().lookUpFirstEntry(*pReloc.symInfo());
+  if (got_entry1 == NULL)
+    return Relocator::BadReloc;
+
+  // setup relocation addend if needed
+  Relocation* dyn_rel = pParent.getRelRelMap().lookUp(pReloc);
+  if ((dyn_rel != NULL) && (X86Relocator::SymVal == dyn_rel->addend()))
+    dyn_rel->setAddend(pReloc.symValue());
+
+  Relocator::DWord A = pReloc.target() + pReloc.addend();
+  pReloc.target() = helper_GOT_ORG(pParent) + got_entry1->getOffset() + A -
+                    pReloc.place();
+  return Relocator::OK;
+}
+
 Relocator::Result unsupported(Relocation& pReloc, X86_64Relocator& pParent) {
   return Relocator::Unsupported;
 }
@@ -83,6 +83,11 @@ class X86Relocator : public Relocator {
                       LDSection& pSection,
                       Input& pInput);
 
+  /// classifyScan - tell what scanRelocation() would do for pReloc
+  ScanKind classifyScan(const Relocation& pReloc,
+                        const LDSection& pSection,
+                        unsigned& pGroup) const;
+
  protected:
   /// addCopyReloc - add a copy relocation into .rel.dyn for pSym
   /// @param pSym - A resolved copy symbol that defined in BSS section
@@ -106,6 +111,12 @@ class X86Relocator : public Relocator {
                                Module& pModule,
                                LDSection& pSection) = 0;
 
+  virtual ScanKind classifyLocalScan(const Relocation& pReloc,
+                                     unsigned& pGroup) const = 0;
+
+  virtual ScanKind classifyGlobalScan(const Relocation& pReloc,
+                                      unsigned& pGroup) const = 0;
+
  private:
   SymPLTMap m_SymPLTMap;
 };
@@ -167,6 +178,11 @@ class X86_32Relocator : public X86Relocator {
                        Module& pModule,
                        LDSection& pSection);
 
+  ScanKind classifyLocalScan(const Relocation& pReloc, unsigned& pGroup) const;
+
+  ScanKind classifyGlobalScan(const Relocation& pReloc,
+                              unsigned& pGroup) const;
+
   /// -----  tls optimization  ----- ///
   /// convert R_386_TLS_IE to R_386_TLS_LE
   void convertTLSIEtoLE(Relocation& pReloc, LDSection& pSection);
@@ -187,11 +203,25 @@ class X86_64Relocator : public X86Relocator {
   typedef KeyEntryMap<ResolveInfo, X86_64GOTEntry> SymGOTPLTMap;
   typedef KeyEntryMap<Relocation, Relocation> RelRelMap;
 
+  enum {
+    R_X86_64_OPT = 43,   // mcld internal relocation type
+    R_X86_64_OPT16 = 44  // mcld internal relocation type
+  };
+
  public:
   X86_64Relocator(X86_64GNULDBackend& pParent, const LinkerConfig& pConfig);
 
   Result applyRelocation(Relocation& pRelocation);
 
+  void applyRelocations(Type pType,
+                        Relocation* const* pBegin,
+                        Relocation* const* pEnd);
+
+  /// canApplyByType - every apply function only touches its own relocation
+  bool canApplyByType() const { return true; }
+
+  bool canApplyAlone(Type pType) const;
+
   X86_64GNULDBackend& getTarget() { return m_Target; }
 
   const X86_64GNULDBackend& getTarget() const { return m_Target; }
@@ -209,6 +239,16 @@ class X86_64Relocator : public X86Relocator {
   const RelRelMap& getRelRelMap() const { return m_RelRelMap; }
   RelRelMap& getRelRelMap() { return m_RelRelMap; }
 
+  /// the pairs of GOT entries of R_X86_64_TLSGD
+  const SymGOTMap& getSymTLSGDMap() const { return m_SymTLSGDMap; }
+  SymGOTMap& getSymTLSGDMap() { return m_SymTLSGDMap; }
+
+  /// the pairs of GOT entries of R_X86_64_GOTPC32_TLSDESC
+  const SymGOTMap& getSymTLSDescMap() const { return m_SymTLSDescMap; }
+  SymGOTMap& getSymTLSDescMap() { return m_SymTLSDescMap; }
+
+  X86_64GOTEntry& getTLSModuleID();
+
   /// mayHaveFunctionPointerAccess - check if the given reloc would possibly
   /// access a function pointer.
   virtual bool mayHaveFunctionPointerAccess(const Relocation& pReloc) const;
@@ -232,11 +272,58 @@ class X86_64Relocator : public X86Relocator {
                        Module& pModule,
                        LDSection& pSection);
 
+  ScanKind classifyLocalScan(const Relocation& pReloc, unsigned& pGroup) const;
+
+  ScanKind classifyGlobalScan(const Relocation& pReloc,
+                              unsigned& pGroup) const;
+
+  /// scanTLSReloc - reserve the entries of a TLS relocation, or relax its
+  /// code sequence when building executables
+  void scanTLSReloc(Relocation& pReloc, LDSection& pSection);
+
+  /// -----  tls optimization  ----- ///
+  /// convert the R_X86_64_TLSGD sequence to R_X86_64_TPOFF32 if pToLE, or
+  /// else to R_X86_64_GOTTPOFF. Return false on an unknown sequence.
+  bool convertTLSGD(Relocation& pReloc, LDSection& pSection, bool pToLE);
+
+  /// convert the R_X86_64_TLSLD sequence to a load of the thread pointer
+  bool convertTLSLDtoLE(Relocation& pReloc, LDSection& pSection);
+
+  /// convert R_X86_64_GOTTPOFF to R_X86_64_TPOFF32
+  bool convertTLSIEtoLE(Relocation& pReloc, LDSection& pSection);
+
+  /// convert R_X86_64_GOTPC32_TLSDESC to R_X86_64_TPOFF32 if pToLE, or else
+  /// to R_X86_64_GOTTPOFF
+  bool convertTLSDesc(Relocation& pReloc, LDSection& pSection, bool pToLE);
+
+  /// convert R_X86_64_TLSDESC_CALL to a nop
+  bool convertTLSDescCall(Relocation& pReloc, LDSection& pSection);
+
+  /// rewriteCode - overwrite pSize bytes from pOffset bytes after the place
+  /// of pReloc with pCode. The bytes are written by internal relocations
+  /// synced right before pReloc.
+  void rewriteCode(Relocation& pReloc,
+                   LDSection& pSection,
+                   int64_t pOffset,
+                   const uint8_t* pCode,
+                   size_t pSize);
+
+  /// -----  GOT optimization  ----- ///
+  /// relaxGOTPCRELX - rewrite the instruction of R_X86_64_[REX_]GOTPCRELX to
+  /// address the symbol directly and turn the reloc into R_X86_64_PC32.
+  /// Return false if the instruction must still load from the GOT.
+  bool relaxGOTPCRELX(Relocation& pReloc, LDSection& pSection);
+
  private:
   X86_64GNULDBackend& m_Target;
   SymGOTMap m_SymGOTMap;
   SymGOTPLTMap m_SymGOTPLTMap;
   RelRelMap m_RelRelMap;
+  SymGOTMap m_SymTLSGDMap;
+  SymGOTMap m_SymTLSDescMap;
+
+  /// the pair of GOT entries of R_X86_64_TLSLD
+  X86_64GOTEntry* m_pTLSModuleID;
 };
 
 }  // namespace mcld
@@ -0,0 +1,32 @@
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=pic %s -o %t.x86_64.o
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared %t.x86_64.o \
+; RUN: -o %t.x86_64.so
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared --batch-apply-relocs \
+; RUN: %t.x86_64.o -o %t.x86_64.batch.so
+; RUN: cmp %t.x86_64.so %t.x86_64.batch.so
+; RUN: %LLC -mtriple="aarch64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=pic %s -o %t.aarch64.o
+; RUN: %MCLinker -mtriple="aarch64-linux-gnu" -shared %t.aarch64.o \
+; RUN: -o %t.aarch64.so
+; RUN: %MCLinker -mtriple="aarch64-linux-gnu" -shared --batch-apply-relocs \
+; RUN: %t.aarch64.o -o %t.aarch64.batch.so
+; RUN: cmp %t.aarch64.so %t.aarch64.batch.so
+
+@table = global [2 x i32 (i32)*] [i32 (i32)* @foo, i32 (i32)* @bar], align 8
+@counter = internal global i32 0, align 4
+
+define i32 @foo(i32 %a) nounwind {
+entry:
+  %0 = load i32, i32* @counter, align 4
+  %add = add nsw i32 %a, %0
+  store i32 %add, i32* @counter, align 4
+  ret i32 %add
+}
+
+define i32 @bar(i32 %a) nounwind {
+entry:
+  %call = call i32 @foo(i32 %a)
+  %mul = mul nsw i32 %call, 3
+  ret i32 %mul
+}
@@ -0,0 +1,18 @@
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=static %s -o %t.o
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -static -e main \
+; RUN: --build-id=sha1 --threads=1 %t.o -o %t.1.out
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -static -e main \
+; RUN: --build-id=sha1 --threads=4 %t.o -o %t.4.out
+; RUN: cmp %t.1.out %t.4.out
+; RUN: readelf -n %t.4.out | FileCheck %s
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -static -e main \
+; RUN: --build-id=0x0123456789abcdef %t.o -o %t.hex.out
+; RUN: readelf -n %t.hex.out | FileCheck %s -check-prefix=HEX
+; CHECK: NT_GNU_BUILD_ID
+; HEX: Build ID: 0123456789abcdef
+
+define i32 @main() nounwind {
+entry:
+  ret i32 0
+}
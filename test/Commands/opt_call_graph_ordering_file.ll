@@ -0,0 +1,32 @@
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj -function-sections \
+; RUN: -relocation-model=pic %s -o %t.o
+; RUN: echo "# caller callee count" > %t.cg
+; RUN: echo "main hot 1000" >> %t.cg
+; RUN: echo "main cold 1" >> %t.cg
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared \
+; RUN: --call-graph-ordering-file=%t.cg %t.o -o %t.so
+; RUN: nm -n %t.so | FileCheck %s
+; CHECK: main
+; CHECK-NEXT: hot
+; CHECK: cold
+
+define i32 @cold(i32 %x) {
+  %r = mul i32 %x, 3
+  ret i32 %r
+}
+
+define i32 @unrelated(i32 %x) {
+  %r = sub i32 %x, 7
+  ret i32 %r
+}
+
+define i32 @hot(i32 %x) {
+  %r = add i32 %x, 1
+  ret i32 %r
+}
+
+define i32 @main(i32 %x) {
+  %a = call i32 @hot(i32 %x)
+  %b = call i32 @cold(i32 %a)
+  ret i32 %b
+}
@@ -0,0 +1,32 @@
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=static %s -o %t.o
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -static -e main \
+; RUN: --compress-debug-sections=zlib --threads=1 %t.o -o %t.1.out
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -static -e main \
+; RUN: --compress-debug-sections=zlib --threads=4 %t.o -o %t.4.out
+; RUN: cmp %t.1.out %t.4.out
+; RUN: readelf -S -W %t.4.out | FileCheck %s
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -static -e main \
+; RUN: --compress-debug-sections=none %t.o -o %t.none.out
+; RUN: readelf -S -W %t.none.out | FileCheck %s -check-prefix=NONE
+; RUN: readelf -x .debug_info %t.none.out > %t.none.dump
+; RUN: readelf -z -x .debug_info %t.4.out > %t.4.dump
+; RUN: cmp %t.none.dump %t.4.dump
+; RUN: objcopy --compress-debug-sections=zlib-gabi %t.o %t.z.o
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -static -e main \
+; RUN: --compress-debug-sections=none %t.z.o -o %t.z.out
+; RUN: readelf -x .debug_info %t.z.out > %t.z.dump
+; RUN: cmp %t.none.dump %t.z.dump
+; CHECK: .debug_info PROGBITS {{.*}} C {{[0-9]+ [0-9]+ 8}}
+; NONE: .debug_info PROGBITS {{.*}} 002000 00 {{[0-9]+ [0-9]+ 1}}
+
+module asm ".section .debug_info,\22\22,@progbits"
+module asm ".rept 512"
+module asm ".ascii \22abcdefghijklmnop\22"
+module asm ".endr"
+module asm ".text"
+
+define i32 @main() nounwind {
+entry:
+  ret i32 0
+}
@@ -0,0 +1,33 @@
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=static %s -o %t.o
+; RUN: sed -e 's/add nsw i32 %a, 7/add nsw i32 %a, 9/' %s | \
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=static -o %t.new.o
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -static -e main --incremental \
+; RUN: %t.o -o %t.out
+; RUN: mv %t.new.o %t.o
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -static -e main --incremental \
+; RUN: --verbose=1 %t.o -o %t.out 2>&1 | FileCheck %s
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -static -e main --incremental \
+; RUN: %t.o -o %t.clean
+; RUN: cmp %t.out %t.clean
+
+; the second link patches the changed object into the first output
+; CHECK: Note: patched 1 changed objects into
+
+@counter = internal global i32 0, align 4
+
+define i32 @foo(i32 %a) nounwind {
+entry:
+  %0 = load i32, i32* @counter, align 4
+  %add = add nsw i32 %a, 7
+  %sum = add nsw i32 %add, %0
+  store i32 %sum, i32* @counter, align 4
+  ret i32 %sum
+}
+
+define i32 @main() nounwind {
+entry:
+  %call = call i32 @foo(i32 1)
+  ret i32 %call
+}
@@ -0,0 +1,24 @@
+; RUN: %LLC -mtriple="arm-none-linux-gnueabi" -march=arm \
+; RUN: -filetype=obj -relocation-model=pic %s -o %t.o
+; RUN: %MCLinker -mtriple="arm-none-linux-gnueabi" -march=arm \
+; RUN: -shared --eh-frame-hdr %t.o -o %t.mmap.so
+; RUN: %MCLinker -mtriple="arm-none-linux-gnueabi" -march=arm \
+; RUN: -shared --eh-frame-hdr --no-mmap-output-file %t.o -o %t.direct.so
+; RUN: cmp %t.mmap.so %t.direct.so
+; RUN: %MCLinker -mtriple="arm-none-linux-gnueabi" -march=arm \
+; RUN: -shared --eh-frame-hdr --no-mmap-output-file --mmap-output-file \
+; RUN: %t.o -o %t.last.so
+; RUN: cmp %t.mmap.so %t.last.so
+
+define i32 @foo(i32 %a) nounwind uwtable {
+entry:
+  %add = add nsw i32 %a, 1
+  ret i32 %add
+}
+
+define i32 @bar(i32 %a) nounwind uwtable {
+entry:
+  %call = call i32 @foo(i32 %a)
+  %mul = mul nsw i32 %call, 3
+  ret i32 %mul
+}
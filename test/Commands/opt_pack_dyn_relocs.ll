@@ -0,0 +1,15 @@
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=pic %s -o %t.o
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared \
+; RUN: --pack-dyn-relocs=relr %t.o -o %t.so
+; RUN: readelf -S -W %t.so | FileCheck %s -check-prefix=SECT
+; RUN: readelf -S -W %t.so | FileCheck %s -check-prefix=NORELA
+; RUN: readelf -d %t.so | FileCheck %s -check-prefix=DYN
+; SECT: .relr.dyn RELR
+; NORELA-NOT: .rela.dyn
+; DYN: RELRSZ
+; DYN: RELRENT {{.*}} 8
+
+@x = internal global i32 0, align 8
+@y = internal global i32 0, align 8
+@table = global [4 x i32*] [i32* @x, i32* @y, i32* @x, i32* @y], align 8
@@ -0,0 +1,29 @@
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj -function-sections \
+; RUN: -relocation-model=pic %s -o %t.o
+; RUN: echo "# hot path" > %t.order
+; RUN: echo "hot2" >> %t.order
+; RUN: echo "hot1" >> %t.order
+; RUN: echo "missing" >> %t.order
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared \
+; RUN: --symbol-ordering-file=%t.order %t.o -o %t.so 2>&1 \
+; RUN: | FileCheck %s -check-prefix=WARN
+; RUN: nm -n %t.so | FileCheck %s
+; WARN: no such symbol: missing
+; CHECK: hot2
+; CHECK: hot1
+; CHECK: cold
+
+define i32 @cold(i32 %x) {
+  %r = mul i32 %x, 3
+  ret i32 %r
+}
+
+define i32 @hot1(i32 %x) {
+  %r = add i32 %x, 1
+  ret i32 %r
+}
+
+define i32 @hot2(i32 %x) {
+  %r = call i32 @hot1(i32 %x)
+  ret i32 %r
+}
@@ -0,0 +1,84 @@
+; The relocations of PIC inputs are scanned the same way for any number of
+; threads. Eight copies of the object give the parallel scan work for every
+; thread, and the second link takes the first shared object as an input.
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=pic %s -o %t.x86_64.o
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared --threads=1 \
+; RUN: %t.x86_64.o %t.x86_64.o %t.x86_64.o %t.x86_64.o \
+; RUN: %t.x86_64.o %t.x86_64.o %t.x86_64.o %t.x86_64.o -o %t.x86_64.1.so
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared --threads=4 \
+; RUN: %t.x86_64.o %t.x86_64.o %t.x86_64.o %t.x86_64.o \
+; RUN: %t.x86_64.o %t.x86_64.o %t.x86_64.o %t.x86_64.o -o %t.x86_64.4.so
+; RUN: cmp %t.x86_64.1.so %t.x86_64.4.so
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared --threads=1 \
+; RUN: %t.x86_64.o %t.x86_64.o %t.x86_64.o %t.x86_64.o \
+; RUN: %t.x86_64.1.so -o %t.x86_64.dep.1.so
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared --threads=4 \
+; RUN: %t.x86_64.o %t.x86_64.o %t.x86_64.o %t.x86_64.o \
+; RUN: %t.x86_64.1.so -o %t.x86_64.dep.4.so
+; RUN: cmp %t.x86_64.dep.1.so %t.x86_64.dep.4.so
+
+; RUN: %LLC -mtriple="armv7-none-linux-gnueabi" -filetype=obj \
+; RUN: -relocation-model=pic %s -o %t.arm.o
+; RUN: %MCLinker -mtriple="armv7-none-linux-gnueabi" -shared --threads=1 \
+; RUN: %t.arm.o %t.arm.o %t.arm.o %t.arm.o \
+; RUN: %t.arm.o %t.arm.o %t.arm.o %t.arm.o -o %t.arm.1.so
+; RUN: %MCLinker -mtriple="armv7-none-linux-gnueabi" -shared --threads=4 \
+; RUN: %t.arm.o %t.arm.o %t.arm.o %t.arm.o \
+; RUN: %t.arm.o %t.arm.o %t.arm.o %t.arm.o -o %t.arm.4.so
+; RUN: cmp %t.arm.1.so %t.arm.4.so
+; RUN: %MCLinker -mtriple="armv7-none-linux-gnueabi" -shared --threads=1 \
+; RUN: %t.arm.o %t.arm.o %t.arm.o %t.arm.o \
+; RUN: %t.arm.1.so -o %t.arm.dep.1.so
+; RUN: %MCLinker -mtriple="armv7-none-linux-gnueabi" -shared --threads=4 \
+; RUN: %t.arm.o %t.arm.o %t.arm.o %t.arm.o \
+; RUN: %t.arm.1.so -o %t.arm.dep.4.so
+; RUN: cmp %t.arm.dep.1.so %t.arm.dep.4.so
+
+; RUN: %LLC -mtriple="aarch64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=pic %s -o %t.aarch64.o
+; RUN: %MCLinker -mtriple="aarch64-linux-gnu" -shared --threads=1 \
+; RUN: %t.aarch64.o %t.aarch64.o %t.aarch64.o %t.aarch64.o \
+; RUN: %t.aarch64.o %t.aarch64.o %t.aarch64.o %t.aarch64.o \
+; RUN: -o %t.aarch64.1.so
+; RUN: %MCLinker -mtriple="aarch64-linux-gnu" -shared --threads=4 \
+; RUN: %t.aarch64.o %t.aarch64.o %t.aarch64.o %t.aarch64.o \
+; RUN: %t.aarch64.o %t.aarch64.o %t.aarch64.o %t.aarch64.o \
+; RUN: -o %t.aarch64.4.so
+; RUN: cmp %t.aarch64.1.so %t.aarch64.4.so
+; RUN: %MCLinker -mtriple="aarch64-linux-gnu" -shared --threads=1 \
+; RUN: %t.aarch64.o %t.aarch64.o %t.aarch64.o %t.aarch64.o \
+; RUN: %t.aarch64.1.so -o %t.aarch64.dep.1.so
+; RUN: %MCLinker -mtriple="aarch64-linux-gnu" -shared --threads=4 \
+; RUN: %t.aarch64.o %t.aarch64.o %t.aarch64.o %t.aarch64.o \
+; RUN: %t.aarch64.1.so -o %t.aarch64.dep.4.so
+; RUN: cmp %t.aarch64.dep.1.so %t.aarch64.dep.4.so
+
+; Every definition is weak, so the copies of the object link together.
+@table = weak global [2 x i32 (i32)*] [i32 (i32)* @foo, i32 (i32)* @bar],
+         align 8
+@counter = weak global i32 0, align 4
+@tls = weak thread_local global i32 0, align 4
+@ext_var = external global i32
+
+declare i32 @ext_func(i32)
+
+define weak i32 @foo(i32 %a) nounwind {
+entry:
+  %0 = load i32, i32* @counter, align 4
+  %1 = load i32, i32* @ext_var, align 4
+  %add = add nsw i32 %a, %0
+  %add1 = add nsw i32 %add, %1
+  store i32 %add1, i32* @counter, align 4
+  ret i32 %add1
+}
+
+define weak i32 @bar(i32 %a) nounwind {
+entry:
+  %call = call i32 @foo(i32 %a)
+  %call1 = call i32 @ext_func(i32 %call)
+  %0 = load i32, i32* @tls, align 4
+  %mul = mul nsw i32 %call1, %0
+  store i32 %mul, i32* @tls, align 4
+  ret i32 %mul
+}
@@ -0,0 +1,43 @@
+; Check .eh_frame_hdr of a 64-bit executable.
+
+define void @foo() #0 {
+entry:
+  ret void
+}
+
+define void @bar() #0 {
+entry:
+  call void @foo()
+  ret void
+}
+
+define void @_start() #0 {
+entry:
+  call void @bar()
+  ret void
+}
+
+attributes #0 = { uwtable "no-frame-pointer-elim"="true" }
+
+; RUN: %LLC -filetype=obj -mtriple=x86_64-linux-gnu %s -o %t.o
+; RUN: %MCLinker --eh-frame-hdr -mtriple=x86_64-linux-gnu -e _start \
+; RUN: %t.o -o %t.out
+
+; check GNU_EH_FRAME segment address
+; RUN: readelf -S -W %t.out | grep -o "\.eh_frame_hdr *PROGBITS *[0-9a-f]*" | \
+; RUN: awk '{print $3}' > %t.txt
+; RUN: readelf -l -W %t.out | grep "GNU_EH_FRAME [0-9a-fx]*" | \
+; RUN: awk '{print $3}' >> %t.txt
+; RUN: cat %t.txt | FileCheck %s -check-prefix=SEG
+; SEG: [[ADDR:([0-9a-f]*)]]
+; SEG-NEXT: 0x{{0*}}[[ADDR]]
+
+; check .eh_frame_hdr size: 12 bytes of header and one entry per FDE
+; RUN: readelf -S -W %t.out | \
+; RUN: grep -o "\.eh_frame_hdr *PROGBITS *[0-9a-f]* *[0-9a-f]* *[0-9a-f]*" | \
+; RUN: awk '{print $5}' | FileCheck %s -check-prefix=SIZE
+; SIZE: 000024
+
+; check the encodings and the number of FDEs
+; RUN: readelf -x .eh_frame_hdr %t.out | FileCheck %s -check-prefix=HDR
+; HDR: 011b033b {{[0-9a-f]+}} 03000000
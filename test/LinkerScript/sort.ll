@@ -0,0 +1,34 @@
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj -function-sections \
+; RUN: -data-sections -relocation-model=pic %s -o %t.o
+; RUN: echo "SECTIONS {                                          \
+; RUN:         .text : { *(SORT_BY_NAME(.text.*)) }            \
+; RUN:         .data : { *(SORT_BY_ALIGNMENT(.data.*)) }       \
+; RUN:       }" > %t.lds
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared -T %t.lds \
+; RUN: %t.o -o %t.so
+; RUN: nm -n %t.so | FileCheck %s -check-prefix=TEXT
+; RUN: nm -n %t.so | FileCheck %s -check-prefix=DATA
+; TEXT: T alpha
+; TEXT: T beta
+; TEXT: T gamma
+; DATA: D big
+; DATA: D medium
+; DATA: D small
+
+@small = global i8 1, align 1
+@medium = global i32 2, align 4
+@big = global i64 3, align 16
+
+define i32 @gamma(i32 %x) {
+  ret i32 %x
+}
+
+define i32 @beta(i32 %x) {
+  %r = add i32 %x, 1
+  ret i32 %r
+}
+
+define i32 @alpha(i32 %x) {
+  %r = add i32 %x, 2
+  ret i32 %r
+}
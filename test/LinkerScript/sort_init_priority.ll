@@ -0,0 +1,41 @@
+; SORT_BY_INIT_PRIORITY orders the sections by the number that ends their
+; names, not by the names: .init_array.200 goes before .init_array.1000, and
+; .ctors run backwards, so .ctors.65000 goes before .ctors.00100.
+; RUN: %LLC -mtriple="x86_64-linux-gnu" -filetype=obj \
+; RUN: -relocation-model=pic %s -o %t.o
+; RUN: echo "SECTIONS {                                               \
+; RUN:         .init_array : {                                      \
+; RUN:           KEEP(*(SORT_BY_INIT_PRIORITY(.init_array.*)))      \
+; RUN:           KEEP(*(.init_array))                               \
+; RUN:         }                                                    \
+; RUN:         .ctors : { KEEP(*(SORT_BY_INIT_PRIORITY(.ctors.*))) } \
+; RUN:       }" > %t.lds
+; RUN: %MCLinker -mtriple="x86_64-linux-gnu" -shared -T %t.lds \
+; RUN: %t.o -o %t.so
+; RUN: readelf -x .init_array %t.so | FileCheck %s -check-prefix=INIT
+; RUN: readelf -x .ctors %t.so | FileCheck %s -check-prefix=CTORS
+; INIT: 0x{{[0-9a-f]+}} 01000000 00000000 02000000 00000000
+; INIT-NEXT: 0x{{[0-9a-f]+}} 03000000 00000000 04000000 00000000
+; INIT-NEXT: 0x{{[0-9a-f]+}} 05000000 00000000
+; CTORS: 0x{{[0-9a-f]+}} 01000000 00000000 02000000 00000000
+
+module asm ".section .init_array.500,\22aw\22,@init_array"
+module asm ".quad 3"
+module asm ".section .init_array,\22aw\22,@init_array"
+module asm ".quad 5"
+module asm ".section .init_array.1000,\22aw\22,@init_array"
+module asm ".quad 4"
+module asm ".section .init_array.100,\22aw\22,@init_array"
+module asm ".quad 1"
+module asm ".section .init_array.200,\22aw\22,@init_array"
+module asm ".quad 2"
+module asm ".section .ctors.00100,\22aw\22,@progbits"
+module asm ".quad 2"
+module asm ".section .ctors.65000,\22aw\22,@progbits"
+module asm ".quad 1"
+module asm ".text"
+
+define i32 @foo() nounwind {
+entry:
+  ret i32 0
+}
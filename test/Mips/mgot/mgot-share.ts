@@ -0,0 +1,33 @@
+; Check that inputs sharing global GOT entries are placed into the same GOT
+; even if they are not adjacent on the command line.
+;
+; The inputs are assembled from `lw $2, %got(<sym>)($gp)' lines:
+;   mgot-share-a.o: f0 .. f8199
+;   mgot-share-b.o: g0 .. g8199
+;   mgot-share-c.o: f0 .. f999
+; The entries of a.o and b.o do not fit into one GOT. c.o only refers to
+; entries of a.o, so it shares the primary GOT with a.o instead of adding
+; 1000 entries and R_MIPS_REL32 relocations to the GOT of b.o.
+;
+; RUN: %MCLinker -march=mipsel -mtriple=mipsel-none-linux-gnueabi \
+; RUN:           -shared -o %t.so %p/mgot-share-a.o %p/mgot-share-b.o \
+; RUN:           %p/mgot-share-c.o
+;
+; RUN: readelf -a %t.so | FileCheck %s
+;
+; Primary GOT: 2 reserved, 16400 global entries.
+; Secondary GOT: 2 reserved, 8200 global entries.
+; CHECK: .got PROGBITS {{[0-9a-fA-F]+}} {{[0-9a-fA-F]+}} 018070
+;
+; CHECK: (MIPS_LOCAL_GOTNO)   2
+;
+; CHECK: Relocation section '.rel.dyn' {{.*}} contains 8200 entries
+; CHECK: {{[0-9a-fA-F]+}} {{[0-9a-fA-F]+}} R_MIPS_REL32 00000000 g0
+; CHECK-NOT: R_MIPS_REL32 {{[0-9a-fA-F]+}} f{{[0-9]+}}
+;
+; The globals of the primary GOT come first.
+; CHECK: Primary GOT:
+; CHECK:  Global entries:
+; CHECK:   {{[0-9a-fA-F]+}} -32744(gp) 00000000 00000000 NOTYPE  UND f0
+; CHECK:   {{[0-9a-fA-F]+}}     52(gp) 00000000 00000000 NOTYPE  UND f8199
+; CHECK:   {{[0-9a-fA-F]+}}     56(gp) 00000000 00000000 NOTYPE  UND g0
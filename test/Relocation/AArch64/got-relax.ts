@@ -0,0 +1,17 @@
+; adrp+ldr of the GOT entry of a symbol defined in the output becomes
+; adrp+add of its address, and an undefined weak symbol keeps the GOT.
+; An adrp whose result is used by more than one ldr is kept as well.
+; RUN: %MCLinker -mtriple=aarch64-linux-gnu -static -e _start \
+; RUN: %p/got-relax.o -o %t
+; RUN: llvm-objdump -d %t | FileCheck %s
+; CHECK: adrp x0
+; CHECK-NEXT: add x0, x0
+; CHECK-NEXT: adrp x1
+; CHECK-NEXT: ldr x1, [x1
+
+; RUN: %MCLinker -mtriple=aarch64-linux-gnu -static -e _start \
+; RUN: %p/got-relax-reuse.o -o %t.reuse
+; RUN: llvm-objdump -d %t.reuse | FileCheck %s -check-prefix=REUSE
+; REUSE: adrp x2
+; REUSE-NEXT: ldr x3, [x2
+; REUSE-NEXT: ldr x4, [x2
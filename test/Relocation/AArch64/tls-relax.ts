@@ -0,0 +1,18 @@
+; The TLS descriptor and initial-exec sequences of an executable are relaxed
+; to the offset from the thread pointer, which is a+16, b+16 and c+16 after
+; the 16-byte TCB.
+; RUN: %MCLinker -mtriple=aarch64-linux-gnu -static -e _start \
+; RUN: %p/tls-relax.o -o %t
+; RUN: llvm-objdump -d %t | FileCheck %s
+; CHECK: movz x0, #0, lsl #16
+; CHECK-NEXT: movk x0, #16
+; CHECK-NEXT: nop
+; CHECK-NEXT: nop
+; CHECK-NEXT: movz x2, #0, lsl #16
+; CHECK-NEXT: movk x2, #24
+; CHECK-NEXT: add x3, x3, #0, lsl #12
+; CHECK-NEXT: add x3, x3, #32
+
+; RUN: readelf -S %t | FileCheck %s -check-prefix=SECT
+; SECT-NOT: .got
+; SECT-NOT: .rela.dyn
@@ -0,0 +1,12 @@
+; A shared object keeps the TLS descriptor and the GOT entry of the offset
+; from the thread pointer, and fills them at load time.
+; RUN: %MCLinker -mtriple=aarch64-linux-gnu -shared %p/tls-shared.o -o %t.so
+; RUN: readelf -r %t.so | FileCheck %s
+; CHECK-DAG: R_AARCH64_TLSDESC {{.*}} a + 0
+; CHECK-DAG: R_AARCH64_TLS_TPREL {{.*}} b + 0
+
+; RUN: llvm-objdump -d %t.so | FileCheck %s -check-prefix=CODE
+; CODE: blr x1
+
+; RUN: readelf -d %t.so | FileCheck %s -check-prefix=DYN
+; DYN: STATIC_TLS
@@ -0,0 +1,13 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -static -e _start \
+; RUN: %p/obj/gotpcrelx.o -o %t.exe
+
+; the symbols are addressed directly, no GOT entry is needed
+; RUN: objdump -d %t.exe | FileCheck %s
+; CHECK: lea {{.*}}(%rip),%rax
+; CHECK-NEXT: lea {{.*}}(%rip),%rcx
+; CHECK-NEXT: addr32 call {{.*}} <foo>
+; CHECK-NEXT: nop
+; CHECK-NEXT: jmp {{.*}} <foo>
+
+; RUN: readelf -S %t.exe | FileCheck %s -check-prefix=SECT
+; SECT-NOT: .got
@@ -0,0 +1,12 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared \
+; RUN: %p/obj/gotpcrelx.o -o %t.so
+
+; foo is preemptible and still loaded from the GOT, the local bar is not
+; RUN: objdump -d %t.so | FileCheck %s
+; CHECK: mov {{.*}}(%rip),%rax
+; CHECK-NEXT: lea {{.*}}(%rip),%rcx
+; CHECK-NEXT: call *{{.*}}(%rip)
+; CHECK-NEXT: jmp *{{.*}}(%rip)
+
+; RUN: readelf -r %t.so | FileCheck %s -check-prefix=REL
+; REL: R_X86_64_GLOB_DAT {{.*}} foo + 0
@@ -0,0 +1,20 @@
+  .text
+  .globl  _start
+  .type   _start, @function
+_start:
+  movq    foo@GOTPCREL(%rip), %rax
+  movq    bar@GOTPCREL(%rip), %rcx
+  call    *foo@GOTPCREL(%rip)
+  jmp     *foo@GOTPCREL(%rip)
+  .size   _start, .-_start
+
+  .globl  foo
+  .type   foo, @function
+foo:
+  ret
+  .size   foo, .-foo
+
+  .type   bar, @function
+bar:
+  ret
+  .size   bar, .-bar
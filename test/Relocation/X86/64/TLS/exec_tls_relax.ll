@@ -0,0 +1,18 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -static -e _start \
+; RUN: %p/obj/tls.o -o %t.exe
+
+; every model is relaxed to the offset from the thread pointer
+; RUN: objdump -d %t.exe | FileCheck %s
+; CHECK: mov %fs:0x0,%rax
+; CHECK-NEXT: lea -0x20(%rax),%rax
+; CHECK-NEXT: data16 data16 data16 mov %fs:0x0,%rax
+; CHECK-NEXT: lea -0x18(%rax),%rcx
+; CHECK-NEXT: mov $0xfffffffffffffff0,%rdx
+; CHECK-NEXT: lea -0x10(%r9),%r9
+; CHECK-NEXT: mov $0xfffffffffffffff8,%rax
+; CHECK-NEXT: xchg %ax,%ax
+
+; no GOT entry or dynamic relocation is left
+; RUN: readelf -S %t.exe | FileCheck %s -check-prefix=SECT
+; SECT-NOT: .got
+; SECT-NOT: .rela.dyn
@@ -0,0 +1,17 @@
+; RUN: %MCLinker -mtriple=x86_64-pc-linux-gnu -shared \
+; RUN: %p/obj/tls.o -o %t.so
+
+; RUN: readelf -r %t.so | FileCheck %s
+; CHECK-DAG: R_X86_64_DTPMOD64 {{.*}} gd + 0
+; CHECK-DAG: R_X86_64_DTPOFF64 {{.*}} gd + 0
+; CHECK-DAG: R_X86_64_DTPMOD64 {{[ ]+}}0
+; CHECK-DAG: R_X86_64_TPOFF64 {{.*}} ie + 0
+; CHECK-DAG: R_X86_64_TLSDESC {{.*}} desc + 0
+
+; the code still calls __tls_get_addr and the descriptor
+; RUN: objdump -d %t.so | FileCheck %s -check-prefix=CODE
+; CODE: data16 lea {{.*}}(%rip),%rdi
+; CODE: call *(%rax)
+
+; RUN: readelf -d %t.so | FileCheck %s -check-prefix=DYN
+; DYN: STATIC_TLS
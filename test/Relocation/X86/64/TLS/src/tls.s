@@ -0,0 +1,36 @@
+  .text
+  .globl  _start
+  .type   _start, @function
+_start:
+  # general dynamic
+  .byte   0x66
+  leaq    gd@tlsgd(%rip), %rdi
+  .value  0x6666
+  rex64
+  call    __tls_get_addr@PLT
+  # local dynamic
+  leaq    ld@tlsld(%rip), %rdi
+  call    __tls_get_addr@PLT
+  leaq    ld@dtpoff(%rax), %rcx
+  # initial exec
+  movq    ie@gottpoff(%rip), %rdx
+  addq    ie@gottpoff(%rip), %r9
+  # descriptor
+  leaq    desc@tlsdesc(%rip), %rax
+  call    *desc@tlscall(%rax)
+  ret
+  .size   _start, .-_start
+
+  .section .tbss,"awT",@nobits
+  .globl  gd
+  .globl  ie
+  .globl  desc
+  .align  8
+gd:
+  .zero   8
+ld:
+  .zero   8
+ie:
+  .zero   8
+desc:
+  .zero   8
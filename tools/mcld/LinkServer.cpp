@@ -0,0 +1,510 @@
+//===- LinkServer.cpp -----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "LinkServer.h"
+
+#include <mcld/Config/Config.h>
+#include <mcld/LD/ParsedInput.h>
+#include <mcld/Support/FileSystem.h>
+#include <mcld/Support/InputCache.h>
+#include <mcld/Support/raw_ostream.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(MCLD_ON_UNIX)
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace mcld {
+
+#if defined(MCLD_ON_UNIX)
+
+namespace {
+
+/// the standard streams passed from a client to the server
+const int kNumOfStreams = 3;
+
+/// a request starts with this byte, which carries the client's streams
+const char kRequestTag = 'L';
+
+bool WriteAll(int pFD, const void* pBuf, size_t pSize) {
+  const char* data = static_cast<const char*>(pBuf);
+  while (pSize > 0) {
+    ssize_t size = ::write(pFD, data, pSize);
+    if (size < 0 && errno == EINTR)
+      continue;
+    if (size <= 0)
+      return false;
+    data += size;
+    pSize -= size;
+  }
+  return true;
+}
+
+bool ReadAll(int pFD, void* pBuf, size_t pSize) {
+  char* data = static_cast<char*>(pBuf);
+  while (pSize > 0) {
+    ssize_t size = ::read(pFD, data, pSize);
+    if (size < 0 && errno == EINTR)
+      continue;
+    if (size <= 0)
+      return false;
+    data += size;
+    pSize -= size;
+  }
+  return true;
+}
+
+bool WriteString(int pFD, const std::string& pString) {
+  uint32_t size = pString.size();
+  return WriteAll(pFD, &size, sizeof(size)) &&
+         WriteAll(pFD, pString.data(), pString.size());
+}
+
+bool ReadString(int pFD, std::string& pString) {
+  uint32_t size;
+  if (!ReadAll(pFD, &size, sizeof(size)))
+    return false;
+  pString.resize(size);
+  return (size == 0) || ReadAll(pFD, &pString[0], size);
+}
+
+bool MakeAddress(const std::string& pSocket, sockaddr_un& pAddress) {
+  if (pSocket.empty() || pSocket.size() >= sizeof(pAddress.sun_path))
+    return false;
+  memset(&pAddress, 0, sizeof(pAddress));
+  pAddress.sun_family = AF_UNIX;
+  memcpy(pAddress.sun_path, pSocket.c_str(), pSocket.size() + 1);
+  return true;
+}
+
+/// Connect - connect to the server on pSocket. @return -1 on failure
+int Connect(const std::string& pSocket) {
+  sockaddr_un address;
+  if (!MakeAddress(pSocket, address))
+    return -1;
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    return -1;
+  if (::connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address))) {
+    ::close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/// SendStreams - pass our standard streams over pSocket
+bool SendStreams(int pSocket) {
+  int fds[kNumOfStreams] = {STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO};
+  char tag = kRequestTag;
+  iovec iov;
+  iov.iov_base = &tag;
+  iov.iov_len = 1;
+
+  char control[CMSG_SPACE(sizeof(fds))];
+  memset(control, 0, sizeof(control));
+  msghdr message;
+  memset(&message, 0, sizeof(message));
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  cmsghdr* header = CMSG_FIRSTHDR(&message);
+  header->cmsg_level = SOL_SOCKET;
+  header->cmsg_type = SCM_RIGHTS;
+  header->cmsg_len = CMSG_LEN(sizeof(fds));
+  memcpy(CMSG_DATA(header), fds, sizeof(fds));
+
+  ssize_t size;
+  do {
+    size = ::sendmsg(pSocket, &message, 0);
+  } while (size < 0 && errno == EINTR);
+  return size == 1;
+}
+
+/// ReceiveStreams - take the streams of the client as our standard streams
+bool ReceiveStreams(int pSocket) {
+  int fds[kNumOfStreams];
+  char tag = 0;
+  iovec iov;
+  iov.iov_base = &tag;
+  iov.iov_len = 1;
+
+  char control[CMSG_SPACE(sizeof(fds))];
+  msghdr message;
+  memset(&message, 0, sizeof(message));
+  message.msg_iov = &iov;
+  message.msg_iovlen = 1;
+  message.msg_control = control;
+  message.msg_controllen = sizeof(control);
+
+  ssize_t size;
+  do {
+    size = ::recvmsg(pSocket, &message, 0);
+  } while (size < 0 && errno == EINTR);
+  if (size != 1 || tag != kRequestTag)
+    return false;
+
+  cmsghdr* header = CMSG_FIRSTHDR(&message);
+  if (header == NULL || header->cmsg_level != SOL_SOCKET ||
+      header->cmsg_type != SCM_RIGHTS ||
+      header->cmsg_len != CMSG_LEN(sizeof(fds)))
+    return false;
+  memcpy(fds, CMSG_DATA(header), sizeof(fds));
+
+  for (int stream = 0; stream < kNumOfStreams; ++stream) {
+    if (fds[stream] == stream)
+      continue;
+    ::dup2(fds[stream], stream);
+    ::close(fds[stream]);
+  }
+  return true;
+}
+
+/// RunLink - serve the request on pConnection in a forked child. The paths
+/// of the inputs it maps are written to pReport, one per line.
+int RunLink(int pConnection, int pReport, LinkServer::LinkFunction pLink) {
+  std::string cwd;
+  uint32_t argc = 0;
+  if (!ReceiveStreams(pConnection) || !ReadString(pConnection, cwd) ||
+      !ReadAll(pConnection, &argc, sizeof(argc)) ||
+      ::chdir(cwd.c_str()) != 0)
+    return EXIT_FAILURE;
+
+  std::vector<std::string> args(argc);
+  for (uint32_t i = 0; i < argc; ++i) {
+    if (!ReadString(pConnection, args[i]))
+      return EXIT_FAILURE;
+  }
+  std::vector<const char*> argv;
+  for (const std::string& arg : args)
+    argv.push_back(arg.c_str());
+  argv.push_back(NULL);
+
+  // forget the paths the server mapped before this link
+  InputCache* cache = InputCache::shared();
+  cache->takeNewPaths();
+
+  int status = pLink(static_cast<int>(argc), argv.data());
+  mcld::outs().flush();
+
+  std::string report;
+  for (const std::string& path : cache->takeNewPaths())
+    report += path + "\n";
+  WriteAll(pReport, report.data(), report.size());
+  ::close(pReport);
+
+  int32_t result = status;
+  WriteAll(pConnection, &result, sizeof(result));
+  ::close(pConnection);
+  return status;
+}
+
+/// Warmer - maps the inputs reported by finished links into the cache, reads
+/// them in and parses their tables on a thread of its own, so the server goes
+/// on accepting links meanwhile. The links forked later inherit the parsed
+/// tables with the rest of the memory of the server.
+///
+/// fork() copies only the calling thread, so the mutex of the cache must
+/// not be held by the warming thread at a fork. The thread holds m_ForkMutex
+/// while it touches the cache, and the server holds it across fork(). Reading
+/// the pages in and parsing happen outside both locks.
+class Warmer {
+ public:
+  explicit Warmer(InputCache& pCache)
+      : m_Cache(pCache), m_bStop(false), m_Thread(&Warmer::run, this) {}
+
+  ~Warmer() {
+    {
+      std::lock_guard<std::mutex> lock(m_QueueMutex);
+      m_bStop = true;
+    }
+    m_Ready.notify_one();
+    m_Thread.join();
+  }
+
+  /// post - warm the files named in pReport, one per line
+  void post(const std::string& pReport) {
+    if (pReport.empty())
+      return;
+    {
+      std::lock_guard<std::mutex> lock(m_QueueMutex);
+      m_Reports.push_back(pReport);
+    }
+    m_Ready.notify_one();
+  }
+
+  /// forkMutex - hold this across fork()
+  std::mutex& forkMutex() { return m_ForkMutex; }
+
+ private:
+  void run() {
+    while (true) {
+      std::string report;
+      {
+        std::unique_lock<std::mutex> lock(m_QueueMutex);
+        m_Ready.wait(lock, [this] { return m_bStop || !m_Reports.empty(); });
+        if (m_bStop)
+          return;
+        report.swap(m_Reports.front());
+        m_Reports.pop_front();
+      }
+      warm(report);
+    }
+  }
+
+  void warm(const std::string& pReport) {
+    size_t begin = 0;
+    while (begin < pReport.size()) {
+      size_t end = pReport.find('\n', begin);
+      if (end == std::string::npos)
+        end = pReport.size();
+      llvm::StringRef path = llvm::StringRef(pReport).slice(begin, end);
+      InputCache::Mapping mapping;
+      InputCache::Parsed parsed;
+      size_t size = 0;
+      bool mapped;
+      {
+        std::lock_guard<std::mutex> lock(m_ForkMutex);
+        mapped = m_Cache.acquire(path, false, mapping, size, &parsed);
+        // only the links forked later care which paths are new
+        m_Cache.takeNewPaths();
+      }
+      if (mapped && !parsed) {
+        ReadIn(mapping.get(), size);
+        parsed.reset(new ParsedInput(mapping.get(), size));
+        if (!parsed->empty()) {
+          std::lock_guard<std::mutex> lock(m_ForkMutex);
+          m_Cache.setParsed(path, mapping, parsed);
+        }
+      }
+      begin = end + 1;
+    }
+  }
+
+  /// ReadIn - fault in every page of the pSize bytes at pData
+  static void ReadIn(const char* pData, size_t pSize) {
+    sys::fs::detail::advise_map(pData, pSize, sys::fs::detail::MapWillNeed);
+    const size_t page = ::sysconf(_SC_PAGESIZE);
+    volatile char sink = 0;
+    for (size_t offset = 0; offset < pSize; offset += page)
+      sink = pData[offset];
+    (void)sink;
+  }
+
+ private:
+  InputCache& m_Cache;
+  std::mutex m_QueueMutex;
+  std::condition_variable m_Ready;
+  std::deque<std::string> m_Reports;
+  bool m_bStop;
+  std::mutex m_ForkMutex;
+  std::thread m_Thread;
+};
+
+/// Child - a running link and what it reported so far
+struct Child {
+  int report;
+  std::string paths;
+};
+
+}  // anonymous namespace
+
+//===----------------------------------------------------------------------===//
+// LinkServer
+//===----------------------------------------------------------------------===//
+LinkServer::LinkServer(const std::string& pSocket,
+                       LinkFunction pLink,
+                       size_t pCacheBudget)
+    : m_Socket(pSocket), m_pLink(pLink), m_CacheBudget(pCacheBudget) {
+}
+
+int LinkServer::serve() {
+  sockaddr_un address;
+  if (!MakeAddress(m_Socket, address)) {
+    mcld::errs() << "Invalid socket path for the link server: " << m_Socket
+                 << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // do not take over the socket of a live server
+  int probe = Connect(m_Socket);
+  if (probe >= 0) {
+    ::close(probe);
+    mcld::errs() << "A link server is already listening on " << m_Socket
+                 << "\n";
+    return EXIT_FAILURE;
+  }
+  ::unlink(m_Socket.c_str());
+
+  int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  // only the owner may connect
+  mode_t mask = ::umask(0077);
+  bool bound = (listener >= 0) &&
+               (::bind(listener, reinterpret_cast<sockaddr*>(&address),
+                       sizeof(address)) == 0);
+  ::umask(mask);
+  if (!bound || ::listen(listener, SOMAXCONN) != 0) {
+    mcld::errs() << "Cannot listen on " << m_Socket << ": "
+                 << strerror(errno) << "\n";
+    if (listener >= 0)
+      ::close(listener);
+    return EXIT_FAILURE;
+  }
+
+  InputCache cache(m_CacheBudget);
+  InputCache::setShared(&cache);
+  std::unique_ptr<Warmer> warmer(new Warmer(cache));
+
+  std::vector<Child> children;
+  while (true) {
+    while (::waitpid(-1, NULL, WNOHANG) > 0) {
+    }
+
+    std::vector<pollfd> fds(children.size() + 1);
+    fds[0].fd = listener;
+    fds[0].events = POLLIN;
+    for (size_t i = 0; i < children.size(); ++i) {
+      fds[i + 1].fd = children[i].report;
+      fds[i + 1].events = POLLIN;
+    }
+    if (::poll(fds.data(), fds.size(), 1000) < 0) {
+      if (errno == EINTR)
+        continue;
+      break;
+    }
+
+    // collect the inputs of the finished links
+    for (size_t i = children.size(); i-- > 0;) {
+      if (fds[i + 1].revents == 0)
+        continue;
+      char buffer[4096];
+      ssize_t size = ::read(children[i].report, buffer, sizeof(buffer));
+      if (size > 0) {
+        children[i].paths.append(buffer, size);
+        continue;
+      }
+      if (size < 0 && errno == EINTR)
+        continue;
+      ::close(children[i].report);
+      warmer->post(children[i].paths);
+      children.erase(children.begin() + i);
+    }
+
+    if ((fds[0].revents & POLLIN) == 0)
+      continue;
+    int connection = ::accept(listener, NULL, NULL);
+    if (connection < 0)
+      continue;
+    int report[2];
+    if (::pipe(report) != 0) {
+      ::close(connection);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> fork_lock(warmer->forkMutex());
+    pid_t pid = ::fork();
+    if (pid == 0) {
+      // the warming thread is not copied into the child
+      fork_lock.release();
+      warmer.release();
+      ::close(listener);
+      ::close(report[0]);
+      for (const Child& child : children)
+        ::close(child.report);
+      return RunLink(connection, report[1], m_pLink);
+    }
+
+    fork_lock.unlock();
+    ::close(connection);
+    ::close(report[1]);
+    if (pid < 0) {
+      ::close(report[0]);
+      continue;
+    }
+    Child child;
+    child.report = report[0];
+    children.push_back(child);
+  }
+
+  mcld::errs() << "The link server stopped: " << strerror(errno) << "\n";
+  warmer.reset();
+  ::close(listener);
+  ::unlink(m_Socket.c_str());
+  InputCache::setShared(NULL);
+  return EXIT_FAILURE;
+}
+
+bool LinkServer::forward(const std::string& pSocket,
+                         int pArgc,
+                         const char* const* pArgv,
+                         int& pStatus) {
+  int connection = Connect(pSocket);
+  if (connection < 0)
+    return false;
+
+  char* cwd = ::getcwd(NULL, 0);
+  bool sent = (cwd != NULL) && SendStreams(connection) &&
+              WriteString(connection, cwd);
+  free(cwd);
+  uint32_t argc = pArgc;
+  sent = sent && WriteAll(connection, &argc, sizeof(argc));
+  for (int i = 0; sent && i < pArgc; ++i)
+    sent = WriteString(connection, pArgv[i]);
+  if (!sent) {
+    ::close(connection);
+    return false;
+  }
+
+  // The server has taken the request. If the link ends without a status,
+  // it exited on a fatal error.
+  int32_t status;
+  pStatus = ReadAll(connection, &status, sizeof(status)) ? status
+                                                           : EXIT_FAILURE;
+  ::close(connection);
+  return true;
+}
+
+#else  // !MCLD_ON_UNIX
+
+LinkServer::LinkServer(const std::string& pSocket,
+                       LinkFunction pLink,
+                       size_t pCacheBudget)
+    : m_Socket(pSocket), m_pLink(pLink), m_CacheBudget(pCacheBudget) {
+}
+
+int LinkServer::serve() {
+  mcld::errs() << "The link server is not supported on this host\n";
+  return EXIT_FAILURE;
+}
+
+bool LinkServer::forward(const std::string& pSocket,
+                         int pArgc,
+                         const char* const* pArgv,
+                         int& pStatus) {
+  return false;
+}
+
+#endif  // MCLD_ON_UNIX
+
+}  // namespace mcld
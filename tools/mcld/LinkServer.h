@@ -0,0 +1,69 @@
+//===- LinkServer.h -------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef TOOLS_MCLD_LINKSERVER_H_
+#define TOOLS_MCLD_LINKSERVER_H_
+
+#include <cstddef>
+#include <string>
+
+namespace mcld {
+
+/** \class LinkServer
+ *  \brief LinkServer runs ld.mcld as a resident process on a local socket.
+ *
+ *  The server accepts command lines from clients and runs each link in a
+ *  child process, in the working directory of the client and with the
+ *  client's standard streams. The server keeps the input files of finished
+ *  links mapped in an InputCache, so later links of the same files find
+ *  them mapped and resident. It also parses the section tables, symbol
+ *  tables and archive symbol indexes of those files into a ParsedInput, and
+ *  since a link runs in a fork of the server, the readers of later links
+ *  create their sections and symbols from the parsed tables without decoding
+ *  the files again. The inputs are mapped, read in and parsed on a thread
+ *  of the server, so accepting links never waits for them. An entry is
+ *  dropped when the device, inode, size or modification time of its file
+ *  changes.
+ *
+ *  ld.mcld forwards its command line to the server named by the
+ *  MCLD_SERVER environment variable and falls back to linking in-process
+ *  if no server answers.
+ */
+class LinkServer {
+ public:
+  /// LinkFunction - link with the given command line and return the exit
+  /// status
+  typedef int (*LinkFunction)(int pArgc, const char* const* pArgv);
+
+ public:
+  /// @param pCacheBudget - the total size of input files to keep mapped
+  LinkServer(const std::string& pSocket,
+             LinkFunction pLink,
+             size_t pCacheBudget);
+
+  /// serve - accept links until an error occurs. In the child that runs a
+  /// link it returns the exit status of that link.
+  int serve();
+
+  /// forward - run the link on the server listening on pSocket.
+  /// @return false if there is no server; pStatus is the exit status of the
+  ///         link otherwise.
+  static bool forward(const std::string& pSocket,
+                      int pArgc,
+                      const char* const* pArgv,
+                      int& pStatus);
+
+ private:
+  std::string m_Socket;
+  LinkFunction m_pLink;
+  size_t m_CacheBudget;
+};
+
+}  // namespace mcld
+
+#endif  // TOOLS_MCLD_LINKSERVER_H_
@@ -26,6 +26,7 @@
 #include <llvm/ADT/ArrayRef.h>
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/ADT/StringExtras.h>
 #include <llvm/ADT/StringRef.h>
 #include <llvm/ADT/StringSwitch.h>
 #include <llvm/Option/Arg.h>
@@ -33,9 +34,12 @@
 #include <llvm/Option/OptTable.h>
 #include <llvm/Option/Option.h>
 #include <llvm/Support/ManagedStatic.h>
+#include <llvm/Support/MemoryBuffer.h>
 #include <llvm/Support/Process.h>
 #include <llvm/Support/Signals.h>
 
+#include "LinkServer.h"
+
 #include <cassert>
 #include <cstdlib>
 #include <string>
@@ -274,9 +278,29 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
     mcld::errs().setColor(res);
   }
 
+  // --server=<path> is only valid on its own, see main()
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_Server)) {
+    mcld::errs() << arg->getOption().getPrefixedName()
+                 << " can not be used with other options\n";
+    return false;
+  }
+
   // --trace
   config_.options().setTrace(args.hasArg(kOpt_Trace));
 
+  // --time-trace=FILE
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_TimeTrace))
+    config_.options().setTimeTraceFile(arg->getValue());
+
+  // --print-stats
+  config_.options().setPrintStats(args.hasArg(kOpt_PrintStats));
+
+  // --print-memory-usage
+  config_.options().setPrintMemoryUsage(args.hasArg(kOpt_PrintMemoryUsage));
+
+  // --huge-pages
+  config_.options().setHugePages(args.hasArg(kOpt_HugePages));
+
   // --verbose=level
   if (llvm::opt::Arg* arg = args.getLastArg(kOpt_Verbose)) {
     llvm::StringRef value = arg->getValue();
@@ -563,6 +587,83 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
     }
   }
 
+  // --build-id[=style]
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_BuildID, kOpt_BuildIDEq)) {
+    typedef mcld::GeneralOptions::BuildIDStyle BuildIDStyle;
+    if (arg->getOption().matches(kOpt_BuildID)) {
+      config_.options().setBuildIDStyle(BuildIDStyle::SHA1);
+    } else {
+      llvm::StringRef value = arg->getValue();
+      if (value.startswith("0x") || value.startswith("0X")) {
+        llvm::StringRef digits = value.drop_front(2);
+        std::string bytes;
+        bool valid = !digits.empty() && (digits.size() % 2 == 0);
+        for (size_t i = 0; valid && i < digits.size(); i += 2) {
+          unsigned hi = llvm::hexDigitValue(digits[i]);
+          unsigned lo = llvm::hexDigitValue(digits[i + 1]);
+          valid = (hi != -1U) && (lo != -1U);
+          bytes.push_back(static_cast<char>((hi << 4) | lo));
+        }
+        if (!valid) {
+          mcld::errs() << "Invalid value for"
+                       << arg->getOption().getPrefixedName() << ": "
+                       << arg->getValue() << "\n";
+          return false;
+        }
+        config_.options().setBuildIDStyle(BuildIDStyle::Hex);
+        config_.options().setBuildIDBytes(bytes);
+      } else {
+        int style = llvm::StringSwitch<int>(value)
+                        .Case("none", static_cast<int>(BuildIDStyle::None))
+                        .Case("fast", static_cast<int>(BuildIDStyle::Fast))
+                        .Case("md5", static_cast<int>(BuildIDStyle::MD5))
+                        .Case("sha1", static_cast<int>(BuildIDStyle::SHA1))
+                        .Case("tree", static_cast<int>(BuildIDStyle::SHA1))
+                        .Case("uuid", static_cast<int>(BuildIDStyle::UUID))
+                        .Default(-1);
+        if (style < 0) {
+          mcld::errs() << "Invalid value for"
+                       << arg->getOption().getPrefixedName() << ": "
+                       << arg->getValue() << "\n";
+          return false;
+        }
+        config_.options().setBuildIDStyle(static_cast<BuildIDStyle>(style));
+      }
+    }
+  }
+
+  // --compress-debug-sections=type
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_CompressDebugSections)) {
+    typedef mcld::GeneralOptions::DebugCompression DebugCompression;
+    llvm::StringRef value = arg->getValue();
+    if (value == "none") {
+      config_.options().setCompressDebugSections(DebugCompression::None);
+    } else if (value == "zlib" || value == "zlib-gabi") {
+      config_.options().setCompressDebugSections(DebugCompression::Zlib);
+    } else {
+      mcld::errs() << "Invalid value for"
+                   << arg->getOption().getPrefixedName() << ": "
+                   << arg->getValue() << "\n";
+      return false;
+    }
+  }
+
+  // --pack-dyn-relocs=format
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_PackDynRelocs)) {
+    typedef mcld::GeneralOptions::DynRelocPacking DynRelocPacking;
+    llvm::StringRef value = arg->getValue();
+    if (value == "none") {
+      config_.options().setPackDynRelocs(DynRelocPacking::None);
+    } else if (value == "relr") {
+      config_.options().setPackDynRelocs(DynRelocPacking::Relr);
+    } else {
+      mcld::errs() << "Invalid value for"
+                   << arg->getOption().getPrefixedName() << ": "
+                   << arg->getValue() << "\n";
+      return false;
+    }
+  }
+
   // --[no]-export-dynamic
   if (llvm::opt::Arg* arg = args.getLastArg(kOpt_ExportDynamic,
                                               kOpt_NoExportDynamic)) {
@@ -624,6 +725,54 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
     config_.options().getUndefSymList().push_back(arg->getValue());
   }
 
+  // --symbol-ordering-file=file, one symbol per line
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_SymbolOrderingFile)) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > buffer =
+        llvm::MemoryBuffer::getFile(arg->getValue());
+    if (!buffer) {
+      mcld::errs() << "Cannot open symbol ordering file `" << arg->getValue()
+                   << "': " << buffer.getError().message() << "\n";
+      return false;
+    }
+    llvm::SmallVector<llvm::StringRef, 128> lines;
+    (*buffer)->getBuffer().split(lines, '\n', -1, false);
+    for (llvm::StringRef line : lines) {
+      line = line.split('#').first.trim();
+      if (!line.empty())
+        config_.options().getSymbolOrderList().push_back(line.str());
+    }
+  }
+
+  // --call-graph-ordering-file=file, one "caller callee count" per line
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_CallGraphOrderingFile)) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer> > buffer =
+        llvm::MemoryBuffer::getFile(arg->getValue());
+    if (!buffer) {
+      mcld::errs() << "Cannot open call graph ordering file `"
+                   << arg->getValue()
+                   << "': " << buffer.getError().message() << "\n";
+      return false;
+    }
+    llvm::SmallVector<llvm::StringRef, 128> lines;
+    (*buffer)->getBuffer().split(lines, '\n', -1, false);
+    for (llvm::StringRef line : lines) {
+      line = line.split('#').first.trim();
+      if (line.empty())
+        continue;
+      llvm::SmallVector<llvm::StringRef, 3> fields;
+      line.split(fields, ' ', -1, false);
+      mcld::GeneralOptions::CallGraphEdge edge;
+      if (fields.size() != 3 || fields[2].getAsInteger(10, edge.count)) {
+        mcld::errs() << "Invalid line in call graph ordering file `"
+                     << arg->getValue() << "': " << line << "\n";
+        return false;
+      }
+      edge.caller = fields[0].str();
+      edge.callee = fields[1].str();
+      config_.options().getCallGraphProfile().push_back(edge);
+    }
+  }
+
   //===--------------------------------------------------------------------===//
   // Script
   //===--------------------------------------------------------------------===//
@@ -813,6 +962,78 @@ bool Driver::TranslateArguments(llvm::opt::InputArgList& args) {
     }
   }
 
+  // --threads=N, --no-threads
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_Threads, kOpt_NoThreads)) {
+    if (arg->getOption().matches(kOpt_NoThreads)) {
+      config_.options().setNumThreads(1);
+    } else {
+      llvm::StringRef value = arg->getValue();
+      int num;
+      if (value.getAsInteger(0, num) || (num < 0)) {
+        mcld::errs() << "Invalid value for"
+                     << arg->getOption().getPrefixedName() << ": "
+                     << arg->getValue() << "\n";
+        return false;
+      }
+      config_.options().setNumThreads(num);
+    }
+  }
+
+  // --mmap-populate-limit=SIZE
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_MmapPopulateLimit)) {
+    llvm::StringRef value = arg->getValue();
+    uint64_t size;
+    if (value.getAsInteger(0, size)) {
+      mcld::errs() << "Invalid value for"
+                   << arg->getOption().getPrefixedName() << ": "
+                   << arg->getValue() << "\n";
+      return false;
+    }
+    config_.options().setMmapPopulateLimit(size);
+  }
+
+  // --[no-]mmap-output-file
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_MmapOutputFile,
+                                              kOpt_NoMmapOutputFile)) {
+    if (arg->getOption().matches(kOpt_MmapOutputFile)) {
+      config_.options().setMmapOutputFile(true);
+    } else {
+      config_.options().setMmapOutputFile(false);
+    }
+  }
+
+  // --batch-apply-relocs
+  config_.options().setBatchApplyRelocs(args.hasArg(kOpt_BatchApplyRelocs));
+
+  // --incremental
+  config_.options().setIncremental(args.hasArg(kOpt_Incremental));
+
+  // --prefetch-inputs=K
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_PrefetchInputs)) {
+    llvm::StringRef value = arg->getValue();
+    uint64_t num;
+    if (value.getAsInteger(0, num)) {
+      mcld::errs() << "Invalid value for"
+                   << arg->getOption().getPrefixedName() << ": "
+                   << arg->getValue() << "\n";
+      return false;
+    }
+    config_.options().setPrefetchInputs(num);
+  }
+
+  // --prefetch-budget=SIZE
+  if (llvm::opt::Arg* arg = args.getLastArg(kOpt_PrefetchBudget)) {
+    llvm::StringRef value = arg->getValue();
+    uint64_t size;
+    if (value.getAsInteger(0, size)) {
+      mcld::errs() << "Invalid value for"
+                   << arg->getOption().getPrefixedName() << ": "
+                   << arg->getValue() << "\n";
+      return false;
+    }
+    config_.options().setPrefetchBudget(size);
+  }
+
   //===--------------------------------------------------------------------===//
   // Positional
   //===--------------------------------------------------------------------===//
@@ -1033,6 +1254,29 @@ std::unique_ptr<Driver> Driver::Create(llvm::ArrayRef<const char*> argv) {
     return nullptr;
   }
 
+  // The state of an incremental link belongs to its command line.
+  if (result->config_.options().incremental()) {
+    std::string key;
+    for (const char* arg : argv.slice(1)) {
+      key += arg;
+      key += '\0';
+    }
+    // the orders given by --symbol-ordering-file and
+    // --call-graph-ordering-file are part of it as well
+    for (const std::string& symbol :
+         result->config_.options().getSymbolOrderList()) {
+      key += symbol;
+      key += '\0';
+    }
+    for (const mcld::GeneralOptions::CallGraphEdge& edge :
+         result->config_.options().getCallGraphProfile()) {
+      key += edge.caller + ' ' + edge.callee + ' ' +
+             llvm::utostr(edge.count);
+      key += '\0';
+    }
+    result->config_.options().setIncrementalKey(key);
+  }
+
   return result;
 }
 
@@ -1044,6 +1288,13 @@ bool Driver::Run() {
     return false;
   }
 
+  // Patch the output of the last incremental link if only the contents of
+  // some objects have changed.
+  if (config_.options().incremental() && linker_.relink(module_)) {
+    mcld::Finalize();
+    return true;
+  }
+
   if (!linker_.link(module_, ir_builder_)) {
     mcld::errs() << "Failed to link objects!\n";
     return false;
@@ -1058,9 +1309,8 @@ bool Driver::Run() {
   return true;
 }
 
-}  // anonymous namespace
-
-int main(int argc, char** argv) {
+/// Link - link with the given command line and return the exit status.
+int Link(int argc, const char* const* argv) {
   std::unique_ptr<Driver> driver =
       Driver::Create(llvm::makeArrayRef(argv, argc));
 
@@ -1070,3 +1320,29 @@ int main(int argc, char** argv) {
     return EXIT_SUCCESS;
   }
 }
+
+/// The size of the input files a link server keeps mapped.
+const size_t kServerCacheBudget = 2048UL * 1024 * 1024;
+
+}  // anonymous namespace
+
+int main(int argc, char** argv) {
+  // --server=<path> runs a resident link server.
+  llvm::StringRef server_prefix("--server=");
+  if (argc == 2 && llvm::StringRef(argv[1]).startswith(server_prefix)) {
+    mcld::LinkServer server(llvm::StringRef(argv[1]).substr(
+                                server_prefix.size()).str(),
+                            Link,
+                            kServerCacheBudget);
+    return server.serve();
+  }
+
+  // Hand the link to a resident server if there is one.
+  if (const char* socket = getenv("MCLD_SERVER")) {
+    int status;
+    if (mcld::LinkServer::forward(socket, argc, argv, status))
+      return status;
+  }
+
+  return Link(argc, argv);
+}
@@ -0,0 +1,394 @@
+//===- ArenaTest.cpp ------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "ArenaTest.h"
+#include "mcld/Support/Arena.h"
+#include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
+#include "mcld/Support/Parallel.h"
+
+#include <llvm/Support/Format.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+/// the size of a relocation
+struct Object {
+  uint64_t offset;
+  uint64_t addend;
+  void* symbol;
+  uint32_t type;
+};
+
+const size_t kBenchObjects = 1u << 20;
+
+/// counts the destructed objects
+struct Counted {
+  static unsigned destructed;
+
+  ~Counted() { ++destructed; }
+};
+
+unsigned Counted::destructed = 0;
+
+/// counts the constructed objects of each type
+template <int N>
+struct Slow {
+  static std::atomic<unsigned> constructed;
+
+  Slow() {
+    ++constructed;
+    // widen the window for two threads to create the object at once
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+};
+
+template <int N>
+std::atomic<unsigned> Slow<N>::constructed(0);
+
+/// a distinct type for every N
+template <int N>
+struct Tag {
+  int value;
+
+  Tag() : value(N) {}
+};
+
+/// GetTags - get Tag<0> to Tag<N - 1> from pContext and check their values
+template <int N>
+struct GetTags {
+  static bool check(LinkContext& pContext) {
+    return GetTags<N - 1>::check(pContext) &&
+           pContext.get<Tag<N - 1> >().value == N - 1;
+  }
+};
+
+template <>
+struct GetTags<0> {
+  static bool check(LinkContext& pContext) { return true; }
+};
+
+typedef std::chrono::steady_clock Clock;
+
+void PrintBench(const char* pName, Clock::time_point pStart, size_t pNum) {
+  double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - pStart).count();
+  llvm::outs() << llvm::format("  %-40s %8.2f ns/object\n", pName, ns / pNum);
+}
+
+bool IsAligned(void* pPtr, size_t pAlign) {
+  return (reinterpret_cast<size_t>(pPtr) & (pAlign - 1)) == 0;
+}
+
+}  // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+ArenaTest::ArenaTest() : m_pContext(NULL) {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ArenaTest::~ArenaTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void ArenaTest::SetUp() {
+  m_pContext = new LinkContext();
+}
+
+// TearDown() will be called immediately after each test.
+void ArenaTest::TearDown() {
+  delete m_pContext;
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(ArenaTest, alignment) {
+  Arena arena;
+  for (size_t align = 1; align <= 64; align *= 2) {
+    char* x = static_cast<char*>(arena.allocate(3, align));
+    char* y = static_cast<char*>(arena.allocate(1, align));
+    ASSERT_TRUE(IsAligned(x, align));
+    ASSERT_TRUE(IsAligned(y, align));
+    ASSERT_TRUE(y >= x + 3);
+  }
+  ASSERT_TRUE(IsAligned(arena.allocate<double>(3), alignof(double)));
+  ASSERT_TRUE(1 == arena.numOfSlabs());
+}
+
+TEST_F(ArenaTest, geometric_slabs) {
+  Arena::Policy policy = {4096, 16384, false};
+  Arena arena(policy);
+  // slabs of 4K, 8K, 16K, 16K, ... at least
+  size_t total = 0;
+  while (arena.numOfSlabs() < 4) {
+    arena.allocate(512);
+    total += 512;
+  }
+  ASSERT_TRUE(total > 4096 + 8192 + 16384);
+  ASSERT_TRUE(arena.bytesReserved() >= 4096 + 8192 + 16384 + 16384);
+  ASSERT_TRUE(total == arena.bytesAllocated());
+}
+
+TEST_F(ArenaTest, large_allocation) {
+  Arena::Policy policy = {4096, 4096, false};
+  Arena arena(policy);
+  char* small = static_cast<char*>(arena.allocate(16));
+  char* large = static_cast<char*>(arena.allocate(100000));
+  ASSERT_TRUE(2 == arena.numOfSlabs());
+  large[99999] = 1;
+  // the slab of the thread is kept
+  char* next = static_cast<char*>(arena.allocate(16));
+  ASSERT_TRUE(small + 16 == next);
+  ASSERT_TRUE(2 == arena.numOfSlabs());
+}
+
+TEST_F(ArenaTest, reset) {
+  Arena arena;
+  arena.allocate(100);
+  arena.reset();
+  ASSERT_TRUE(0 == arena.numOfSlabs());
+  ASSERT_TRUE(0 == arena.bytesAllocated());
+  int* value = arena.allocate<int>(1);
+  *value = 3;
+  ASSERT_TRUE(1 == arena.numOfSlabs());
+}
+
+TEST_F(ArenaTest, many_arenas) {
+  // more arenas than the bump pointers a thread caches
+  std::vector<Arena*> arenas;
+  for (int i = 0; i < 20; ++i)
+    arenas.push_back(new Arena());
+  for (int round = 0; round < 100; ++round) {
+    for (size_t i = 0; i < arenas.size(); ++i)
+      *arenas[i]->allocate<int>(1) = round;
+  }
+  for (size_t i = 0; i < arenas.size(); ++i) {
+    ASSERT_TRUE(1 == arenas[i]->numOfSlabs());
+    ASSERT_TRUE(100 * sizeof(int) == arenas[i]->bytesAllocated());
+    delete arenas[i];
+  }
+}
+
+TEST_F(ArenaTest, threads) {
+  Arena::Policy policy = {4096, 65536, false};
+  Arena arena(policy);
+  const size_t num = 10000;
+  std::vector<std::vector<int*> > values(4);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < values.size(); ++t) {
+    threads.push_back(std::thread([&arena, &values, t, num]() {
+      for (size_t i = 0; i < num; ++i) {
+        int* value = arena.allocate<int>(1);
+        *value = t;
+        values[t].push_back(value);
+      }
+    }));
+  }
+  for (size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+
+  // no two threads got the same memory
+  for (size_t t = 0; t < values.size(); ++t) {
+    for (size_t i = 0; i < num; ++i)
+      ASSERT_TRUE(static_cast<int>(t) == *values[t][i]);
+  }
+  ASSERT_TRUE(4 * num * sizeof(int) == arena.bytesAllocated());
+}
+
+TEST_F(ArenaTest, factory_chunks) {
+  LinkContext::Scope scope(*m_pContext);
+  ArenaGCFactory<int, 4> factory;
+  for (int i = 0; i < 100; ++i)
+    *factory.allocate() = i;
+
+  // chunks of 4, 8, 16, 32 and 64
+  AllocatorUsage usage = {factory.allocatorName(), 0, 1, 0, 0, 0};
+  factory.getUsage(usage);
+  ASSERT_TRUE(5 == usage.chunks);
+  ASSERT_TRUE(124 == usage.capacity);
+  ASSERT_TRUE(100 == factory.size());
+
+  int expect = 0;
+  ArenaGCFactory<int, 4>::iterator it, itEnd = factory.end();
+  for (it = factory.begin(); it != itEnd; ++it)
+    ASSERT_TRUE(expect++ == *it);
+  ASSERT_TRUE(100 == expect);
+
+  // more than a chunk at once
+  int* many = factory.allocate(1000);
+  ASSERT_FALSE(NULL == many);
+  ASSERT_TRUE(1100 == factory.size());
+}
+
+TEST_F(ArenaTest, factory_deallocate) {
+  LinkContext::Scope scope(*m_pContext);
+  ArenaGCFactory<int, 4> factory;
+  int* first = factory.allocate();
+  int* second = factory.allocate();
+  factory.deallocate(first);
+  ASSERT_FALSE(NULL == first);
+  factory.deallocate(second);
+  ASSERT_TRUE(NULL == second);
+  ASSERT_TRUE(1 == factory.size());
+  ASSERT_TRUE(first + 1 == factory.allocate());
+}
+
+TEST_F(ArenaTest, factory_clear_reuses_chunks) {
+  LinkContext::Scope scope(*m_pContext);
+  ArenaGCFactory<int, 4> factory;
+  factory.allocate(100);
+  uint64_t allocated = Arena::current().bytesAllocated();
+  factory.clear();
+  ASSERT_TRUE(factory.empty());
+  factory.allocate(50);
+  factory.allocate(50);
+  ASSERT_TRUE(allocated == Arena::current().bytesAllocated());
+}
+
+TEST_F(ArenaTest, factory_destructs_objects) {
+  LinkContext::Scope scope(*m_pContext);
+  Counted::destructed = 0;
+  {
+    ArenaGCFactory<Counted, 4> factory;
+    for (int i = 0; i < 10; ++i)
+      new (factory.allocate()) Counted();
+    factory.clear();
+    ASSERT_TRUE(10 == Counted::destructed);
+
+    for (int i = 0; i < 7; ++i)
+      new (factory.allocate()) Counted();
+  }
+  // the factory destructs what it holds when it goes away
+  ASSERT_TRUE(17 == Counted::destructed);
+
+  // and so does the link context, with the factories it owns
+  typedef ArenaGCFactory<Counted, 4> CountedFactory;
+  LinkContext* context = new LinkContext();
+  {
+    LinkContext::Scope inner(*context);
+    for (int i = 0; i < 5; ++i)
+      new (context->get<CountedFactory>().allocate()) Counted();
+  }
+  delete context;
+  ASSERT_TRUE(22 == Counted::destructed);
+}
+
+TEST_F(ArenaTest, context_get_from_workers) {
+  LinkContext::Scope scope(*m_pContext);
+  std::vector<void*> arenas(64), first(64), second(64);
+  parallel::forEach(8, 64, 8, [&](size_t pIdx) {
+    arenas[pIdx] = &Arena::current();
+    first[pIdx] = &LinkContext::current().get<Slow<0> >();
+    second[pIdx] = &LinkContext::current().get<Slow<1> >();
+  });
+
+  // every worker got the objects of the caller's context, created once
+  ASSERT_TRUE(1 == Slow<0>::constructed);
+  ASSERT_TRUE(1 == Slow<1>::constructed);
+  for (size_t i = 0; i < 64; ++i) {
+    ASSERT_TRUE(&m_pContext->get<Arena>() == arenas[i]);
+    ASSERT_TRUE(&m_pContext->get<Slow<0> >() == first[i]);
+    ASSERT_TRUE(&m_pContext->get<Slow<1> >() == second[i]);
+  }
+}
+
+TEST_F(ArenaTest, context_many_types) {
+  // more types than one block of slots holds
+  ASSERT_TRUE(GetTags<200>::check(*m_pContext));
+  ASSERT_TRUE(GetTags<200>::check(*m_pContext));
+}
+
+TEST_F(ArenaTest, bench_single_thread) {
+  LinkContext::Scope scope(*m_pContext);
+  llvm::outs() << "allocating " << kBenchObjects << " objects of "
+               << sizeof(Object) << " bytes:\n";
+
+  Clock::time_point start = Clock::now();
+  {
+    std::vector<Object*> objects(kBenchObjects);
+    for (size_t i = 0; i < kBenchObjects; ++i)
+      objects[i] = static_cast<Object*>(std::malloc(sizeof(Object)));
+    for (size_t i = 0; i < kBenchObjects; ++i)
+      std::free(objects[i]);
+  }
+  PrintBench("malloc and free", start, kBenchObjects);
+
+  start = Clock::now();
+  {
+    GCFactory<Object, 1024> factory;
+    for (size_t i = 0; i < kBenchObjects; ++i)
+      factory.allocate();
+  }
+  PrintBench("GCFactory (LinearAllocator, 1024)", start, kBenchObjects);
+
+  start = Clock::now();
+  {
+    ArenaGCFactory<Object, 1024> factory;
+    for (size_t i = 0; i < kBenchObjects; ++i)
+      factory.allocate();
+  }
+  PrintBench("ArenaGCFactory (from 1024)", start, kBenchObjects);
+
+  start = Clock::now();
+  {
+    Arena arena;
+    for (size_t i = 0; i < kBenchObjects; ++i)
+      arena.allocate<Object>(1);
+  }
+  PrintBench("Arena", start, kBenchObjects);
+}
+
+TEST_F(ArenaTest, bench_threads) {
+  const unsigned num_threads = 4;
+  const size_t num = kBenchObjects / num_threads;
+  llvm::outs() << "allocating " << kBenchObjects << " objects on "
+               << num_threads << " threads:\n";
+
+  Clock::time_point start = Clock::now();
+  {
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; ++t) {
+      threads.push_back(std::thread([num]() {
+        std::vector<Object*> objects(num);
+        for (size_t i = 0; i < num; ++i)
+          objects[i] = static_cast<Object*>(std::malloc(sizeof(Object)));
+        for (size_t i = 0; i < num; ++i)
+          std::free(objects[i]);
+      }));
+    }
+    for (unsigned t = 0; t < num_threads; ++t)
+      threads[t].join();
+  }
+  PrintBench("malloc and free", start, kBenchObjects);
+
+  start = Clock::now();
+  {
+    Arena arena;
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < num_threads; ++t) {
+      threads.push_back(std::thread([&arena, num]() {
+        for (size_t i = 0; i < num; ++i)
+          arena.allocate<Object>(1);
+      }));
+    }
+    for (unsigned t = 0; t < num_threads; ++t)
+      threads[t].join();
+    ASSERT_TRUE(kBenchObjects * sizeof(Object) == arena.bytesAllocated());
+  }
+  PrintBench("Arena", start, kBenchObjects);
+}
@@ -0,0 +1,46 @@
+//===- ArenaTest.h --------------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_ARENA_TEST_H
+#define MCLD_ARENA_TEST_H
+
+#include <gtest.h>
+
+namespace mcld {
+class LinkContext;
+}  // namespace for mcld
+
+namespace mcldtest {
+
+/** \class ArenaTest
+ *  \brief The testcase of Arena and ArenaAllocator. The bench_* cases print
+ *  how long allocating takes with each allocator.
+ *
+ *  \see Arena
+ */
+class ArenaTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  ArenaTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~ArenaTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  mcld::LinkContext* m_pContext;
+};
+
+}  // namespace of mcldtest
+
+#endif
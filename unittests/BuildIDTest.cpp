@@ -0,0 +1,98 @@
+//===- BuildIDTest.cpp ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "BuildIDTest.h"
+#include "mcld/LD/BuildID.h"
+#include "mcld/Support/Digest.h"
+
+#include <cstring>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+BuildIDTest::BuildIDTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+BuildIDTest::~BuildIDTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void BuildIDTest::SetUp() {
+  // 1000 chunks of 64 bytes and a partial one
+  m_Data.resize(64 * 1000 + 13);
+  for (size_t i = 0; i < m_Data.size(); ++i)
+    m_Data[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+}
+
+// TearDown() will be called immediately after each test.
+void BuildIDTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(BuildIDTest, digest_size) {
+  ASSERT_TRUE(8 == BuildID::getDigestSize(BuildID::Style::Fast));
+  ASSERT_TRUE(16 == BuildID::getDigestSize(BuildID::Style::MD5));
+  ASSERT_TRUE(20 == BuildID::getDigestSize(BuildID::Style::SHA1));
+  ASSERT_TRUE(16 == BuildID::getDigestSize(BuildID::Style::UUID));
+}
+
+TEST_F(BuildIDTest, same_for_any_threads) {
+  BuildID::Style styles[] = {
+      BuildID::Style::Fast, BuildID::Style::MD5, BuildID::Style::SHA1};
+  for (size_t s = 0; s < 3; ++s) {
+    uint8_t serial[20], parallel[20];
+    BuildID::computeTreeHash(styles[s], m_Data, 64, 1, serial);
+    for (unsigned threads = 2; threads <= 8; threads *= 2) {
+      BuildID::computeTreeHash(styles[s], m_Data, 64, threads, parallel);
+      ASSERT_TRUE(0 == std::memcmp(serial, parallel,
+                                   BuildID::getDigestSize(styles[s])));
+    }
+  }
+}
+
+TEST_F(BuildIDTest, content_change) {
+  uint8_t before[20], after[20];
+  BuildID::computeTreeHash(BuildID::Style::SHA1, m_Data, 64, 4, before);
+  m_Data[64 * 500 + 3] ^= 0x1;
+  BuildID::computeTreeHash(BuildID::Style::SHA1, m_Data, 64, 4, after);
+  ASSERT_FALSE(0 == std::memcmp(before, after, 20));
+}
+
+TEST_F(BuildIDTest, xxhash64) {
+  const uint8_t abc[] = {'a', 'b', 'c'};
+  ASSERT_TRUE(0xef46db3751d8e999ULL ==
+              digest::xxHash64(llvm::ArrayRef<uint8_t>()));
+  ASSERT_TRUE(0x44bc2cf5ad770999ULL == digest::xxHash64(abc));
+  // long enough for the 32-byte stripes and every tail
+  ASSERT_TRUE(0x6e866190a0050089ULL == digest::xxHash64(m_Data));
+}
+
+TEST_F(BuildIDTest, sha1) {
+  const uint8_t expect_abc[] = {0xa9, 0x99, 0x3e, 0x36, 0x47, 0x06, 0x81,
+                                0x6a, 0xba, 0x3e, 0x25, 0x71, 0x78, 0x50,
+                                0xc2, 0x6c, 0x9c, 0xd0, 0xd8, 0x9d};
+  const uint8_t abc[] = {'a', 'b', 'c'};
+  uint8_t result[digest::kSHA1Size];
+  digest::SHA1(abc, result);
+  ASSERT_TRUE(0 == std::memcmp(expect_abc, result, sizeof(result)));
+
+  // 56 bytes need a second block for the length
+  const char* two_blocks =
+      "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+  const uint8_t expect_two_blocks[] = {0x84, 0x98, 0x3e, 0x44, 0x1c, 0x3b, 0xd2,
+                                       0x6e, 0xba, 0xae, 0x4a, 0xa1, 0xf9, 0x51,
+                                       0x29, 0xe5, 0xe5, 0x46, 0x70, 0xf1};
+  digest::SHA1(llvm::ArrayRef<uint8_t>(
+                   reinterpret_cast<const uint8_t*>(two_blocks), 56),
+               result);
+  ASSERT_TRUE(0 == std::memcmp(expect_two_blocks, result, sizeof(result)));
+}
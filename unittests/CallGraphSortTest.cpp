@@ -0,0 +1,103 @@
+//===- CallGraphSortTest.cpp ----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "CallGraphSortTest.h"
+#include "mcld/LD/CallGraphSort.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+CallGraphSortTest::CallGraphSortTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+CallGraphSortTest::~CallGraphSortTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void CallGraphSortTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void CallGraphSortTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(CallGraphSortTest, hot_pair_first) {
+  CallGraphSort sorter(4096);
+  unsigned int cold = sorter.addNode(100);
+  unsigned int c = sorter.addNode(100);
+  unsigned int d = sorter.addNode(100);
+  unsigned int a = sorter.addNode(100);
+  unsigned int b = sorter.addNode(100);
+  sorter.addEdge(a, b, 1000);
+  sorter.addEdge(c, d, 10);
+
+  std::vector<unsigned int> order;
+  sorter.sort(order);
+  unsigned int expected[] = {a, b, c, d, cold};
+  ASSERT_TRUE(order == std::vector<unsigned int>(expected, expected + 5));
+}
+
+TEST_F(CallGraphSortTest, chain) {
+  CallGraphSort sorter(4096);
+  unsigned int a = sorter.addNode(64);
+  unsigned int b = sorter.addNode(64);
+  unsigned int c = sorter.addNode(64);
+  sorter.addEdge(b, c, 50);
+  sorter.addEdge(a, b, 100);
+
+  std::vector<unsigned int> order;
+  sorter.sort(order);
+  unsigned int expected[] = {a, b, c};
+  ASSERT_TRUE(order == std::vector<unsigned int>(expected, expected + 3));
+}
+
+TEST_F(CallGraphSortTest, cluster_size_limit) {
+  // the pair does not fit in a page, so the callee goes first by itself
+  CallGraphSort sorter(4096);
+  unsigned int a = sorter.addNode(3000);
+  unsigned int b = sorter.addNode(3000);
+  sorter.addEdge(a, b, 1000);
+
+  std::vector<unsigned int> order;
+  sorter.sort(order);
+  ASSERT_EQ(2U, order.size());
+  ASSERT_EQ(b, order[0]);
+  ASSERT_EQ(a, order[1]);
+}
+
+TEST_F(CallGraphSortTest, every_node_once) {
+  CallGraphSort sorter(4096);
+  const unsigned int num = 5000;
+  uint32_t seed = 1;
+  for (unsigned int i = 0; i < num; ++i) {
+    seed = seed * 1103515245 + 12345;
+    sorter.addNode(16 + (seed >> 16) % 1024);
+  }
+  for (unsigned int i = 0; i < num * 4; ++i) {
+    seed = seed * 1103515245 + 12345;
+    unsigned int from = (seed >> 8) % num;
+    seed = seed * 1103515245 + 12345;
+    unsigned int to = (seed >> 8) % num;
+    sorter.addEdge(from, to, 1 + (seed >> 20) % 100);
+  }
+
+  std::vector<unsigned int> order;
+  sorter.sort(order);
+  ASSERT_EQ(num, order.size());
+  std::sort(order.begin(), order.end());
+  for (unsigned int i = 0; i < num; ++i)
+    ASSERT_EQ(i, order[i]);
+}
@@ -0,0 +1,38 @@
+//===- CallGraphSortTest.h ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_CALLGRAPHSORT_TEST_H
+#define MCLD_CALLGRAPHSORT_TEST_H
+
+#include <gtest.h>
+
+namespace mcldtest {
+
+/** \class CallGraphSortTest
+ *  \brief The testcase of CallGraphSort
+ *
+ *  \see CallGraphSort
+ */
+class CallGraphSortTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  CallGraphSortTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~CallGraphSortTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -0,0 +1,71 @@
+//===- CompressionTest.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "CompressionTest.h"
+#include "mcld/Support/Compression.h"
+
+#include <cstring>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+CompressionTest::CompressionTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+CompressionTest::~CompressionTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void CompressionTest::SetUp() {
+  // more than three chunks of 1 MiB, compressible but not trivially
+  m_Data.resize(3 * 1024 * 1024 + 4097);
+  for (size_t i = 0; i < m_Data.size(); ++i)
+    m_Data[i] = static_cast<uint8_t>((i % 251) ^ (i >> 12));
+}
+
+// TearDown() will be called immediately after each test.
+void CompressionTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(CompressionTest, round_trip) {
+  std::vector<uint8_t> deflated;
+  zlib::compress(m_Data, 4, deflated);
+  ASSERT_TRUE(deflated.size() < m_Data.size());
+
+  std::vector<uint8_t> inflated(m_Data.size());
+  ASSERT_TRUE(zlib::uncompress(deflated, inflated.data(), inflated.size()));
+  ASSERT_TRUE(inflated == m_Data);
+}
+
+TEST_F(CompressionTest, small_input) {
+  const uint8_t text[] = "abcabcabcabcabcabcabcabc";
+  std::vector<uint8_t> deflated;
+  zlib::compress(llvm::ArrayRef<uint8_t>(text, sizeof(text)), 4, deflated);
+
+  uint8_t inflated[sizeof(text)];
+  ASSERT_TRUE(zlib::uncompress(deflated, inflated, sizeof(inflated)));
+  ASSERT_TRUE(0 == std::memcmp(text, inflated, sizeof(text)));
+
+  // the size must match exactly
+  ASSERT_FALSE(zlib::uncompress(deflated, inflated, sizeof(inflated) - 1));
+}
+
+TEST_F(CompressionTest, same_for_any_threads) {
+  std::vector<uint8_t> serial;
+  zlib::compress(m_Data, 1, serial);
+  for (unsigned threads = 2; threads <= 8; threads *= 2) {
+    std::vector<uint8_t> parallel;
+    zlib::compress(m_Data, threads, parallel);
+    ASSERT_TRUE(serial == parallel);
+  }
+}
@@ -0,0 +1,45 @@
+//===- CompressionTest.h --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_COMPRESSION_TEST_H
+#define MCLD_COMPRESSION_TEST_H
+
+#include <gtest.h>
+
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcldtest {
+
+/** \class CompressionTest
+ *  \brief The testcase of zlib compression
+ *
+ *  \see Compression
+ */
+class CompressionTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  CompressionTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~CompressionTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  std::vector<uint8_t> m_Data;
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -12,7 +12,9 @@
 #include "mcld/TargetOptions.h"
 #include "mcld/LD/ELFReader.h"
 #include "mcld/LD/LDContext.h"
+#include "mcld/LD/ParsedInput.h"
 #include "mcld/MC/Input.h"
+#include "mcld/Support/InputCache.h"
 #include "mcld/Support/Path.h"
 #include "mcld/Support/MemoryArea.h"
 #include <../lib/Target/X86/X86LDBackend.h>
@@ -152,3 +154,53 @@ TEST_F(ELFReaderTest, is_my_format) {
   bool doContinue;
   ASSERT_TRUE(m_pELFObjReader->isMyFormat(*m_pInput, doContinue));
 }
+
+TEST_F(ELFReaderTest, read_parsed_tables) {
+  // the same file under another name, so that it gets a MemoryArea of its own
+  Path path(TOPDIR);
+  path.append("unittests/./test_x86_64.o");
+
+  InputCache cache(1024 * 1024);
+  InputCache::Mapping mapping;
+  size_t size = 0;
+  ASSERT_TRUE(cache.acquire(path.native(), false, mapping, size));
+  InputCache::Parsed parsed(new ParsedInput(mapping.get(), size));
+  ASSERT_TRUE(cache.setParsed(path.native(), mapping, parsed));
+
+  InputCache::setShared(&cache);
+  Input* input = m_pIRBuilder->ReadInput("test_x86_64_parsed", path);
+  InputCache::setShared(NULL);
+  ASSERT_TRUE(NULL != input);
+  ASSERT_TRUE(parsed.get() == input->memArea()->parsed());
+  ASSERT_TRUE(NULL != ELFReaderIF::getParsed(*input));
+
+  // the sections created from the parsed table are those read from the file
+  llvm::StringRef region = input->memArea()->request(
+      input->fileOffset(), m_pELFReader->getELFHeaderSize());
+  ASSERT_TRUE(m_pELFReader->readSectionHeaders(*input, region.begin()));
+  ASSERT_EQ(m_pInput->context()->numOfSections(),
+            input->context()->numOfSections());
+  for (unsigned i = 0; i < input->context()->numOfSections(); ++i) {
+    const LDSection* expected = m_pInput->context()->getSection(i);
+    const LDSection* section = input->context()->getSection(i);
+    ASSERT_EQ(expected->name(), section->name());
+    ASSERT_EQ(expected->kind(), section->kind());
+    ASSERT_EQ(expected->type(), section->type());
+    ASSERT_EQ(expected->flag(), section->flag());
+    ASSERT_EQ(expected->offset(), section->offset());
+    ASSERT_EQ(expected->size(), section->size());
+    ASSERT_EQ(expected->align(), section->align());
+    ASSERT_EQ(expected->getInfo(), section->getInfo());
+    ASSERT_EQ(expected->getLink() == NULL, section->getLink() == NULL);
+    if (expected->getLink() != NULL)
+      ASSERT_EQ(expected->getLink()->name(), section->getLink()->name());
+  }
+
+  // the symbols come from the parsed table, the names from .strtab
+  input->setType(Input::Object);
+  ASSERT_TRUE(m_pELFObjReader->readSymbols(*input));
+  ASSERT_EQ("hello.c", std::string(input->context()->getSymbol(1)->name()));
+  ASSERT_EQ("main", std::string(input->context()->getSymbol(9)->name()));
+  ASSERT_EQ("puts", std::string(input->context()->getSymbol(10)->name()));
+  ASSERT_TRUE(NULL == input->context()->getSymbol(11));
+}
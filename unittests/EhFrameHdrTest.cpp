@@ -0,0 +1,93 @@
+//===- EhFrameHdrTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "EhFrameHdrTest.h"
+#include "mcld/LD/EhFrameHdr.h"
+
+#include <algorithm>
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+bool lessByHighWord(uint64_t pLHS, uint64_t pRHS) {
+  return (pLHS >> 32) < (pRHS >> 32);
+}
+
+}  // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+EhFrameHdrTest::EhFrameHdrTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+EhFrameHdrTest::~EhFrameHdrTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void EhFrameHdrTest::SetUp() {
+  // enough entries for several chunks, with many equal keys so that the
+  // order of the low words shows whether the sort is stable
+  m_Entries.resize(50000);
+  uint32_t seed = 12345;
+  for (size_t i = 0; i < m_Entries.size(); ++i) {
+    seed = seed * 1103515245u + 12345u;
+    uint32_t key = (seed >> 8) % 4096;
+    m_Entries[i] = (static_cast<uint64_t>(key) << 32) | i;
+  }
+}
+
+// TearDown() will be called immediately after each test.
+void EhFrameHdrTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(EhFrameHdrTest, radix_sort_is_stable_sort) {
+  std::vector<uint64_t> expected = m_Entries;
+  std::stable_sort(expected.begin(), expected.end(), lessByHighWord);
+
+  for (unsigned threads = 1; threads <= 8; threads *= 2) {
+    std::vector<uint64_t> entries = m_Entries;
+    std::vector<uint64_t> buffer(entries.size());
+    EhFrameHdr::radixSort(entries, buffer, threads);
+    ASSERT_TRUE(expected == entries);
+  }
+}
+
+TEST_F(EhFrameHdrTest, radix_sort_full_keys) {
+  // keys that differ in every byte, including the skipped-when-equal ones
+  for (size_t i = 0; i < m_Entries.size(); ++i)
+    m_Entries[i] ^= static_cast<uint64_t>(i * 2654435761u) << 32;
+
+  std::vector<uint64_t> expected = m_Entries;
+  std::stable_sort(expected.begin(), expected.end(), lessByHighWord);
+
+  std::vector<uint64_t> buffer(m_Entries.size());
+  EhFrameHdr::radixSort(m_Entries, buffer, 4);
+  ASSERT_TRUE(expected == m_Entries);
+}
+
+TEST_F(EhFrameHdrTest, radix_sort_small) {
+  std::vector<uint64_t> entries;
+  entries.push_back(UINT64_C(0x0000000300000000));
+  entries.push_back(UINT64_C(0x0000000100000001));
+  entries.push_back(UINT64_C(0x0000000300000002));
+  entries.push_back(UINT64_C(0x8000000000000003));
+  entries.push_back(UINT64_C(0x0000000100000004));
+
+  std::vector<uint64_t> buffer(entries.size());
+  EhFrameHdr::radixSort(entries, buffer, 4);
+  ASSERT_TRUE(UINT64_C(0x0000000100000001) == entries[0]);
+  ASSERT_TRUE(UINT64_C(0x0000000100000004) == entries[1]);
+  ASSERT_TRUE(UINT64_C(0x0000000300000000) == entries[2]);
+  ASSERT_TRUE(UINT64_C(0x0000000300000002) == entries[3]);
+  ASSERT_TRUE(UINT64_C(0x8000000000000003) == entries[4]);
+}
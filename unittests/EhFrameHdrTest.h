@@ -0,0 +1,45 @@
+//===- EhFrameHdrTest.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_EHFRAMEHDR_TEST_H
+#define MCLD_EHFRAMEHDR_TEST_H
+
+#include <gtest.h>
+
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcldtest {
+
+/** \class EhFrameHdrTest
+ *  \brief The testcase of the .eh_frame_hdr search table
+ *
+ *  \see EhFrameHdr
+ */
+class EhFrameHdrTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  EhFrameHdrTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~EhFrameHdrTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  std::vector<uint64_t> m_Entries;
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -0,0 +1,163 @@
+//===- HexagonEncodingTableTest.cpp ---------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "HexagonEncodingTableTest.h"
+#include <../lib/Target/Hexagon/HexagonEncodingTable.h>
+
+#include <llvm/Support/Format.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <chrono>
+#include <vector>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+HexagonEncodingTableTest::HexagonEncodingTableTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+HexagonEncodingTableTest::~HexagonEncodingTableTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void HexagonEncodingTableTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void HexagonEncodingTableTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+namespace {
+
+/// the linear scan of the encoding table that HexagonRelocator used to do
+const Instruction* linearLookUp(const HexagonEncodingTable& pTable,
+                                uint32_t pInsn) {
+  for (size_t i = 0; i < pTable.size(); ++i) {
+    const Instruction& encoding = pTable.getEncoding(i);
+    if (((pInsn & 0xc000) == 0) && !encoding.isDuplex)
+      continue;
+    if (((pInsn & 0xc000) != 0) && encoding.isDuplex)
+      continue;
+    if ((encoding.insnMask & pInsn) == encoding.insnCmpMask)
+      return &encoding;
+  }
+  return NULL;
+}
+
+/// the number of times the benchmarks decode every instruction word
+const unsigned kBenchRounds = 200;
+
+typedef std::chrono::steady_clock Clock;
+
+void PrintBench(const char* pName, Clock::time_point pStart, size_t pNum) {
+  double ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  Clock::now() - pStart).count();
+  llvm::outs() << llvm::format("  %-40s %8.2f ns/lookup\n", pName, ns / pNum);
+}
+
+/// one word per encoding, the fixed bits with the parse bits the entry needs
+std::vector<uint32_t> benchWords(const HexagonEncodingTable& pTable) {
+  std::vector<uint32_t> words(pTable.size());
+  for (size_t i = 0; i < pTable.size(); ++i) {
+    const Instruction& encoding = pTable.getEncoding(i);
+    words[i] = encoding.insnCmpMask;
+    if (!encoding.isDuplex && (words[i] & 0xc000) == 0)
+      words[i] |= 0xc000 & ~encoding.insnMask;
+  }
+  return words;
+}
+
+}  // anonymous namespace
+
+TEST_F(HexagonEncodingTableTest, same_as_linear_scan) {
+  const HexagonEncodingTable& table = HexagonEncodingTable::instance();
+  ASSERT_TRUE(table.size() > 0);
+
+  const uint32_t parse_bits[] = {0x0, 0x4000, 0x8000, 0xc000};
+  unsigned int found = 0;
+  for (size_t i = 0; i < table.size(); ++i) {
+    const Instruction& encoding = table.getEncoding(i);
+    for (unsigned p = 0; p < 4; ++p) {
+      // the fixed bits only, and with every free bit set
+      uint32_t insns[] = {encoding.insnCmpMask,
+                          encoding.insnCmpMask | ~encoding.insnMask};
+      for (unsigned j = 0; j < 2; ++j) {
+        uint32_t insn = (insns[j] & ~0xc000u) | parse_bits[p];
+        const Instruction* expected = linearLookUp(table, insn);
+        ASSERT_TRUE(expected == table.lookUp(insn));
+        if (expected != NULL)
+          ++found;
+      }
+    }
+  }
+  // every entry is reachable with its own parse bits
+  ASSERT_TRUE(found >= table.size());
+}
+
+TEST_F(HexagonEncodingTableTest, own_mask) {
+  const HexagonEncodingTable& table = HexagonEncodingTable::instance();
+  for (size_t i = 0; i < table.size(); ++i) {
+    const Instruction& encoding = table.getEncoding(i);
+    uint32_t insn = encoding.insnCmpMask;
+    if (!encoding.isDuplex && (insn & 0xc000) == 0)
+      insn |= 0xc000 & ~encoding.insnMask;
+    const Instruction* expected = linearLookUp(table, insn);
+    const Instruction* result = table.lookUp(insn);
+    ASSERT_TRUE(result == expected);
+    if (result != NULL) {
+      ASSERT_EQ(expected->insnBitMask, result->insnBitMask);
+    }
+  }
+}
+
+TEST_F(HexagonEncodingTableTest, random_words) {
+  const HexagonEncodingTable& table = HexagonEncodingTable::instance();
+  uint32_t seed = 0x12345678;
+  for (unsigned i = 0; i < 100000; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    ASSERT_TRUE(linearLookUp(table, seed) == table.lookUp(seed));
+  }
+}
+
+TEST_F(HexagonEncodingTableTest, bench_lookup) {
+  const HexagonEncodingTable& table = HexagonEncodingTable::instance();
+  std::vector<uint32_t> words = benchWords(table);
+  size_t num = words.size() * kBenchRounds;
+  llvm::outs() << "decoding " << num << " words over " << table.size()
+               << " encodings:\n";
+
+  // sum the bit masks so that the lookups cannot be optimized away
+  uint32_t linear = 0;
+  Clock::time_point start = Clock::now();
+  for (unsigned r = 0; r < kBenchRounds; ++r) {
+    for (size_t i = 0; i < words.size(); ++i) {
+      const Instruction* encoding = linearLookUp(table, words[i]);
+      if (encoding != NULL)
+        linear += encoding->insnBitMask;
+    }
+  }
+  PrintBench("linear scan", start, num);
+
+  uint32_t bucketed = 0;
+  start = Clock::now();
+  for (unsigned r = 0; r < kBenchRounds; ++r) {
+    for (size_t i = 0; i < words.size(); ++i) {
+      const Instruction* encoding = table.lookUp(words[i]);
+      if (encoding != NULL)
+        bucketed += encoding->insnBitMask;
+    }
+  }
+  PrintBench("HexagonEncodingTable::lookUp", start, num);
+
+  ASSERT_TRUE(linear == bucketed);
+}
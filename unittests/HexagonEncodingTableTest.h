@@ -0,0 +1,38 @@
+//===- HexagonEncodingTableTest.h -----------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_HEXAGONENCODINGTABLE_TEST_H
+#define MCLD_HEXAGONENCODINGTABLE_TEST_H
+
+#include <gtest.h>
+
+namespace mcldtest {
+
+/** \class HexagonEncodingTableTest
+ *  \brief The testcase of HexagonEncodingTable
+ *
+ *  \see HexagonEncodingTable
+ */
+class HexagonEncodingTableTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  HexagonEncodingTableTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~HexagonEncodingTableTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -0,0 +1,132 @@
+//===- IncrementalStateTest.cpp -------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "IncrementalStateTest.h"
+#include "mcld/Object/IncrementalState.h"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+IncrementalStateTest::IncrementalStateTest() : m_pTestee(NULL) {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+IncrementalStateTest::~IncrementalStateTest() {
+  delete m_pTestee;
+}
+
+// SetUp() will be called immediately before each test.
+void IncrementalStateTest::SetUp() {
+  m_Path = "IncrementalStateTest.tmp";
+  std::remove(m_Path.c_str());
+  m_pTestee = new IncrementalState();
+}
+
+// TearDown() will be called immediately after each test.
+void IncrementalStateTest::TearDown() {
+  std::remove(m_Path.c_str());
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(IncrementalStateTest, round_trip) {
+  m_pTestee->setKey(IncrementalState::digest("-o\0a.out\0main.o"));
+  m_pTestee->setCodePosition(2);
+  m_pTestee->setSymTabOffset(0x2040);
+
+  IncrementalState::FileIdentity output = {1, 2, 4096, 123456789};
+  m_pTestee->setOutput(output);
+
+  IncrementalState::File file = {"/usr/lib/libc.a", {1, 3, 100, 7}};
+  m_pTestee->files().push_back(file);
+
+  IncrementalState::Object object;
+  object.path = "dir with space/main.o";
+  object.identity = output;
+  object.symbolDigest = 0xfedcba9876543210ULL;
+  IncrementalState::Section text = {IncrementalState::Section::Patch,
+                                    1, 6, 16, 0, 0x40, 0x10, true,
+                                    0x401000, 0x1000, 0, ".text"};
+  IncrementalState::Section rela = {IncrementalState::Section::Relocs,
+                                    4, 0x40, 8, 1, 0x18, 0, false,
+                                    0, 0, 0, ".rela.text"};
+  object.sections.push_back(text);
+  object.sections.push_back(rela);
+  IncrementalState::Symbol sym = {8, 5};
+  IncrementalState::Symbol global = {0, IncrementalState::Symbol::Fixed};
+  object.symbols.push_back(sym);
+  object.symbols.push_back(global);
+  m_pTestee->objects().push_back(object);
+
+  IncrementalState::Global main = {true, true, 0x401000};
+  m_pTestee->globals()["main"] = main;
+
+  ASSERT_TRUE(m_pTestee->write(m_Path));
+
+  IncrementalState state;
+  ASSERT_TRUE(state.read(m_Path));
+  ASSERT_TRUE(m_pTestee->key() == state.key());
+  ASSERT_TRUE(2 == state.codePosition());
+  ASSERT_TRUE(0x2040 == state.symtabOffset());
+  ASSERT_TRUE(output == state.output());
+
+  ASSERT_TRUE(1 == state.files().size());
+  ASSERT_TRUE("/usr/lib/libc.a" == state.files()[0].path);
+  ASSERT_TRUE(file.identity == state.files()[0].identity);
+
+  ASSERT_TRUE(1 == state.objects().size());
+  const IncrementalState::Object& read = state.objects()[0];
+  ASSERT_TRUE("dir with space/main.o" == read.path);
+  ASSERT_TRUE(0xfedcba9876543210ULL == read.symbolDigest);
+  ASSERT_TRUE(2 == read.sections.size());
+  ASSERT_TRUE(IncrementalState::Section::Patch == read.sections[0].mode);
+  ASSERT_TRUE(0x10 == read.sections[0].reserve);
+  ASSERT_TRUE(read.sections[0].placed);
+  ASSERT_TRUE(0x401000 == read.sections[0].addr);
+  ASSERT_TRUE(".text" == read.sections[0].name);
+  ASSERT_TRUE(IncrementalState::Section::Relocs == read.sections[1].mode);
+  ASSERT_FALSE(read.sections[1].placed);
+  ASSERT_TRUE(2 == read.symbols.size());
+  ASSERT_TRUE(5 == read.symbols[0].outIndex);
+  ASSERT_TRUE(IncrementalState::Symbol::Fixed == read.symbols[1].outIndex);
+
+  ASSERT_TRUE(1 == state.globals().size());
+  ASSERT_TRUE(state.globals().count("main"));
+  ASSERT_TRUE(0x401000 == state.globals().lookup("main").value);
+}
+
+TEST_F(IncrementalStateTest, bad_file) {
+  ASSERT_FALSE(m_pTestee->read(m_Path));
+
+  {
+    std::ofstream file(m_Path.c_str());
+    file << "mcld-incremental 0\n";
+  }
+  ASSERT_FALSE(m_pTestee->read(m_Path));
+
+  {
+    std::ofstream file(m_Path.c_str());
+    file << "mcld-incremental 1\nkey twelve\n";
+  }
+  ASSERT_FALSE(m_pTestee->read(m_Path));
+}
+
+TEST_F(IncrementalStateTest, digest) {
+  ASSERT_TRUE(IncrementalState::digest("abc") ==
+              IncrementalState::digest("abc"));
+  ASSERT_TRUE(IncrementalState::digest("abc") !=
+              IncrementalState::digest("abd"));
+  // the command line key keeps its separators
+  ASSERT_TRUE(IncrementalState::digest(llvm::StringRef("a\0b", 3)) !=
+              IncrementalState::digest(llvm::StringRef("ab\0", 3)));
+}
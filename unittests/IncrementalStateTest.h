@@ -0,0 +1,48 @@
+//===- IncrementalStateTest.h ---------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_INCREMENTALSTATE_TEST_H
+#define MCLD_INCREMENTALSTATE_TEST_H
+
+#include <gtest.h>
+
+#include <string>
+
+namespace mcld {
+class IncrementalState;
+}  // namespace for mcld
+
+namespace mcldtest {
+
+/** \class IncrementalStateTest
+ *  \brief The testcase of IncrementalState
+ *
+ *  \see IncrementalState
+ */
+class IncrementalStateTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  IncrementalStateTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~IncrementalStateTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  mcld::IncrementalState* m_pTestee;
+  std::string m_Path;
+};
+
+}  // namespace of mcldtest
+
+#endif
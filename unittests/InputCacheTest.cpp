@@ -0,0 +1,153 @@
+//===- InputCacheTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "InputCacheTest.h"
+#include "mcld/LD/ParsedInput.h"
+#include "mcld/Support/InputCache.h"
+#include "mcld/Support/MemoryArea.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+InputCacheTest::InputCacheTest() : m_pTestee(NULL) {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+InputCacheTest::~InputCacheTest() {
+  delete m_pTestee;
+}
+
+// SetUp() will be called immediately before each test.
+void InputCacheTest::SetUp() {
+  // test3.txt has 10708 bytes
+  m_Path = TOPDIR;
+  m_Path += "/unittests/test3.txt";
+  m_pTestee = new InputCache(1024 * 1024);
+}
+
+// TearDown() will be called immediately after each test.
+void InputCacheTest::TearDown() {
+  InputCache::setShared(NULL);
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(InputCacheTest, map_once) {
+  InputCache::Mapping first, second;
+  size_t size = 0;
+  ASSERT_TRUE(m_pTestee->acquire(m_Path, false, first, size));
+  ASSERT_TRUE(10708 == size);
+  ASSERT_TRUE(m_pTestee->acquire(m_Path, false, second, size));
+  ASSERT_TRUE(first.get() == second.get());
+
+  ASSERT_TRUE(1 == m_pTestee->size());
+  ASSERT_TRUE(10708 == m_pTestee->cachedBytes());
+  ASSERT_TRUE(1 == m_pTestee->numOfMisses());
+  ASSERT_TRUE(1 == m_pTestee->numOfHits());
+
+  std::vector<std::string> paths = m_pTestee->takeNewPaths();
+  ASSERT_TRUE(1 == paths.size());
+  ASSERT_TRUE(paths[0] == m_Path);
+  ASSERT_TRUE(m_pTestee->takeNewPaths().empty());
+}
+
+TEST_F(InputCacheTest, missing_file) {
+  InputCache::Mapping mapping;
+  size_t size = 0;
+  ASSERT_FALSE(m_pTestee->acquire(m_Path + ".missing", false, mapping, size));
+  ASSERT_TRUE(0 == m_pTestee->size());
+}
+
+TEST_F(InputCacheTest, changed_file) {
+  std::string path = "InputCacheTest.tmp";
+  std::remove(path.c_str());
+  {
+    std::ofstream file(path.c_str());
+    file << "first version";
+  }
+  InputCache::Mapping first;
+  size_t size = 0;
+  ASSERT_TRUE(m_pTestee->acquire(path, false, first, size));
+  ASSERT_TRUE(13 == size);
+
+  {
+    std::ofstream file(path.c_str(), std::ios::app);
+    file << ", changed";
+  }
+  InputCache::Mapping second;
+  ASSERT_TRUE(m_pTestee->acquire(path, false, second, size));
+  ASSERT_TRUE(22 == size);
+  ASSERT_TRUE(0 == memcmp(second.get(), "first version, changed", 22));
+  ASSERT_TRUE(2 == m_pTestee->numOfMisses());
+  ASSERT_TRUE(1 == m_pTestee->size());
+
+  // the old mapping stays valid while it is used
+  ASSERT_TRUE(0 == memcmp(first.get(), "first version", 13));
+  std::remove(path.c_str());
+}
+
+TEST_F(InputCacheTest, budget) {
+  InputCache small(1000);
+  InputCache::Mapping mapping;
+  size_t size = 0;
+  ASSERT_TRUE(small.acquire(m_Path, false, mapping, size));
+  // the newest entry is kept even if it alone exceeds the budget
+  ASSERT_TRUE(1 == small.size());
+
+  std::string other(TOPDIR);
+  other += "/unittests/test2.txt";
+  ASSERT_TRUE(small.acquire(other, false, mapping, size));
+  ASSERT_TRUE(1 == small.size());
+  ASSERT_TRUE(4096 == small.cachedBytes());
+}
+
+TEST_F(InputCacheTest, shared_by_memory_area) {
+  InputCache::setShared(m_pTestee);
+  {
+    MemoryArea area1(llvm::StringRef(m_Path), 0);
+    MemoryArea area2(llvm::StringRef(m_Path), 0);
+    ASSERT_TRUE(area1.isMapped());
+    ASSERT_TRUE(10708 == area1.size());
+    ASSERT_TRUE(area1.request(0, 1).data() == area2.request(0, 1).data());
+  }
+  // the mapping outlives the areas
+  ASSERT_TRUE(1 == m_pTestee->size());
+  ASSERT_TRUE(1 == m_pTestee->numOfHits());
+}
+
+TEST_F(InputCacheTest, parsed_tables) {
+  InputCache::Mapping mapping;
+  InputCache::Parsed parsed;
+  size_t size = 0;
+  ASSERT_TRUE(m_pTestee->acquire(m_Path, false, mapping, size, &parsed));
+  ASSERT_TRUE(NULL == parsed.get());
+
+  InputCache::Parsed tables(new ParsedInput(mapping.get(), size));
+  ASSERT_TRUE(m_pTestee->setParsed(m_Path, mapping, tables));
+  ASSERT_TRUE(1 == m_pTestee->numOfParsed());
+
+  // the tables go with the mapping to every later user of the file
+  ASSERT_TRUE(m_pTestee->acquire(m_Path, false, mapping, size, &parsed));
+  ASSERT_TRUE(tables == parsed);
+  InputCache::setShared(m_pTestee);
+  {
+    MemoryArea area(llvm::StringRef(m_Path), 0);
+    ASSERT_TRUE(tables.get() == area.parsed());
+  }
+
+  // tables of another mapping of the file are not kept
+  InputCache::Mapping other(new char[1], std::default_delete<char[]>());
+  ASSERT_FALSE(m_pTestee->setParsed(m_Path, other, tables));
+  ASSERT_FALSE(m_pTestee->setParsed(m_Path + ".missing", mapping, tables));
+}
@@ -0,0 +1,48 @@
+//===- InputCacheTest.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_INPUTCACHE_TEST_H
+#define MCLD_INPUTCACHE_TEST_H
+
+#include <gtest.h>
+
+#include <string>
+
+namespace mcld {
+class InputCache;
+}  // namespace for mcld
+
+namespace mcldtest {
+
+/** \class InputCacheTest
+ *  \brief The testcase of InputCache
+ *
+ *  \see InputCache
+ */
+class InputCacheTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  InputCacheTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~InputCacheTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  mcld::InputCache* m_pTestee;
+  std::string m_Path;
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -0,0 +1,103 @@
+//===- InputPrefetcherTest.cpp --------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "InputPrefetcherTest.h"
+#include "mcld/MC/InputPrefetcher.h"
+#include "mcld/Support/MemoryArea.h"
+
+#include <string>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+InputPrefetcherTest::InputPrefetcherTest() {
+  static const char* files[] = {
+      "test.txt", "test2.txt", "test3.txt", "test_x86_64.o"};
+  for (int i = 0; i < 4; ++i) {
+    std::string path(TOPDIR);
+    path += "/unittests/";
+    path += files[i];
+    m_pAreas[i] = new MemoryArea(path);
+  }
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+InputPrefetcherTest::~InputPrefetcherTest() {
+  for (int i = 0; i < 4; ++i)
+    delete m_pAreas[i];
+}
+
+// SetUp() will be called immediately before each test.
+void InputPrefetcherTest::SetUp() {
+}
+
+// TearDown() will be called immediately after each test.
+void InputPrefetcherTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(InputPrefetcherTest, add_unique_areas) {
+  InputPrefetcher prefetcher(4, 2, 1 << 20);
+  for (int i = 0; i < 4; ++i)
+    prefetcher.add(*m_pAreas[i]);
+  // archive members share the area of their archive
+  prefetcher.add(*m_pAreas[0]);
+  prefetcher.add(*m_pAreas[2]);
+  ASSERT_TRUE(4 == prefetcher.size());
+
+  // memory buffers are never prefetched
+  static const char data[] = "not a file";
+  MemoryArea buffer(data, sizeof(data));
+  prefetcher.add(buffer);
+  ASSERT_TRUE(4 == prefetcher.size());
+}
+
+TEST_F(InputPrefetcherTest, read_in_order) {
+  InputPrefetcher prefetcher(4, 2, 1 << 20);
+  for (int i = 0; i < 4; ++i)
+    prefetcher.add(*m_pAreas[i]);
+  prefetcher.start();
+
+  for (int i = 0; i < 4; ++i)
+    prefetcher.advance(*m_pAreas[i]);
+  // going back or reading an unknown area is harmless
+  prefetcher.advance(*m_pAreas[1]);
+  static const char data[] = "not a file";
+  MemoryArea buffer(data, sizeof(data));
+  prefetcher.advance(buffer);
+  prefetcher.stop();
+
+  ASSERT_TRUE(prefetcher.numOfPrefetched() <= 4);
+  ASSERT_TRUE(prefetcher.prefetchedBytes() <= 27 + 4096 + 10708 + 1496);
+}
+
+TEST_F(InputPrefetcherTest, disabled) {
+  // no lookahead
+  InputPrefetcher no_lookahead(4, 0, 1 << 20);
+  for (int i = 0; i < 4; ++i)
+    no_lookahead.add(*m_pAreas[i]);
+  no_lookahead.start();
+  for (int i = 0; i < 4; ++i)
+    no_lookahead.advance(*m_pAreas[i]);
+  no_lookahead.stop();
+  ASSERT_TRUE(0 == no_lookahead.numOfPrefetched());
+
+  // --no-threads
+  InputPrefetcher one_thread(1, 2, 1 << 20);
+  for (int i = 0; i < 4; ++i)
+    one_thread.add(*m_pAreas[i]);
+  one_thread.start();
+  for (int i = 0; i < 4; ++i)
+    one_thread.advance(*m_pAreas[i]);
+  one_thread.stop();
+  ASSERT_TRUE(0 == one_thread.numOfPrefetched());
+  ASSERT_TRUE(0 == one_thread.savedMicroseconds());
+}
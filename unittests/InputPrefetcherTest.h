@@ -0,0 +1,45 @@
+//===- InputPrefetcherTest.h ----------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_INPUTPREFETCHER_TEST_H
+#define MCLD_INPUTPREFETCHER_TEST_H
+
+#include <gtest.h>
+
+namespace mcld {
+class MemoryArea;
+}  // namespace for mcld
+
+namespace mcldtest {
+
+/** \class InputPrefetcherTest
+ *  \brief The testcase of InputPrefetcher
+ *
+ *  \see InputPrefetcher
+ */
+class InputPrefetcherTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  InputPrefetcherTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~InputPrefetcherTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  mcld::MemoryArea* m_pAreas[4];
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -0,0 +1,178 @@
+//===- LinkServerTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "LinkServerTest.h"
+#include "LinkServer.h"
+#include "mcld/Support/InputCache.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+/// FakeLink - a link that maps its second argument through the cache of
+/// the server and returns the number of arguments if it runs in the
+/// directory named by its first argument, plus 200 if the server has parsed
+/// the tables of that input
+int FakeLink(int pArgc, const char* const* pArgv) {
+  if (pArgc < 2)
+    return 100;
+
+  char* cwd = ::getcwd(NULL, 0);
+  bool same = (cwd != NULL) && (0 == std::strcmp(cwd, pArgv[1]));
+  free(cwd);
+  if (!same)
+    return 101;
+
+  if (pArgc > 2) {
+    InputCache* cache = InputCache::shared();
+    InputCache::Mapping mapping;
+    InputCache::Parsed parsed;
+    size_t size;
+    if (cache == NULL ||
+        !cache->acquire(pArgv[2], false, mapping, size, &parsed))
+      return 102;
+    if (parsed)
+      return 200 + pArgc;
+  }
+  return pArgc;
+}
+
+}  // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+LinkServerTest::LinkServerTest() : m_ServerPID(-1) {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+LinkServerTest::~LinkServerTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void LinkServerTest::SetUp() {
+  std::ostringstream socket;
+  socket << "/tmp/mcld-server-test-" << ::getpid() << ".sock";
+  m_Socket = socket.str();
+  // test3.txt has 10708 bytes
+  m_Input = TOPDIR;
+  m_Input += "/unittests/test3.txt";
+}
+
+// TearDown() will be called immediately after each test.
+void LinkServerTest::TearDown() {
+  if (m_ServerPID > 0) {
+    ::kill(m_ServerPID, SIGTERM);
+    ::waitpid(m_ServerPID, NULL, 0);
+  }
+  ::unlink(m_Socket.c_str());
+}
+
+bool LinkServerTest::startServer() {
+  m_ServerPID = ::fork();
+  if (m_ServerPID == 0) {
+    // serve() returns in the server on an error and in every forked link
+    LinkServer server(m_Socket, FakeLink, 1024 * 1024);
+    ::_exit(server.serve());
+  }
+  if (m_ServerPID < 0)
+    return false;
+
+  // wait up to 10 seconds for the socket
+  const char* argv[] = {"ld.mcld"};
+  for (unsigned i = 0; i < 1000; ++i) {
+    int status;
+    if (LinkServer::forward(m_Socket, 1, argv, status))
+      return true;
+    ::usleep(10000);
+  }
+  return false;
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(LinkServerTest, no_server) {
+  const char* argv[] = {"ld.mcld"};
+  int status = -1;
+  ASSERT_FALSE(LinkServer::forward(m_Socket, 1, argv, status));
+  ASSERT_TRUE(-1 == status);
+}
+
+TEST_F(LinkServerTest, forward) {
+  ASSERT_TRUE(startServer());
+
+  char* cwd = ::getcwd(NULL, 0);
+  ASSERT_TRUE(cwd != NULL);
+  std::string dir(cwd);
+  free(cwd);
+
+  // the link runs in our working directory and reports its status
+  const char* argv[] = {"ld.mcld", dir.c_str(), m_Input.c_str()};
+  int status = -1;
+  ASSERT_TRUE(LinkServer::forward(m_Socket, 2, argv, status));
+  ASSERT_TRUE(2 == status);
+
+  // inputs mapped by a link are warmed by the server for the next ones
+  for (unsigned i = 0; i < 8; ++i) {
+    status = -1;
+    ASSERT_TRUE(LinkServer::forward(m_Socket, 3, argv, status));
+    ASSERT_TRUE(3 == status);
+  }
+}
+
+TEST_F(LinkServerTest, second_server) {
+  ASSERT_TRUE(startServer());
+
+  // a live server keeps its socket
+  LinkServer server(m_Socket, FakeLink, 1024 * 1024);
+  ASSERT_TRUE(EXIT_FAILURE == server.serve());
+
+  const char* argv[] = {"ld.mcld"};
+  int status = -1;
+  ASSERT_TRUE(LinkServer::forward(m_Socket, 1, argv, status));
+}
+
+TEST_F(LinkServerTest, parsed_inputs) {
+  ASSERT_TRUE(startServer());
+
+  char* cwd = ::getcwd(NULL, 0);
+  ASSERT_TRUE(cwd != NULL);
+  std::string dir(cwd);
+  free(cwd);
+
+  std::string object(TOPDIR);
+  object += "/unittests/test_x86_64.o";
+  const char* argv[] = {"ld.mcld", dir.c_str(), object.c_str()};
+  int status = -1;
+  ASSERT_TRUE(LinkServer::forward(m_Socket, 3, argv, status));
+  ASSERT_TRUE(3 == status);
+
+  // the server parses the object after the first link, on its own thread,
+  // and the links forked later find the tables
+  for (unsigned i = 0; i < 1000 && 203 != status; ++i) {
+    ::usleep(10000);
+    ASSERT_TRUE(LinkServer::forward(m_Socket, 3, argv, status));
+  }
+  ASSERT_TRUE(203 == status);
+
+  // a text file parses to nothing and gets no tables
+  const char* text[] = {"ld.mcld", dir.c_str(), m_Input.c_str()};
+  for (unsigned i = 0; i < 4; ++i) {
+    ASSERT_TRUE(LinkServer::forward(m_Socket, 3, text, status));
+    ASSERT_TRUE(3 == status);
+    ::usleep(10000);
+  }
+}
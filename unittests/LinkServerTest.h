@@ -0,0 +1,50 @@
+//===- LinkServerTest.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_LINKSERVER_TEST_H
+#define MCLD_LINKSERVER_TEST_H
+
+#include <gtest.h>
+
+#include <string>
+
+namespace mcldtest {
+
+/** \class LinkServerTest
+ *  \brief The testcase of the link server and the forwarding client
+ *
+ *  \see LinkServer
+ */
+class LinkServerTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  LinkServerTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~LinkServerTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  /// startServer - run a server on m_Socket in a child process and wait
+  /// until it accepts links
+  bool startServer();
+
+ protected:
+  std::string m_Socket;
+  std::string m_Input;
+  int m_ServerPID;
+};
+
+}  // namespace of mcldtest
+
+#endif
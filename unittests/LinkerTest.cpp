@@ -15,11 +15,19 @@
 #include "mcld/Linker.h"
 #include "mcld/LinkerConfig.h"
 #include "mcld/LinkerScript.h"
+#include "mcld/LD/LDSection.h"
 
+#include "mcld/Support/LinkContext.h"
 #include "mcld/Support/Path.h"
 
 #include <llvm/Support/ELF.h>
 
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
 using namespace mcld;
 using namespace mcld::test;
 using namespace mcld::sys::fs;
@@ -499,3 +507,104 @@ TEST_F(LinkerTest, plasma_object) {
 
   Finalize();
 }
+
+// Objects created through the static factories belong to the current link
+// context, and each context has its own factories.
+TEST_F(LinkerTest, link_context_owns_factories) {
+  LinkContext context1;
+  LinkContext context2;
+
+  {
+    LinkContext::Scope scope(context1);
+    ASSERT_TRUE(&LinkContext::current() == &context1);
+    LDSection* sect1 = LDSection::Create(".text", LDFileFormat::TEXT, 0, 0);
+    ASSERT_TRUE(sect1->name() == ".text");
+    LinkerScript script;
+    Module module("test1", script);
+    ASSERT_TRUE(&module.getContext() == &context1);
+  }
+  ASSERT_TRUE(&LinkContext::current() == &LinkContext::global());
+
+  {
+    LinkContext::Scope scope(context2);
+    LDSection* sect2 = LDSection::Create(".data", LDFileFormat::DATA, 0, 0);
+    // releasing context1 must not touch the sections of context2
+    context1.release();
+    ASSERT_TRUE(sect2->name() == ".data");
+    LDSection::Destroy(sect2);
+  }
+}
+
+/// LinkPlasma - link libplasma.so into pOutput in a context of its own.
+static bool LinkPlasma(const std::string& pOutput) {
+  LinkContext context;
+  LinkContext::Scope scope(context);
+
+  LinkerScript script;
+  LinkerConfig config("armv7-none-linux-gnueabi");
+  Path search_dir(TOPDIR);
+  search_dir.append("test/libs/ARM/Android/android-14");
+  script.directories().insert(search_dir);
+
+  Linker linker;
+  linker.emulate(script, config);
+  config.setCodeGenType(LinkerConfig::DynObj);
+  config.options().setSOName("libplasma.so");
+
+  Module module("libplasma.so", script);
+  IRBuilder builder(module, config);
+
+  Path crtbegin(search_dir);
+  crtbegin.append("crtbegin_so.o");
+  builder.ReadInput("crtbegin", crtbegin);
+
+  Path plasma(TOPDIR);
+  plasma.append("test/Android/Plasma/ARM/plasma.o");
+  builder.ReadInput("plasma", plasma);
+
+  builder.ReadInput("m");
+  builder.ReadInput("log");
+  builder.ReadInput("jnigraphics");
+  builder.ReadInput("c");
+
+  Path crtend(search_dir);
+  crtend.append("crtend_so.o");
+  builder.ReadInput("crtend", crtend);
+
+  bool result = linker.link(module, builder) && linker.emit(module, pOutput);
+  linker.reset();
+  return result;
+}
+
+// Run independent links on several threads at once. Each of them works in
+// its own link context, so all outputs must be identical.
+TEST_F(LinkerTest, plasma_in_parallel) {
+  Initialize();
+
+  const unsigned num_links = 4;
+  bool results[num_links];
+  std::vector<std::thread> links;
+  for (unsigned i = 0; i < num_links; ++i) {
+    links.push_back(std::thread([i, &results]() {
+      results[i] = LinkPlasma("libplasma." + std::to_string(i) + ".so");
+    }));
+  }
+  for (std::thread& link : links)
+    link.join();
+
+  std::string expected;
+  for (unsigned i = 0; i < num_links; ++i) {
+    ASSERT_TRUE(results[i]);
+    std::ifstream output("libplasma." + std::to_string(i) + ".so",
+                         std::ios::binary);
+    std::string content((std::istreambuf_iterator<char>(output)),
+                        std::istreambuf_iterator<char>());
+    ASSERT_FALSE(content.empty());
+    if (i == 0)
+      expected = content;
+    else
+      ASSERT_TRUE(content == expected);
+  }
+
+  Finalize();
+}
@@ -0,0 +1,106 @@
+//===- MemoryAreaTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "MemoryAreaTest.h"
+#include "mcld/Support/FileHandle.h"
+#include "mcld/Support/MemoryArea.h"
+#include "mcld/Support/Path.h"
+
+#include <cstring>
+#include <string>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+MemoryAreaTest::MemoryAreaTest() : m_pTestee(NULL) {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+MemoryAreaTest::~MemoryAreaTest() {
+  delete m_pTestee;
+}
+
+// SetUp() will be called immediately before each test.
+void MemoryAreaTest::SetUp() {
+  // test3.txt has 10708 bytes, which is two full pages and a partial one.
+  std::string path(TOPDIR);
+  path += "/unittests/test3.txt";
+  m_pTestee = new MemoryArea(path);
+}
+
+// TearDown() will be called immediately after each test.
+void MemoryAreaTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(MemoryAreaTest, map_file) {
+  ASSERT_TRUE(m_pTestee->isMapped());
+  ASSERT_TRUE(10708 == m_pTestee->size());
+  ASSERT_TRUE(10708 == m_pTestee->mappedBytes());
+  ASSERT_TRUE(0 == m_pTestee->touchedBytes());
+
+  // the mapping has the same content as the file
+  sys::fs::Path path(TOPDIR);
+  path.append("unittests/test3.txt");
+  FileHandle file;
+  ASSERT_TRUE(file.open(path, FileHandle::OpenMode(FileHandle::ReadOnly),
+                        FileHandle::Permission(FileHandle::System)));
+  char buffer[128];
+  ASSERT_TRUE(file.read(buffer, 5000, sizeof(buffer)));
+  ASSERT_TRUE(file.close());
+
+  llvm::StringRef region = m_pTestee->request(5000, sizeof(buffer));
+  ASSERT_TRUE(0 == memcmp(buffer, region.data(), sizeof(buffer)));
+}
+
+TEST_F(MemoryAreaTest, touched_bytes) {
+  m_pTestee->request(0, 10);
+  ASSERT_TRUE(4096 == m_pTestee->touchedBytes());
+
+  // requesting the same page again does not count
+  m_pTestee->request(100, 10);
+  ASSERT_TRUE(4096 == m_pTestee->touchedBytes());
+
+  // the last page is partial
+  m_pTestee->request(9000, 100);
+  ASSERT_TRUE(4096 + 2516 == m_pTestee->touchedBytes());
+
+  // a region across the page boundary touches both pages
+  m_pTestee->request(4000, 200);
+  ASSERT_TRUE(10708 == m_pTestee->touchedBytes());
+
+  // prefetching does not touch anything
+  m_pTestee->prefetch(0, m_pTestee->size());
+  ASSERT_TRUE(10708 == m_pTestee->touchedBytes());
+}
+
+TEST_F(MemoryAreaTest, populate) {
+  std::string path(TOPDIR);
+  path += "/unittests/test3.txt";
+  MemoryArea populated(path, /*pPopulateLimit*/ 1 << 20);
+  ASSERT_TRUE(populated.isMapped());
+  ASSERT_TRUE(0 == populated.touchedBytes());
+
+  llvm::StringRef lhs = populated.request(0, populated.size());
+  llvm::StringRef rhs = m_pTestee->request(0, m_pTestee->size());
+  ASSERT_TRUE(lhs == rhs);
+}
+
+TEST_F(MemoryAreaTest, memory_buffer) {
+  static const char data[] = "MemoryArea over a memory buffer";
+  MemoryArea area(data, sizeof(data));
+  ASSERT_FALSE(area.isMapped());
+  ASSERT_TRUE(0 == area.mappedBytes());
+
+  llvm::StringRef region = area.request(11, 4);
+  ASSERT_TRUE(region == "over");
+  ASSERT_TRUE(0 == area.touchedBytes());
+}
@@ -0,0 +1,45 @@
+//===- MemoryAreaTest.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_MEMORYAREA_TEST_H
+#define MCLD_MEMORYAREA_TEST_H
+
+#include <gtest.h>
+
+namespace mcld {
+class MemoryArea;
+}  // namespace for mcld
+
+namespace mcldtest {
+
+/** \class MemoryAreaTest
+ *  \brief The testcase of MemoryArea
+ *
+ *  \see MemoryArea
+ */
+class MemoryAreaTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  MemoryAreaTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~MemoryAreaTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  mcld::MemoryArea* m_pTestee;
+};
+
+}  // namespace of mcldtest
+
+#endif
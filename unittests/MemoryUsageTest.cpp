@@ -0,0 +1,121 @@
+//===- MemoryUsageTest.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "MemoryUsageTest.h"
+#include "mcld/Support/GCFactory.h"
+#include "mcld/Support/LinkContext.h"
+#include "mcld/Support/MemoryUsage.h"
+
+#include <llvm/Support/raw_ostream.h>
+
+#include <string>
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+struct Point {
+  int x, y;
+};
+
+struct Line {
+  Point from, to;
+};
+
+}  // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+MemoryUsageTest::MemoryUsageTest() : m_pContext(NULL) {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+MemoryUsageTest::~MemoryUsageTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void MemoryUsageTest::SetUp() {
+  m_pContext = new LinkContext();
+}
+
+// TearDown() will be called immediately after each test.
+void MemoryUsageTest::TearDown() {
+  delete m_pContext;
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(MemoryUsageTest, type_name) {
+  ASSERT_TRUE("int" == getTypeName<int>());
+  // compilers may leave out the namespaces
+  ASSERT_TRUE(getTypeName<LinkContext*>().endswith("LinkContext*"));
+}
+
+TEST_F(MemoryUsageTest, factory_usage) {
+  LinkContext::Scope scope(*m_pContext);
+  GCFactory<Point, 4> points;
+  for (int i = 0; i < 5; ++i)
+    points.allocate();
+
+  AllocatorUsage usage = {points.allocatorName(), 0, 1, 0, 0, 0};
+  points.getUsage(usage);
+  ASSERT_TRUE(sizeof(Point) == usage.objectSize);
+  ASSERT_TRUE(2 == usage.chunks);
+  ASSERT_TRUE(5 == usage.objects);
+  ASSERT_TRUE(8 == usage.capacity);
+  ASSERT_TRUE(8 * sizeof(Point) == usage.allocatedBytes());
+  ASSERT_TRUE(3 * sizeof(Point) == usage.wastedBytes());
+}
+
+TEST_F(MemoryUsageTest, summed_by_type) {
+  LinkContext::Scope scope(*m_pContext);
+  MemoryUsage& memory = MemoryUsage::current();
+  GCFactory<Point, 4> points1, points2;
+  GCFactory<Line, 16> lines;
+  points1.allocate();
+  points2.allocate(4);
+  lines.allocate();
+  {
+    GCFactory<Point, 4> gone;
+    ASSERT_TRUE(4 == memory.numOfAllocators());
+  }
+  ASSERT_TRUE(3 == memory.numOfAllocators());
+
+  MemoryUsage::UsageList usage;
+  memory.getUsage(usage);
+  ASSERT_TRUE(2 == usage.size());
+  // the most allocated bytes come first
+  ASSERT_TRUE(usage[0].name.endswith("Line"));
+  ASSERT_TRUE(1 == usage[0].instances);
+  ASSERT_TRUE(usage[1].name.endswith("Point"));
+  ASSERT_TRUE(2 == usage[1].instances);
+  ASSERT_TRUE(2 == usage[1].chunks);
+  ASSERT_TRUE(5 == usage[1].objects);
+  ASSERT_TRUE(8 == usage[1].capacity);
+
+  std::string out;
+  llvm::raw_string_ostream os(out);
+  memory.print(os, "layout");
+  os.flush();
+  ASSERT_TRUE(0 == out.find("Memory usage after layout:\n"));
+  ASSERT_NE(std::string::npos, out.find("Point"));
+  ASSERT_NE(std::string::npos, out.find("  total "));
+}
+
+TEST_F(MemoryUsageTest, outlive_context) {
+  GCFactory<Point, 4>* points = NULL;
+  {
+    LinkContext context;
+    LinkContext::Scope scope(context);
+    points = new GCFactory<Point, 4>();
+    ASSERT_TRUE(1 == MemoryUsage::current().numOfAllocators());
+  }
+  // the context and its MemoryUsage have gone
+  delete points;
+}
@@ -0,0 +1,45 @@
+//===- MemoryUsageTest.h --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_MEMORYUSAGE_TEST_H
+#define MCLD_MEMORYUSAGE_TEST_H
+
+#include <gtest.h>
+
+namespace mcld {
+class LinkContext;
+}  // namespace for mcld
+
+namespace mcldtest {
+
+/** \class MemoryUsageTest
+ *  \brief The testcase of MemoryUsage
+ *
+ *  \see MemoryUsage
+ */
+class MemoryUsageTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  MemoryUsageTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~MemoryUsageTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  mcld::LinkContext* m_pContext;
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -0,0 +1,180 @@
+//===- ParsedInputTest.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "ParsedInputTest.h"
+#include "mcld/LD/ParsedInput.h"
+
+#include <llvm/Support/ELF.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+/// MemberHeader - the header of an archive member of pSize bytes
+std::string MemberHeader(const char* pName, size_t pSize) {
+  char header[61];
+  snprintf(header, sizeof(header), "%-16s%-12s%-6s%-6s%-8s%-10zu`\n", pName,
+           "0", "0", "0", "644", pSize);
+  return std::string(header, 60);
+}
+
+/// BigEndian32 - pValue as a 32-bit big-endian word
+std::string BigEndian32(uint32_t pValue) {
+  char word[4] = {static_cast<char>(pValue >> 24),
+                  static_cast<char>(pValue >> 16),
+                  static_cast<char>(pValue >> 8),
+                  static_cast<char>(pValue)};
+  return std::string(word, 4);
+}
+
+}  // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+ParsedInputTest::ParsedInputTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+ParsedInputTest::~ParsedInputTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void ParsedInputTest::SetUp() {
+  std::string path(TOPDIR);
+  path += "/unittests/test_x86_64.o";
+  std::ifstream file(path.c_str(), std::ios::binary);
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  m_Object = contents.str();
+}
+
+// TearDown() will be called immediately after each test.
+void ParsedInputTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(ParsedInputTest, parse_object) {
+  ASSERT_FALSE(m_Object.empty());
+  ParsedInput parsed(m_Object.data(), m_Object.size());
+  ASSERT_FALSE(parsed.empty());
+  ASSERT_FALSE(parsed.hasArchiveSymbols());
+  ASSERT_TRUE(1 == parsed.numOfObjects());
+
+  const ParsedInput::Object* object = parsed.getObject(0x0);
+  ASSERT_TRUE(NULL != object);
+  ASSERT_TRUE(NULL == parsed.getObject(0x40));
+
+  ASSERT_EQ(13u, object->sections.size());
+  const ParsedInput::Section& text = object->sections[1];
+  ASSERT_EQ(".text", text.name);
+  ASSERT_EQ(llvm::ELF::SHT_PROGBITS, text.type);
+  ASSERT_EQ(0x40u, text.offset);
+  ASSERT_EQ(0x15u, text.size);
+  ASSERT_EQ(0x4u, text.addralign);
+  ASSERT_TRUE(llvm::ELF::SHF_ALLOC & text.flags);
+
+  const ParsedInput::Section& rela = object->sections[2];
+  ASSERT_EQ(".rela.text", rela.name);
+  ASSERT_EQ(11u, rela.link);
+  ASSERT_EQ(1u, rela.info);
+
+  // the symbols of .symtab, with their names in .strtab
+  ASSERT_EQ(0x470u, object->symtabOffset);
+  ASSERT_EQ(0x108u, object->symtabSize);
+  ASSERT_EQ(11u, object->symbols.size());
+  const char* strtab = m_Object.data() + object->sections[12].offset;
+  ASSERT_EQ(std::string("hello.c"), strtab + object->symbols[1].name);
+  ASSERT_EQ(llvm::ELF::SHN_ABS, object->symbols[1].shndx);
+
+  const ParsedInput::Symbol& main = object->symbols[9];
+  ASSERT_EQ(std::string("main"), strtab + main.name);
+  ASSERT_EQ(1u, main.shndx);
+  ASSERT_EQ(21u, main.size);
+  ASSERT_EQ(llvm::ELF::STB_GLOBAL, main.info >> 4);
+  ASSERT_EQ(llvm::ELF::STT_FUNC, main.info & 0xf);
+
+  ASSERT_EQ(std::string("puts"), strtab + object->symbols[10].name);
+  ASSERT_EQ(llvm::ELF::SHN_UNDEF, object->symbols[10].shndx);
+}
+
+TEST_F(ParsedInputTest, parse_archive) {
+  std::string names("main\0puts\0", 10);
+  std::string index = BigEndian32(2);
+  size_t member = 8 + 60 + 4 + 8 + names.size();
+  index += BigEndian32(member);
+  index += BigEndian32(member);
+  index += names;
+
+  std::string archive("!<arch>\n");
+  archive += MemberHeader("/", index.size());
+  archive += index;
+  archive += MemberHeader("test_x86_64.o/", m_Object.size());
+  archive += m_Object;
+  ASSERT_TRUE(member + 60 + m_Object.size() == archive.size());
+  if (archive.size() % 2 != 0)
+    archive += '\n';
+
+  // a member with a long name, which is not a special member
+  std::string long_names("a_rather_long_member_name.o/\n");
+  archive += MemberHeader("//", long_names.size());
+  archive += long_names;
+  if (archive.size() % 2 != 0)
+    archive += '\n';
+  size_t long_member = archive.size();
+  archive += MemberHeader("/0", m_Object.size());
+  archive += m_Object;
+
+  ParsedInput parsed(archive.data(), archive.size());
+  ASSERT_TRUE(parsed.hasArchiveSymbols());
+  ASSERT_EQ(2u, parsed.archiveSymbols().size());
+  ASSERT_EQ("main", parsed.archiveSymbols()[0].name);
+  ASSERT_EQ(member, parsed.archiveSymbols()[0].fileOffset);
+  ASSERT_EQ("puts", parsed.archiveSymbols()[1].name);
+  ASSERT_EQ(member, parsed.archiveSymbols()[1].fileOffset);
+
+  // the member is found by the offset of its contents, as an Input of it is
+  ASSERT_TRUE(2 == parsed.numOfObjects());
+  ASSERT_TRUE(NULL == parsed.getObject(member));
+  const ParsedInput::Object* object = parsed.getObject(member + 60);
+  ASSERT_TRUE(NULL != object);
+  ASSERT_EQ(13u, object->sections.size());
+  ASSERT_EQ(11u, object->symbols.size());
+  ASSERT_TRUE(NULL != parsed.getObject(long_member + 60));
+
+  // an index claiming more symbols than it holds is left out
+  archive.replace(8 + 60, 4, BigEndian32(1000));
+  ParsedInput broken(archive.data(), archive.size());
+  ASSERT_FALSE(broken.hasArchiveSymbols());
+  ASSERT_TRUE(broken.archiveSymbols().empty());
+  ASSERT_TRUE(NULL != broken.getObject(member + 60));
+}
+
+TEST_F(ParsedInputTest, malformed) {
+  // not an input at all
+  ParsedInput text("hello, world\n", 13);
+  ASSERT_TRUE(text.empty());
+
+  // the section table is cut off
+  ParsedInput truncated(m_Object.data(), 0x200);
+  ASSERT_TRUE(truncated.empty());
+  ASSERT_TRUE(NULL == truncated.getObject(0x0));
+
+  // a section name out of .shstrtab
+  std::string object = m_Object;
+  uint64_t shoff = 0x130;
+  object[shoff + 64 + 0] = '\xff';
+  object[shoff + 64 + 1] = '\xff';
+  ParsedInput bad_name(object.data(), object.size());
+  ASSERT_TRUE(bad_name.empty());
+}
@@ -0,0 +1,44 @@
+//===- ParsedInputTest.h --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_PARSEDINPUT_TEST_H
+#define MCLD_PARSEDINPUT_TEST_H
+
+#include <gtest.h>
+
+#include <string>
+
+namespace mcldtest {
+
+/** \class ParsedInputTest
+ *  \brief The testcase of ParsedInput
+ *
+ *  \see ParsedInput
+ */
+class ParsedInputTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  ParsedInputTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~ParsedInputTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  /// the contents of unittests/test_x86_64.o
+  std::string m_Object;
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -0,0 +1,103 @@
+//===- RelrSectionTest.cpp ------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "RelrSectionTest.h"
+#include "mcld/Target/RelrSection.h"
+
+using namespace mcld;
+using namespace mcldtest;
+
+namespace {
+
+/// Decode - the addresses relocated by the .relr.dyn words pWords
+std::vector<uint64_t> Decode(const std::vector<uint64_t>& pWords,
+                             unsigned int pWordSize) {
+  std::vector<uint64_t> addrs;
+  uint64_t where = 0;
+  for (size_t i = 0; i < pWords.size(); ++i) {
+    uint64_t word = pWords[i];
+    if ((word & 0x1) == 0) {
+      addrs.push_back(word);
+      where = word + pWordSize;
+      continue;
+    }
+    for (unsigned int bit = 0; (word >>= 1) != 0; ++bit) {
+      if ((word & 0x1) != 0)
+        addrs.push_back(where + bit * pWordSize);
+    }
+    where += (pWordSize * 8 - 1) * pWordSize;
+  }
+  return addrs;
+}
+
+}  // anonymous namespace
+
+// Constructor can do set-up work for all test here.
+RelrSectionTest::RelrSectionTest() {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+RelrSectionTest::~RelrSectionTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void RelrSectionTest::SetUp() {
+  // runs of words, scattered words and words far apart
+  uint64_t addr = 0x10000;
+  for (unsigned int i = 0; i < 1000; ++i) {
+    m_Addrs.push_back(addr);
+    addr += ((i * 37) % 11 == 0) ? 8 * (i % 97) + 8 : 8;
+  }
+  m_Addrs.push_back(addr + 0x100000);
+}
+
+// TearDown() will be called immediately after each test.
+void RelrSectionTest::TearDown() {
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(RelrSectionTest, encode_bitmap) {
+  uint64_t addrs[] = {0x1000, 0x1008, 0x1010, 0x1100, 0x3000};
+  std::vector<uint64_t> words;
+  RelrSection::encode(std::vector<uint64_t>(addrs, addrs + 5), 8, words);
+  ASSERT_EQ(3U, words.size());
+  ASSERT_EQ(0x1000U, words[0]);
+  ASSERT_EQ(UINT64_C(0x100000007), words[1]);
+  ASSERT_EQ(0x3000U, words[2]);
+}
+
+TEST_F(RelrSectionTest, encode_long_run) {
+  // 101 words in a row take an address and two bitmaps
+  std::vector<uint64_t> addrs;
+  for (uint64_t i = 0; i <= 100; ++i)
+    addrs.push_back(0x2000 + i * 8);
+  std::vector<uint64_t> words;
+  RelrSection::encode(addrs, 8, words);
+  ASSERT_EQ(3U, words.size());
+  ASSERT_EQ(0x2000U, words[0]);
+  ASSERT_EQ(~UINT64_C(0), words[1]);
+  ASSERT_EQ((((UINT64_C(1) << 37) - 1) << 1) | 1, words[2]);
+}
+
+TEST_F(RelrSectionTest, round_trip) {
+  std::vector<uint64_t> words;
+  RelrSection::encode(m_Addrs, 8, words);
+  ASSERT_TRUE(words.size() < m_Addrs.size());
+  ASSERT_TRUE(Decode(words, 8) == m_Addrs);
+
+  // 32-bit words hold 31 bits per bitmap
+  std::vector<uint64_t> addrs32;
+  for (size_t i = 0; i < m_Addrs.size(); ++i)
+    addrs32.push_back(m_Addrs[i] / 2);
+  RelrSection::encode(addrs32, 4, words);
+  for (size_t i = 0; i < words.size(); ++i)
+    ASSERT_TRUE(words[i] <= UINT64_C(0xffffffff));
+  ASSERT_TRUE(Decode(words, 4) == addrs32);
+}
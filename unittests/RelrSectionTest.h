@@ -0,0 +1,45 @@
+//===- RelrSectionTest.h --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_RELRSECTION_TEST_H
+#define MCLD_RELRSECTION_TEST_H
+
+#include <gtest.h>
+
+#include <llvm/Support/DataTypes.h>
+
+#include <vector>
+
+namespace mcldtest {
+
+/** \class RelrSectionTest
+ *  \brief The testcase of RelrSection
+ *
+ *  \see RelrSection
+ */
+class RelrSectionTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  RelrSectionTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~RelrSectionTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  std::vector<uint64_t> m_Addrs;
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -0,0 +1,109 @@
+//===- SearchDirsTest.cpp -------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "SearchDirsTest.h"
+#include "mcld/MC/SearchDirs.h"
+#include "mcld/Support/Path.h"
+
+#include <errno.h>
+#include <string>
+
+using namespace mcld;
+using namespace mcld::sys::fs;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+SearchDirsTest::SearchDirsTest() {
+  // readdir() fails if errno is polluted by other testcases.
+  errno = 0;
+
+  // create testee. modify it if need
+  m_pTestee = new SearchDirs();
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+SearchDirsTest::~SearchDirsTest() {
+  delete m_pTestee;
+}
+
+// SetUp() will be called immediately before each test.
+void SearchDirsTest::SetUp() {
+  std::string root(TOPDIR);
+  ASSERT_TRUE(m_pTestee->insert(root + "/test/libs/X86/Android/android-14"));
+  ASSERT_TRUE(m_pTestee->insert(root + "/test/libs/X86/Linux"));
+  ASSERT_TRUE(m_pTestee->insert(root + "/test/libs/AArch64/Android"));
+}
+
+// TearDown() will be called immediately after each test.
+void SearchDirsTest::TearDown() {
+}
+
+//==========================================================================//
+// Testcases
+//
+TEST_F(SearchDirsTest, find_shared_object) {
+  std::string root(TOPDIR);
+  Path* path = m_pTestee->find("c", Input::DynObj);
+  ASSERT_TRUE(path != NULL);
+  EXPECT_TRUE(Path(root + "/test/libs/X86/Android/android-14/libc.so") ==
+              *path);
+
+  // only found in the last directory
+  path = m_pTestee->find("dl", Input::DynObj);
+  ASSERT_TRUE(path != NULL);
+  EXPECT_TRUE(Path(root + "/test/libs/AArch64/Android/libdl.so") == *path);
+}
+
+TEST_F(SearchDirsTest, find_archive) {
+  std::string root(TOPDIR);
+  // an archive is a fallback of a shared object
+  Path* path = m_pTestee->find("c_nonshared", Input::DynObj);
+  ASSERT_TRUE(path != NULL);
+  EXPECT_TRUE(Path(root + "/test/libs/X86/Linux/libc_nonshared.a") == *path);
+
+  // -Bstatic never picks up a shared object
+  EXPECT_TRUE(NULL == m_pTestee->find("c", Input::Archive));
+
+  path = m_pTestee->find("gcc", Input::Archive);
+  ASSERT_TRUE(path != NULL);
+  EXPECT_TRUE(Path(root + "/test/libs/AArch64/Android/libgcc.a") == *path);
+}
+
+TEST_F(SearchDirsTest, find_script) {
+  std::string root(TOPDIR);
+  Path* path = m_pTestee->find("crtbegin.o", Input::Script);
+  ASSERT_TRUE(path != NULL);
+  EXPECT_TRUE(Path(root + "/test/libs/X86/Linux/crtbegin.o") == *path);
+}
+
+TEST_F(SearchDirsTest, not_found) {
+  // versioned shared objects are not candidates of -l
+  EXPECT_TRUE(NULL == m_pTestee->find("gcc_s", Input::DynObj));
+  EXPECT_TRUE(NULL == m_pTestee->find("not_exist", Input::DynObj));
+  EXPECT_TRUE(NULL == m_pTestee->find("not_exist", Input::Archive));
+  EXPECT_TRUE(NULL == m_pTestee->find("not_exist", Input::Script));
+}
+
+// A driver command line with hundreds of -L and -l options.
+TEST_F(SearchDirsTest, many_namespecs) {
+  std::string root(TOPDIR);
+  for (int i = 0; i < 200; ++i)
+    ASSERT_TRUE(m_pTestee->insert(root + "/test/libs/X86/Linux/64"));
+
+  static const char* libs[] = {"c", "m", "log", "stdc++", "EGL", "dl",
+                               "gcc", "c_nonshared", "not_exist"};
+  const size_t num_libs = sizeof(libs) / sizeof(libs[0]);
+  for (int i = 0; i < 500; ++i) {
+    const char* name = libs[i % num_libs];
+    Path* path = m_pTestee->find(name, Input::DynObj);
+    if (i % num_libs == num_libs - 1)
+      EXPECT_TRUE(NULL == path);
+    else
+      EXPECT_TRUE(NULL != path);
+  }
+}
@@ -0,0 +1,45 @@
+//===- SearchDirsTest.h ---------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_SEARCHDIRS_TEST_H
+#define MCLD_SEARCHDIRS_TEST_H
+
+#include <gtest.h>
+
+namespace mcld {
+class SearchDirs;
+}  // namespace for mcld
+
+namespace mcldtest {
+
+/** \class SearchDirsTest
+ *  \brief The testcase of SearchDirs
+ *
+ *  \see SearchDirs
+ */
+class SearchDirsTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  SearchDirsTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~SearchDirsTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  mcld::SearchDirs* m_pTestee;
+};
+
+}  // namespace of mcldtest
+
+#endif
@@ -8,6 +8,10 @@
 //===----------------------------------------------------------------------===//
 #include "SectionDataTest.h"
 
+#include "mcld/Fragment/AlignFragment.h"
+#include "mcld/Fragment/FillFragment.h"
+#include "mcld/Fragment/FragmentIndex.h"
+#include "mcld/Fragment/FragmentRef.h"
 #include "mcld/LD/SectionData.h"
 #include "mcld/LD/LDFileFormat.h"
 #include "mcld/LD/LDSection.h"
@@ -73,3 +77,95 @@ TEST_F(SectionDataTest, Fragment_list_and_iterator) {
 
   LDSection::Destroy(test);
 }
+
+TEST_F(SectionDataTest, fragment_index) {
+  LDSection* test = LDSection::Create("test", LDFileFormat::DATA, 0, 0);
+  SectionData* s = SectionData::Create(*test);
+
+  new FillFragment(0x0, 1, 3, s);
+  new AlignFragment(8, 0x0, 1, 8, s);
+  new FillFragment(0x0, 1, 0, s);
+  new FillFragment(0x0, 1, 10, s);
+  new AlignFragment(4, 0x0, 1, 4, s);
+  new FillFragment(0x0, 1, 6, s);
+
+  FragmentIndex index;
+  index.build(*s);
+  ASSERT_EQ(6u, index.numOfFragments());
+  EXPECT_EQ(0u, index.getOffset(0));
+  EXPECT_EQ(3u, index.getOffset(1));
+  EXPECT_EQ(8u, index.getOffset(2));
+  EXPECT_EQ(8u, index.getOffset(3));
+  EXPECT_EQ(18u, index.getOffset(4));
+  EXPECT_EQ(20u, index.getOffset(5));
+  EXPECT_EQ(26u, index.getOffset(6));
+
+  index.assignOffsets();
+  EXPECT_EQ(18u, index.getFragment(4).getOffset());
+  EXPECT_EQ(2u, index.getFragment(4).size());
+
+  // binary search finds what the walk along the list finds
+  for (uint64_t offset = 0; offset <= 30; ++offset) {
+    FragmentRef* walk = FragmentRef::Create(s->front(), offset);
+    FragmentRef* search = FragmentRef::Create(index, offset);
+    ASSERT_EQ(walk->isNull(), search->isNull());
+    if (walk->isNull())
+      continue;
+    EXPECT_EQ(walk->frag(), search->frag());
+    EXPECT_EQ(walk->offset(), search->offset());
+  }
+
+  // the section finds offsets through its index while it has one
+  test->setSectionData(s);
+  EXPECT_TRUE(NULL == s->getIndex());
+  {
+    FragmentRef::IndexScope scope(*test);
+    ASSERT_TRUE(NULL != s->getIndex());
+    FragmentRef* ref = FragmentRef::Create(*test, 19);
+    EXPECT_EQ(&index.getFragment(4), ref->frag());
+    EXPECT_EQ(1u, ref->offset());
+  }
+  EXPECT_TRUE(NULL == s->getIndex());
+
+  LDSection::Destroy(test);
+}
+
+TEST_F(SectionDataTest, update_offsets) {
+  LDSection* test = LDSection::Create("test", LDFileFormat::DATA, 0, 0);
+  SectionData* s = SectionData::Create(*test);
+
+  // enough fragments to lay them out on several threads
+  const size_t size = 20000;
+  for (size_t i = 0; i < size; ++i) {
+    if (i % 7 == 3)
+      new AlignFragment(16, 0x0, 1, 16, s);
+    else
+      new FillFragment(0x0, 1, i % 5, s);
+  }
+  FragmentIndex serial;
+  serial.build(*s);
+  serial.assignOffsets();
+
+  FragmentIndex parallel;
+  parallel.build(*s, 4);
+  ASSERT_EQ(size, parallel.numOfFragments());
+  for (size_t i = 0; i <= size; ++i)
+    ASSERT_EQ(serial.getOffset(i), parallel.getOffset(i));
+
+  // grow a fragment in the middle, as a stub would, and lay out the rest
+  SectionData::iterator grown = s->begin();
+  std::advance(grown, size / 2);
+  Fragment* stub = new FillFragment(0x0, 1, 12);
+  stub->setParent(s);
+  s->getFragmentList().insertAfter(grown, stub);
+  s->updateOffsets(*stub, 4);
+
+  FragmentIndex expected;
+  expected.build(*s);
+  size_t idx = 0;
+  for (SectionData::iterator frag = s->begin(); frag != s->end(); ++frag)
+    ASSERT_EQ(expected.getOffset(idx++), frag->getOffset());
+  EXPECT_EQ(grown->getOffset() + grown->size(), stub->getOffset());
+
+  LDSection::Destroy(test);
+}
@@ -0,0 +1,101 @@
+//===- TimeTraceTest.cpp --------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include "TimeTraceTest.h"
+#include "mcld/Support/LinkContext.h"
+#include "mcld/Support/Parallel.h"
+#include "mcld/Support/TimeTrace.h"
+
+#include <llvm/Support/raw_ostream.h>
+
+#include <string>
+
+using namespace mcld;
+using namespace mcldtest;
+
+// Constructor can do set-up work for all test here.
+TimeTraceTest::TimeTraceTest() : m_pContext(NULL) {
+}
+
+// Destructor can do clean-up work that doesn't throw exceptions here.
+TimeTraceTest::~TimeTraceTest() {
+}
+
+// SetUp() will be called immediately before each test.
+void TimeTraceTest::SetUp() {
+  m_pContext = new LinkContext();
+}
+
+// TearDown() will be called immediately after each test.
+void TimeTraceTest::TearDown() {
+  delete m_pContext;
+}
+
+//===----------------------------------------------------------------------===//
+// Testcases
+//===----------------------------------------------------------------------===//
+TEST_F(TimeTraceTest, disabled) {
+  LinkContext::Scope scope(*m_pContext);
+  TimeTrace& trace = TimeTrace::current();
+  {
+    TimeTrace::Scope step("layout");
+  }
+  trace.addCounter("symbols", 10);
+  ASSERT_FALSE(trace.isEnabled());
+  ASSERT_TRUE(0 == trace.numOfEvents());
+}
+
+TEST_F(TimeTraceTest, steps_and_counters) {
+  LinkContext::Scope scope(*m_pContext);
+  TimeTrace& trace = TimeTrace::current();
+  trace.enable();
+  {
+    TimeTrace::Scope phase("Layout");
+    TimeTrace::Scope step("readInput", "dir/\"a\".o");
+  }
+  trace.addCounter("symbols", 10);
+  trace.addCounter("symbols", 12);
+  ASSERT_TRUE(4 == trace.numOfEvents());
+
+  std::string json;
+  llvm::raw_string_ostream os(json);
+  trace.write(os);
+  os.flush();
+  ASSERT_TRUE(0 == json.find("{\"traceEvents\":["));
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"readInput\""));
+  ASSERT_NE(std::string::npos, json.find("\"detail\":\"dir/\\\"a\\\".o\""));
+  ASSERT_NE(std::string::npos,
+            json.find("\"ph\":\"C\",\"args\":{\"symbols\":12}"));
+  ASSERT_NE(std::string::npos, json.find("\"thread_name\""));
+
+  std::string stats;
+  llvm::raw_string_ostream ss(stats);
+  trace.printStats(ss);
+  ss.flush();
+  // steps are listed in the order they finished
+  ASSERT_TRUE(stats.find("readInput") < stats.find("Layout"));
+  // a counter shows its last value
+  ASSERT_NE(std::string::npos, stats.find(" 12\n"));
+  ASSERT_EQ(std::string::npos, stats.find(" 10\n"));
+}
+
+TEST_F(TimeTraceTest, worker_threads) {
+  LinkContext::Scope scope(*m_pContext);
+  TimeTrace& trace = TimeTrace::current();
+  trace.enable();
+  parallel::forEach(4, 64, 1, [](size_t pIdx) {
+    TimeTrace::Scope step("work");
+  });
+  ASSERT_TRUE(64 == trace.numOfEvents());
+
+  std::string stats;
+  llvm::raw_string_ostream ss(stats);
+  trace.printStats(ss);
+  ss.flush();
+  ASSERT_NE(std::string::npos, stats.find("      64\n"));
+}
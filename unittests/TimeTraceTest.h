@@ -0,0 +1,45 @@
+//===- TimeTraceTest.h ----------------------------------------------------===//
+//
+//                     The MCLinker Project
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#ifndef MCLD_TIMETRACE_TEST_H
+#define MCLD_TIMETRACE_TEST_H
+
+#include <gtest.h>
+
+namespace mcld {
+class LinkContext;
+}  // namespace for mcld
+
+namespace mcldtest {
+
+/** \class TimeTraceTest
+ *  \brief The testcase of TimeTrace
+ *
+ *  \see TimeTrace
+ */
+class TimeTraceTest : public ::testing::Test {
+ public:
+  // Constructor can do set-up work for all test here.
+  TimeTraceTest();
+
+  // Destructor can do clean-up work that doesn't throw exceptions here.
+  virtual ~TimeTraceTest();
+
+  // SetUp() will be called immediately before each test.
+  virtual void SetUp();
+
+  // TearDown() will be called immediately after each test.
+  virtual void TearDown();
+
+ protected:
+  mcld::LinkContext* m_pContext;
+};
+
+}  // namespace of mcldtest
+
+#endif